@@ -1,5 +1,5 @@
 // SPDX-License-Identifier: MIT
-// Copyright (c) 2018-2023 The Pybricks Authors
+// Copyright (c) 2018-2026 The Pybricks Authors
 
 // This file provides a MicroPython runtime to run code in MULTI_MPY_V6 format.
 
@@ -430,6 +430,7 @@ void pbsys_main_run_program(pbsys_main_program_t *program) {
 }
 
 void pbsys_main_run_program_cleanup(void) {
+    pb_package_pybricks_deinit();
     gc_sweep_all();
     mp_deinit();
 }
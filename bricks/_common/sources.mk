@@ -1,5 +1,5 @@
 # SPDX-License-Identifier: MIT
-# Copyright (c) 2019-2023 The Pybricks Authors
+# Copyright (c) 2019-2026 The Pybricks Authors
 
 # This file contains the sources common to all Pybricks MicroPython ports.
 
@@ -48,6 +48,8 @@ PYBRICKS_PYBRICKS_SRC_C = $(addprefix pybricks/,\
 	iodevices/pb_type_i2c_device.c \
 	iodevices/pb_type_iodevices_lwp3device.c \
 	iodevices/pb_type_iodevices_pupdevice.c \
+	iodevices/pb_type_iodevices_sampler.c \
+	iodevices/pb_type_iodevices_trigger.c \
 	iodevices/pb_type_iodevices_xbox_controller.c \
 	iodevices/pb_type_uart_device.c \
 	messaging/pb_module_messaging.c \
@@ -152,6 +154,7 @@ PBIO_SRC_C = $(addprefix lib/pbio/,\
 	drv/gpio/gpio_pico.c \
 	drv/gpio/gpio_stm32.c \
 	drv/gpio/gpio_virtual.c \
+	drv/i2c/i2c.c \
 	drv/i2c/i2c_ev3.c \
 	drv/imu/imu_lsm6ds3tr_c_stm32.c \
 	drv/ioport/ioport.c \
@@ -204,6 +207,7 @@ PBIO_SRC_C = $(addprefix lib/pbio/,\
 	src/battery.c \
 	src/busy_count.c \
 	src/cobs.c \
+	src/color/calibration.c \
 	src/color/conversion.c \
 	src/color/util.c \
 	src/control_settings.c \
@@ -234,9 +238,11 @@ PBIO_SRC_C = $(addprefix lib/pbio/,\
 	src/port.c \
 	src/protocol/nus.c \
 	src/protocol/pybricks.c \
+	src/sampler.c \
 	src/servo.c \
 	src/tacho.c \
 	src/trajectory.c \
+	src/trigger.c \
 	src/util.c \
 	sys/battery_temp.c \
 	sys/battery.c \
@@ -253,6 +259,7 @@ PBIO_SRC_C = $(addprefix lib/pbio/,\
 	sys/main.c \
 	sys/program_stop.c \
 	sys/status.c \
+	sys/storage_kv.c \
 	sys/storage_settings.c \
 	sys/storage.c \
 	sys/telemetry.c \
@@ -1,5 +1,5 @@
 // SPDX-License-Identifier: MIT
-// Copyright (c) 2025 The Pybricks Authors
+// Copyright (c) 2025-2026 The Pybricks Authors
 
 #define MICROPY_HW_BOARD_NAME                   "Raspberry Pi Build HAT"
 #define MICROPY_HW_MCU_NAME                     "RP2040"
@@ -32,6 +32,8 @@
 #define PYBRICKS_PY_IODEVICES_LUMP_DEVICE       (0)
 #define PYBRICKS_PY_IODEVICES_LWP3_DEVICE       (0)
 #define PYBRICKS_PY_IODEVICES_PUP_DEVICE        (0) // TODO
+#define PYBRICKS_PY_IODEVICES_SAMPLER           (0)
+#define PYBRICKS_PY_IODEVICES_TRIGGER           (0)
 #define PYBRICKS_PY_IODEVICES_UART_DEVICE       (0) // TODO
 #define PYBRICKS_PY_IODEVICES_XBOX_CONTROLLER   (0)
 #define PYBRICKS_PY_MESSAGING                   (1)
@@ -44,6 +46,7 @@
 #define PYBRICKS_PY_PARAMETERS_ICON             (0)
 #define PYBRICKS_PY_PARAMETERS_IMAGE            (0)
 #define PYBRICKS_PY_DEVICES                     (1)
+#define PYBRICKS_PY_DEVICES_COLOR_CALIBRATION   (0)
 #define PYBRICKS_PY_PUPDEVICES                  (0) // TODO
 #define PYBRICKS_PY_ROBOTICS                    (0) // TODO
 #define PYBRICKS_PY_ROBOTICS_DRIVEBASE_GYRO     (0) // TODO
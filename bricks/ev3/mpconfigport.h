@@ -1,5 +1,5 @@
 // SPDX-License-Identifier: MIT
-// Copyright (c) 2024 The Pybricks Authors
+// Copyright (c) 2024-2026 The Pybricks Authors
 
 
 #define MICROPY_HW_BOARD_NAME                   "MINDSTORMS EV3 Brick"
@@ -39,6 +39,8 @@
 #define PYBRICKS_PY_IODEVICES_LUMP_DEVICE       (1)
 #define PYBRICKS_PY_IODEVICES_LWP3_DEVICE       (0)
 #define PYBRICKS_PY_IODEVICES_PUP_DEVICE        (1)
+#define PYBRICKS_PY_IODEVICES_SAMPLER           (1)
+#define PYBRICKS_PY_IODEVICES_TRIGGER           (1)
 #define PYBRICKS_PY_IODEVICES_UART_DEVICE       (1)
 #define PYBRICKS_PY_IODEVICES_XBOX_CONTROLLER   (0)
 #define PYBRICKS_PY_MESSAGING                   (1)
@@ -52,6 +54,7 @@
 #define PYBRICKS_PY_PARAMETERS_IMAGE            (1)
 #define PYBRICKS_PY_PARAMETERS_IMAGE_FILE       (1)
 #define PYBRICKS_PY_DEVICES                     (1)
+#define PYBRICKS_PY_DEVICES_COLOR_CALIBRATION   (1)
 #define PYBRICKS_PY_PUPDEVICES                  (0)
 #define PYBRICKS_PY_PUPDEVICES_REMOTE           (0)
 #define PYBRICKS_PY_ROBOTICS                    (1)
@@ -1,5 +1,5 @@
 // SPDX-License-Identifier: MIT
-// Copyright (c) 2018-2023 The Pybricks Authors
+// Copyright (c) 2018-2026 The Pybricks Authors
 
 #include "stm32f070xb.h"
 
@@ -38,6 +38,7 @@
 #define PYBRICKS_PY_PARAMETERS_ICON             (0)
 #define PYBRICKS_PY_PARAMETERS_IMAGE            (0)
 #define PYBRICKS_PY_DEVICES                     (1)
+#define PYBRICKS_PY_DEVICES_COLOR_CALIBRATION   (0)
 #define PYBRICKS_PY_PUPDEVICES                  (1)
 #define PYBRICKS_PY_PUPDEVICES_DUPLO_TRAIN      (0)
 #define PYBRICKS_PY_PUPDEVICES_MARIO            (0)
@@ -1,5 +1,5 @@
 // SPDX-License-Identifier: MIT
-// Copyright (c) 2018-2023 The Pybricks Authors
+// Copyright (c) 2018-2026 The Pybricks Authors
 
 #define MICROPY_HW_BOARD_NAME                   "LEGO MINDSTORMS NXT Brick"
 #define MICROPY_HW_MCU_NAME                     "AT91SAM7S256"
@@ -37,6 +37,8 @@
 #define PYBRICKS_PY_IODEVICES_LUMP_DEVICE       (0)
 #define PYBRICKS_PY_IODEVICES_LWP3_DEVICE       (0)
 #define PYBRICKS_PY_IODEVICES_PUP_DEVICE        (0)
+#define PYBRICKS_PY_IODEVICES_SAMPLER           (0)
+#define PYBRICKS_PY_IODEVICES_TRIGGER           (0)
 #define PYBRICKS_PY_IODEVICES_UART_DEVICE       (0)
 #define PYBRICKS_PY_IODEVICES_XBOX_CONTROLLER   (0)
 #define PYBRICKS_PY_MESSAGING                   (0)
@@ -49,6 +51,7 @@
 #define PYBRICKS_PY_PARAMETERS_IMAGE            (1)
 #define PYBRICKS_PY_PARAMETERS_IMAGE_FILE       (0)
 #define PYBRICKS_PY_DEVICES                     (1)
+#define PYBRICKS_PY_DEVICES_COLOR_CALIBRATION   (0)
 #define PYBRICKS_PY_ROBOTICS                    (1)
 #define PYBRICKS_PY_ROBOTICS_DRIVEBASE_GYRO     (0)
 #define PYBRICKS_PY_ROBOTICS_DRIVEBASE_SPIKE    (0)
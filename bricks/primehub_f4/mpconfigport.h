@@ -1,5 +1,5 @@
 // SPDX-License-Identifier: MIT
-// Copyright (c) 2019-2023 The Pybricks Authors
+// Copyright (c) 2019-2026 The Pybricks Authors
 
 #include "stm32f413xx.h"
 
@@ -37,6 +37,8 @@
 #define PYBRICKS_PY_IODEVICES_LUMP_DEVICE       (0)
 #define PYBRICKS_PY_IODEVICES_LWP3_DEVICE       (1)
 #define PYBRICKS_PY_IODEVICES_PUP_DEVICE        (1)
+#define PYBRICKS_PY_IODEVICES_SAMPLER           (1)
+#define PYBRICKS_PY_IODEVICES_TRIGGER           (1)
 #define PYBRICKS_PY_IODEVICES_UART_DEVICE       (1)
 #define PYBRICKS_PY_IODEVICES_XBOX_CONTROLLER   (1)
 #define PYBRICKS_PY_MEDIA_IMAGE                 (0)
@@ -50,6 +52,7 @@
 #define PYBRICKS_PY_PARAMETERS_BUTTON           (1)
 #define PYBRICKS_PY_PARAMETERS_ICON             (1)
 #define PYBRICKS_PY_DEVICES                     (1)
+#define PYBRICKS_PY_DEVICES_COLOR_CALIBRATION   (1)
 #define PYBRICKS_PY_PUPDEVICES                  (1)
 #define PYBRICKS_PY_PUPDEVICES_DUPLO_TRAIN      (1)
 #define PYBRICKS_PY_PUPDEVICES_MARIO            (1)
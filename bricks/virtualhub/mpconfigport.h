@@ -36,6 +36,8 @@
 #define PYBRICKS_PY_IODEVICES_LUMP_DEVICE       (0)
 #define PYBRICKS_PY_IODEVICES_LWP3_DEVICE       (1)
 #define PYBRICKS_PY_IODEVICES_PUP_DEVICE        (0)
+#define PYBRICKS_PY_IODEVICES_SAMPLER           (0)
+#define PYBRICKS_PY_IODEVICES_TRIGGER           (0)
 #define PYBRICKS_PY_IODEVICES_UART_DEVICE       (0)
 #define PYBRICKS_PY_IODEVICES_XBOX_CONTROLLER   (1)
 #define PYBRICKS_PY_MESSAGING                   (1)
@@ -55,6 +57,7 @@
 #define PYBRICKS_PY_PUPDEVICES_REMOTE           (1)
 #define PYBRICKS_PY_PUPDEVICES_TECHNIC_MOVE_HUB (1)
 #define PYBRICKS_PY_DEVICES                     (1)
+#define PYBRICKS_PY_DEVICES_COLOR_CALIBRATION   (1)
 #define PYBRICKS_PY_ROBOTICS                    (1)
 #define PYBRICKS_PY_ROBOTICS_DRIVEBASE_SPIKE    (0)
 #define PYBRICKS_PY_TOOLS                       (1)
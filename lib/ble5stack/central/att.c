@@ -91,7 +91,9 @@ bStatus_t ATT_ExecuteWriteRsp(uint16_t connHandle) {
 }
 
 bStatus_t ATT_HandleValueNoti(uint16_t connHandle, attHandleValueNoti_t *pNoti) {
-    uint8_t buf[32];
+    // Large enough for notifications up to the full size of an HCI command
+    // packet, minus the SPI/HCI header (6 bytes) and checksum (1 byte).
+    uint8_t buf[TX_BUFFER_SIZE - 7];
 
     buf[0] = connHandle & 0xFF;
     buf[1] = (connHandle >> 8) & 0xFF;
@@ -1,5 +1,5 @@
 // SPDX-License-Identifier: MIT
-// Copyright (c) 2025 The Pybricks Authors
+// Copyright (c) 2025-2026 The Pybricks Authors
 
 // Block device driver for N25Q128 SPI flash memory chip and the ADS7957SRHB
 // ADC converter, both connected to SPI0 on the TIAM1808.
@@ -558,6 +558,46 @@ enum {
     FLASH_STATUS_BUSY = 0x01,
 };
 
+/**
+ * Number of erasable sectors in the storage area.
+ */
+#define NUM_SECTORS ((PBDRV_CONFIG_BLOCK_DEVICE_EV3_SIZE + FLASH_SIZE_ERASE - 1) / FLASH_SIZE_ERASE)
+
+/**
+ * What we know about the contents of each sector on flash, so that sectors
+ * that did not change can be skipped when saving.
+ */
+static struct {
+    /** CRC-32 of the stored bytes. */
+    uint32_t crc;
+    /** Number of stored bytes covered by the CRC, or 0 if unknown. */
+    uint32_t size;
+} sectors[NUM_SECTORS];
+
+/**
+ * Gets the number of bytes in a sector that are used for a disk of given size.
+ *
+ * @param [in]  offset  Start of the sector.
+ * @param [in]  size    Total number of bytes used on the disk.
+ * @return              Number of used bytes in this sector.
+ */
+static uint32_t sector_used_size(uint32_t offset, uint32_t size) {
+    return offset >= size ? 0 : pbio_int_math_min(size - offset, FLASH_SIZE_ERASE);
+}
+
+/**
+ * Records the checksum of each sector after loading the disk from flash.
+ *
+ * @param [in]  buffer  The loaded data.
+ * @param [in]  size    Number of bytes loaded.
+ */
+static void sectors_set_loaded(const uint8_t *buffer, uint32_t size) {
+    for (uint32_t offset = 0; offset < size; offset += FLASH_SIZE_ERASE) {
+        sectors[offset / FLASH_SIZE_ERASE].size = sector_used_size(offset, size);
+        sectors[offset / FLASH_SIZE_ERASE].crc = pbio_crc32(0, buffer + offset, sectors[offset / FLASH_SIZE_ERASE].size);
+    }
+}
+
 // N25Q128 manufacturer and device ID.
 static const uint8_t device_id[] = {0x20, 0xba, 0x18};
 
@@ -638,6 +678,7 @@ static pbio_error_t pbdrv_block_device_write_disk(pbio_os_state_t *state, const
     static uint32_t offset;
     static uint32_t size_now;
     static uint32_t size_done;
+    static uint32_t crc;
     pbio_error_t err;
 
     PBIO_OS_ASYNC_BEGIN(state);
@@ -647,8 +688,18 @@ static pbio_error_t pbdrv_block_device_write_disk(pbio_os_state_t *state, const
         return PBIO_ERROR_INVALID_ARG;
     }
 
-    // Erase sector by sector.
     for (offset = 0; offset < size; offset += FLASH_SIZE_ERASE) {
+
+        // Skip sectors that are already stored with the same contents.
+        crc = pbio_crc32(0, buffer + offset, sector_used_size(offset, size));
+        if (sectors[offset / FLASH_SIZE_ERASE].size == sector_used_size(offset, size) &&
+            sectors[offset / FLASH_SIZE_ERASE].crc == crc) {
+            continue;
+        }
+
+        // Contents are unknown until the sector is fully written.
+        sectors[offset / FLASH_SIZE_ERASE].size = 0;
+
         // Enable writing
         err = spi_begin_for_flash(cmd_write_enable, sizeof(cmd_write_enable), 0, 0, 0);
         if (err != PBIO_SUCCESS) {
@@ -669,32 +720,35 @@ static pbio_error_t pbdrv_block_device_write_disk(pbio_os_state_t *state, const
         if (err != PBIO_SUCCESS) {
             return err;
         }
-    }
 
-    // Write page by page.
-    for (size_done = 0; size_done < size; size_done += size_now) {
-        size_now = pbio_int_math_min(size - size_done, FLASH_SIZE_WRITE);
+        // Write the used part of this sector page by page.
+        for (size_done = offset; size_done < offset + sector_used_size(offset, size); size_done += size_now) {
+            size_now = pbio_int_math_min(size - size_done, FLASH_SIZE_WRITE);
 
-        // Enable writing
-        err = spi_begin_for_flash(cmd_write_enable, sizeof(cmd_write_enable), 0, 0, 0);
-        if (err != PBIO_SUCCESS) {
-            return err;
-        }
-        PBIO_OS_AWAIT_WHILE(state, spi_dev.status & SPI_STATUS_WAIT_ANY);
+            // Enable writing
+            err = spi_begin_for_flash(cmd_write_enable, sizeof(cmd_write_enable), 0, 0, 0);
+            if (err != PBIO_SUCCESS) {
+                return err;
+            }
+            PBIO_OS_AWAIT_WHILE(state, spi_dev.status & SPI_STATUS_WAIT_ANY);
 
-        // Write this block
-        set_address_be(&write_address[1], PBDRV_CONFIG_BLOCK_DEVICE_EV3_START_ADDRESS + size_done);
-        err = spi_begin_for_flash(write_address, sizeof(write_address), buffer + size_done, 0, size_now);
-        if (err != PBIO_SUCCESS) {
-            return err;
-        }
-        PBIO_OS_AWAIT_WHILE(state, spi_dev.status & SPI_STATUS_WAIT_ANY);
+            // Write this block
+            set_address_be(&write_address[1], PBDRV_CONFIG_BLOCK_DEVICE_EV3_START_ADDRESS + size_done);
+            err = spi_begin_for_flash(write_address, sizeof(write_address), buffer + size_done, 0, size_now);
+            if (err != PBIO_SUCCESS) {
+                return err;
+            }
+            PBIO_OS_AWAIT_WHILE(state, spi_dev.status & SPI_STATUS_WAIT_ANY);
 
-        // Wait for completion
-        PBIO_OS_AWAIT(state, &sub, err = flash_wait_write(&sub));
-        if (err != PBIO_SUCCESS) {
-            return err;
+            // Wait for completion
+            PBIO_OS_AWAIT(state, &sub, err = flash_wait_write(&sub));
+            if (err != PBIO_SUCCESS) {
+                return err;
+            }
         }
+
+        sectors[offset / FLASH_SIZE_ERASE].crc = crc;
+        sectors[offset / FLASH_SIZE_ERASE].size = sector_used_size(offset, size);
     }
 
     PBIO_OS_ASYNC_END(PBIO_SUCCESS);
@@ -919,6 +973,11 @@ pbio_error_t ev3_spi_process_thread(pbio_os_state_t *state, void *context) {
     // properly on shutdown.
     pbdrv_block_device_load_err = err;
 
+    // Remember what is on flash now, so we only have to write changes later.
+    if (err == PBIO_SUCCESS) {
+        sectors_set_loaded((uint8_t *)&ramdisk, ramdisk.saved_size);
+    }
+
     // Read one set of ADC samples before continuing boot.
     // This ensures that e.g. the low-battery warning doesn't falsely trigger.
     pbdrv_block_device_ev3_spi_begin_for_adc(
@@ -1,5 +1,5 @@
 // SPDX-License-Identifier: MIT
-// Copyright (c) 2024 The Pybricks Authors
+// Copyright (c) 2024-2026 The Pybricks Authors
 
 // Block device dummy driver with a simple program to simplify making new ports.
 
@@ -12,9 +12,15 @@
 
 #include "../sys/storage_data.h"
 
+#include <pbdrv/block_device.h>
+
 #include <pbio/os.h>
 #include <pbio/version.h>
 
+#include "block_device_test.h"
+
+#if PBDRV_CONFIG_BLOCK_DEVICE_RAM_SIZE
+
 /**
 The following script is compiled using pybricksdev compile hello.py in MULTI_MPY_V6.
 
@@ -80,15 +86,71 @@ pbio_error_t pbdrv_block_device_get_data(pbsys_storage_data_map_t **data) {
     return PBIO_SUCCESS;
 }
 
+// Don't store any data in this implementation.
+pbio_error_t pbdrv_block_device_write_all(pbio_os_state_t *state, uint32_t used_data_size) {
+    return PBIO_ERROR_NOT_IMPLEMENTED;
+}
+
+#endif // PBDRV_CONFIG_BLOCK_DEVICE_RAM_SIZE
+
+#if PBDRV_CONFIG_BLOCK_DEVICE_JOURNAL_NUM_SECTORS
+
+#define JOURNAL_SIZE (PBDRV_CONFIG_BLOCK_DEVICE_JOURNAL_NUM_SECTORS * PBDRV_CONFIG_BLOCK_DEVICE_JOURNAL_SECTOR_SIZE)
+
+// Journal in RAM that behaves like flash: programming only clears bits.
+static uint8_t journal[JOURNAL_SIZE];
+
+// Error returned by writes and erases, to simulate failing flash.
+static pbio_error_t journal_err;
+
+void pbdrv_block_device_test_set_journal_error(pbio_error_t err) {
+    journal_err = err;
+}
+
+pbio_error_t pbdrv_block_device_journal_read(pbio_os_state_t *state, uint32_t offset, uint8_t *buffer, uint32_t size) {
+    if (size == 0 || offset + size > JOURNAL_SIZE) {
+        return PBIO_ERROR_INVALID_ARG;
+    }
+    memcpy(buffer, &journal[offset], size);
+    return PBIO_SUCCESS;
+}
+
+pbio_error_t pbdrv_block_device_journal_write(pbio_os_state_t *state, uint32_t offset, const uint8_t *buffer, uint32_t size) {
+    if (size == 0 || offset + size > JOURNAL_SIZE) {
+        return PBIO_ERROR_INVALID_ARG;
+    }
+    if (journal_err != PBIO_SUCCESS) {
+        return journal_err;
+    }
+    for (uint32_t i = 0; i < size; i++) {
+        journal[offset + i] &= buffer[i];
+    }
+    return PBIO_SUCCESS;
+}
+
+pbio_error_t pbdrv_block_device_journal_erase(pbio_os_state_t *state, uint32_t offset) {
+    if (offset % PBDRV_CONFIG_BLOCK_DEVICE_JOURNAL_SECTOR_SIZE || offset >= JOURNAL_SIZE) {
+        return PBIO_ERROR_INVALID_ARG;
+    }
+    if (journal_err != PBIO_SUCCESS) {
+        return journal_err;
+    }
+    memset(&journal[offset], 0xFF, PBDRV_CONFIG_BLOCK_DEVICE_JOURNAL_SECTOR_SIZE);
+    return PBIO_SUCCESS;
+}
+
+#endif // PBDRV_CONFIG_BLOCK_DEVICE_JOURNAL_NUM_SECTORS
+
 void pbdrv_block_device_init(void) {
+    #if PBDRV_CONFIG_BLOCK_DEVICE_RAM_SIZE
     ramdisk.data_map.slot_info[0].size = sizeof(_program_data);
     memcpy(ramdisk.data_map.stored_firmware_hash, MICROPY_GIT_HASH, sizeof(ramdisk.data_map.stored_firmware_hash));
     memcpy(ramdisk.data_map.program_data, _program_data, sizeof(_program_data));
-}
+    #endif
 
-// Don't store any data in this implementation.
-pbio_error_t pbdrv_block_device_write_all(pbio_os_state_t *state, uint32_t used_data_size) {
-    return PBIO_ERROR_NOT_IMPLEMENTED;
+    #if PBDRV_CONFIG_BLOCK_DEVICE_JOURNAL_NUM_SECTORS
+    memset(journal, 0xFF, sizeof(journal));
+    #endif
 }
 
 #endif // PBDRV_CONFIG_BLOCK_DEVICE_TEST
@@ -0,0 +1,18 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2026 The Pybricks Authors
+
+#ifndef _INTERNAL_PBDRV_BLOCK_DEVICE_TEST_H_
+#define _INTERNAL_PBDRV_BLOCK_DEVICE_TEST_H_
+
+#include <pbdrv/config.h>
+
+#if PBDRV_CONFIG_BLOCK_DEVICE_TEST && PBDRV_CONFIG_BLOCK_DEVICE_JOURNAL_NUM_SECTORS
+
+#include <pbio/error.h>
+
+// extra journal function just for tests: makes writes and erases fail with err
+void pbdrv_block_device_test_set_journal_error(pbio_error_t err);
+
+#endif // PBDRV_CONFIG_BLOCK_DEVICE_TEST && PBDRV_CONFIG_BLOCK_DEVICE_JOURNAL_NUM_SECTORS
+
+#endif // _INTERNAL_PBDRV_BLOCK_DEVICE_TEST_H_
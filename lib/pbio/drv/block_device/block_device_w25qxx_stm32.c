@@ -40,6 +40,7 @@
 #include <pbio/busy_count.h>
 #include <pbio/error.h>
 #include <pbio/int_math.h>
+#include <pbio/util.h>
 
 #define DEBUG 0
 #if DEBUG
@@ -132,6 +133,46 @@ enum {
     FLASH_STATUS_WRITE_ENABLED = 0x02,
 };
 
+/**
+ * Number of erasable sectors in the storage area.
+ */
+#define NUM_SECTORS ((PBDRV_CONFIG_BLOCK_DEVICE_W25QXX_STM32_SIZE + FLASH_SIZE_ERASE - 1) / FLASH_SIZE_ERASE)
+
+/**
+ * What we know about the contents of each sector on flash, so that sectors
+ * that did not change can be skipped when saving.
+ */
+static struct {
+    /** CRC-32 of the stored bytes. */
+    uint32_t crc;
+    /** Number of stored bytes covered by the CRC, or 0 if unknown. */
+    uint32_t size;
+} sectors[NUM_SECTORS];
+
+/**
+ * Gets the number of bytes in a sector that are used for a disk of given size.
+ *
+ * @param [in]  offset  Start of the sector.
+ * @param [in]  size    Total number of bytes used on the disk.
+ * @return              Number of used bytes in this sector.
+ */
+static uint32_t sector_used_size(uint32_t offset, uint32_t size) {
+    return offset >= size ? 0 : pbio_int_math_min(size - offset, FLASH_SIZE_ERASE);
+}
+
+/**
+ * Records the checksum of each sector after loading the disk from flash.
+ *
+ * @param [in]  buffer  The loaded data.
+ * @param [in]  size    Number of bytes loaded.
+ */
+static void sectors_set_loaded(const uint8_t *buffer, uint32_t size) {
+    for (uint32_t offset = 0; offset < size; offset += FLASH_SIZE_ERASE) {
+        sectors[offset / FLASH_SIZE_ERASE].size = sector_used_size(offset, size);
+        sectors[offset / FLASH_SIZE_ERASE].crc = pbio_crc32(0, buffer + offset, sectors[offset / FLASH_SIZE_ERASE].size);
+    }
+}
+
 // W25Qxx manufacturer and device ID.
 static const uint8_t device_id[] = {0xEF, 0x40, W25Qxx(0x16, 0x19)};
 
@@ -894,12 +935,20 @@ static pbio_error_t flash_erase_or_write(pbio_os_state_t *state, uint32_t addres
     PBIO_OS_ASYNC_END(PBIO_SUCCESS);
 }
 
-pbio_error_t pbdrv_block_device_write_all(pbio_os_state_t *state, uint32_t used_data_size) {
+/**
+ * Set while an operation started by one of the public functions below is
+ * using the flash. These may be requested by different processes, so they
+ * have to take turns.
+ */
+static bool flash_in_use;
+
+static pbio_error_t write_all(pbio_os_state_t *state, uint32_t used_data_size) {
 
     static pbio_os_state_t sub;
     static uint32_t offset;
     static uint32_t size_now;
     static uint32_t size_done;
+    static uint32_t crc;
     pbio_error_t err;
 
     // We're going to write the used portion of the ramdisk to flash. Includes
@@ -917,21 +966,78 @@ pbio_error_t pbdrv_block_device_write_all(pbio_os_state_t *state, uint32_t used_
     // Store the new size so we know how much to load on next boot.
     ramdisk.saved_size = size;
 
-    // Erase sector by sector.
     for (offset = 0; offset < size; offset += FLASH_SIZE_ERASE) {
+
+        // Skip sectors that are already stored with the same contents.
+        crc = pbio_crc32(0, buffer + offset, sector_used_size(offset, size));
+        if (sectors[offset / FLASH_SIZE_ERASE].size == sector_used_size(offset, size) &&
+            sectors[offset / FLASH_SIZE_ERASE].crc == crc) {
+            continue;
+        }
+
+        // Contents are unknown until the sector is fully written.
+        sectors[offset / FLASH_SIZE_ERASE].size = 0;
+
         // Writing size 0 means erase.
         PBIO_OS_AWAIT(state, &sub, err = flash_erase_or_write(&sub,
             PBDRV_CONFIG_BLOCK_DEVICE_W25QXX_STM32_START_ADDRESS + offset, NULL, 0));
         if (err != PBIO_SUCCESS) {
             return err;
         }
+
+        // Write the used part of this sector page by page.
+        for (size_done = offset; size_done < offset + sector_used_size(offset, size); size_done += size_now) {
+            size_now = pbio_int_math_min(size - size_done, FLASH_SIZE_WRITE);
+            PBIO_OS_AWAIT(state, &sub, err = flash_erase_or_write(&sub,
+                PBDRV_CONFIG_BLOCK_DEVICE_W25QXX_STM32_START_ADDRESS + size_done, buffer + size_done, size_now));
+            if (err != PBIO_SUCCESS) {
+                return err;
+            }
+        }
+
+        sectors[offset / FLASH_SIZE_ERASE].crc = crc;
+        sectors[offset / FLASH_SIZE_ERASE].size = sector_used_size(offset, size);
     }
 
-    // Write page by page.
+    PBIO_OS_ASYNC_END(PBIO_SUCCESS);
+}
+
+pbio_error_t pbdrv_block_device_write_all(pbio_os_state_t *state, uint32_t used_data_size) {
+
+    static pbio_os_state_t sub;
+    pbio_error_t err;
+
+    PBIO_OS_ASYNC_BEGIN(state);
+
+    PBIO_OS_AWAIT_UNTIL(state, !flash_in_use);
+    flash_in_use = true;
+
+    PBIO_OS_AWAIT(state, &sub, err = write_all(&sub, used_data_size));
+
+    flash_in_use = false;
+
+    PBIO_OS_ASYNC_END(err);
+}
+
+#if PBDRV_CONFIG_BLOCK_DEVICE_JOURNAL_NUM_SECTORS || PBDRV_CONFIG_BLOCK_DEVICE_RESOURCE_SIZE
+
+/**
+ * Programs data that may span several pages. The area must be erased.
+ */
+static pbio_error_t flash_write_pages(pbio_os_state_t *state, uint32_t address, const uint8_t *buffer, uint32_t size) {
+
+    static pbio_os_state_t sub;
+    static uint32_t size_done;
+    static uint32_t size_now;
+    pbio_error_t err;
+
+    PBIO_OS_ASYNC_BEGIN(state);
+
+    // Page programs wrap around at the page boundary, so split up writes that
+    // don't start at the beginning of a page.
     for (size_done = 0; size_done < size; size_done += size_now) {
-        size_now = pbio_int_math_min(size - size_done, FLASH_SIZE_WRITE);
-        PBIO_OS_AWAIT(state, &sub, err = flash_erase_or_write(&sub,
-            PBDRV_CONFIG_BLOCK_DEVICE_W25QXX_STM32_START_ADDRESS + size_done, buffer + size_done, size_now));
+        size_now = pbio_int_math_min(size - size_done, FLASH_SIZE_WRITE - (address + size_done) % FLASH_SIZE_WRITE);
+        PBIO_OS_AWAIT(state, &sub, err = flash_erase_or_write(&sub, address + size_done, (uint8_t *)buffer + size_done, size_now));
         if (err != PBIO_SUCCESS) {
             return err;
         }
@@ -940,6 +1046,282 @@ pbio_error_t pbdrv_block_device_write_all(pbio_os_state_t *state, uint32_t used_
     PBIO_OS_ASYNC_END(PBIO_SUCCESS);
 }
 
+#endif // PBDRV_CONFIG_BLOCK_DEVICE_JOURNAL_NUM_SECTORS || PBDRV_CONFIG_BLOCK_DEVICE_RESOURCE_SIZE
+
+#if PBDRV_CONFIG_BLOCK_DEVICE_JOURNAL_NUM_SECTORS
+
+_Static_assert(PBDRV_CONFIG_BLOCK_DEVICE_JOURNAL_SECTOR_SIZE == FLASH_SIZE_ERASE,
+    "Journal sectors must match the flash erase size.");
+
+/**
+ * Total size of the journal area.
+ */
+#define JOURNAL_SIZE (PBDRV_CONFIG_BLOCK_DEVICE_JOURNAL_NUM_SECTORS * FLASH_SIZE_ERASE)
+
+pbio_error_t pbdrv_block_device_journal_read(pbio_os_state_t *state, uint32_t offset, uint8_t *buffer, uint32_t size) {
+
+    static pbio_os_state_t sub;
+    pbio_error_t err;
+
+    PBIO_OS_ASYNC_BEGIN(state);
+
+    // Exit on invalid size. Journal is always smaller than one read chunk.
+    if (size == 0 || offset + size > JOURNAL_SIZE) {
+        return PBIO_ERROR_INVALID_ARG;
+    }
+
+    PBIO_OS_AWAIT_UNTIL(state, !flash_in_use);
+    flash_in_use = true;
+
+    PBIO_OS_AWAIT(state, &sub, err = flash_read(&sub,
+        PBDRV_CONFIG_BLOCK_DEVICE_W25QXX_STM32_JOURNAL_ADDRESS + offset, buffer, size));
+
+    flash_in_use = false;
+
+    PBIO_OS_ASYNC_END(err);
+}
+
+pbio_error_t pbdrv_block_device_journal_write(pbio_os_state_t *state, uint32_t offset, const uint8_t *buffer, uint32_t size) {
+
+    static pbio_os_state_t sub;
+    pbio_error_t err;
+
+    PBIO_OS_ASYNC_BEGIN(state);
+
+    // Exit on invalid size.
+    if (size == 0 || offset + size > JOURNAL_SIZE) {
+        return PBIO_ERROR_INVALID_ARG;
+    }
+
+    PBIO_OS_AWAIT_UNTIL(state, !flash_in_use);
+    flash_in_use = true;
+
+    PBIO_OS_AWAIT(state, &sub, err = flash_write_pages(&sub,
+        PBDRV_CONFIG_BLOCK_DEVICE_W25QXX_STM32_JOURNAL_ADDRESS + offset, buffer, size));
+
+    flash_in_use = false;
+
+    PBIO_OS_ASYNC_END(err);
+}
+
+pbio_error_t pbdrv_block_device_journal_erase(pbio_os_state_t *state, uint32_t offset) {
+
+    static pbio_os_state_t sub;
+    pbio_error_t err;
+
+    PBIO_OS_ASYNC_BEGIN(state);
+
+    if (offset % FLASH_SIZE_ERASE || offset >= JOURNAL_SIZE) {
+        return PBIO_ERROR_INVALID_ARG;
+    }
+
+    PBIO_OS_AWAIT_UNTIL(state, !flash_in_use);
+    flash_in_use = true;
+
+    // Writing size 0 means erase.
+    PBIO_OS_AWAIT(state, &sub, err = flash_erase_or_write(&sub,
+        PBDRV_CONFIG_BLOCK_DEVICE_W25QXX_STM32_JOURNAL_ADDRESS + offset, NULL, 0));
+
+    flash_in_use = false;
+
+    PBIO_OS_ASYNC_END(err);
+}
+
+#endif // PBDRV_CONFIG_BLOCK_DEVICE_JOURNAL_NUM_SECTORS
+
+#if PBDRV_CONFIG_BLOCK_DEVICE_RESOURCE_SIZE
+
+/**
+ * Size of one block in the resource cache.
+ */
+#define RESOURCE_BLOCK_SIZE (512)
+
+_Static_assert(PBDRV_CONFIG_BLOCK_DEVICE_RESOURCE_CACHE_BLOCKS >= 2,
+    "Resource cache needs room for read-ahead.");
+
+/**
+ * Cache of recently read blocks from the resource area.
+ */
+static struct {
+    /** Offset of the cached block, or UINT32_MAX if not valid. */
+    uint32_t offset;
+    /** When this block was last used, to find the least recently used one. */
+    uint32_t last_used;
+    /** Cached data. */
+    uint8_t data[RESOURCE_BLOCK_SIZE];
+} resource_cache[PBDRV_CONFIG_BLOCK_DEVICE_RESOURCE_CACHE_BLOCKS];
+
+/**
+ * Increments each time a cached block is used.
+ */
+static uint32_t resource_cache_use_count;
+
+/**
+ * Invalidates all cached resource blocks.
+ */
+static void resource_cache_reset(void) {
+    for (uint32_t i = 0; i < PBDRV_CONFIG_BLOCK_DEVICE_RESOURCE_CACHE_BLOCKS; i++) {
+        resource_cache[i].offset = UINT32_MAX;
+        resource_cache[i].last_used = 0;
+    }
+}
+
+/**
+ * Gets the index of a cached block.
+ *
+ * @param [in]  offset  Offset of the block in the resource area.
+ * @return              Index of the block or -1 if it is not cached.
+ */
+static int32_t resource_cache_find(uint32_t offset) {
+    for (uint32_t i = 0; i < PBDRV_CONFIG_BLOCK_DEVICE_RESOURCE_CACHE_BLOCKS; i++) {
+        if (resource_cache[i].offset == offset) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+/**
+ * Gets the index of the least recently used block, except the given one.
+ *
+ * @param [in]  keep    Index of a block that should stay cached, or -1.
+ * @return              Index of the block that can be replaced.
+ */
+static int32_t resource_cache_get_oldest(int32_t keep) {
+    int32_t oldest = keep == 0 ? 1 : 0;
+    for (int32_t i = 0; i < PBDRV_CONFIG_BLOCK_DEVICE_RESOURCE_CACHE_BLOCKS; i++) {
+        if (i != keep && resource_cache[i].last_used < resource_cache[oldest].last_used) {
+            oldest = i;
+        }
+    }
+    return oldest;
+}
+
+static pbio_error_t resource_read(pbio_os_state_t *state, uint32_t offset, uint8_t *buffer, uint32_t size) {
+
+    static pbio_os_state_t sub;
+    static uint32_t size_done;
+    static uint32_t size_now;
+    static uint32_t block;
+    static int32_t index;
+    static int32_t ahead;
+    pbio_error_t err;
+
+    PBIO_OS_ASYNC_BEGIN(state);
+
+    for (size_done = 0; size_done < size; size_done += size_now) {
+        block = offset + size_done - (offset + size_done) % RESOURCE_BLOCK_SIZE;
+        index = resource_cache_find(block);
+
+        if (index < 0) {
+            index = resource_cache_get_oldest(-1);
+            resource_cache[index].offset = UINT32_MAX;
+            PBIO_OS_AWAIT(state, &sub, err = flash_read(&sub,
+                PBDRV_CONFIG_BLOCK_DEVICE_W25QXX_STM32_RESOURCE_ADDRESS + block,
+                resource_cache[index].data, RESOURCE_BLOCK_SIZE));
+            if (err != PBIO_SUCCESS) {
+                return err;
+            }
+            resource_cache[index].offset = block;
+            resource_cache[index].last_used = ++resource_cache_use_count;
+
+            // Resources are mostly read front to back, so also get the next
+            // block if it isn't cached already.
+            if (block + RESOURCE_BLOCK_SIZE < PBDRV_CONFIG_BLOCK_DEVICE_RESOURCE_SIZE &&
+                resource_cache_find(block + RESOURCE_BLOCK_SIZE) < 0) {
+                ahead = resource_cache_get_oldest(index);
+                resource_cache[ahead].offset = UINT32_MAX;
+                PBIO_OS_AWAIT(state, &sub, err = flash_read(&sub,
+                    PBDRV_CONFIG_BLOCK_DEVICE_W25QXX_STM32_RESOURCE_ADDRESS + block + RESOURCE_BLOCK_SIZE,
+                    resource_cache[ahead].data, RESOURCE_BLOCK_SIZE));
+                if (err != PBIO_SUCCESS) {
+                    return err;
+                }
+                resource_cache[ahead].offset = block + RESOURCE_BLOCK_SIZE;
+                resource_cache[ahead].last_used = resource_cache_use_count;
+            }
+        }
+
+        size_now = pbio_int_math_min(size - size_done, block + RESOURCE_BLOCK_SIZE - (offset + size_done));
+        memcpy(buffer + size_done, &resource_cache[index].data[offset + size_done - block], size_now);
+        resource_cache[index].last_used = ++resource_cache_use_count;
+    }
+
+    PBIO_OS_ASYNC_END(PBIO_SUCCESS);
+}
+
+pbio_error_t pbdrv_block_device_resource_read(pbio_os_state_t *state, uint32_t offset, uint8_t *buffer, uint32_t size) {
+
+    static pbio_os_state_t sub;
+    pbio_error_t err;
+
+    PBIO_OS_ASYNC_BEGIN(state);
+
+    if (size == 0 || offset + size > PBDRV_CONFIG_BLOCK_DEVICE_RESOURCE_SIZE) {
+        return PBIO_ERROR_INVALID_ARG;
+    }
+
+    PBIO_OS_AWAIT_UNTIL(state, !flash_in_use);
+    flash_in_use = true;
+
+    PBIO_OS_AWAIT(state, &sub, err = resource_read(&sub, offset, buffer, size));
+
+    flash_in_use = false;
+
+    PBIO_OS_ASYNC_END(err);
+}
+
+static pbio_error_t resource_write(pbio_os_state_t *state, uint32_t offset, const uint8_t *buffer, uint32_t size) {
+
+    static pbio_os_state_t sub;
+    static uint32_t sector;
+    pbio_error_t err;
+
+    PBIO_OS_ASYNC_BEGIN(state);
+
+    // Erase each sector in the written range. The start is aligned to a
+    // sector, so no other data is erased.
+    for (sector = offset; sector < offset + size; sector += FLASH_SIZE_ERASE) {
+        PBIO_OS_AWAIT(state, &sub, err = flash_erase_or_write(&sub,
+            PBDRV_CONFIG_BLOCK_DEVICE_W25QXX_STM32_RESOURCE_ADDRESS + sector, NULL, 0));
+        if (err != PBIO_SUCCESS) {
+            return err;
+        }
+    }
+
+    PBIO_OS_AWAIT(state, &sub, err = flash_write_pages(&sub,
+        PBDRV_CONFIG_BLOCK_DEVICE_W25QXX_STM32_RESOURCE_ADDRESS + offset, buffer, size));
+
+    PBIO_OS_ASYNC_END(err);
+}
+
+pbio_error_t pbdrv_block_device_resource_write(pbio_os_state_t *state, uint32_t offset, const uint8_t *buffer, uint32_t size) {
+
+    static pbio_os_state_t sub;
+    pbio_error_t err;
+
+    PBIO_OS_ASYNC_BEGIN(state);
+
+    // Writes must start at a sector, since the sectors are erased first.
+    if (size == 0 || offset % FLASH_SIZE_ERASE || offset + size > PBDRV_CONFIG_BLOCK_DEVICE_RESOURCE_SIZE) {
+        return PBIO_ERROR_INVALID_ARG;
+    }
+
+    PBIO_OS_AWAIT_UNTIL(state, !flash_in_use);
+    flash_in_use = true;
+
+    // Cached data may be overwritten, including when writing fails halfway.
+    resource_cache_reset();
+
+    PBIO_OS_AWAIT(state, &sub, err = resource_write(&sub, offset, buffer, size));
+
+    flash_in_use = false;
+
+    PBIO_OS_ASYNC_END(err);
+}
+
+#endif // PBDRV_CONFIG_BLOCK_DEVICE_RESOURCE_SIZE
+
 pbio_error_t pbdrv_block_device_w25qxx_stm32_init_process_thread(pbio_os_state_t *state, void *context) {
 
     pbio_error_t err;
@@ -995,6 +1377,13 @@ pbio_error_t pbdrv_block_device_w25qxx_stm32_init_process_thread(pbio_os_state_t
     // higher level code sees this error when requesting the RAM disk. On
     // failure, it can reset the user data to factory defaults, and save it
     // properly on shutdown.
+    if (err != PBIO_SUCCESS) {
+        goto done;
+    }
+
+    // Remember what is on flash now, so we only have to write changes later.
+    sectors_set_loaded((uint8_t *)&ramdisk, ramdisk.saved_size);
+
 done:
     pbio_busy_count_down();
 
@@ -1003,6 +1392,10 @@ done:
 
 void pbdrv_block_device_init(void) {
 
+    #if PBDRV_CONFIG_BLOCK_DEVICE_RESOURCE_SIZE
+    resource_cache_reset();
+    #endif // PBDRV_CONFIG_BLOCK_DEVICE_RESOURCE_SIZE
+
     #if PBDRV_CONFIG_BLOCK_DEVICE_W25QXX_STM32_XSPI
     bdev.pdata = &pbdrv_block_device_w25qxx_stm32_platform_data;
     bdev.spi_status = SPI_STATUS_COMPLETE;
@@ -47,6 +47,18 @@ void pbdrv_bluetooth_set_receive_handler(pbdrv_bluetooth_receive_handler_t handl
 static uint32_t pbdrv_bluetooth_noti_size[PBIO_PYBRICKS_EVENT_NUM_EVENTS];
 static uint8_t pbdrv_bluetooth_noti_buf[PBIO_PYBRICKS_EVENT_NUM_EVENTS][PBDRV_BLUETOOTH_MAX_CHAR_SIZE];
 
+/**
+ * Stdout is sent in notifications of up to the negotiated MTU size, so it
+ * gets its own buffer instead of the one in pbdrv_bluetooth_noti_buf.
+ */
+static uint8_t stdout_noti_buf[PBDRV_BLUETOOTH_MAX_MTU_SIZE - 3];
+
+/**
+ * Stdout is sent when a full notification is ready or when this timer expires.
+ * It is started when stdout data arrives while none is waiting to be sent.
+ */
+static pbio_os_timer_t stdout_flush_timer;
+
 /**
  * Buffer scheduled status.
  */
@@ -73,7 +85,7 @@ static lwrb_t stdout_ring_buf;
 void pbdrv_bluetooth_init(void) {
     // enough for two packets, one currently being sent and one to be ready
     // as soon as the previous one completes + 1 byte for ring buf pointer
-    static uint8_t stdout_buf[PBDRV_BLUETOOTH_MAX_CHAR_SIZE * 2 + 1];
+    static uint8_t stdout_buf[sizeof(stdout_noti_buf) * 2 + 1];
     lwrb_init(&stdout_ring_buf, stdout_buf, PBIO_ARRAY_SIZE(stdout_buf));
 
     pbdrv_bluetooth_init_hci();
@@ -98,6 +110,11 @@ pbio_error_t pbdrv_bluetooth_tx(const uint8_t *data, uint32_t *size) {
         return PBIO_ERROR_INVALID_OP;
     }
 
+    // Start the deadline for sending if this is the oldest unsent data.
+    if (lwrb_get_full(&stdout_ring_buf) == 0 && !pbdrv_bluetooth_noti_size[PBIO_PYBRICKS_EVENT_WRITE_STDOUT]) {
+        pbio_os_timer_set(&stdout_flush_timer, PBDRV_BLUETOOTH_STDOUT_FLUSH_TIMEOUT);
+    }
+
     // Buffer data to send it more efficiently even if the caller is only
     // writing one byte at a time.
     if ((*size = lwrb_write(&stdout_ring_buf, data, *size)) == 0) {
@@ -105,7 +122,7 @@ pbio_error_t pbdrv_bluetooth_tx(const uint8_t *data, uint32_t *size) {
     }
 
     // poke the process to start tx soon-ish. This way, we can accumulate up to
-    // PBDRV_BLUETOOTH_MAX_CHAR_SIZE bytes before actually transmitting
+    // a full notification before actually transmitting
     pbio_os_request_poll();
 
     return PBIO_SUCCESS;
@@ -359,6 +376,32 @@ pbio_error_t pbdrv_bluetooth_await_peripheral_command(pbio_os_state_t *state, vo
 static pbio_os_process_func_t advertising_or_scan_func;
 static pbio_error_t advertising_or_scan_err;
 
+/**
+ * Broadcast data was changed while already broadcasting. This is handled
+ * separately from advertising_or_scan_func so that callers don't have to wait
+ * for it, and newer data replaces data that has not been sent yet.
+ *
+ * Handled by pbdrv_bluetooth_main_thread.
+ */
+static bool broadcast_data_update_pending;
+
+/**
+ * Most recently requested broadcast data. While broadcasting, updates are
+ * stored here and copied to pbdrv_bluetooth_broadcast_data only when the
+ * update is sent, so the data is never changed while it is being sent.
+ */
+static uint8_t broadcast_data_requested[PBDRV_BLUETOOTH_MAX_ADV_SIZE];
+static uint8_t broadcast_data_requested_size;
+
+/**
+ * Copies the most recently requested broadcast data to the buffer that is
+ * used for sending it.
+ */
+static void pbdrv_bluetooth_broadcast_data_commit(void) {
+    pbdrv_bluetooth_broadcast_data_size = broadcast_data_requested_size;
+    memcpy(pbdrv_bluetooth_broadcast_data, broadcast_data_requested, broadcast_data_requested_size);
+}
+
 pbdrv_bluetooth_advertising_state_t pbdrv_bluetooth_advertising_state;
 
 pbio_error_t pbdrv_bluetooth_start_advertising(bool start) {
@@ -381,7 +424,8 @@ pbio_error_t pbdrv_bluetooth_start_advertising(bool start) {
     }
 
     // Invalidate broadcast data cache.
-    pbdrv_bluetooth_broadcast_data_size = 0;
+    broadcast_data_requested_size = 0;
+    broadcast_data_update_pending = false;
 
     // Initialize newly given task.
     advertising_or_scan_err = PBIO_ERROR_AGAIN;
@@ -422,18 +466,33 @@ pbio_error_t pbdrv_bluetooth_start_broadcasting(const uint8_t *data, size_t size
         }
         advertising_or_scan_err = PBIO_ERROR_AGAIN;
         advertising_or_scan_func = pbdrv_bluetooth_stop_advertising_func;
+        broadcast_data_update_pending = false;
         pbio_os_request_poll();
         return PBIO_SUCCESS;
     }
 
     // Avoid I/O operations if the user tries to broadcast the same data
     // over and over in a tight loop.
-    if (is_broadcasting && pbdrv_bluetooth_broadcast_data_size == size && !memcmp(pbdrv_bluetooth_broadcast_data, data, size)) {
+    if (is_broadcasting && broadcast_data_requested_size == size && !memcmp(broadcast_data_requested, data, size)) {
+        advertising_or_scan_err = PBIO_SUCCESS;
+        return PBIO_SUCCESS;
+    }
+    broadcast_data_requested_size = size;
+    memcpy(broadcast_data_requested, data, size);
+
+    // If already broadcasting, only the data has to be updated. This does not
+    // restart advertising, so there is nothing for the caller to wait for.
+    // The previous update may still be sending, so the new data is copied
+    // for sending when the update is handled.
+    if (is_broadcasting) {
         advertising_or_scan_err = PBIO_SUCCESS;
+        broadcast_data_update_pending = true;
+        pbio_os_request_poll();
         return PBIO_SUCCESS;
     }
-    pbdrv_bluetooth_broadcast_data_size = size;
-    memcpy(pbdrv_bluetooth_broadcast_data, data, size);
+
+    // Nothing is being sent when not broadcasting yet.
+    pbdrv_bluetooth_broadcast_data_commit();
 
     // Initialize newly given task.
     advertising_or_scan_err = PBIO_ERROR_AGAIN;
@@ -511,31 +570,45 @@ static bool update_and_get_event_buffer(uint8_t **buf, uint32_t **len) {
         pbio_os_timer_set(&status_timer, PBDRV_BLUETOOTH_STATUS_UPDATE_INTERVAL);
     }
 
-    // Prepare stdout, drain into chunk of maximum send size.
+    // Prepare stdout, drain into chunk of maximum send size for the
+    // currently negotiated MTU.
+    uint32_t *stdout_size = &pbdrv_bluetooth_noti_size[PBIO_PYBRICKS_EVENT_WRITE_STDOUT];
+    uint32_t stdout_max = pbio_int_math_min(pbdrv_bluetooth_get_pybricks_notification_size(), sizeof(stdout_noti_buf));
     if (lwrb_get_full(&stdout_ring_buf) != 0) {
         // Message always starts with event byte.
-        if (!pbdrv_bluetooth_noti_size[PBIO_PYBRICKS_EVENT_WRITE_STDOUT]) {
-            pbdrv_bluetooth_noti_buf[PBIO_PYBRICKS_EVENT_WRITE_STDOUT][0] = PBIO_PYBRICKS_EVENT_WRITE_STDOUT;
-            pbdrv_bluetooth_noti_size[PBIO_PYBRICKS_EVENT_WRITE_STDOUT] = 1;
+        if (!*stdout_size) {
+            stdout_noti_buf[0] = PBIO_PYBRICKS_EVENT_WRITE_STDOUT;
+            *stdout_size = 1;
         }
         // Drain ring buffer to send buffer as much as we can.
-        uint32_t stdout_free = sizeof(pbdrv_bluetooth_noti_buf[PBIO_PYBRICKS_EVENT_WRITE_STDOUT]) - pbdrv_bluetooth_noti_size[PBIO_PYBRICKS_EVENT_WRITE_STDOUT];
-        if (stdout_free) {
-            uint8_t *dest = &pbdrv_bluetooth_noti_buf[PBIO_PYBRICKS_EVENT_WRITE_STDOUT][sizeof(pbdrv_bluetooth_noti_buf[PBIO_PYBRICKS_EVENT_WRITE_STDOUT]) - stdout_free];
-            pbdrv_bluetooth_noti_size[PBIO_PYBRICKS_EVENT_WRITE_STDOUT] += lwrb_read(&stdout_ring_buf, dest, stdout_free);
+        if (*stdout_size < stdout_max) {
+            *stdout_size += lwrb_read(&stdout_ring_buf, &stdout_noti_buf[*stdout_size], stdout_max - *stdout_size);
         }
     }
 
     // Other events are awaited as-is and don't allow setting new data until
     // they have been transmitted, so don't need further processing/draining.
+    // Since each notification starts with a single event type, they can't be
+    // combined with stdout into one packet.
 
-    // Return highest priority pending event, ready for sending.s
+    // Return highest priority pending event, ready for sending.
     for (uint32_t i = 0; i < PBIO_PYBRICKS_EVENT_NUM_EVENTS; i++) {
-        if (pbdrv_bluetooth_noti_size[i]) {
-            *len = &pbdrv_bluetooth_noti_size[i];
-            *buf = pbdrv_bluetooth_noti_buf[i];
+        if (!pbdrv_bluetooth_noti_size[i]) {
+            continue;
+        }
+        if (i == PBIO_PYBRICKS_EVENT_WRITE_STDOUT) {
+            // Hold back partial stdout packets so subsequent writes can be
+            // combined, unless it has been waiting for too long.
+            if (*stdout_size < stdout_max && !pbio_os_timer_is_expired(&stdout_flush_timer)) {
+                continue;
+            }
+            *len = stdout_size;
+            *buf = stdout_noti_buf;
             return true;
         }
+        *len = &pbdrv_bluetooth_noti_size[i];
+        *buf = pbdrv_bluetooth_noti_buf[i];
+        return true;
     }
     return false;
 }
@@ -647,6 +720,16 @@ init:
             *noti_size = 0;
         }
 
+        // Update broadcast data in place. Errors are not reported since the
+        // caller is not waiting for it.
+        if (broadcast_data_update_pending) {
+            broadcast_data_update_pending = false;
+            if (pbdrv_bluetooth_advertising_state == PBDRV_BLUETOOTH_ADVERTISING_STATE_BROADCASTING) {
+                pbdrv_bluetooth_broadcast_data_commit();
+                PBIO_OS_AWAIT(state, &sub, pbdrv_bluetooth_start_broadcasting_func(&sub, NULL));
+            }
+        }
+
         // Handle pending advertising/scan enable/disable task, if any.
         if (advertising_or_scan_func) {
             PBIO_OS_AWAIT(state, &sub, advertising_or_scan_err = advertising_or_scan_func(&sub, NULL));
@@ -1,5 +1,5 @@
 // SPDX-License-Identifier: MIT
-// Copyright (c) 2020 The Pybricks Authors
+// Copyright (c) 2020-2026 The Pybricks Authors
 
 // Internal common bluetooth functions.
 
@@ -37,6 +37,14 @@ pbio_error_t pbdrv_bluetooth_peripheral_write_characteristic_func(pbio_os_state_
 
 pbio_error_t pbdrv_bluetooth_send_pybricks_value_notification(pbio_os_state_t *state, const uint8_t *data, uint16_t size);
 
+/**
+ * Gets the maximum size of a Pybricks value notification that can be sent to
+ * all connected hosts, as limited by the negotiated ATT MTU.
+ *
+ * @return  Maximum notification size in bytes.
+ */
+uint16_t pbdrv_bluetooth_get_pybricks_notification_size(void);
+
 void pbdrv_bluetooth_host_connection_changed(void);
 
 extern pbdrv_bluetooth_receive_handler_t pbdrv_bluetooth_receive_handler;
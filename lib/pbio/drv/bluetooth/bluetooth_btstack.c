@@ -111,8 +111,47 @@ typedef struct {
     uint16_t notification_size;
     /** Notification has been sent. */
     bool notification_done;
+    /** Whether the short connection interval is currently requested. */
+    bool fast_connection;
+    /** Keeps the short connection interval active until it expires. */
+    pbio_os_timer_t activity_timer;
 } pbdrv_bluetooth_btstack_host_connection_t;
 
+/**
+ * Connection interval while data is being exchanged with a host, such as
+ * during a program download or when printing a lot of output. In units of
+ * 1.25 ms. The host may still choose a longer interval.
+ */
+#define HOST_FAST_CONN_INTERVAL_MIN (6)
+#define HOST_FAST_CONN_INTERVAL_MAX (12)
+
+/**
+ * Connection interval while idle, to save power. In units of 1.25 ms.
+ */
+#define HOST_IDLE_CONN_INTERVAL_MIN (24)
+#define HOST_IDLE_CONN_INTERVAL_MAX (48)
+
+/**
+ * Supervision timeout for host connections. In units of 10 ms.
+ */
+#define HOST_CONN_SUPERVISION_TIMEOUT (200)
+
+/**
+ * How long the fast connection interval is kept after the last data was
+ * exchanged with a host.
+ */
+#define HOST_ACTIVITY_TIMEOUT (2000)
+
+/**
+ * Preferred PHY for host connections (bit mask as in LE Set PHY command).
+ */
+#define HOST_PREFERRED_PHYS (0x02) // LE 2M
+
+/**
+ * The LE 2M PHY was introduced with this LMP version (Bluetooth 5.0).
+ */
+#define HOST_PREFERRED_PHYS_MIN_LMP_VERSION (9)
+
 #if PBDRV_CONFIG_BLUETOOTH_BTSTACK_NUM_LE_HOSTS
 static pbdrv_bluetooth_btstack_host_connection_t host_connections[PBDRV_CONFIG_BLUETOOTH_BTSTACK_NUM_LE_HOSTS];
 #endif
@@ -153,7 +192,23 @@ static pbio_error_t att_error_to_pbio_error(uint8_t status) {
     }
 }
 
+/**
+ * Marks a host connection as active, so that the fast connection interval is
+ * requested on the next poll.
+ *
+ * @param [in]  host    The host connection.
+ */
+static void pbdrv_bluetooth_btstack_host_activity(pbdrv_bluetooth_btstack_host_connection_t *host) {
+    pbio_os_timer_set(&host->activity_timer, HOST_ACTIVITY_TIMEOUT);
+    pbio_os_request_poll();
+}
+
 static pbio_pybricks_error_t pybricks_data_received(hci_con_handle_t tx_con_handle, const uint8_t *data, uint16_t size) {
+    pbdrv_bluetooth_btstack_host_connection_t *host = pbdrv_bluetooth_btstack_get_host_connection(tx_con_handle);
+    if (host) {
+        pbdrv_bluetooth_btstack_host_activity(host);
+    }
+
     // Treating all incoming host data the same.
     if (pbdrv_bluetooth_receive_handler) {
         return pbdrv_bluetooth_receive_handler(data, size);
@@ -322,6 +377,11 @@ static void parse_hci_local_version_information(pbdrv_bluetooth_btstack_local_ve
 
 static const pbdrv_bluetooth_btstack_chipset_info_t *chipset_info;
 
+/**
+ * LMP version of the local controller, used to check for LE 2M PHY support.
+ */
+static uint8_t local_lmp_version;
+
 static bool pbdrv_bluetooth_btstack_ble_supported(void) {
     return chipset_info && chipset_info->supports_ble;
 }
@@ -340,6 +400,7 @@ static void packet_handler(uint8_t packet_type, uint16_t channel, uint8_t *packe
                     pbdrv_bluetooth_btstack_local_version_info_t info;
                     parse_hci_local_version_information(&info, rp);
                     chipset_info = pbdrv_bluetooth_btstack_set_chipset(&info);
+                    local_lmp_version = info.lmp_pal_version;
                     break;
                 }
                 default:
@@ -391,6 +452,19 @@ static void packet_handler(uint8_t packet_type, uint16_t channel, uint8_t *packe
                 }
                 host->con_handle = handle;
 
+                // Start with the fast connection interval since the host
+                // usually starts exchanging data right away.
+                host->fast_connection = false;
+                pbdrv_bluetooth_btstack_host_activity(host);
+
+                // The LE 2M PHY requires Bluetooth 5.0. This only states a
+                // preference, the host and controller settle on the PHY.
+                // Data length extension is negotiated by the controller
+                // because BTstack sets the suggested default data length.
+                if (local_lmp_version >= HOST_PREFERRED_PHYS_MIN_LMP_VERSION) {
+                    gap_le_set_phy(handle, 0, HOST_PREFERRED_PHYS, HOST_PREFERRED_PHYS, 0);
+                }
+
                 // don't start advertising again on disconnect
                 gap_advertisements_enable(false);
                 pbdrv_bluetooth_advertising_state = PBDRV_BLUETOOTH_ADVERTISING_STATE_NONE;
@@ -608,6 +682,11 @@ static void pybricks_on_ready_to_send(void *context) {
     pybricks_service_server_send(host->con_handle, host->notification_data, host->notification_size);
     host->notification_done = true;
     pbio_os_request_poll();
+
+    // Periodic status reports alone should not keep the connection fast.
+    if (host->notification_data[0] != PBIO_PYBRICKS_EVENT_STATUS_REPORT) {
+        pbdrv_bluetooth_btstack_host_activity(host);
+    }
 }
 #endif
 
@@ -649,6 +728,22 @@ pbio_error_t pbdrv_bluetooth_send_pybricks_value_notification(pbio_os_state_t *s
     #endif
 }
 
+uint16_t pbdrv_bluetooth_get_pybricks_notification_size(void) {
+    uint16_t size = UINT16_MAX;
+
+    #if PBDRV_CONFIG_BLUETOOTH_BTSTACK_NUM_LE_HOSTS
+    // The same notification goes to all hosts, so use the smallest MTU.
+    for (size_t i = 0; i < PBDRV_CONFIG_BLUETOOTH_BTSTACK_NUM_LE_HOSTS; i++) {
+        pbdrv_bluetooth_btstack_host_connection_t *host = &host_connections[i];
+        if (host->con_handle != HCI_CON_HANDLE_INVALID && host->pybricks_configured) {
+            size = btstack_min(size, att_server_get_mtu(host->con_handle) - 3);
+        }
+    }
+    #endif
+
+    return size == UINT16_MAX ? ATT_DEFAULT_MTU - 3 : size;
+}
+
 pbio_error_t pbdrv_bluetooth_peripheral_scan_and_connect_func(pbio_os_state_t *state, void *context) {
     if (!pbdrv_bluetooth_btstack_ble_supported()) {
         return PBIO_ERROR_NOT_SUPPORTED;
@@ -1362,6 +1457,35 @@ static const btstack_run_loop_t bluetooth_btstack_run_loop = {
     .poll_data_sources_from_irq = pbdrv_bluetooth_btstack_run_loop_trigger,
 };
 
+/**
+ * Requests a short connection interval for hosts that are exchanging data,
+ * and a longer one for idle hosts.
+ */
+static void pbdrv_bluetooth_btstack_update_host_connection_parameters(void) {
+    #if PBDRV_CONFIG_BLUETOOTH_BTSTACK_NUM_LE_HOSTS
+    for (size_t i = 0; i < PBDRV_CONFIG_BLUETOOTH_BTSTACK_NUM_LE_HOSTS; i++) {
+        pbdrv_bluetooth_btstack_host_connection_t *host = &host_connections[i];
+        if (host->con_handle == HCI_CON_HANDLE_INVALID) {
+            continue;
+        }
+
+        bool fast = !pbio_os_timer_is_expired(&host->activity_timer);
+        if (fast == host->fast_connection) {
+            continue;
+        }
+
+        // BTstack queues the request and sends it when it can.
+        if (gap_request_connection_parameter_update(host->con_handle,
+            fast ? HOST_FAST_CONN_INTERVAL_MIN : HOST_IDLE_CONN_INTERVAL_MIN,
+            fast ? HOST_FAST_CONN_INTERVAL_MAX : HOST_IDLE_CONN_INTERVAL_MAX,
+            0, HOST_CONN_SUPERVISION_TIMEOUT) == ERROR_CODE_SUCCESS) {
+            DEBUG_PRINT("Requested %s connection interval for handle %u\n", fast ? "fast" : "idle", host->con_handle);
+            host->fast_connection = fast;
+        }
+    }
+    #endif
+}
+
 static pbio_os_process_t pbdrv_bluetooth_hci_process;
 
 /**
@@ -1377,6 +1501,8 @@ static pbio_error_t pbdrv_bluetooth_hci_process_thread(pbio_os_state_t *state, v
 
     pbdrv_bluetooth_btstack_platform_poll();
 
+    pbdrv_bluetooth_btstack_update_host_connection_parameters();
+
     static pbio_os_timer_t btstack_timer = {
         .duration = 1,
     };
@@ -1,5 +1,5 @@
 // SPDX-License-Identifier: MIT
-// Copyright (c) 2018-2023 The Pybricks Authors
+// Copyright (c) 2018-2026 The Pybricks Authors
 
 // Bluetooth for STM32 MCU with STMicro BlueNRG-MS
 
@@ -325,6 +325,11 @@ retry:
     PBIO_OS_ASYNC_END(PBIO_SUCCESS);
 }
 
+uint16_t pbdrv_bluetooth_get_pybricks_notification_size(void) {
+    // The characteristic value is limited to the default MTU size.
+    return ATT_MTU - 3;
+}
+
 pbio_error_t pbdrv_bluetooth_peripheral_scan_and_connect_func(pbio_os_state_t *state, void *context) {
     pbdrv_bluetooth_peripheral_t *peri = context;
 
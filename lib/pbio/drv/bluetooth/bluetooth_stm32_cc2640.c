@@ -1,5 +1,5 @@
 // SPDX-License-Identifier: MIT
-// Copyright (c) 2018-2023 The Pybricks Authors
+// Copyright (c) 2018-2026 The Pybricks Authors
 
 // Bluetooth for STM32 MCU with TI CC2640
 
@@ -360,6 +360,11 @@ pbio_error_t pbdrv_bluetooth_send_pybricks_value_notification(pbio_os_state_t *s
     PBIO_OS_ASYNC_END(PBIO_SUCCESS);
 }
 
+uint16_t pbdrv_bluetooth_get_pybricks_notification_size(void) {
+    // Until the MTU exchange, the default ATT MTU applies.
+    return (conn_mtu ? conn_mtu : ATT_MTU_SIZE) - 3;
+}
+
 pbio_error_t pbdrv_bluetooth_peripheral_scan_and_connect_func(pbio_os_state_t *state, void *context) {
     pbdrv_bluetooth_peripheral_t *peri = context;
 
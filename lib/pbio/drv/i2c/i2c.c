@@ -0,0 +1,79 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2026 The Pybricks Authors
+
+// Functionality shared by all I2C drivers.
+
+#include <pbdrv/config.h>
+
+#if PBDRV_CONFIG_I2C
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <pbdrv/i2c.h>
+
+#include <pbio/error.h>
+#include <pbio/os.h>
+
+#include "i2c.h"
+
+pbio_error_t pbdrv_i2c_run_commands(
+    pbio_os_state_t *state,
+    pbdrv_i2c_dev_t *i2c_dev,
+    const pbdrv_i2c_command_t *commands,
+    size_t num_commands,
+    uint32_t repeat,
+    uint8_t *result,
+    size_t result_size,
+    bool nxt_quirk) {
+
+    pbdrv_i2c_command_list_state_t *list = pbdrv_i2c_get_command_list_state(i2c_dev);
+    pbio_error_t err;
+
+    PBIO_OS_ASYNC_BEGIN(state);
+
+    // All data read must fit in the result buffer.
+    size_t total_read = 0;
+    for (size_t i = 0; i < num_commands; i++) {
+        total_read += commands[i].read_len;
+    }
+    if (repeat && total_read > result_size / repeat) {
+        return PBIO_ERROR_INVALID_ARG;
+    }
+
+    list->offset = 0;
+
+    for (list->repeat = 0; list->repeat < repeat; list->repeat++) {
+        for (list->index = 0; list->index < num_commands; list->index++) {
+
+            // Each command starts as soon as the previous one completes,
+            // without returning to the caller in between.
+            list->rdata = NULL;
+            PBIO_OS_AWAIT(state, &list->child, err = pbdrv_i2c_write_then_read(
+                &list->child, i2c_dev,
+                commands[list->index].address,
+                commands[list->index].write_data,
+                commands[list->index].write_len,
+                &list->rdata,
+                commands[list->index].read_len,
+                nxt_quirk));
+            if (err != PBIO_SUCCESS) {
+                return err;
+            }
+
+            if (commands[list->index].read_len) {
+                memcpy(&result[list->offset], list->rdata, commands[list->index].read_len);
+                list->offset += commands[list->index].read_len;
+            }
+
+            if (commands[list->index].delay) {
+                PBIO_OS_AWAIT_MS(state, &list->timer, commands[list->index].delay);
+            }
+        }
+    }
+
+    PBIO_OS_ASYNC_END(PBIO_SUCCESS);
+}
+
+#endif // PBDRV_CONFIG_I2C
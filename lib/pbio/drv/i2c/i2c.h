@@ -1,20 +1,52 @@
 // SPDX-License-Identifier: MIT
-// Copyright (c) 2025 The Pybricks Authors
+// Copyright (c) 2025-2026 The Pybricks Authors
 
 // Common interface shared by I2C drivers
 
 #ifndef _INTERNAL_PBDRV_I2C_H_
 #define _INTERNAL_PBDRV_I2C_H_
 
+#include <stddef.h>
+#include <stdint.h>
+
 #include <pbdrv/config.h>
+#include <pbdrv/i2c.h>
+
+#include <pbio/os.h>
 
 #if PBDRV_CONFIG_I2C
 
+/**
+ * State of the command list that is being run on an I2C device.
+ */
+typedef struct {
+    /** State of the ongoing transaction. */
+    pbio_os_state_t child;
+    /** Timer for the delay after each command. */
+    pbio_os_timer_t timer;
+    /** Number of times the list was completed. */
+    uint32_t repeat;
+    /** Index of the ongoing command. */
+    size_t index;
+    /** Number of bytes written to the result buffer so far. */
+    size_t offset;
+    /** Data read by the ongoing command. */
+    uint8_t *rdata;
+} pbdrv_i2c_command_list_state_t;
+
 /**
  * Initializes the I2C driver.
  */
 void pbdrv_i2c_init(void);
 
+/**
+ * Gets the command list state of an I2C device. Implemented by each driver.
+ *
+ * @param [in]  i2c_dev     The I2C device.
+ * @return                  The command list state.
+ */
+pbdrv_i2c_command_list_state_t *pbdrv_i2c_get_command_list_state(pbdrv_i2c_dev_t *i2c_dev);
+
 #else // PBDRV_CONFIG_I2C
 
 static inline void pbdrv_i2c_init() {
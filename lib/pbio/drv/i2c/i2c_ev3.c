@@ -1,5 +1,5 @@
 // SPDX-License-Identifier: MIT
-// Copyright (c) 2025 The Pybricks Authors
+// Copyright (c) 2025-2026 The Pybricks Authors
 
 // I2C driver for EV3
 
@@ -26,6 +26,7 @@
 
 #include "../drv/rproc/rproc.h"
 #include "../rproc/rproc_ev3.h"
+#include "i2c.h"
 
 #define DEBUG 0
 #if DEBUG
@@ -55,6 +56,7 @@ struct _pbdrv_i2c_dev_t {
     uint8_t pru_i2c_idx;
     pbio_os_timer_t timer;
     size_t try_count;
+    pbdrv_i2c_command_list_state_t command_list;
 };
 
 static pbdrv_i2c_dev_t i2c_devs[PBDRV_RPROC_EV3_PRU1_NUM_I2C_BUSES];
@@ -79,6 +81,10 @@ pbio_error_t pbdrv_i2c_get_instance(uint8_t id, pbdrv_i2c_dev_t **i2c_dev) {
     return PBIO_SUCCESS;
 }
 
+pbdrv_i2c_command_list_state_t *pbdrv_i2c_get_command_list_state(pbdrv_i2c_dev_t *i2c_dev) {
+    return &i2c_dev->command_list;
+}
+
 static void pbdrv_i2c_irq_0(void) {
     IntSystemStatusClear(SYS_INT_EVTOUT4);
     HWREG(INTC_PHYS_BASE + PRU_INTC_SICR_REG) = PRU_I2C_PORT1_EVT;
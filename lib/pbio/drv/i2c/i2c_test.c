@@ -0,0 +1,138 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2026 The Pybricks Authors
+
+// I2C driver for tests. Each bus has one simulated device with 256 registers.
+// Transactions take some time to complete, during which the bus is busy even
+// if the caller stops awaiting it, like real hardware.
+
+#include <pbdrv/config.h>
+
+#if PBDRV_CONFIG_I2C_TEST
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <pbdrv/i2c.h>
+
+#include <pbio/error.h>
+#include <pbio/os.h>
+
+#include "i2c.h"
+#include "i2c_test.h"
+
+#define PBDRV_I2C_TEST_NUM_BUSES (1)
+
+struct _pbdrv_i2c_dev_t {
+    uint8_t buffer[0x200];
+    uint8_t registers[0x100];
+    uint8_t register_index;
+    bool is_initialized;
+    bool in_transaction;
+    pbio_error_t result;
+    uint32_t transaction_count;
+    pbio_os_timer_t timer;
+    pbdrv_i2c_command_list_state_t command_list;
+};
+
+static pbdrv_i2c_dev_t i2c_devs[PBDRV_I2C_TEST_NUM_BUSES];
+
+pbio_error_t pbdrv_i2c_get_instance(uint8_t id, pbdrv_i2c_dev_t **i2c_dev) {
+    if (id >= PBDRV_I2C_TEST_NUM_BUSES) {
+        return PBIO_ERROR_INVALID_ARG;
+    }
+    pbdrv_i2c_dev_t *dev = &i2c_devs[id];
+    if (!dev->is_initialized) {
+        return PBIO_ERROR_AGAIN;
+    }
+    *i2c_dev = dev;
+    return PBIO_SUCCESS;
+}
+
+pbdrv_i2c_command_list_state_t *pbdrv_i2c_get_command_list_state(pbdrv_i2c_dev_t *i2c_dev) {
+    return &i2c_dev->command_list;
+}
+
+uint8_t *pbdrv_i2c_test_get_registers(pbdrv_i2c_dev_t *i2c_dev) {
+    return i2c_dev->registers;
+}
+
+uint32_t pbdrv_i2c_test_get_transaction_count(pbdrv_i2c_dev_t *i2c_dev) {
+    return i2c_dev->transaction_count;
+}
+
+// The bus becomes free when the transaction time has passed, whether or not
+// anyone is still waiting for the result.
+static bool pbdrv_i2c_test_is_busy(pbdrv_i2c_dev_t *i2c_dev) {
+    if (i2c_dev->in_transaction && pbio_os_timer_is_expired(&i2c_dev->timer)) {
+        i2c_dev->in_transaction = false;
+    }
+    return i2c_dev->in_transaction;
+}
+
+pbio_error_t pbdrv_i2c_write_then_read(
+    pbio_os_state_t *state,
+    pbdrv_i2c_dev_t *i2c_dev,
+    uint8_t dev_addr,
+    const uint8_t *wdata,
+    size_t wlen,
+    uint8_t **rdata,
+    size_t rlen,
+    bool nxt_quirk) {
+
+    PBIO_OS_ASYNC_BEGIN(state);
+
+    if (wlen && !wdata) {
+        return PBIO_ERROR_INVALID_ARG;
+    }
+    if (*rdata) {
+        return PBIO_ERROR_INVALID_ARG;
+    }
+    if (wlen > 0xff || rlen > 0xff) {
+        return PBIO_ERROR_INVALID_ARG;
+    }
+
+    if (pbdrv_i2c_test_is_busy(i2c_dev)) {
+        return PBIO_ERROR_BUSY;
+    }
+
+    // Run the transaction on the simulated device right away. The result is
+    // made available once the transaction time has passed.
+    i2c_dev->transaction_count++;
+    i2c_dev->in_transaction = true;
+    pbio_os_timer_set(&i2c_dev->timer, PBDRV_I2C_TEST_TRANSACTION_TIME);
+
+    if (dev_addr != PBDRV_I2C_TEST_ADDRESS) {
+        i2c_dev->result = PBIO_ERROR_IO;
+    } else {
+        // First byte written selects the register, and the rest is written
+        // to consecutive registers. Reading continues from there.
+        for (size_t i = 0; i < wlen; i++) {
+            if (i == 0) {
+                i2c_dev->register_index = wdata[0];
+            } else {
+                i2c_dev->registers[i2c_dev->register_index++] = wdata[i];
+            }
+        }
+        for (size_t i = 0; i < rlen; i++) {
+            i2c_dev->buffer[wlen + i] = i2c_dev->registers[i2c_dev->register_index++];
+        }
+        i2c_dev->result = PBIO_SUCCESS;
+    }
+
+    PBIO_OS_AWAIT_WHILE(state, pbdrv_i2c_test_is_busy(i2c_dev));
+
+    if (i2c_dev->result == PBIO_SUCCESS && rlen) {
+        *rdata = &i2c_dev->buffer[wlen];
+    }
+
+    PBIO_OS_ASYNC_END(i2c_dev->result);
+}
+
+void pbdrv_i2c_init(void) {
+    for (int i = 0; i < PBDRV_I2C_TEST_NUM_BUSES; i++) {
+        i2c_devs[i].is_initialized = true;
+    }
+}
+
+#endif // PBDRV_CONFIG_I2C_TEST
@@ -0,0 +1,28 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2026 The Pybricks Authors
+
+#ifndef _INTERNAL_PBDRV_I2C_TEST_H_
+#define _INTERNAL_PBDRV_I2C_TEST_H_
+
+#include <pbdrv/config.h>
+
+#if PBDRV_CONFIG_I2C_TEST
+
+#include <stdint.h>
+
+#include <pbdrv/i2c.h>
+
+// Address of the simulated device on each bus. Other addresses don't respond.
+#define PBDRV_I2C_TEST_ADDRESS (0x10)
+
+// Time (ms) that each transaction takes on the bus.
+#define PBDRV_I2C_TEST_TRANSACTION_TIME (2)
+
+// extra functions just for tests: get the 256 registers of the simulated
+// device and the number of transactions started on the bus.
+uint8_t *pbdrv_i2c_test_get_registers(pbdrv_i2c_dev_t *i2c_dev);
+uint32_t pbdrv_i2c_test_get_transaction_count(pbdrv_i2c_dev_t *i2c_dev);
+
+#endif // PBDRV_CONFIG_I2C_TEST
+
+#endif // _INTERNAL_PBDRV_I2C_TEST_H_
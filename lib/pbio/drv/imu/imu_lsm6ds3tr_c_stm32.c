@@ -29,6 +29,19 @@
 
 #include "./imu_lsm6ds3tr_c_stm32.h"
 
+// If PBDRV_CONFIG_IMU_LSM6S3TR_C_STM32_FIFO_FRAMES is nonzero, samples are
+// collected in the IMU FIFO and read in bursts of about this many frames,
+// instead of reading every sample when it is ready.
+#if PBDRV_CONFIG_IMU_LSM6S3TR_C_STM32_FIFO_FRAMES
+/**
+ * Maximum number of frames read from the FIFO in one go. This is larger than
+ * the watermark so that we can catch up if reading was delayed.
+ */
+#define NUM_FRAMES_MAX (PBDRV_CONFIG_IMU_LSM6S3TR_C_STM32_FIFO_FRAMES * 2)
+#else
+#define NUM_FRAMES_MAX (1)
+#endif
+
 struct _pbdrv_imu_dev_t {
     /** Driver context for external library. */
     stmdev_ctx_t ctx;
@@ -36,12 +49,12 @@ struct _pbdrv_imu_dev_t {
     I2C_HandleTypeDef hi2c;
     /** IMU configuration to convert raw data to phsyical units. */
     pbdrv_imu_config_t config;
-    /** Callback to process one frame of unfiltered gyro and accelerometer data. */
+    /** Callback to process frames of unfiltered gyro and accelerometer data. */
     pbdrv_imu_handle_frame_data_func_t handle_frame_data;
     /* Callback to process unfiltered gyro and accelerometer data recorded while stationary. */
     pbdrv_imu_handle_stationary_data_func_t handle_stationary_data;
-    /** Latest raw data. */
-    int16_t data[6];
+    /** Latest raw data, one or more frames of gyro (xyz) and accel (xyz). */
+    int16_t data[NUM_FRAMES_MAX][6];
     /** Most recent slow moving average of raw data. */
     int16_t data_slow[6];
     /** Sum of raw data for slow moving average. */
@@ -64,14 +77,15 @@ struct _pbdrv_imu_dev_t {
     volatile bool int1;
 };
 
-/** The size of the data field in pbdrv_imu_dev_t in bytes. */
-#define NUM_DATA_BYTES sizeof(((struct _pbdrv_imu_dev_t *)0)->data)
+/** The size of one frame in the data field in pbdrv_imu_dev_t in bytes. */
+#define NUM_DATA_BYTES sizeof(((struct _pbdrv_imu_dev_t *)0)->data[0])
 
 /** All data rate dependent values should be defined here so it is clear
  *  what needs to be changed when the data rate is changed. */
 #define LSM6DS3TR_INITIAL_DATA_RATE (833)
 #define LSM6DS3TR_GYRO_DATA_RATE (LSM6DS3TR_C_GY_ODR_833Hz)
 #define LSM6DS3TR_ACCL_DATA_RATE (LSM6DS3TR_C_XL_ODR_833Hz)
+#define LSM6DS3TR_FIFO_DATA_RATE (LSM6DS3TR_C_FIFO_833Hz)
 
 static pbdrv_imu_dev_t global_imu_dev;
 
@@ -236,10 +250,25 @@ static pbio_error_t pbdrv_imu_lsm6ds3tr_c_stm32_init(pbio_os_state_t *state) {
     imu_dev->config.gyro_stationary_threshold = 0;
     imu_dev->config.accel_stationary_threshold = 0;
 
+    #if PBDRV_CONFIG_IMU_LSM6S3TR_C_STM32_FIFO_FRAMES
+    // Store gyro and accel data in the FIFO at the full data rate. Once the
+    // watermark is reached, the samples are read out in one burst.
+    PBIO_OS_AWAIT(state, &sub, lsm6ds3tr_c_fifo_gy_batch_set(&sub, ctx, LSM6DS3TR_C_FIFO_GY_NO_DEC));
+    PBIO_OS_AWAIT(state, &sub, lsm6ds3tr_c_fifo_xl_batch_set(&sub, ctx, LSM6DS3TR_C_FIFO_XL_NO_DEC));
+    PBIO_OS_AWAIT(state, &sub, lsm6ds3tr_c_fifo_data_rate_set(&sub, ctx, LSM6DS3TR_FIFO_DATA_RATE));
+    PBIO_OS_AWAIT(state, &sub, lsm6ds3tr_c_fifo_watermark_set(&sub, ctx, PBDRV_CONFIG_IMU_LSM6S3TR_C_STM32_FIFO_FRAMES * 6));
+    PBIO_OS_AWAIT(state, &sub, lsm6ds3tr_c_fifo_mode_set(&sub, ctx, LSM6DS3TR_C_STREAM_MODE));
+
+    // Configure INT1 to trigger when the FIFO watermark is reached.
+    PBIO_OS_AWAIT(state, &sub, lsm6ds3tr_c_pin_int1_route_set(&sub, ctx, (lsm6ds3tr_c_int1_route_t) {
+        .int1_fth = 1,
+    }));
+    #else
     // Configure INT1 to trigger when new gyro data is ready.
     PBIO_OS_AWAIT(state, &sub, lsm6ds3tr_c_pin_int1_route_set(&sub, ctx, (lsm6ds3tr_c_int1_route_t) {
         .int1_drdy_g = 1,
     }));
+    #endif
 
     // If we leave the default latched mode, sometimes we don't get the INT1 interrupt.
     PBIO_OS_AWAIT(state, &sub, lsm6ds3tr_c_data_ready_mode_set(&sub, ctx, LSM6DS3TR_C_DRDY_PULSED));
@@ -258,16 +287,16 @@ static inline bool is_bounded(int16_t diff, int16_t threshold) {
     return diff < threshold && diff > -threshold;
 }
 
-static void pbdrv_imu_lsm6ds3tr_c_stm32_reset_stationary_buffer(pbdrv_imu_dev_t *imu_dev) {
+static void pbdrv_imu_lsm6ds3tr_c_stm32_reset_stationary_buffer(pbdrv_imu_dev_t *imu_dev, uint32_t time_us) {
     imu_dev->stationary_sample_count = 0;
-    imu_dev->stationary_time_start = pbdrv_clock_get_us();
+    imu_dev->stationary_time_start = time_us;
     memset(&imu_dev->stationary_accel_data_sum, 0, sizeof(imu_dev->stationary_accel_data_sum));
     memset(&imu_dev->stationary_gyro_data_sum, 0, sizeof(imu_dev->stationary_gyro_data_sum));
 }
 
-static void pbdrv_imu_lsm6ds3tr_c_stm32_update_slow_moving_average(pbdrv_imu_dev_t *imu_dev) {
+static void pbdrv_imu_lsm6ds3tr_c_stm32_update_slow_moving_average(pbdrv_imu_dev_t *imu_dev, const int16_t *frame) {
     for (uint32_t i = 0; i < 6; i++) {
-        imu_dev->data_slow_sum[i] += imu_dev->data[i];
+        imu_dev->data_slow_sum[i] += frame[i];
     }
     imu_dev->data_slow_count++;
     if (imu_dev->data_slow_count == 125) {
@@ -279,18 +308,25 @@ static void pbdrv_imu_lsm6ds3tr_c_stm32_update_slow_moving_average(pbdrv_imu_dev
     }
 }
 
-static void pbdrv_imu_lsm6ds3tr_c_stm32_update_stationary_status(pbdrv_imu_dev_t *imu_dev) {
+/**
+ * Updates the stationary detection with one frame of data.
+ *
+ * @param [in]  imu_dev     The IMU device.
+ * @param [in]  frame       Gyro (xyz) and accel (xyz) samples of this frame.
+ * @param [in]  time_us     Time at which this frame was sampled (us).
+ */
+static void pbdrv_imu_lsm6ds3tr_c_stm32_update_stationary_status(pbdrv_imu_dev_t *imu_dev, const int16_t *frame, uint32_t time_us) {
 
     // Update slow moving average of raw data, used as starting point for stationary detection.
-    pbdrv_imu_lsm6ds3tr_c_stm32_update_slow_moving_average(imu_dev);
+    pbdrv_imu_lsm6ds3tr_c_stm32_update_slow_moving_average(imu_dev, frame);
 
     // Check whether still stationary compared to constant start sample.
-    if (!is_bounded(imu_dev->data[0] - imu_dev->stationary_data_start[0], imu_dev->config.gyro_stationary_threshold) ||
-        !is_bounded(imu_dev->data[1] - imu_dev->stationary_data_start[1], imu_dev->config.gyro_stationary_threshold) ||
-        !is_bounded(imu_dev->data[2] - imu_dev->stationary_data_start[2], imu_dev->config.gyro_stationary_threshold) ||
-        !is_bounded(imu_dev->data[3] - imu_dev->stationary_data_start[3], imu_dev->config.accel_stationary_threshold) ||
-        !is_bounded(imu_dev->data[4] - imu_dev->stationary_data_start[4], imu_dev->config.accel_stationary_threshold) ||
-        !is_bounded(imu_dev->data[5] - imu_dev->stationary_data_start[5], imu_dev->config.accel_stationary_threshold)
+    if (!is_bounded(frame[0] - imu_dev->stationary_data_start[0], imu_dev->config.gyro_stationary_threshold) ||
+        !is_bounded(frame[1] - imu_dev->stationary_data_start[1], imu_dev->config.gyro_stationary_threshold) ||
+        !is_bounded(frame[2] - imu_dev->stationary_data_start[2], imu_dev->config.gyro_stationary_threshold) ||
+        !is_bounded(frame[3] - imu_dev->stationary_data_start[3], imu_dev->config.accel_stationary_threshold) ||
+        !is_bounded(frame[4] - imu_dev->stationary_data_start[4], imu_dev->config.accel_stationary_threshold) ||
+        !is_bounded(frame[5] - imu_dev->stationary_data_start[5], imu_dev->config.accel_stationary_threshold)
         ) {
         // Not stationary anymore, so reset counter and gyro sum data so we can start over.
         imu_dev->stationary_now = false;
@@ -298,18 +334,18 @@ static void pbdrv_imu_lsm6ds3tr_c_stm32_update_stationary_status(pbdrv_imu_dev_t
         // Slow moving average becomes new starting value to compare to.
         memcpy(&imu_dev->stationary_data_start[0], &imu_dev->data_slow[0], sizeof(imu_dev->stationary_data_start));
 
-        pbdrv_imu_lsm6ds3tr_c_stm32_reset_stationary_buffer(imu_dev);
+        pbdrv_imu_lsm6ds3tr_c_stm32_reset_stationary_buffer(imu_dev, time_us);
         return;
     }
 
     // Updating running sum of stationary data.
     imu_dev->stationary_sample_count++;
-    imu_dev->stationary_gyro_data_sum[0] += imu_dev->data[0];
-    imu_dev->stationary_gyro_data_sum[1] += imu_dev->data[1];
-    imu_dev->stationary_gyro_data_sum[2] += imu_dev->data[2];
-    imu_dev->stationary_accel_data_sum[0] += imu_dev->data[3];
-    imu_dev->stationary_accel_data_sum[1] += imu_dev->data[4];
-    imu_dev->stationary_accel_data_sum[2] += imu_dev->data[5];
+    imu_dev->stationary_gyro_data_sum[0] += frame[0];
+    imu_dev->stationary_gyro_data_sum[1] += frame[1];
+    imu_dev->stationary_gyro_data_sum[2] += frame[2];
+    imu_dev->stationary_accel_data_sum[0] += frame[3];
+    imu_dev->stationary_accel_data_sum[1] += frame[4];
+    imu_dev->stationary_accel_data_sum[2] += frame[5];
 
     // Exit if we don't have enough samples yet.
     if (imu_dev->stationary_sample_count < LSM6DS3TR_INITIAL_DATA_RATE) {
@@ -320,7 +356,7 @@ static void pbdrv_imu_lsm6ds3tr_c_stm32_update_stationary_status(pbdrv_imu_dev_t
     imu_dev->stationary_now = true;
 
     // The actual sampling rate is slightly different from the configured rate, so measure it.
-    imu_dev->config.sample_time = (pbdrv_clock_get_us() - imu_dev->stationary_time_start) / 1000000.0f / imu_dev->stationary_sample_count;
+    imu_dev->config.sample_time = (time_us - imu_dev->stationary_time_start) / 1000000.0f / imu_dev->stationary_sample_count;
 
     // Process the data recorded while stationary.
     if (imu_dev->handle_stationary_data) {
@@ -328,7 +364,39 @@ static void pbdrv_imu_lsm6ds3tr_c_stm32_update_stationary_status(pbdrv_imu_dev_t
     }
 
     // Reset counter and gyro sum data so we can start over.
-    pbdrv_imu_lsm6ds3tr_c_stm32_reset_stationary_buffer(imu_dev);
+    pbdrv_imu_lsm6ds3tr_c_stm32_reset_stationary_buffer(imu_dev, time_us);
+}
+
+/**
+ * Processes frames of raw data that were just read from the IMU.
+ *
+ * @param [in]  imu_dev     The IMU device.
+ * @param [in]  num_frames  Number of frames in imu_dev->data.
+ * @param [in]  time_us     Time at which the last frame was sampled (us).
+ */
+static void pbdrv_imu_lsm6ds3tr_c_stm32_process_frames(pbdrv_imu_dev_t *imu_dev, uint32_t num_frames, uint32_t time_us) {
+
+    uint32_t sample_time_us = imu_dev->config.sample_time * 1000000.0f;
+
+    for (uint32_t f = 0; f < num_frames; f++) {
+        int16_t *frame = imu_dev->data[f];
+
+        // Account for mounting orientation in hub. Any other tranformations
+        // are applied at the higher level in pbio.
+        frame[0] *= PBDRV_CONFIG_IMU_LSM6S3TR_C_STM32_SIGN_X;
+        frame[1] *= PBDRV_CONFIG_IMU_LSM6S3TR_C_STM32_SIGN_Y;
+        frame[2] *= PBDRV_CONFIG_IMU_LSM6S3TR_C_STM32_SIGN_Z;
+        frame[3] *= PBDRV_CONFIG_IMU_LSM6S3TR_C_STM32_SIGN_X;
+        frame[4] *= PBDRV_CONFIG_IMU_LSM6S3TR_C_STM32_SIGN_Y;
+        frame[5] *= PBDRV_CONFIG_IMU_LSM6S3TR_C_STM32_SIGN_Z;
+
+        // Frames were sampled one sample time apart, ending with the last one.
+        pbdrv_imu_lsm6ds3tr_c_stm32_update_stationary_status(imu_dev, frame, time_us - (num_frames - 1 - f) * sample_time_us);
+    }
+
+    if (imu_dev->handle_frame_data) {
+        imu_dev->handle_frame_data(&imu_dev->data[0][0], num_frames);
+    }
 }
 
 static pbio_os_process_t pbdrv_imu_lsm6ds3tr_c_stm32_process;
@@ -338,9 +406,18 @@ static pbio_error_t pbdrv_imu_lsm6ds3tr_c_stm32_process_thread(pbio_os_state_t *
     I2C_HandleTypeDef *hi2c = &imu_dev->hi2c;
 
     static pbio_os_state_t sub;
-    static uint8_t buf[NUM_DATA_BYTES];
     pbio_error_t err;
 
+    #if PBDRV_CONFIG_IMU_LSM6S3TR_C_STM32_FIFO_FRAMES
+    static uint8_t status[4];
+    static uint8_t discard[NUM_DATA_BYTES];
+    static uint32_t num_words;
+    static uint32_t num_frames;
+    static uint32_t num_skip;
+    #else
+    static uint8_t buf[NUM_DATA_BYTES];
+    #endif
+
     PBIO_OS_ASYNC_BEGIN(state);
 
     PBIO_OS_AWAIT(state, &sub, err = pbdrv_imu_lsm6ds3tr_c_stm32_init(&sub));
@@ -352,6 +429,63 @@ static pbio_error_t pbdrv_imu_lsm6ds3tr_c_stm32_process_thread(pbio_os_state_t *
         return err;
     }
 
+    #if PBDRV_CONFIG_IMU_LSM6S3TR_C_STM32_FIFO_FRAMES
+
+    while (!(pbdrv_imu_lsm6ds3tr_c_stm32_process.request & PBIO_OS_PROCESS_REQUEST_TYPE_CANCEL)) {
+
+        PBIO_OS_AWAIT_UNTIL(state, atomic_exchange(&imu_dev->int1, false));
+
+        // Read the number of unread words and the type of the next word.
+        lsm6ds3tr_c_read_reg(&imu_dev->ctx, LSM6DS3TR_C_FIFO_STATUS1, status, sizeof(status));
+        PBIO_OS_AWAIT_UNTIL(state, imu_dev->ctx.read_write_done);
+
+        if (HAL_I2C_GetError(hi2c) != HAL_I2C_ERROR_NONE) {
+            pbdrv_imu_lsm6ds3tr_c_stm32_i2c_reset(hi2c);
+            imu_dev->int1 = true;
+            continue;
+        }
+
+        num_words = status[0] | (status[1] & 0x07) << 8;
+
+        // If the FIFO overran, the next word need not be the start of a
+        // frame, so skip ahead to the next gyro x sample.
+        num_skip = (6 - (status[2] | (status[3] & 0x03) << 8)) % 6;
+        if (num_skip > 0 && num_skip <= num_words) {
+            lsm6ds3tr_c_read_reg(&imu_dev->ctx, LSM6DS3TR_C_FIFO_DATA_OUT_L, discard, num_skip * sizeof(int16_t));
+            PBIO_OS_AWAIT_UNTIL(state, imu_dev->ctx.read_write_done);
+            num_words -= num_skip;
+        }
+
+        // Read whole frames, up to what fits in the buffer. The register
+        // address rolls back automatically, so this is one burst read.
+        num_frames = num_words / 6;
+        if (num_frames > NUM_FRAMES_MAX) {
+            num_frames = NUM_FRAMES_MAX;
+        }
+        if (num_frames == 0) {
+            continue;
+        }
+
+        lsm6ds3tr_c_read_reg(&imu_dev->ctx, LSM6DS3TR_C_FIFO_DATA_OUT_L, (uint8_t *)&imu_dev->data[0][0], num_frames * NUM_DATA_BYTES);
+        PBIO_OS_AWAIT_UNTIL(state, imu_dev->ctx.read_write_done);
+
+        if (HAL_I2C_GetError(hi2c) != HAL_I2C_ERROR_NONE) {
+            pbdrv_imu_lsm6ds3tr_c_stm32_i2c_reset(hi2c);
+            imu_dev->int1 = true;
+            continue;
+        }
+
+        pbdrv_imu_lsm6ds3tr_c_stm32_process_frames(imu_dev, num_frames, pbdrv_clock_get_us());
+
+        // The watermark interrupt is level triggered but the MCU interrupt is
+        // edge triggered, so we won't get a new one if we haven't caught up.
+        if (num_words - num_frames * 6 >= PBDRV_CONFIG_IMU_LSM6S3TR_C_STM32_FIFO_FRAMES * 6) {
+            imu_dev->int1 = true;
+        }
+    }
+
+    #else // PBDRV_CONFIG_IMU_LSM6S3TR_C_STM32_FIFO_FRAMES
+
 retry:
     // Write the register address of the start of the gyro and accel data.
     buf[0] = LSM6DS3TR_C_OUTX_L_G;
@@ -397,23 +531,13 @@ retry:
             goto retry;
         }
 
-        memcpy(&imu_dev->data[0], buf, NUM_DATA_BYTES);
+        memcpy(&imu_dev->data[0][0], buf, NUM_DATA_BYTES);
 
-        // Account for mounting orientation in hub. Any other tranformations
-        // are applied at the higher level in pbio.
-        imu_dev->data[0] *= PBDRV_CONFIG_IMU_LSM6S3TR_C_STM32_SIGN_X;
-        imu_dev->data[1] *= PBDRV_CONFIG_IMU_LSM6S3TR_C_STM32_SIGN_Y;
-        imu_dev->data[2] *= PBDRV_CONFIG_IMU_LSM6S3TR_C_STM32_SIGN_Z;
-        imu_dev->data[3] *= PBDRV_CONFIG_IMU_LSM6S3TR_C_STM32_SIGN_X;
-        imu_dev->data[4] *= PBDRV_CONFIG_IMU_LSM6S3TR_C_STM32_SIGN_Y;
-        imu_dev->data[5] *= PBDRV_CONFIG_IMU_LSM6S3TR_C_STM32_SIGN_Z;
-
-        pbdrv_imu_lsm6ds3tr_c_stm32_update_stationary_status(imu_dev);
-        if (imu_dev->handle_frame_data) {
-            imu_dev->handle_frame_data(imu_dev->data);
-        }
+        pbdrv_imu_lsm6ds3tr_c_stm32_process_frames(imu_dev, 1, pbdrv_clock_get_us());
     }
 
+    #endif // PBDRV_CONFIG_IMU_LSM6S3TR_C_STM32_FIFO_FRAMES
+
     // Cancellation complete.
     pbdrv_imu_lsm6ds3tr_c_stm32_i2c_reset(hi2c);
     pbio_busy_count_down();
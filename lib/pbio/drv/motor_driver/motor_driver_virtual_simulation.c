@@ -1,22 +1,30 @@
 // SPDX-License-Identifier: MIT
-// Copyright (c) 2022-2025 The Pybricks Authors
+// Copyright (c) 2022-2026 The Pybricks Authors
 
 #include <pbdrv/config.h>
 
 #if PBDRV_CONFIG_MOTOR_DRIVER_VIRTUAL_SIMULATION
 
+#include <math.h>
+#include <string.h>
+
 #include <pbdrv/clock.h>
 #include <pbdrv/counter.h>
+#include <pbdrv/imu.h>
 #include <pbdrv/motor_driver.h>
 
 #include <pbio/battery.h>
 #include <pbio/busy_count.h>
+#include <pbio/int_math.h>
 #include <pbio/observer.h>
 #include <pbio/port_interface.h>
 #include <pbio/util.h>
 
 #include "motor_driver_virtual_simulation.h"
 
+// Discretization time step of the simulation models (s).
+#define PBDRV_MOTOR_DRIVER_VIRTUAL_SIMULATION_TIME_STEP (0.001)
+
 typedef struct _pbio_simulation_model_t {
     double d_angle_d_speed;
     double d_speed_d_speed;
@@ -43,6 +51,7 @@ struct _pbdrv_motor_driver_dev_t {
     double current;
     double speed;
     double voltage;
+    // External load torque applied by the chassis, if any.
     double torque;
     const pbio_simulation_model_t *model;
     const pbdrv_motor_driver_virtual_simulation_platform_data_t *pdata;
@@ -65,8 +74,226 @@ static const pbio_simulation_model_t model_technic_m_angular = {
     .torque_friction = 21413.268,
 };
 
+// The models below have not been identified separately. They are derived from
+// the Technic M angular model above by scaling the voltage and torque columns
+// such that the steady state speed per volt and speed per unit of load torque
+// match the ratios of the respective observer models in servo_settings.c. The
+// friction is taken from the observer models directly.
+
+static const pbio_simulation_model_t model_technic_s_angular = {
+    .d_angle_d_speed = 0.0009981527613056019,
+    .d_speed_d_speed = 0.994653578576391,
+    .d_current_d_speed = -0.0021977502690683696,
+    .d_angle_d_current = 0.001957577848006867,
+    .d_speed_d_current = 3.640640918794361,
+    .d_current_d_current = 0.6348769647439378,
+    .d_angle_d_voltage = 0.00027579762112445654,
+    .d_speed_d_voltage = 0.7982348543432757,
+    .d_current_d_voltage = 0.3281299259661564,
+    .d_angle_d_torque = -0.00019818826099940025,
+    .d_speed_d_torque = -0.3960180375921504,
+    .d_current_d_torque = 0.0004688538564930334,
+    .torque_friction = 9182,
+};
+
+static const pbio_simulation_model_t model_technic_l_angular = {
+    .d_angle_d_speed = 0.0009981527613056019,
+    .d_speed_d_speed = 0.994653578576391,
+    .d_current_d_speed = -0.0021977502690683696,
+    .d_angle_d_current = 0.001957577848006867,
+    .d_speed_d_current = 3.640640918794361,
+    .d_current_d_current = 0.6348769647439378,
+    .d_angle_d_voltage = 0.00025839655707216085,
+    .d_speed_d_voltage = 0.7478713458671304,
+    .d_current_d_voltage = 0.30742702854473336,
+    .d_angle_d_torque = -3.099923431891178e-05,
+    .d_speed_d_torque = -0.061942396991272027,
+    .d_current_d_torque = 7.333487102345059e-05,
+    .torque_friction = 23239,
+};
+
+static const pbio_simulation_model_t model_ev3_l = {
+    .d_angle_d_speed = 0.0009981527613056019,
+    .d_speed_d_speed = 0.994653578576391,
+    .d_current_d_speed = -0.0021977502690683696,
+    .d_angle_d_current = 0.001957577848006867,
+    .d_speed_d_current = 3.640640918794361,
+    .d_current_d_current = 0.6348769647439378,
+    .d_angle_d_voltage = 0.0002241487852122294,
+    .d_speed_d_voltage = 0.6487487897307319,
+    .d_current_d_voltage = 0.26668077845349714,
+    .d_angle_d_torque = -3.358392541809605e-05,
+    .d_speed_d_torque = -0.06710710398107678,
+    .d_current_d_torque = 7.944947328891689e-05,
+    .torque_friction = 16476,
+};
+
+static const pbio_simulation_model_t model_ev3_m = {
+    .d_angle_d_speed = 0.0009981527613056019,
+    .d_speed_d_speed = 0.994653578576391,
+    .d_current_d_speed = -0.0021977502690683696,
+    .d_angle_d_current = 0.001957577848006867,
+    .d_speed_d_current = 3.640640918794361,
+    .d_current_d_current = 0.6348769647439378,
+    .d_angle_d_voltage = 0.00036335464444130797,
+    .d_speed_d_voltage = 1.0516491784737896,
+    .d_current_d_voltage = 0.43230080119575365,
+    .d_angle_d_torque = -0.00011848004085744268,
+    .d_speed_d_torque = -0.23674577413212297,
+    .d_current_d_torque = 0.00028028816537036097,
+    .torque_friction = 24593,
+};
+
 static pbdrv_motor_driver_dev_t motor_driver_devs[PBDRV_CONFIG_MOTOR_DRIVER_NUM_DEV];
 
+#if PBDRV_CONFIG_MOTOR_DRIVER_VIRTUAL_SIMULATION_CHASSIS
+
+/**
+ * State of the simulated differential drive chassis.
+ *
+ * The forward and turn coordinates are expressed as equivalent wheel angles,
+ * just like the distance and heading controllers of the drive base. This way
+ * the wheel coupling can be computed without unit conversions.
+ */
+typedef struct {
+    /** Whether the chassis is currently coupled to the wheel motors. */
+    bool enabled;
+    /** Average forward rotation of both wheels (mdeg). */
+    double forward;
+    /** Forward rate of change (mdeg/s). */
+    double forward_speed;
+    /** Half the difference of the wheel rotations, clockwise positive (mdeg). */
+    double turn;
+    /** Turn rate of change (mdeg/s). */
+    double turn_speed;
+    /** Turn coordinate at which the heading is zero (mdeg). */
+    double turn_start;
+    /** Acceleration of the forward coordinate during the last step (mm/s^2). */
+    double forward_acceleration;
+    /** Position of the chassis center along the x-axis (mm). */
+    double x;
+    /** Position of the chassis center along the y-axis (mm). */
+    double y;
+} pbdrv_motor_driver_virtual_simulation_chassis_t;
+
+static pbdrv_motor_driver_virtual_simulation_chassis_t chassis;
+
+/**
+ * Gets the heading of the simulated chassis in degrees, clockwise positive.
+ */
+static double simulation_chassis_get_heading(void) {
+    const pbdrv_motor_driver_virtual_simulation_chassis_platform_data_t *cdata = &pbdrv_motor_driver_virtual_simulation_chassis_platform_data;
+    return (chassis.turn - chassis.turn_start) * cdata->wheel_diameter / cdata->axle_track / 1000;
+}
+
+/**
+ * Gets the heading rate of the simulated chassis in degrees per second, clockwise positive.
+ */
+static double simulation_chassis_get_heading_rate(void) {
+    const pbdrv_motor_driver_virtual_simulation_chassis_platform_data_t *cdata = &pbdrv_motor_driver_virtual_simulation_chassis_platform_data;
+    return chassis.turn_speed * cdata->wheel_diameter / cdata->axle_track / 1000;
+}
+
+/**
+ * Gets the ground truth pose of the simulated chassis.
+ *
+ * @param [out] x       Position along the x-axis (mm).
+ * @param [out] y       Position along the y-axis (mm).
+ * @param [out] heading Heading (deg), clockwise positive.
+ */
+void pbdrv_motor_driver_virtual_simulation_chassis_get_pose(double *x, double *y, double *heading) {
+    *x = chassis.x;
+    *y = chassis.y;
+    *heading = simulation_chassis_get_heading();
+}
+
+/**
+ * Computes the load torque that the chassis applies to each wheel motor.
+ *
+ * The tires are modeled as a stiff spring and damper between the wheel angle
+ * and the wheel angle implied by the chassis motion. This is evaluated before
+ * the motors are updated, so that the result can be applied as load.
+ */
+static void simulation_chassis_apply_wheel_loads(void) {
+    const pbdrv_motor_driver_virtual_simulation_chassis_platform_data_t *cdata = &pbdrv_motor_driver_virtual_simulation_chassis_platform_data;
+    pbdrv_motor_driver_dev_t *left = &motor_driver_devs[cdata->left_index];
+    pbdrv_motor_driver_dev_t *right = &motor_driver_devs[cdata->right_index];
+
+    if (!chassis.enabled) {
+        return;
+    }
+
+    // Wheel rotations in the forward direction of the chassis.
+    double left_angle = left->angle * cdata->left_direction;
+    double left_speed = left->speed * cdata->left_direction;
+    double right_angle = right->angle * cdata->right_direction;
+    double right_speed = right->speed * cdata->right_direction;
+
+    // Torque opposing each wheel, in the forward direction of the chassis.
+    double left_torque =
+        (left_angle - chassis.forward - chassis.turn) * cdata->wheel_stiffness +
+        (left_speed - chassis.forward_speed - chassis.turn_speed) * cdata->wheel_damping;
+    double right_torque =
+        (right_angle - chassis.forward + chassis.turn) * cdata->wheel_stiffness +
+        (right_speed - chassis.forward_speed + chassis.turn_speed) * cdata->wheel_damping;
+
+    // Apply load to the motors in their own direction.
+    left->torque = left_torque * cdata->left_direction;
+    right->torque = right_torque * cdata->right_direction;
+
+    // The reaction pushes the chassis along: x(k+1) = x(k) + B tau(k)
+    double forward_speed_next = chassis.forward_speed + (left_torque + right_torque) * cdata->d_forward_speed_d_torque;
+    double turn_speed_next = chassis.turn_speed + (left_torque - right_torque) * cdata->d_turn_speed_d_torque;
+    double forward_next = chassis.forward + chassis.forward_speed * PBDRV_MOTOR_DRIVER_VIRTUAL_SIMULATION_TIME_STEP;
+    double turn_next = chassis.turn + chassis.turn_speed * PBDRV_MOTOR_DRIVER_VIRTUAL_SIMULATION_TIME_STEP;
+
+    // Integrate the planar pose from the traveled distance. The heading is
+    // clockwise positive, so it is negated to get the angle with the x-axis.
+    double mm_per_mdeg = cdata->wheel_diameter * M_PI / 360000;
+    double distance = (forward_next - chassis.forward) * mm_per_mdeg;
+    double angle = -simulation_chassis_get_heading() * M_PI / 180;
+    chassis.x += distance * cos(angle);
+    chassis.y += distance * sin(angle);
+
+    // Save new state.
+    chassis.forward_acceleration = (forward_speed_next - chassis.forward_speed) * mm_per_mdeg / PBDRV_MOTOR_DRIVER_VIRTUAL_SIMULATION_TIME_STEP;
+    chassis.forward = forward_next;
+    chassis.forward_speed = forward_speed_next;
+    chassis.turn = turn_next;
+    chassis.turn_speed = turn_speed_next;
+}
+
+/**
+ * Couples or decouples the simulated chassis and the wheel motors.
+ *
+ * When coupled, the chassis starts at rest at the origin with zero heading,
+ * with the tires aligned to the current wheel angles so there is no initial
+ * load. When decoupled, the motors spin freely without load.
+ *
+ * @param [in]  enable  Whether to couple the chassis to the motors.
+ */
+void pbdrv_motor_driver_virtual_simulation_chassis_set_enabled(bool enable) {
+    const pbdrv_motor_driver_virtual_simulation_chassis_platform_data_t *cdata = &pbdrv_motor_driver_virtual_simulation_chassis_platform_data;
+    pbdrv_motor_driver_dev_t *left = &motor_driver_devs[cdata->left_index];
+    pbdrv_motor_driver_dev_t *right = &motor_driver_devs[cdata->right_index];
+
+    double left_angle = left->angle * cdata->left_direction;
+    double right_angle = right->angle * cdata->right_direction;
+
+    chassis = (pbdrv_motor_driver_virtual_simulation_chassis_t) {
+        .enabled = enable,
+        .forward = (left_angle + right_angle) / 2,
+        .forward_speed = (left->speed * cdata->left_direction + right->speed * cdata->right_direction) / 2,
+        .turn = (left_angle - right_angle) / 2,
+        .turn_speed = (left->speed * cdata->left_direction - right->speed * cdata->right_direction) / 2,
+        .turn_start = (left_angle - right_angle) / 2,
+    };
+    left->torque = 0;
+    right->torque = 0;
+}
+
+#endif // PBDRV_CONFIG_MOTOR_DRIVER_VIRTUAL_SIMULATION_CHASSIS
+
 static void simulation_init(void) {
 
     // This simulation implements the counter and motor driver in one, with
@@ -92,13 +319,19 @@ static void simulation_init(void) {
         // Select model corresponding to device ID.
         switch (driver->pdata->type_id) {
             case LEGO_DEVICE_TYPE_ID_SPIKE_S_MOTOR:
-                driver->model = &model_technic_m_angular; // TODO
+                driver->model = &model_technic_s_angular;
                 break;
             case LEGO_DEVICE_TYPE_ID_SPIKE_M_MOTOR:
                 driver->model = &model_technic_m_angular;
                 break;
             case LEGO_DEVICE_TYPE_ID_SPIKE_L_MOTOR:
-                driver->model = &model_technic_m_angular; // TODO
+                driver->model = &model_technic_l_angular;
+                break;
+            case LEGO_DEVICE_TYPE_ID_EV3_LARGE_MOTOR:
+                driver->model = &model_ev3_l;
+                break;
+            case LEGO_DEVICE_TYPE_ID_EV3_MEDIUM_MOTOR:
+                driver->model = &model_ev3_m;
                 break;
             default:
             case LEGO_DEVICE_TYPE_ID_NONE:
@@ -106,8 +339,122 @@ static void simulation_init(void) {
                 break;
         }
     }
+
+    #if PBDRV_CONFIG_MOTOR_DRIVER_VIRTUAL_SIMULATION_CHASSIS
+    pbdrv_motor_driver_virtual_simulation_chassis_set_enabled(pbdrv_motor_driver_virtual_simulation_chassis_platform_data.enabled);
+    #endif
 }
 
+#if PBDRV_CONFIG_IMU_VIRTUAL_SIMULATION
+
+/**
+ * Simulated IMU that measures the chassis motion. Only the motion in the
+ * horizontal plane is simulated, so the hub is always flat.
+ */
+struct _pbdrv_imu_dev_t {
+    /** IMU configuration to convert raw data to phsyical units. */
+    pbdrv_imu_config_t config;
+    /** Callback to process one frame of unfiltered gyro and accelerometer data. */
+    pbdrv_imu_handle_frame_data_func_t handle_frame_data;
+    /* Callback to process unfiltered gyro and accelerometer data recorded while stationary. */
+    pbdrv_imu_handle_stationary_data_func_t handle_stationary_data;
+    /** Latest raw data. */
+    int16_t data[6];
+    /** Sum of gyro samples during the stationary period. */
+    int32_t stationary_gyro_data_sum[3];
+    /** Sum of accelerometer samples during the stationary period. */
+    int32_t stationary_accel_data_sum[3];
+    /** Number of sequential stationary samples. */
+    uint32_t stationary_sample_count;
+    /** Whether it is currently stationary, to be polled by higher level APIs. */
+    bool stationary_now;
+};
+
+static pbdrv_imu_dev_t simulation_imu_dev = {
+    .config = {
+        .sample_time = PBDRV_MOTOR_DRIVER_VIRTUAL_SIMULATION_TIME_STEP,
+        // Same scale as LSM6DS3TR-C at 2000 dps and 8 g full scale.
+        .gyro_scale = 0.07f,
+        .accel_scale = 0.244f * 9.81f,
+        .gyro_stationary_threshold = 1,
+        .accel_stationary_threshold = 1,
+    },
+};
+
+static int16_t simulation_imu_to_raw(double value, float scale) {
+    return pbio_int_math_clamp(value / scale, INT16_MAX);
+}
+
+/**
+ * Produces one frame of IMU data from the current chassis state.
+ */
+static void simulation_imu_update(void) {
+    pbdrv_imu_dev_t *imu_dev = &simulation_imu_dev;
+
+    // Gyro. The z-axis points up, so it is counterclockwise positive.
+    imu_dev->data[0] = 0;
+    imu_dev->data[1] = 0;
+    imu_dev->data[2] = simulation_imu_to_raw(-simulation_chassis_get_heading_rate(), imu_dev->config.gyro_scale);
+
+    // Accelerometer, with only forward acceleration and gravity.
+    imu_dev->data[3] = simulation_imu_to_raw(chassis.forward_acceleration, imu_dev->config.accel_scale);
+    imu_dev->data[4] = 0;
+    imu_dev->data[5] = simulation_imu_to_raw(9806.65, imu_dev->config.accel_scale);
+
+    // Without noise, stationary means all gyro samples are exactly zero.
+    if (imu_dev->data[2] != 0 || imu_dev->data[3] != 0) {
+        imu_dev->stationary_now = false;
+        imu_dev->stationary_sample_count = 0;
+        memset(imu_dev->stationary_gyro_data_sum, 0, sizeof(imu_dev->stationary_gyro_data_sum));
+        memset(imu_dev->stationary_accel_data_sum, 0, sizeof(imu_dev->stationary_accel_data_sum));
+    } else {
+        for (uint32_t i = 0; i < 3; i++) {
+            imu_dev->stationary_gyro_data_sum[i] += imu_dev->data[i];
+            imu_dev->stationary_accel_data_sum[i] += imu_dev->data[i + 3];
+        }
+
+        // Process the stationary data once per second, like a real IMU.
+        if (++imu_dev->stationary_sample_count == 1000) {
+            imu_dev->stationary_now = true;
+            if (imu_dev->handle_stationary_data) {
+                imu_dev->handle_stationary_data(imu_dev->stationary_gyro_data_sum, imu_dev->stationary_accel_data_sum, imu_dev->stationary_sample_count);
+            }
+            imu_dev->stationary_sample_count = 0;
+            memset(imu_dev->stationary_gyro_data_sum, 0, sizeof(imu_dev->stationary_gyro_data_sum));
+            memset(imu_dev->stationary_accel_data_sum, 0, sizeof(imu_dev->stationary_accel_data_sum));
+        }
+    }
+
+    if (imu_dev->handle_frame_data) {
+        imu_dev->handle_frame_data(imu_dev->data, 1);
+    }
+}
+
+void pbdrv_imu_init(void) {
+    simulation_init();
+}
+
+void pbdrv_imu_deinit(void) {
+}
+
+pbio_error_t pbdrv_imu_get_imu(pbdrv_imu_dev_t **imu_dev, pbdrv_imu_config_t **config) {
+    *imu_dev = &simulation_imu_dev;
+    *config = &simulation_imu_dev.config;
+    return PBIO_SUCCESS;
+}
+
+void pbdrv_imu_set_data_handlers(pbdrv_imu_dev_t *imu_dev, pbdrv_imu_handle_frame_data_func_t frame_data_func, pbdrv_imu_handle_stationary_data_func_t stationary_data_func) {
+    imu_dev->handle_frame_data = frame_data_func;
+    imu_dev->handle_stationary_data = stationary_data_func;
+}
+
+bool pbdrv_imu_is_stationary(pbdrv_imu_dev_t *imu_dev) {
+    return imu_dev->stationary_now;
+}
+
+#endif // PBDRV_CONFIG_IMU_VIRTUAL_SIMULATION
+
+
 pbio_error_t pbdrv_counter_get_dev(uint8_t id, pbdrv_counter_dev_t **dev) {
     if (id >= PBIO_ARRAY_SIZE(motor_driver_devs) || motor_driver_devs[id].pdata->type_id == LEGO_DEVICE_TYPE_ID_NONE) {
         return PBIO_ERROR_NO_DEV;
@@ -189,6 +536,11 @@ pbio_error_t pbdrv_motor_driver_virtual_simulation_process_thread(pbio_os_state_
         PBIO_OS_AWAIT_UNTIL(state, pbio_os_timer_is_expired(&timer));
         pbio_os_timer_extend(&timer);
 
+        #if PBDRV_CONFIG_MOTOR_DRIVER_VIRTUAL_SIMULATION_CHASSIS
+        // Wheel loads depend on the current state, so get them first.
+        simulation_chassis_apply_wheel_loads();
+        #endif
+
         for (dev_index = 0; dev_index < PBDRV_CONFIG_MOTOR_DRIVER_NUM_DEV; dev_index++) {
             driver = &motor_driver_devs[dev_index];
 
@@ -220,7 +572,7 @@ pbio_error_t pbdrv_motor_driver_virtual_simulation_process_thread(pbio_os_state_
             }
 
             double voltage = driver->voltage;
-            double torque = friction + external_torque;
+            double torque = friction + external_torque + driver->torque;
 
             // Get next state based on current state and input: x(k+1) = Ax(k) + Bu(k)
             double angle_next = driver->angle +
@@ -244,6 +596,10 @@ pbio_error_t pbdrv_motor_driver_virtual_simulation_process_thread(pbio_os_state_
             driver->speed = speed_next;
             driver->current = current_next;
         }
+
+        #if PBDRV_CONFIG_IMU_VIRTUAL_SIMULATION
+        simulation_imu_update();
+        #endif
     }
 
     PBIO_OS_ASYNC_END(PBIO_ERROR_FAILED);
@@ -1,5 +1,5 @@
 // SPDX-License-Identifier: MIT
-// Copyright (c) 2022 The Pybricks Authors
+// Copyright (c) 2022-2026 The Pybricks Authors
 
 // Driver that simulates motor driver chips with a dc motor attached to it.
 
@@ -10,6 +10,7 @@
 
 #if PBDRV_CONFIG_MOTOR_DRIVER_VIRTUAL_SIMULATION
 
+#include <stdbool.h>
 #include <stdint.h>
 
 #include <pbio/dcmotor.h>
@@ -37,6 +38,45 @@ typedef struct {
 extern const pbdrv_motor_driver_virtual_simulation_platform_data_t
     pbdrv_motor_driver_virtual_simulation_platform_data[PBDRV_CONFIG_MOTOR_DRIVER_NUM_DEV];
 
+#if PBDRV_CONFIG_MOTOR_DRIVER_VIRTUAL_SIMULATION_CHASSIS
+
+/**
+ * Description of a virtual differential drive chassis that couples two of the
+ * simulated motors through their wheels.
+ */
+typedef struct {
+    /** Whether the chassis is coupled to the motors on boot. */
+    bool enabled;
+    /** Index of the motor that drives the left wheel. */
+    uint8_t left_index;
+    /** Index of the motor that drives the right wheel. */
+    uint8_t right_index;
+    /** 1 if the positive direction of the left motor drives forward, else -1. */
+    int8_t left_direction;
+    /** 1 if the positive direction of the right motor drives forward, else -1. */
+    int8_t right_direction;
+    /** Wheel diameter (mm). */
+    double wheel_diameter;
+    /** Distance between the points where the wheels touch the ground (mm). */
+    double axle_track;
+    /** Tire load torque per unit of wheel slip angle (mdeg). */
+    double wheel_stiffness;
+    /** Tire load torque per unit of wheel slip speed (mdeg/s). */
+    double wheel_damping;
+    /** Change of forward speed per time step for every unit of wheel torque. Smaller for heavier robots. */
+    double d_forward_speed_d_torque;
+    /** Change of turn speed per time step for every unit of wheel torque. Smaller for larger rotational inertia. */
+    double d_turn_speed_d_torque;
+} pbdrv_motor_driver_virtual_simulation_chassis_platform_data_t;
+
+extern const pbdrv_motor_driver_virtual_simulation_chassis_platform_data_t
+    pbdrv_motor_driver_virtual_simulation_chassis_platform_data;
+
+void pbdrv_motor_driver_virtual_simulation_chassis_set_enabled(bool enable);
+void pbdrv_motor_driver_virtual_simulation_chassis_get_pose(double *x, double *y, double *heading);
+
+#endif // PBDRV_CONFIG_MOTOR_DRIVER_VIRTUAL_SIMULATION_CHASSIS
+
 void pbdrv_motor_driver_virtual_simulation_get_angle(pbdrv_motor_driver_dev_t *dev, int32_t *rotations, int32_t *millidegrees);
 
 #endif // PBDRV_CONFIG_MOTOR_DRIVER_VIRTUAL_SIMULATION
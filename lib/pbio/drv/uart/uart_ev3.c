@@ -1,5 +1,5 @@
 // SPDX-License-Identifier: MIT
-// Copyright (c) 2018-2024 The Pybricks Authors
+// Copyright (c) 2018-2026 The Pybricks Authors
 
 // UART driver for EV3
 
@@ -143,16 +143,14 @@ static pbio_error_t pbdrv_uart_write_pru(pbio_os_state_t *state, pbdrv_uart_dev_
         pbio_os_timer_set(&uart->write_timer, timeout);
     }
 
-    // Write one byte at a time until all bytes are written.
+    // Write in blocks until all bytes are written.
     PBIO_OS_AWAIT_UNTIL(state, ({
-        // Try to write one byte if any are remaining.
+        // Queue as many of the remaining bytes as the PRU UART buffer takes.
+        // The interrupt handler sends them out in FIFO sized chunks without
+        // further involvement from this process.
         if (uart->write_pos < uart->write_length) {
-            // Attempt to write one byte with the PRU UART. We could be sending
-            // more than one byte at a time, but we keep it consistent with the
-            // current PRU API. EV3 sensors don't send much data anyway.
-            if (pbdrv_uart_ev3_pru_write_bytes(pdata->peripheral_id, &uart->write_buf[uart->write_pos], 1)) {
-                uart->write_pos++;
-            }
+            uart->write_pos += pbdrv_uart_ev3_pru_write_bytes(pdata->peripheral_id,
+                &uart->write_buf[uart->write_pos], uart->write_length - uart->write_pos);
         }
         // Completion on transmission of whole message and finishing writing, or timeout.
         bool complete = pbdrv_uart_ev3_pru_can_write(pdata->peripheral_id) && uart->write_pos == uart->write_length;
@@ -243,12 +241,19 @@ pbio_error_t pbdrv_uart_write(pbio_os_state_t *state, pbdrv_uart_dev_t *uart, co
     }
 }
 
-void pbdrv_uart_set_baud_rate(pbdrv_uart_dev_t *uart, uint32_t baud) {
+pbio_error_t pbdrv_uart_set_baud_rate(pbdrv_uart_dev_t *uart, uint32_t baud) {
     if (uart->pdata->uart_kind == EV3_UART_HW) {
+        // Divisor must be at least 1 with 16x oversampling.
+        if (baud == 0 || baud > SOC_UART_0_MODULE_FREQ / 16) {
+            return PBIO_ERROR_INVALID_ARG;
+        }
         UARTConfigSetExpClk(uart->pdata->base_address, SOC_UART_0_MODULE_FREQ, baud, UART_WORDL_8BITS, UART_OVER_SAMP_RATE_16);
-    } else {
-        pbdrv_uart_ev3_pru_set_baudrate(uart->pdata->peripheral_id, baud);
+        return PBIO_SUCCESS;
+    }
+    if (pbdrv_uart_ev3_pru_set_baudrate(uart->pdata->peripheral_id, baud)) {
+        return PBIO_ERROR_INVALID_ARG;
     }
+    return PBIO_SUCCESS;
 }
 
 
@@ -266,6 +271,24 @@ void pbdrv_uart_flush(pbdrv_uart_dev_t *uart) {
     lwrb_reset(&uart->rx_buf);
 }
 
+pbio_error_t pbdrv_uart_set_rx_buffer(pbdrv_uart_dev_t *uart, uint8_t *buf, uint32_t size) {
+    // Don't let the IRQ handler write while the buffer is swapped. The PRU
+    // UART uses the TX interrupt ID for both directions.
+    uint32_t int_id = uart->pdata->uart_kind == EV3_UART_HW ?
+        uart->pdata->sys_int_uart_rx_int_id :
+        uart->pdata->sys_int_uart_tx_int_id;
+    IntSystemDisable(int_id);
+    lwrb_init(&uart->rx_buf, buf, size);
+    IntSystemEnable(int_id);
+    return PBIO_SUCCESS;
+}
+
+void pbdrv_uart_release_rx_buffer(pbdrv_uart_dev_t *uart, uint8_t *buf) {
+    if (uart->rx_buf.buff == buf) {
+        pbdrv_uart_set_rx_buffer(uart, pbdrv_uart_rx_data[uart - uart_devs], RX_DATA_SIZE);
+    }
+}
+
 /**
  * Handles RX interrupts for the hardware UART.
  *
@@ -20,7 +20,7 @@
 // Original license given above. Modifications are licensed as follows:
 //
 // SPDX-License-Identifier: MIT
-// Copyright (c) 2024 The Pybricks Authors
+// Copyright (c) 2024-2026 The Pybricks Authors
 //
 // Based on the original LEGO EV3 and ev3dev sources, with non-Linux inspired
 // by liyixiao from EV3RT. All Pybricks modifications are licensed as above.
@@ -73,6 +73,13 @@ struct circ_buf {
 
 #define OVERSAMPLE_RATE (SUART_DEFAULT_OVRSMPL)
 
+// Baud rates are set as a divisor of SUART_DEFAULT_BAUD, which is the fastest
+// rate for the given oversampling. Allowed divisors are limited by McASP.
+#define SUART_CLK_DIVISOR_MAX (384)
+
+// Maximum baud rate error that is accepted when setting the baud rate, in %.
+#define SUART_BAUD_ERROR_MAX (2)
+
 // FIFO timeout when this number of bits *should* have been received, but
 // nothing has.
 #define FIFO_TIMEOUT_SYMBOLS (32)
@@ -157,17 +164,22 @@ static void pru_suart_stop_tx(omapl_pru_suart_t *suart) {
     pru_softuart_clrTxStatus(&suart->suart_hdl);
 }
 
-static void omapl_pru_tx_chars(omapl_pru_suart_t *suart) {
+/**
+ * Sends the next chunk of up to SUART_FIFO_LEN + 1 bytes from the write buffer.
+ *
+ * @return true if a chunk was started, false if there was nothing to send.
+ */
+static bool omapl_pru_tx_chars(omapl_pru_suart_t *suart) {
     struct circ_buf *xmit = &suart->write_buf;
     int32_t count = 0;
 
     if (!(suart_get_duplex(suart) & ePRU_SUART_HALF_TX)) {
-        return;
+        return false;
     }
 
     if (uart_circ_empty(xmit) /*|| uart_tx_stopped(&suart->port)*/) {
         pru_suart_stop_tx(suart);
-        return;
+        return false;
     }
 
     for (count = 0; (uint32_t)count <= SUART_FIFO_LEN; count++) {
@@ -188,6 +200,7 @@ static void omapl_pru_tx_chars(omapl_pru_suart_t *suart) {
         (uint32_t *)&suart->suart_dma_addr.dma_phys_addr_tx, count)) {
         __suart_err("failed to tx data\n");
     }
+    return true;
 }
 
 static void omapl_pru_rx_chars(omapl_pru_suart_t *suart, lwrb_t *rx_dest) {
@@ -201,14 +214,16 @@ static void omapl_pru_rx_chars(omapl_pru_suart_t *suart, lwrb_t *rx_dest) {
     }
     /* read the status */
     rx_status = pru_softuart_getRxStatus(&suart->suart_hdl);
-    pru_softuart_read_data(&suart->suart_hdl, suart_data,
-        data_len + 1, &data_len_read);
 
     /* check for errors */
     if (rx_status & CHN_TXRX_STATUS_ERR) {
         // NB: Originally, here the driver used to call pru_suart_stop_rx if
         // the "sensor was inited" but it is not clear why.
 
+        // Data is not valid, but it must still be taken out of the FIFO.
+        pru_softuart_read_data(&suart->suart_hdl, suart_data,
+            data_len + 1, &data_len_read);
+
         if (rx_status & CHN_TXRX_STATUS_FE) {
             suart->icount.frame++;
         }
@@ -222,8 +237,17 @@ static void omapl_pru_rx_chars(omapl_pru_suart_t *suart, lwrb_t *rx_dest) {
             suart->break_rcvt = 1;
         }
 
+    } else if (lwrb_get_linear_block_write_length(rx_dest) > data_len) {
+        // Read the whole chunk straight into the ring buffer if it fits in
+        // the contiguous part, which is the common case.
+        pru_softuart_read_data(&suart->suart_hdl, lwrb_get_linear_block_write_address(rx_dest),
+            data_len + 1, &data_len_read);
+        lwrb_advance(rx_dest, data_len_read);
     } else {
-        // Receive data into ring buffer
+        // Otherwise go through a temporary buffer.
+        pru_softuart_read_data(&suart->suart_hdl, suart_data,
+            data_len + 1, &data_len_read);
+
         space = lwrb_get_free(rx_dest);
 
         if (space < data_len_read) {
@@ -231,8 +255,6 @@ static void omapl_pru_rx_chars(omapl_pru_suart_t *suart, lwrb_t *rx_dest) {
             pru_suart_stop_rx(suart);
         }
 
-        // TODO: we could just have pru_softuart_read_data read directly
-        // into the lwrb buffer via lwrb_get_linear_block_write_address.
         lwrb_write(rx_dest, suart_data, data_len_read);
     }
 
@@ -261,8 +283,11 @@ void pbdrv_uart_ev3_pru_handle_irq_data(uint8_t id, lwrb_t *rx_dest) {
         if ((PRU_TX_INTR & txrx_flag) == PRU_TX_INTR) {
             pru_intr_clr_isrstatus(uartNum, PRU_TX_INTR);
             pru_softuart_clrTxStatus(&suart->suart_hdl);
-            omapl_pru_tx_chars(suart);
-            suart->write_busy = false;
+            // Keep sending chunks until the write buffer is empty, so the
+            // whole message is sent without waiting for the caller.
+            if (!omapl_pru_tx_chars(suart)) {
+                suart->write_busy = false;
+            }
         }
     } while (txrx_flag & (PRU_RX_INTR | PRU_TX_INTR));
 }
@@ -463,14 +488,31 @@ void pbdrv_uart_ev3_pru_exit(uint8_t line) {
     pru_suart_shutdown(suart);
 }
 
-void pbdrv_uart_ev3_pru_set_baudrate(uint8_t line, uint32_t baud) {
+int32_t pbdrv_uart_ev3_pru_set_baudrate(uint8_t line, uint32_t baud) {
     omapl_pru_suart_t *suart = &suartdevs[line];
     if (baud == suart->baud) {
-        return;
+        return 0;
+    }
+
+    // Only whole divisors of the base rate can be made, so reject rates that
+    // would be too far off for the other side to understand.
+    if (baud == 0 || baud > SUART_DEFAULT_BAUD) {
+        return -EINVAL;
     }
+    uint32_t divisor = (SUART_DEFAULT_BAUD + baud / 2) / baud;
+    if (divisor > SUART_CLK_DIVISOR_MAX) {
+        return -EINVAL;
+    }
+    uint32_t actual = SUART_DEFAULT_BAUD / divisor;
+    uint32_t error = actual > baud ? actual - baud : baud - actual;
+    if (error * 100 > baud * SUART_BAUD_ERROR_MAX) {
+        return -EINVAL;
+    }
+
     suart->baud = baud;
     pru_softuart_setdatabits(&suart->suart_hdl, ePRU_SUART_DATA_BITS8, ePRU_SUART_DATA_BITS8);
-    pru_softuart_setbaud(&suart->suart_hdl, SUART_DEFAULT_BAUD / baud, SUART_DEFAULT_BAUD / baud);
+    pru_softuart_setbaud(&suart->suart_hdl, divisor, divisor);
+    return 0;
 }
 
 int32_t pbdrv_uart_ev3_pru_get_break_state(uint8_t line) {
@@ -140,7 +140,7 @@ pbio_error_t pbdrv_uart_write(pbio_os_state_t *state, pbdrv_uart_dev_t *uart, co
 }
 
 #if defined(STM32F4)
-void pbdrv_uart_set_baud_rate(pbdrv_uart_dev_t *uart, uint32_t baud) {
+pbio_error_t pbdrv_uart_set_baud_rate(pbdrv_uart_dev_t *uart, uint32_t baud) {
 
     USART_TypeDef *USARTx = uart->pdata->uart;
     uint32_t periphclk = LL_RCC_PERIPH_FREQUENCY_NO;
@@ -164,9 +164,10 @@ void pbdrv_uart_set_baud_rate(pbdrv_uart_dev_t *uart, uint32_t baud) {
     }
 
     LL_USART_SetBaudRate(USARTx, periphclk, LL_USART_OVERSAMPLING_16, baud);
+    return PBIO_SUCCESS;
 }
 #elif defined(STM32H5)
-void pbdrv_uart_set_baud_rate(pbdrv_uart_dev_t *uart, uint32_t baud) {
+pbio_error_t pbdrv_uart_set_baud_rate(pbdrv_uart_dev_t *uart, uint32_t baud) {
     USART_TypeDef *USARTx = uart->pdata->uart;
     uint32_t periphclk = LL_RCC_PERIPH_FREQUENCY_NO;
 
@@ -227,6 +228,7 @@ void pbdrv_uart_set_baud_rate(pbdrv_uart_dev_t *uart, uint32_t baud) {
     // i.e. assert_param(IS_LL_USART_BRR_MIN(USARTx->BRR))
     LL_USART_SetBaudRate(USARTx, periphclk, LL_USART_PRESCALER_DIV1, LL_USART_OVERSAMPLING_16, baud);
     LL_USART_SetPrescaler(USARTx, LL_USART_PRESCALER_DIV1);
+    return PBIO_SUCCESS;
 }
 #else
 #error "unsupported MCU for btstack_stm32_hal_set_baudrate()"
@@ -246,6 +248,20 @@ void pbdrv_uart_flush(pbdrv_uart_dev_t *uart) {
     lwrb_reset(&uart->rx_buf);
 }
 
+pbio_error_t pbdrv_uart_set_rx_buffer(pbdrv_uart_dev_t *uart, uint8_t *buf, uint32_t size) {
+    // Don't let the IRQ handler write while the buffer is swapped.
+    NVIC_DisableIRQ(uart->pdata->irq);
+    lwrb_init(&uart->rx_buf, buf, size);
+    NVIC_EnableIRQ(uart->pdata->irq);
+    return PBIO_SUCCESS;
+}
+
+void pbdrv_uart_release_rx_buffer(pbdrv_uart_dev_t *uart, uint8_t *buf) {
+    if (uart->rx_buf.buff == buf) {
+        pbdrv_uart_set_rx_buffer(uart, pbdrv_uart_rx_data[uart - uart_devs], RX_DATA_SIZE);
+    }
+}
+
 void pbdrv_uart_stm32_ll_irq_handle_irq(uint8_t id) {
     pbdrv_uart_dev_t *uart = &uart_devs[id];
     USART_TypeDef *USARTx = uart->pdata->uart;
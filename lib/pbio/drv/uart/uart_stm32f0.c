@@ -1,5 +1,5 @@
 // SPDX-License-Identifier: MIT
-// Copyright (c) 2018-2025 The Pybricks Authors
+// Copyright (c) 2018-2026 The Pybricks Authors
 
 // This driver is for UARTs on STM32F0 MCUs. It provides async read and write
 // functions for sending and receive data and allows changing the baud rate.
@@ -138,8 +138,9 @@ pbio_error_t pbdrv_uart_write(pbio_os_state_t *state, pbdrv_uart_dev_t *uart, co
     PBIO_OS_ASYNC_END(PBIO_SUCCESS);
 }
 
-void pbdrv_uart_set_baud_rate(pbdrv_uart_dev_t *uart, uint32_t baud) {
+pbio_error_t pbdrv_uart_set_baud_rate(pbdrv_uart_dev_t *uart, uint32_t baud) {
     uart->USART->BRR = PBDRV_CONFIG_SYS_CLOCK_RATE / baud;
+    return PBIO_SUCCESS;
 }
 
 void pbdrv_uart_flush(pbdrv_uart_dev_t *uart) {
@@ -150,6 +151,20 @@ void pbdrv_uart_flush(pbdrv_uart_dev_t *uart) {
     uart->rx_buf_index = 0;
 }
 
+pbio_error_t pbdrv_uart_set_rx_buffer(pbdrv_uart_dev_t *uart, uint8_t *buf, uint32_t size) {
+    // Don't let the IRQ handler write while the buffer is swapped.
+    NVIC_DisableIRQ(uart->irq);
+    lwrb_init(&uart->rx_ring_buf, buf, size);
+    NVIC_EnableIRQ(uart->irq);
+    return PBIO_SUCCESS;
+}
+
+void pbdrv_uart_release_rx_buffer(pbdrv_uart_dev_t *uart, uint8_t *buf) {
+    if (uart->rx_ring_buf.buff == buf) {
+        pbdrv_uart_set_rx_buffer(uart, uart->rx_ring_buf_data, UART_RING_BUF_SIZE);
+    }
+}
+
 void pbdrv_uart_stm32f0_handle_irq(uint8_t id) {
     pbdrv_uart_dev_t *uart = &uart_devs[id];
     uint32_t isr = uart->USART->ISR;
@@ -1,5 +1,5 @@
 // SPDX-License-Identifier: MIT
-// Copyright (c) 2018-2020 The Pybricks Authors
+// Copyright (c) 2018-2026 The Pybricks Authors
 // Copyright (c) 2020 Tilen MAJERLE
 // https://github.com/MaJerle/stm32-usart-uart-dma-rx-tx/blob/master/projects/usart_rx_idle_line_irq_rtos_L4_multi_instance/Src/main.c
 
@@ -187,6 +187,14 @@ uint32_t pbdrv_uart_in_waiting(pbdrv_uart_dev_t *uart) {
     return (rx_head - uart->rx_tail) & (RX_DATA_SIZE - 1);
 }
 
+pbio_error_t pbdrv_uart_set_rx_buffer(pbdrv_uart_dev_t *uart, uint8_t *buf, uint32_t size) {
+    // Received bytes go straight into the DMA buffer, which is fixed.
+    return PBIO_ERROR_NOT_SUPPORTED;
+}
+
+void pbdrv_uart_release_rx_buffer(pbdrv_uart_dev_t *uart, uint8_t *buf) {
+}
+
 pbio_error_t pbdrv_uart_read(pbio_os_state_t *state, pbdrv_uart_dev_t *uart, uint8_t *msg, uint32_t length, uint32_t timeout) {
 
     PBIO_OS_ASYNC_BEGIN(state);
@@ -260,7 +268,7 @@ pbio_error_t pbdrv_uart_write(pbio_os_state_t *state, pbdrv_uart_dev_t *uart, co
     PBIO_OS_ASYNC_END(PBIO_SUCCESS);
 }
 
-void pbdrv_uart_set_baud_rate(pbdrv_uart_dev_t *uart, uint32_t baud) {
+pbio_error_t pbdrv_uart_set_baud_rate(pbdrv_uart_dev_t *uart, uint32_t baud) {
 
     USART_TypeDef *USARTx = uart->pdata->uart;
     uint32_t periphclk = LL_RCC_PERIPH_FREQUENCY_NO;
@@ -290,11 +298,12 @@ void pbdrv_uart_set_baud_rate(pbdrv_uart_dev_t *uart, uint32_t baud) {
         }
         #endif /* UART5 */
         else {
-            return;
+            return PBIO_ERROR_NOT_SUPPORTED;
         }
 
         LL_USART_SetBaudRate(USARTx, periphclk, LL_USART_OVERSAMPLING_16, baud);
     }
+    return PBIO_SUCCESS;
 }
 
 void pbdrv_uart_flush(pbdrv_uart_dev_t *uart) {
@@ -1,5 +1,5 @@
 // SPDX-License-Identifier: MIT
-// Copyright (c) 2022 The Pybricks Authors
+// Copyright (c) 2022-2026 The Pybricks Authors
 
 /**
  * @addtogroup BlockDeviceDriver Driver: Block device.
@@ -72,6 +72,129 @@ static inline uint32_t pbdrv_block_device_get_writable_size(void) {
 
 #endif
 
+#if PBDRV_CONFIG_BLOCK_DEVICE && PBDRV_CONFIG_BLOCK_DEVICE_JOURNAL_NUM_SECTORS
+
+/**
+ * Reads data from the journal area.
+ *
+ * The journal is a small area of storage outside of the "RAM Disk". It
+ * consists of ::PBDRV_CONFIG_BLOCK_DEVICE_JOURNAL_NUM_SECTORS sectors of
+ * ::PBDRV_CONFIG_BLOCK_DEVICE_JOURNAL_SECTOR_SIZE bytes each. It can be
+ * written in small increments while a program runs.
+ *
+ * @param [in] state    Protothread state.
+ * @param [in] offset   Offset from the start of the journal area.
+ * @param [in] buffer   Buffer to read into.
+ * @param [in] size     How many bytes to read.
+ * @return              ::PBIO_SUCCESS on success.
+ *                      ::PBIO_ERROR_INVALID_ARG if reading out of bounds.
+ *                      ::PBIO_ERROR_BUSY (driver-specific error)
+ *                      ::PBIO_ERROR_TIMEDOUT (driver-specific error)
+ *                      ::PBIO_ERROR_IO (driver-specific error)
+ */
+pbio_error_t pbdrv_block_device_journal_read(pbio_os_state_t *state, uint32_t offset, uint8_t *buffer, uint32_t size);
+
+/**
+ * Programs data to the journal area without erasing it first.
+ *
+ * Bits can only be cleared by programming, so the destination should be
+ * erased, or the data should only clear bits that are still set.
+ *
+ * @param [in] state    Protothread state.
+ * @param [in] offset   Offset from the start of the journal area.
+ * @param [in] buffer   Data to write. Must remain valid until completion.
+ * @param [in] size     How many bytes to write.
+ * @return              ::PBIO_SUCCESS on success.
+ *                      ::PBIO_ERROR_INVALID_ARG if writing out of bounds.
+ *                      ::PBIO_ERROR_BUSY (driver-specific error)
+ *                      ::PBIO_ERROR_TIMEDOUT (driver-specific error)
+ *                      ::PBIO_ERROR_IO (driver-specific error)
+ */
+pbio_error_t pbdrv_block_device_journal_write(pbio_os_state_t *state, uint32_t offset, const uint8_t *buffer, uint32_t size);
+
+/**
+ * Erases one sector of the journal area.
+ *
+ * @param [in] state    Protothread state.
+ * @param [in] offset   Offset of the sector from the start of the journal area.
+ * @return              ::PBIO_SUCCESS on success.
+ *                      ::PBIO_ERROR_INVALID_ARG if not aligned to a sector.
+ *                      ::PBIO_ERROR_BUSY (driver-specific error)
+ *                      ::PBIO_ERROR_TIMEDOUT (driver-specific error)
+ *                      ::PBIO_ERROR_IO (driver-specific error)
+ */
+pbio_error_t pbdrv_block_device_journal_erase(pbio_os_state_t *state, uint32_t offset);
+
+#else
+
+static inline pbio_error_t pbdrv_block_device_journal_read(pbio_os_state_t *state, uint32_t offset, uint8_t *buffer, uint32_t size) {
+    return PBIO_ERROR_NOT_SUPPORTED;
+}
+
+static inline pbio_error_t pbdrv_block_device_journal_write(pbio_os_state_t *state, uint32_t offset, const uint8_t *buffer, uint32_t size) {
+    return PBIO_ERROR_NOT_SUPPORTED;
+}
+
+static inline pbio_error_t pbdrv_block_device_journal_erase(pbio_os_state_t *state, uint32_t offset) {
+    return PBIO_ERROR_NOT_SUPPORTED;
+}
+
+#endif // PBDRV_CONFIG_BLOCK_DEVICE_JOURNAL_NUM_SECTORS
+
+#if PBDRV_CONFIG_BLOCK_DEVICE && PBDRV_CONFIG_BLOCK_DEVICE_RESOURCE_SIZE
+
+/**
+ * Reads data from the resource area.
+ *
+ * The resource area is a read-mostly area of storage of
+ * ::PBDRV_CONFIG_BLOCK_DEVICE_RESOURCE_SIZE bytes for data that is too big to
+ * keep in RAM, such as images and sounds. It is read on demand through a
+ * small block cache, which also reads ahead the next block.
+ *
+ * @param [in] state    Protothread state.
+ * @param [in] offset   Offset from the start of the resource area.
+ * @param [in] buffer   Buffer to read into.
+ * @param [in] size     How many bytes to read.
+ * @return              ::PBIO_SUCCESS on success.
+ *                      ::PBIO_ERROR_INVALID_ARG if reading out of bounds.
+ *                      ::PBIO_ERROR_BUSY (driver-specific error)
+ *                      ::PBIO_ERROR_TIMEDOUT (driver-specific error)
+ *                      ::PBIO_ERROR_IO (driver-specific error)
+ */
+pbio_error_t pbdrv_block_device_resource_read(pbio_os_state_t *state, uint32_t offset, uint8_t *buffer, uint32_t size);
+
+/**
+ * Writes data to the resource area.
+ *
+ * Every sector in the written range is erased first, so the offset must be
+ * aligned to a flash sector (4096 bytes on W25Qxx). Any data after the
+ * written range in the last sector is erased as well.
+ *
+ * @param [in] state    Protothread state.
+ * @param [in] offset   Offset from the start of the resource area.
+ * @param [in] buffer   Data to write. Must remain valid until completion.
+ * @param [in] size     How many bytes to write.
+ * @return              ::PBIO_SUCCESS on success.
+ *                      ::PBIO_ERROR_INVALID_ARG if writing out of bounds or
+ *                      if the offset is not aligned to a sector.
+ *                      ::PBIO_ERROR_BUSY (driver-specific error)
+ *                      ::PBIO_ERROR_TIMEDOUT (driver-specific error)
+ *                      ::PBIO_ERROR_IO (driver-specific error)
+ */
+pbio_error_t pbdrv_block_device_resource_write(pbio_os_state_t *state, uint32_t offset, const uint8_t *buffer, uint32_t size);
+
+#else
+
+static inline pbio_error_t pbdrv_block_device_resource_read(pbio_os_state_t *state, uint32_t offset, uint8_t *buffer, uint32_t size) {
+    return PBIO_ERROR_NOT_SUPPORTED;
+}
+
+static inline pbio_error_t pbdrv_block_device_resource_write(pbio_os_state_t *state, uint32_t offset, const uint8_t *buffer, uint32_t size) {
+    return PBIO_ERROR_NOT_SUPPORTED;
+}
+
+#endif // PBDRV_CONFIG_BLOCK_DEVICE_RESOURCE_SIZE
+
 #endif // _PBDRV_BLOCK_DEVICE_H_
 
 /** @} */
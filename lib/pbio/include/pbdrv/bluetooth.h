@@ -1,5 +1,5 @@
 // SPDX-License-Identifier: MIT
-// Copyright (c) 2018-2025 The Pybricks Authors
+// Copyright (c) 2018-2026 The Pybricks Authors
 
 /**
  * @addtogroup BluetoothDriver Driver: Bluetooth
@@ -19,6 +19,7 @@
 #include <lego/lwp3.h>
 
 #define PBDRV_BLUETOOTH_STATUS_UPDATE_INTERVAL (500)
+#define PBDRV_BLUETOOTH_STDOUT_FLUSH_TIMEOUT (5)
 #define PBDRV_BLUETOOTH_MAX_CHAR_SIZE 20
 #define PBDRV_BLUETOOTH_MAX_ADV_SIZE 31
 
@@ -531,6 +532,10 @@ pbio_error_t pbdrv_bluetooth_start_advertising(bool start);
  *
  * Setting @p data to NULL or @p size to 0 stops broadcasting.
  *
+ * If already broadcasting, only the advertising data is updated without
+ * restarting advertising. This completes right away, so it can be called at
+ * a high rate. Data that has not been sent yet is replaced by newer data.
+ *
  * @param [in]  data    The advertising data.
  * @param [in]  size    The length of @p data in bytes.
  * @return              ::PBIO_SUCCESS if operation was scheduled,
@@ -1,5 +1,5 @@
 // SPDX-License-Identifier: MIT
-// Copyright (c) 2025 The Pybricks Authors
+// Copyright (c) 2025-2026 The Pybricks Authors
 
 /**
  * @addtogroup I2CDriver Driver
@@ -18,6 +18,32 @@
 
 typedef struct _pbdrv_i2c_dev_t pbdrv_i2c_dev_t;
 
+/**
+ * One step in a list of I2C commands.
+ */
+typedef struct {
+    /**
+     * Data to be sent to the device. Can be null if @p write_len is 0.
+     */
+    const uint8_t *write_data;
+    /**
+     * I2C device address (unshifted). Can be different for each command.
+     */
+    uint8_t address;
+    /**
+     * Length of @p write_data.
+     */
+    uint8_t write_len;
+    /**
+     * Number of bytes to read. These are appended to the result buffer.
+     */
+    uint8_t read_len;
+    /**
+     * Time (ms) to wait after this command before starting the next one.
+     */
+    uint8_t delay;
+} pbdrv_i2c_command_t;
+
 #if PBDRV_CONFIG_I2C
 
 /**
@@ -63,6 +89,34 @@ pbio_error_t pbdrv_i2c_write_then_read(
     size_t rlen,
     bool nxt_quirk);
 
+/**
+ * Runs a list of I2C operations back to back, optionally repeating the list.
+ *
+ * This has the same effect as awaiting ::pbdrv_i2c_write_then_read for each
+ * command, but the caller is only resumed once everything is done.
+ *
+ * @param [in]  state        Protothread state for async operation.
+ * @param [in]  i2c_dev      The I2C device.
+ * @param [in]  commands     The commands. Must remain valid until completion.
+ * @param [in]  num_commands Number of @p commands.
+ * @param [in]  repeat       Number of times to run the whole list.
+ * @param [out] result       Buffer for all data read, in order.
+ * @param [in]  result_size  Size of @p result.
+ * @param [in]  nxt_quirk    Whether to use NXT I2C transaction quirk.
+ * @return                   ::PBIO_SUCCESS on success.
+ *                           ::PBIO_ERROR_INVALID_ARG if @p result is too small.
+ *                           Otherwise the error of the first failed command.
+ */
+pbio_error_t pbdrv_i2c_run_commands(
+    pbio_os_state_t *state,
+    pbdrv_i2c_dev_t *i2c_dev,
+    const pbdrv_i2c_command_t *commands,
+    size_t num_commands,
+    uint32_t repeat,
+    uint8_t *result,
+    size_t result_size,
+    bool nxt_quirk);
+
 #else // PBDRV_CONFIG_I2C
 
 static inline pbio_error_t pbdrv_i2c_get_instance(uint8_t id, pbdrv_i2c_dev_t **i2c_dev) {
@@ -82,6 +136,18 @@ static inline pbio_error_t pbdrv_i2c_write_then_read(
     return PBIO_ERROR_NOT_SUPPORTED;
 }
 
+static inline pbio_error_t pbdrv_i2c_run_commands(
+    pbio_os_state_t *state,
+    pbdrv_i2c_dev_t *i2c_dev,
+    const pbdrv_i2c_command_t *commands,
+    size_t num_commands,
+    uint32_t repeat,
+    uint8_t *result,
+    size_t result_size,
+    bool nxt_quirk) {
+    return PBIO_ERROR_NOT_SUPPORTED;
+}
+
 #endif // PBDRV_CONFIG_I2C
 
 #endif // _PBDRV_I2C_H_
@@ -1,5 +1,5 @@
 // SPDX-License-Identifier: MIT
-// Copyright (c) 2020-2022 The Pybricks Authors
+// Copyright (c) 2020-2026 The Pybricks Authors
 
 /**
  * @addtogroup IMUDriver Driver: Inertial Measurement Unit (IMU)
@@ -58,11 +58,13 @@ pbio_error_t pbdrv_imu_get_imu(pbdrv_imu_dev_t **imu_dev, pbdrv_imu_config_t **c
 bool pbdrv_imu_is_stationary(pbdrv_imu_dev_t *imu_dev);
 
 /**
- * Callback to process one frame of unfiltered gyro and accelerometer data.
+ * Callback to process one or more consecutive frames of unfiltered gyro and
+ * accelerometer data.
  *
- * @param [in]  data        Array with unscaled gyro (xyz) and acceleration (xyz) samples to process.
+ * @param [in]  data        Array with unscaled gyro (xyz) and acceleration (xyz) samples to process, six values per frame.
+ * @param [in]  num_frames  Number of frames in @p data, oldest first.
  */
-typedef void (*pbdrv_imu_handle_frame_data_func_t)(int16_t *data);
+typedef void (*pbdrv_imu_handle_frame_data_func_t)(int16_t *data, uint32_t num_frames);
 
 /**
  * Callback to process @p num_samples unfiltered gyro and accelerometer data
@@ -78,7 +80,7 @@ typedef void (*pbdrv_imu_handle_stationary_data_func_t)(const int32_t *gyro_data
  * Sets the data handlers for processing new data.
  *
  * @param [in]  imu_dev                The IMU device instance.
- * @param [in]  frame_data_func        Callback that handles one data frame.
+ * @param [in]  frame_data_func        Callback that handles one or more data frames.
  * @param [in]  stationary_data_func   Callback that handles multiple stationary data frames.
  */
 void pbdrv_imu_set_data_handlers(pbdrv_imu_dev_t *imu_dev, pbdrv_imu_handle_frame_data_func_t frame_data_func, pbdrv_imu_handle_stationary_data_func_t stationary_data_func);
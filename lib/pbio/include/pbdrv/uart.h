@@ -1,5 +1,5 @@
 // SPDX-License-Identifier: MIT
-// Copyright (c) 2018-2020 The Pybricks Authors
+// Copyright (c) 2018-2026 The Pybricks Authors
 
 /**
  * @addtogroup UARTDriver Driver: Universal Asynchronous Receiver/Transmitter (UART)
@@ -29,7 +29,16 @@ typedef struct _pbdrv_uart_dev_t pbdrv_uart_dev_t;
  */
 pbio_error_t pbdrv_uart_get_instance(uint8_t id, pbdrv_uart_dev_t **uart_dev);
 
-void pbdrv_uart_set_baud_rate(pbdrv_uart_dev_t *uart_dev, uint32_t baud);
+/**
+ * Sets the baud rate of the UART device.
+ *
+ * @param [in]  uart_dev        The UART device.
+ * @param [in]  baud            The baud rate.
+ * @return                      ::PBIO_SUCCESS or ::PBIO_ERROR_INVALID_ARG if
+ *                              the device can't produce this baud rate.
+ */
+pbio_error_t pbdrv_uart_set_baud_rate(pbdrv_uart_dev_t *uart_dev, uint32_t baud);
+
 void pbdrv_uart_stop(pbdrv_uart_dev_t *uart_dev);
 void pbdrv_uart_flush(pbdrv_uart_dev_t *uart_dev);
 
@@ -41,6 +50,31 @@ void pbdrv_uart_flush(pbdrv_uart_dev_t *uart_dev);
  */
 uint32_t pbdrv_uart_in_waiting(pbdrv_uart_dev_t *uart_dev);
 
+/**
+ * Replaces the buffer for incoming bytes, for example to use a bigger buffer
+ * for high data rates. Bytes that were not read yet are discarded.
+ *
+ * The buffer is filled from interrupts, so it must remain valid until it is
+ * released with ::pbdrv_uart_release_rx_buffer.
+ *
+ * @param [in]  uart_dev  The UART device.
+ * @param [in]  buf       The buffer.
+ * @param [in]  size      The size of @p buf.
+ * @return                ::PBIO_SUCCESS on success.
+ *                        ::PBIO_ERROR_NOT_SUPPORTED if the driver has no
+ *                        support for changing the buffer.
+ */
+pbio_error_t pbdrv_uart_set_rx_buffer(pbdrv_uart_dev_t *uart_dev, uint8_t *buf, uint32_t size);
+
+/**
+ * Goes back to the default buffer for incoming bytes, if @p buf is currently
+ * in use. Bytes that were not read yet are discarded.
+ *
+ * @param [in]  uart_dev  The UART device.
+ * @param [in]  buf       The buffer previously given to ::pbdrv_uart_set_rx_buffer.
+ */
+void pbdrv_uart_release_rx_buffer(pbdrv_uart_dev_t *uart_dev, uint8_t *buf);
+
 /**
  * Asynchronously read from the UART.
  *
@@ -72,7 +106,8 @@ static inline pbio_error_t pbdrv_uart_get_instance(uint8_t id, pbdrv_uart_dev_t
     *uart_dev = NULL;
     return PBIO_ERROR_NOT_SUPPORTED;
 }
-static inline void pbdrv_uart_set_baud_rate(pbdrv_uart_dev_t *uart_dev, uint32_t baud) {
+static inline pbio_error_t pbdrv_uart_set_baud_rate(pbdrv_uart_dev_t *uart_dev, uint32_t baud) {
+    return PBIO_ERROR_NOT_SUPPORTED;
 }
 static inline void pbdrv_uart_stop(pbdrv_uart_dev_t *uart_dev) {
 }
@@ -83,6 +118,13 @@ static inline uint32_t pbdrv_uart_in_waiting(pbdrv_uart_dev_t *uart_dev) {
     return 0;
 }
 
+static inline pbio_error_t pbdrv_uart_set_rx_buffer(pbdrv_uart_dev_t *uart_dev, uint8_t *buf, uint32_t size) {
+    return PBIO_ERROR_NOT_SUPPORTED;
+}
+
+static inline void pbdrv_uart_release_rx_buffer(pbdrv_uart_dev_t *uart_dev, uint8_t *buf) {
+}
+
 static inline pbio_error_t pbdrv_uart_write(pbio_os_state_t *state, pbdrv_uart_dev_t *uart, const uint8_t *msg, uint32_t length, uint32_t timeout) {
     return PBIO_ERROR_NOT_SUPPORTED;
 }
@@ -1,5 +1,5 @@
 // SPDX-License-Identifier: MIT
-// Copyright (c) 2020,2022 The Pybricks Authors
+// Copyright (c) 2020-2026 The Pybricks Authors
 
 /**
  * @addtogroup Color pbio/color: Color Conversion Functions
@@ -13,6 +13,8 @@
 
 #include <stdint.h>
 
+#include <pbio/error.h>
+
 /** @cond INTERNAL */
 
 /**
@@ -124,6 +126,24 @@ typedef int32_t (*pbio_color_distance_func_t)(const pbio_color_hsv_t *hsv_a, con
 int32_t pbio_color_get_distance_bicone_squared(const pbio_color_hsv_t *hsv_a, const pbio_color_hsv_t *hsv_b);
 int32_t pbio_color_get_distance_saturation_heuristic(const pbio_color_hsv_t *hsv_a, const pbio_color_hsv_t *hsv_b);
 
+/** Scale of the calibration matrix entries, so 1000 means a gain of 1. */
+#define PBIO_COLOR_CALIBRATION_SCALE (1000)
+
+/** Calibration of a color sensor, applied to its raw RGB readings. */
+typedef struct _pbio_color_calibration_t {
+    /** Raw readings of a black surface. */
+    int16_t black[3];
+    /** Raw readings of a white surface. Must be greater than black. */
+    int16_t white[3];
+    /** Color correction matrix in row major order, applied to the readings
+     * after they are scaled between the black and white references. */
+    int16_t matrix[9];
+} pbio_color_calibration_t;
+
+void pbio_color_calibration_reset(pbio_color_calibration_t *cal, const int16_t *black, const int16_t *white);
+pbio_error_t pbio_color_calibration_set(pbio_color_calibration_t *cal, const int16_t *black, const int16_t *white, const int16_t *matrix);
+void pbio_color_calibration_get_hsv(const pbio_color_calibration_t *cal, const int16_t *raw, pbio_color_hsv_t *hsv);
+
 #endif // _PBIO_COLOR_H_
 
 /** @} */
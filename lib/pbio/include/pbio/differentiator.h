@@ -1,5 +1,5 @@
 // SPDX-License-Identifier: MIT
-// Copyright (c) 2022-2023 The Pybricks Authors
+// Copyright (c) 2022-2026 The Pybricks Authors
 
 // SPDX-License-Identifier: BSD-3-Clause
 // Copyright (c) 2022-2023 LEGO System A/S
@@ -20,12 +20,31 @@
 #include <pbio/angle.h>
 #include <pbio/control_settings.h>
 
+/**
+ * Speed estimation method of the differentiator.
+ */
+typedef enum {
+    /**
+     * Average speed across the window. This is the position difference
+     * between the newest and oldest sample, divided by the window duration.
+     */
+    PBIO_DIFFERENTIATOR_MODE_AVERAGE,
+    /**
+     * Slope of the least squares line fit through all positions in the
+     * window. This is less sensitive to noise on the endpoints, which makes
+     * it suitable for short windows. Equivalent to a first order
+     * Savitzky-Golay derivative filter evaluated at the window center.
+     */
+    PBIO_DIFFERENTIATOR_MODE_REGRESSION,
+} pbio_differentiator_mode_t;
+
 /**
  * Differentiator of position signal.
  *
- * This works by keeping a ring buffer of position increments between each
- * loop iteration. The speed is the average position difference across a given
- * time window.
+ * This works by keeping a ring buffer of the running sum of position
+ * increments between each loop iteration. The speed is the average position
+ * difference across a given time window, which is the difference of two
+ * entries regardless of the window size.
  */
 typedef struct _pbio_differentiator_t {
     /**
@@ -33,9 +52,14 @@ typedef struct _pbio_differentiator_t {
      */
     pbio_angle_t prev_angle;
     /**
-     * Ring buffer of increments.
+     * Ring buffer of the running sum of increments in mdeg. This is allowed
+     * to wrap around since only differences between entries are used.
+     *
+     * The sum across a window does not fit in 16 bits, so this takes twice
+     * the RAM of storing the increments: 244 instead of 122 bytes per servo
+     * with the default buffer size.
      */
-    int16_t history[PBIO_CONFIG_DIFFERENTIATOR_BUFFER_SIZE];
+    uint32_t history[PBIO_CONFIG_DIFFERENTIATOR_BUFFER_SIZE];
     /**
      * Ring buffer index of the newest sampe.
      */
@@ -44,7 +68,7 @@ typedef struct _pbio_differentiator_t {
 
 int32_t pbio_differentiator_update_and_get_speed(pbio_differentiator_t *dif, const pbio_angle_t *angle);
 
-pbio_error_t pbio_differentiator_get_speed(pbio_differentiator_t *dif, uint32_t window, int32_t *speed);
+pbio_error_t pbio_differentiator_get_speed(pbio_differentiator_t *dif, uint32_t window, pbio_differentiator_mode_t mode, int32_t *speed);
 
 void pbio_differentiator_reset(pbio_differentiator_t *dif, const pbio_angle_t *angle);
 
@@ -1,5 +1,5 @@
 // SPDX-License-Identifier: MIT
-// Copyright (c) 2018-2023 The Pybricks Authors
+// Copyright (c) 2018-2026 The Pybricks Authors
 
 // SPDX-License-Identifier: BSD-3-Clause
 // Copyright (c) 2020-2023 LEGO System A/S
@@ -49,13 +49,44 @@ typedef struct _pbio_drivebase_t {
      * Distance controller.
      */
     pbio_control_t control_distance;
+    /**
+     * Position along the x-axis, which is the forward direction when the pose
+     * was reset. In units of distance control steps, upscaled by 10000.
+     */
+    int64_t pose_x;
+    /**
+     * Position along the y-axis, which points to the left when the pose was
+     * reset. In units of distance control steps, upscaled by 10000.
+     */
+    int64_t pose_y;
+    /**
+     * Distance at the previous pose update, in distance control steps.
+     */
+    pbio_angle_t pose_distance_prev;
+    /**
+     * Heading at the previous pose update, in heading control steps.
+     */
+    pbio_angle_t pose_heading_prev;
+    /**
+     * Pose heading minus the drivebase angle, in millidegrees.
+     */
+    int64_t pose_heading_offset;
+    /**
+     * Optional trigger that ends the ongoing maneuver early. It is checked on
+     * every control loop iteration and cleared when a new maneuver starts.
+     */
+    struct _pbio_trigger_t *stop_trigger;
+    /**
+     * What to do when the ongoing maneuver is ended by the stop trigger.
+     */
+    pbio_control_on_completion_t stop_trigger_on_completion;
 } pbio_drivebase_t;
 
 pbio_error_t pbio_drivebase_get_drivebase(pbio_drivebase_t **db_address, pbio_servo_t *left, pbio_servo_t *right, int32_t wheel_diameter, int32_t axle_track);
 
 // Drive base status:
 
-void pbio_drivebase_update_all(void);
+void pbio_drivebase_update_all(uint32_t time_now);
 bool pbio_drivebase_update_loop_is_running(pbio_drivebase_t *db);
 bool pbio_drivebase_any_uses_gyro(void);
 bool pbio_drivebase_is_done(const pbio_drivebase_t *db);
@@ -73,6 +104,8 @@ pbio_error_t pbio_drivebase_drive_arc_distance(pbio_drivebase_t *db, int32_t rad
 
 pbio_error_t pbio_drivebase_drive_forever(pbio_drivebase_t *db, int32_t speed, int32_t turn_rate);
 pbio_error_t pbio_drivebase_stop(pbio_drivebase_t *db, pbio_control_on_completion_t on_completion);
+pbio_error_t pbio_drivebase_set_stop_trigger(pbio_drivebase_t *db, struct _pbio_trigger_t *trigger, pbio_control_on_completion_t on_completion);
+void pbio_drivebase_clear_stop_trigger(struct _pbio_trigger_t *trigger);
 
 
 // Measuring and settings:
@@ -80,6 +113,8 @@ pbio_error_t pbio_drivebase_stop(pbio_drivebase_t *db, pbio_control_on_completio
 pbio_error_t pbio_drivebase_get_state_user(pbio_drivebase_t *db, int32_t *distance, int32_t *drive_speed, int32_t *angle, int32_t *turn_rate);
 pbio_error_t pbio_drivebase_get_state_user_angle(pbio_drivebase_t *db, float *angle);
 pbio_error_t pbio_drivebase_reset(pbio_drivebase_t *db, int32_t distance, int32_t angle);
+pbio_error_t pbio_drivebase_get_pose(pbio_drivebase_t *db, int32_t *x, int32_t *y, int32_t *heading);
+pbio_error_t pbio_drivebase_reset_pose(pbio_drivebase_t *db, int32_t x, int32_t y, int32_t heading);
 pbio_error_t pbio_drivebase_get_drive_settings(const pbio_drivebase_t *db, int32_t *drive_speed, int32_t *drive_acceleration, int32_t *drive_deceleration, int32_t *turn_rate, int32_t *turn_acceleration, int32_t *turn_deceleration);
 pbio_error_t pbio_drivebase_set_drive_settings(pbio_drivebase_t *db, int32_t drive_speed, int32_t drive_acceleration, int32_t drive_deceleration, int32_t turn_rate, int32_t turn_acceleration, int32_t turn_deceleration);
 pbio_error_t pbio_drivebase_set_use_gyro(pbio_drivebase_t *db, pbio_imu_heading_type_t heading_type);
@@ -1,5 +1,5 @@
 // SPDX-License-Identifier: MIT
-// Copyright (c) 2023 The Pybricks Authors
+// Copyright (c) 2023-2026 The Pybricks Authors
 
 /**
  * @addtogroup Imu Imu functions
@@ -100,6 +100,19 @@ typedef struct {
     float heading_correction_1d;
 } pbio_imu_persistent_settings_t;
 
+/**
+ * One raw IMU sample as recorded in the background. All data types are
+ * little-endian, so a buffer of samples can be passed on as-is.
+ */
+typedef struct {
+    /** Time at which the sample was taken, in microseconds. */
+    uint32_t time;
+    /** Raw angular velocity in the hub frame. See ::pbio_imu_record_get_scale. */
+    int16_t angular_velocity[3];
+    /** Raw acceleration in the hub frame. See ::pbio_imu_record_get_scale. */
+    int16_t acceleration[3];
+} pbio_imu_sample_t;
+
 #if PBIO_CONFIG_IMU
 
 void pbio_imu_init(void);
@@ -136,6 +149,16 @@ void pbio_imu_get_heading_scaled(pbio_imu_heading_type_t type, pbio_angle_t *hea
 
 void pbio_orientation_imu_get_orientation(pbio_geometry_matrix_3x3_t *rotation);
 
+pbio_error_t pbio_imu_record_start(void);
+
+void pbio_imu_record_stop(void);
+
+uint32_t pbio_imu_record_get_count(void);
+
+uint32_t pbio_imu_record_read(pbio_imu_sample_t *samples, uint32_t max_samples);
+
+void pbio_imu_record_get_scale(float *angular_velocity_scale, float *acceleration_scale);
+
 #else // PBIO_CONFIG_IMU
 
 static inline void pbio_imu_init(void) {
@@ -197,6 +220,24 @@ static inline void pbio_imu_get_heading_scaled(pbio_imu_heading_type_t type, pbi
 static inline void pbio_orientation_imu_get_orientation(pbio_geometry_matrix_3x3_t *rotation) {
 }
 
+static inline pbio_error_t pbio_imu_record_start(void) {
+    return PBIO_ERROR_NOT_SUPPORTED;
+}
+
+static inline void pbio_imu_record_stop(void) {
+}
+
+static inline uint32_t pbio_imu_record_get_count(void) {
+    return 0;
+}
+
+static inline uint32_t pbio_imu_record_read(pbio_imu_sample_t *samples, uint32_t max_samples) {
+    return 0;
+}
+
+static inline void pbio_imu_record_get_scale(float *angular_velocity_scale, float *acceleration_scale) {
+}
+
 
 #endif // PBIO_CONFIG_IMU
 
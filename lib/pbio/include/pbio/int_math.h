@@ -1,5 +1,5 @@
 // SPDX-License-Identifier: MIT
-// Copyright (c) 2018-2023 The Pybricks Authors
+// Copyright (c) 2018-2026 The Pybricks Authors
 
 // SPDX-License-Identifier: BSD-3-Clause
 // Copyright (c) 2020-2023 LEGO System A/S
@@ -35,10 +35,13 @@ int32_t pbio_int_math_sign(int32_t a);
 // Integer re-implementations of selected math functions.
 
 int32_t pbio_int_math_atan2(int32_t y, int32_t x);
+int32_t pbio_int_math_atan2_mdeg(int32_t y, int32_t x);
 int32_t pbio_int_math_mult_then_div(int32_t a, int32_t b, int32_t c);
 int32_t pbio_int_math_sqrt(int32_t n);
 int32_t pbio_int_math_sin_deg(int32_t x);
 int32_t pbio_int_math_cos_deg(int32_t x);
+int32_t pbio_int_math_sin_mdeg(int32_t x);
+int32_t pbio_int_math_cos_mdeg(int32_t x);
 
 // Interpolation
 
@@ -1,5 +1,5 @@
 // SPDX-License-Identifier: MIT
-// Copyright (c) 2018-2025 The Pybricks Authors
+// Copyright (c) 2018-2026 The Pybricks Authors
 
 /**
  * @addtogroup Port pbio/port: I/O port interface
@@ -12,6 +12,7 @@
 // REVISIT: Merge to pbio/port, but this is currently a circular dependency.
 
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 
 #include <pbdrv/config.h>
@@ -83,6 +84,8 @@ pbio_error_t pbio_port_get_servo(pbio_port_t *port, lego_device_type_id_t *expec
 
 pbio_error_t pbio_port_get_lump_device(pbio_port_t *port, lego_device_type_id_t *expected_type_id, pbio_port_lump_dev_t **lump_dev);
 
+pbio_error_t pbio_port_get_dcm(pbio_port_t *port, pbio_port_dcm_t **dcm);
+
 pbio_error_t pbio_port_get_angle(pbio_port_t *port, pbio_angle_t *angle);
 
 pbio_error_t pbio_port_get_abs_angle(pbio_port_t *port, pbio_angle_t *angle);
@@ -132,6 +135,10 @@ static inline pbio_error_t pbio_port_get_lump_device(pbio_port_t *port, lego_dev
     return PBIO_ERROR_NO_DEV;
 }
 
+static inline pbio_error_t pbio_port_get_dcm(pbio_port_t *port, pbio_port_dcm_t **dcm) {
+    return PBIO_ERROR_NOT_SUPPORTED;
+}
+
 static inline pbio_error_t pbio_port_get_angle(pbio_port_t *port, pbio_angle_t *angle) {
     return PBIO_ERROR_NOT_SUPPORTED;
 }
@@ -171,6 +178,52 @@ static inline pbio_error_t pbio_port_get_i2c_dev(pbio_port_t *port, pbdrv_i2c_de
 
 #endif // PBIO_CONFIG_PORT
 
+/**
+ * Maximum number of I2C commands run on each background poll.
+ */
+#define PBIO_PORT_I2C_POLL_MAX_COMMANDS (4)
+
+#if PBIO_CONFIG_PORT && PBIO_CONFIG_PORT_I2C_POLL_SIZE
+
+pbio_error_t pbio_port_i2c_poll_start(pbio_port_t *port, const pbdrv_i2c_command_t *commands, size_t num_commands, uint32_t interval, bool nxt_quirk);
+
+void pbio_port_i2c_poll_stop(pbio_port_t *port);
+
+bool pbio_port_i2c_poll_is_active(pbio_port_t *port);
+
+pbio_error_t pbio_port_i2c_poll_get_data(pbio_port_t *port, const uint8_t **data, size_t *len, uint32_t *time);
+
+pbio_error_t pbio_port_i2c_poll_request(pbio_port_t *port, uint8_t address, const uint8_t *write_data, size_t write_len, size_t read_len, bool nxt_quirk);
+
+pbio_error_t pbio_port_i2c_poll_request_get_result(pbio_port_t *port, const uint8_t **data);
+
+#else // PBIO_CONFIG_PORT && PBIO_CONFIG_PORT_I2C_POLL_SIZE
+
+static inline pbio_error_t pbio_port_i2c_poll_start(pbio_port_t *port, const pbdrv_i2c_command_t *commands, size_t num_commands, uint32_t interval, bool nxt_quirk) {
+    return PBIO_ERROR_NOT_SUPPORTED;
+}
+
+static inline void pbio_port_i2c_poll_stop(pbio_port_t *port) {
+}
+
+static inline bool pbio_port_i2c_poll_is_active(pbio_port_t *port) {
+    return false;
+}
+
+static inline pbio_error_t pbio_port_i2c_poll_get_data(pbio_port_t *port, const uint8_t **data, size_t *len, uint32_t *time) {
+    return PBIO_ERROR_NOT_SUPPORTED;
+}
+
+static inline pbio_error_t pbio_port_i2c_poll_request(pbio_port_t *port, uint8_t address, const uint8_t *write_data, size_t write_len, size_t read_len, bool nxt_quirk) {
+    return PBIO_ERROR_NOT_SUPPORTED;
+}
+
+static inline pbio_error_t pbio_port_i2c_poll_request_get_result(pbio_port_t *port, const uint8_t **data) {
+    return PBIO_ERROR_NOT_SUPPORTED;
+}
+
+#endif // PBIO_CONFIG_PORT && PBIO_CONFIG_PORT_I2C_POLL_SIZE
+
 #endif // _PBIO_PORT_INTERFACE_H_
 
 /** @} */
@@ -1,5 +1,5 @@
 // SPDX-License-Identifier: MIT
-// Copyright (c) 2018-2025 The Pybricks Authors
+// Copyright (c) 2018-2026 The Pybricks Authors
 
 #ifndef _PBIO_PORT_LUMP_H_
 #define _PBIO_PORT_LUMP_H_
@@ -57,6 +57,8 @@ pbio_error_t pbio_port_lump_get_angle(pbio_port_lump_dev_t *lump_dev, pbio_angle
 
 pbio_port_power_requirements_t pbio_port_lump_get_power_requirements(pbio_port_lump_dev_t *lump_dev);
 
+size_t pbio_port_lump_data_size(lump_data_type_t type);
+
 #else // PBIO_CONFIG_PORT_LUMP
 
 static inline pbio_port_lump_dev_t *pbio_port_lump_init_instance(uint8_t device_index) {
@@ -102,6 +104,10 @@ static inline pbio_port_power_requirements_t pbio_port_lump_get_power_requiremen
     return PBIO_PORT_POWER_REQUIREMENTS_NONE;
 }
 
+static inline size_t pbio_port_lump_data_size(lump_data_type_t type) {
+    return 0;
+}
+
 static inline pbio_error_t pbio_port_lump_sync_thread(pbio_os_state_t *state, pbio_port_lump_dev_t *lump_dev, pbdrv_uart_dev_t *uart_dev, pbio_os_timer_t *timer) {
     return PBIO_ERROR_NOT_SUPPORTED;
 }
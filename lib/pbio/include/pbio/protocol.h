@@ -1,5 +1,5 @@
 // SPDX-License-Identifier: MIT
-// Copyright (c) 2021-2023 The Pybricks Authors
+// Copyright (c) 2021-2026 The Pybricks Authors
 
 /**
  * @addtogroup ProtocolPybricks pbio/protocol: Pybricks Communication Profile
@@ -381,6 +381,12 @@ typedef enum {
      * @since Pybricks Profile v1.5.0
      */
     PBIO_PYBRICKS_STATUS_FILE_IO_IN_PROGRESS = 13,
+    /**
+     * Hub is saving programs, user data, or settings to storage.
+     *
+     * @since Pybricks Profile v1.6.0
+     */
+    PBIO_PYBRICKS_STATUS_STORAGE_WRITE_IN_PROGRESS = 14,
     /** Total number of indications. */
     NUM_PBIO_PYBRICKS_STATUS,
 } pbio_pybricks_status_flags_t;
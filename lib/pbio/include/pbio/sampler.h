@@ -0,0 +1,102 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2026 The Pybricks Authors
+
+/**
+ * @addtogroup Sampler pbio/sampler: Background sensor sampling
+ *
+ * Samples a sensor value at a fixed rate in the background and stores each
+ * value with its timestamp, so it can be read later in bulk.
+ * @{
+ */
+
+#ifndef _PBIO_SAMPLER_H_
+#define _PBIO_SAMPLER_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <pbio/config.h>
+#include <pbio/error.h>
+#include <pbio/port.h>
+
+#include <lego/device.h>
+
+/**
+ * Size of the timestamp at the start of each sample, in bytes.
+ */
+#define PBIO_SAMPLER_TIME_SIZE (sizeof(uint32_t))
+
+typedef struct _pbio_sampler_t pbio_sampler_t;
+
+#if PBIO_CONFIG_SAMPLER_NUM_DEV
+
+pbio_error_t pbio_sampler_start_lump(pbio_sampler_t **sampler, pbio_port_t *port, uint8_t mode, uint32_t period);
+
+pbio_error_t pbio_sampler_start_analog(pbio_sampler_t **sampler, pbio_port_t *port, lego_device_type_id_t type_id, bool active, uint32_t period);
+
+void pbio_sampler_stop(pbio_sampler_t *sampler);
+
+void pbio_sampler_stop_all(void);
+
+bool pbio_sampler_is_active(pbio_sampler_t *sampler);
+
+uint32_t pbio_sampler_get_sample_size(pbio_sampler_t *sampler);
+
+uint32_t pbio_sampler_get_count(pbio_sampler_t *sampler);
+
+uint32_t pbio_sampler_get_num_dropped(pbio_sampler_t *sampler);
+
+pbio_error_t pbio_sampler_get_error(pbio_sampler_t *sampler);
+
+void pbio_sampler_clear_error(pbio_sampler_t *sampler);
+
+uint32_t pbio_sampler_read(pbio_sampler_t *sampler, uint8_t *data, uint32_t max_samples);
+
+#else // PBIO_CONFIG_SAMPLER_NUM_DEV
+
+static inline pbio_error_t pbio_sampler_start_lump(pbio_sampler_t **sampler, pbio_port_t *port, uint8_t mode, uint32_t period) {
+    return PBIO_ERROR_NOT_SUPPORTED;
+}
+
+static inline pbio_error_t pbio_sampler_start_analog(pbio_sampler_t **sampler, pbio_port_t *port, lego_device_type_id_t type_id, bool active, uint32_t period) {
+    return PBIO_ERROR_NOT_SUPPORTED;
+}
+
+static inline void pbio_sampler_stop(pbio_sampler_t *sampler) {
+}
+
+static inline void pbio_sampler_stop_all(void) {
+}
+
+static inline bool pbio_sampler_is_active(pbio_sampler_t *sampler) {
+    return false;
+}
+
+static inline uint32_t pbio_sampler_get_sample_size(pbio_sampler_t *sampler) {
+    return 0;
+}
+
+static inline uint32_t pbio_sampler_get_count(pbio_sampler_t *sampler) {
+    return 0;
+}
+
+static inline uint32_t pbio_sampler_get_num_dropped(pbio_sampler_t *sampler) {
+    return 0;
+}
+
+static inline pbio_error_t pbio_sampler_get_error(pbio_sampler_t *sampler) {
+    return PBIO_ERROR_NOT_SUPPORTED;
+}
+
+static inline void pbio_sampler_clear_error(pbio_sampler_t *sampler) {
+}
+
+static inline uint32_t pbio_sampler_read(pbio_sampler_t *sampler, uint8_t *data, uint32_t max_samples) {
+    return 0;
+}
+
+#endif // PBIO_CONFIG_SAMPLER_NUM_DEV
+
+#endif // _PBIO_SAMPLER_H_
+
+/** @} */
@@ -1,5 +1,5 @@
 // SPDX-License-Identifier: MIT
-// Copyright (c) 2018-2023 The Pybricks Authors
+// Copyright (c) 2018-2026 The Pybricks Authors
 
 // SPDX-License-Identifier: BSD-3-Clause
 // Copyright (c) 2020-2023 LEGO System A/S
@@ -52,6 +52,8 @@
  * the motor shaft. Scaling happens through the gear ratio value given during
  * the servo setup.
  */
+struct _pbio_trigger_t;
+
 typedef struct _pbio_servo_t {
     /**
      * The dcmotor being controlled.
@@ -83,6 +85,16 @@ typedef struct _pbio_servo_t {
      * occur.
      */
     bool run_update_loop;
+    /**
+     * Optional trigger that ends the ongoing command early. It is checked on
+     * every control loop iteration, so the servo stops within one sample of
+     * the trigger firing. Cleared when a new command starts.
+     */
+    struct _pbio_trigger_t *stop_trigger;
+    /**
+     * What to do when the ongoing command is ended by the stop trigger.
+     */
+    pbio_control_on_completion_t stop_trigger_on_completion;
 } pbio_servo_t;
 
 /**
@@ -143,14 +155,14 @@ pbio_error_t pbio_servo_actuate(pbio_servo_t *srv, pbio_dcmotor_actuation_t actu
 int32_t pbio_servo_get_max_voltage(lego_device_type_id_t id);
 const pbio_servo_settings_reduced_t *pbio_servo_get_reduced_settings(lego_device_type_id_t id);
 void pbio_servo_override_settings(pbio_control_settings_t *settings, lego_device_type_id_t id);
-void pbio_servo_update_all(void);
+void pbio_servo_update_all(uint32_t time_now);
 /** @endcond */
 
 /** @name Status Functions */
 /**@{*/
 pbio_error_t pbio_servo_get_state_control(pbio_servo_t *srv, pbio_control_state_t *state);
 pbio_error_t pbio_servo_get_state_user(pbio_servo_t *srv, int32_t *angle, int32_t *speed);
-pbio_error_t pbio_servo_get_speed_user(pbio_servo_t *srv, uint32_t window, int32_t *speed);
+pbio_error_t pbio_servo_get_speed_user(pbio_servo_t *srv, uint32_t window, pbio_differentiator_mode_t mode, int32_t *speed);
 bool pbio_servo_update_loop_is_running(pbio_servo_t *srv);
 pbio_error_t pbio_servo_is_stalled(pbio_servo_t *srv, bool *stalled, uint32_t *stall_duration);
 pbio_error_t pbio_servo_get_load(pbio_servo_t *srv, int32_t *load);
@@ -166,6 +178,8 @@ pbio_error_t pbio_servo_run_until_stalled(pbio_servo_t *srv, int32_t speed, int3
 pbio_error_t pbio_servo_run_angle(pbio_servo_t *srv, int32_t speed, int32_t angle, pbio_control_on_completion_t on_completion);
 pbio_error_t pbio_servo_run_target(pbio_servo_t *srv, int32_t speed, int32_t target, pbio_control_on_completion_t on_completion);
 pbio_error_t pbio_servo_track_target(pbio_servo_t *srv, int32_t target);
+pbio_error_t pbio_servo_set_stop_trigger(pbio_servo_t *srv, struct _pbio_trigger_t *trigger, pbio_control_on_completion_t on_completion);
+void pbio_servo_clear_stop_trigger(struct _pbio_trigger_t *trigger);
 /**@}*/
 
 #endif // PBIO_CONFIG_SERVO
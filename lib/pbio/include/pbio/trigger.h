@@ -0,0 +1,101 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2026 The Pybricks Authors
+
+/**
+ * @addtogroup Trigger pbio/trigger: Sensor value triggers
+ *
+ * Checks a condition on a sensor value each time the sensor reports new data,
+ * so user code can wait for it without polling. Optionally stops motors as
+ * soon as the condition is met.
+ * @{
+ */
+
+#ifndef _PBIO_TRIGGER_H_
+#define _PBIO_TRIGGER_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <pbio/config.h>
+#include <pbio/control.h>
+#include <pbio/error.h>
+#include <pbio/port.h>
+#include <pbio/port_dcm.h>
+#include <pbio/port_lump.h>
+#include <pbio/servo.h>
+
+#include <lego/device.h>
+
+/**
+ * Maximum number of motors that a trigger can stop.
+ */
+#define PBIO_TRIGGER_NUM_SERVOS (2)
+
+/**
+ * Condition on the sensor value.
+ */
+typedef enum {
+    /** Value is greater than the threshold. */
+    PBIO_TRIGGER_CONDITION_ABOVE,
+    /** Value is less than the threshold. */
+    PBIO_TRIGGER_CONDITION_BELOW,
+    /** Value is equal to the threshold. */
+    PBIO_TRIGGER_CONDITION_EQUAL,
+    /** Value is not equal to the threshold. */
+    PBIO_TRIGGER_CONDITION_NOT_EQUAL,
+} pbio_trigger_condition_t;
+
+typedef struct _pbio_trigger_t pbio_trigger_t;
+
+#if PBIO_CONFIG_TRIGGER_NUM_DEV
+
+pbio_error_t pbio_trigger_start_lump(pbio_trigger_t **trigger, pbio_port_t *port, uint8_t mode, uint8_t index, pbio_trigger_condition_t condition, int32_t threshold, bool edge, pbio_servo_t **servos, uint8_t num_servos, pbio_control_on_completion_t on_completion);
+
+pbio_error_t pbio_trigger_start_analog(pbio_trigger_t **trigger, pbio_port_t *port, lego_device_type_id_t type_id, bool active, pbio_trigger_condition_t condition, int32_t threshold, bool edge, pbio_servo_t **servos, uint8_t num_servos, pbio_control_on_completion_t on_completion);
+
+void pbio_trigger_stop(pbio_trigger_t *trigger);
+
+void pbio_trigger_stop_all(void);
+
+pbio_error_t pbio_trigger_get_result(pbio_trigger_t *trigger, int32_t *value, uint32_t *time);
+
+void pbio_trigger_update(pbio_trigger_t *trigger);
+
+void pbio_trigger_lump_data_received(pbio_port_lump_dev_t *lump_dev);
+
+void pbio_trigger_dcm_data_received(pbio_port_dcm_t *dcm);
+
+#else // PBIO_CONFIG_TRIGGER_NUM_DEV
+
+static inline pbio_error_t pbio_trigger_start_lump(pbio_trigger_t **trigger, pbio_port_t *port, uint8_t mode, uint8_t index, pbio_trigger_condition_t condition, int32_t threshold, bool edge, pbio_servo_t **servos, uint8_t num_servos, pbio_control_on_completion_t on_completion) {
+    return PBIO_ERROR_NOT_SUPPORTED;
+}
+
+static inline pbio_error_t pbio_trigger_start_analog(pbio_trigger_t **trigger, pbio_port_t *port, lego_device_type_id_t type_id, bool active, pbio_trigger_condition_t condition, int32_t threshold, bool edge, pbio_servo_t **servos, uint8_t num_servos, pbio_control_on_completion_t on_completion) {
+    return PBIO_ERROR_NOT_SUPPORTED;
+}
+
+static inline void pbio_trigger_stop(pbio_trigger_t *trigger) {
+}
+
+static inline void pbio_trigger_stop_all(void) {
+}
+
+static inline pbio_error_t pbio_trigger_get_result(pbio_trigger_t *trigger, int32_t *value, uint32_t *time) {
+    return PBIO_ERROR_NOT_SUPPORTED;
+}
+
+static inline void pbio_trigger_update(pbio_trigger_t *trigger) {
+}
+
+static inline void pbio_trigger_lump_data_received(pbio_port_lump_dev_t *lump_dev) {
+}
+
+static inline void pbio_trigger_dcm_data_received(pbio_port_dcm_t *dcm) {
+}
+
+#endif // PBIO_CONFIG_TRIGGER_NUM_DEV
+
+#endif // _PBIO_TRIGGER_H_
+
+/** @} */
@@ -1,5 +1,5 @@
 // SPDX-License-Identifier: MIT
-// Copyright (c) 2019-2022 The Pybricks Authors
+// Copyright (c) 2019-2026 The Pybricks Authors
 
 /**
  * @addtogroup Utility pbio/util: Utility Functions
@@ -131,6 +131,8 @@ void pbio_uuid128_le_copy(uint8_t *dst, const uint8_t *src);
 bool pbio_uuid128_reverse_compare(const uint8_t *uuid1, const uint8_t *uuid2);
 void pbio_uuid128_reverse_copy(uint8_t *dst, const uint8_t *src);
 
+uint32_t pbio_crc32(uint32_t crc, const uint8_t *data, uint32_t size);
+
 typedef void (*pbio_util_void_callback_t)(void);
 
 /**
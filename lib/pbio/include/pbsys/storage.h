@@ -1,5 +1,5 @@
 // SPDX-License-Identifier: MIT
-// Copyright (c) 2022-2024 The Pybricks Authors
+// Copyright (c) 2022-2026 The Pybricks Authors
 
 /**
  * @addtogroup SysStorage System: Load user programs, data, and settings.
@@ -14,6 +14,8 @@
 
 #include <stdint.h>
 
+#include <pbio/error.h>
+#include <pbio/os.h>
 #include <pbsys/config.h>
 #include <pbsys/storage_settings.h>
 
@@ -51,6 +53,32 @@ static inline void pbsys_storage_request_write(void) {
 
 #endif // PBSYS_CONFIG_STORAGE
 
+#if PBSYS_CONFIG_STORAGE_KV_SIZE
+
+pbio_error_t pbsys_storage_kv_get(const uint8_t *key, uint32_t key_size, const uint8_t **value, uint32_t *value_size);
+
+pbio_error_t pbsys_storage_kv_set(const uint8_t *key, uint32_t key_size, const uint8_t *value, uint32_t value_size);
+
+pbio_error_t pbsys_storage_kv_await_saved(pbio_os_state_t *state);
+
+#else
+
+static inline pbio_error_t pbsys_storage_kv_get(const uint8_t *key, uint32_t key_size, const uint8_t **value, uint32_t *value_size) {
+    *value = NULL;
+    *value_size = 0;
+    return PBIO_ERROR_NOT_SUPPORTED;
+}
+
+static inline pbio_error_t pbsys_storage_kv_set(const uint8_t *key, uint32_t key_size, const uint8_t *value, uint32_t value_size) {
+    return PBIO_ERROR_NOT_SUPPORTED;
+}
+
+static inline pbio_error_t pbsys_storage_kv_await_saved(pbio_os_state_t *state) {
+    return PBIO_ERROR_NOT_SUPPORTED;
+}
+
+#endif // PBSYS_CONFIG_STORAGE_KV_SIZE
+
 #endif // _PBSYS_STORAGE_H_
 
 /** @} */
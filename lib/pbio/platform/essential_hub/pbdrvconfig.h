@@ -1,5 +1,5 @@
 // SPDX-License-Identifier: MIT
-// Copyright (c) 2021-2022 The Pybricks Authors
+// Copyright (c) 2021-2026 The Pybricks Authors
 
 #define PBDRV_CONFIG_ADC                            (1)
 #define PBDRV_CONFIG_ADC_STM32_HAL                  (1)
@@ -47,6 +47,15 @@
 // just needs to be big enough to back up the user program on shutdown.
 #define PBDRV_CONFIG_BLOCK_DEVICE_W25QXX_STM32_START_ADDRESS (512 * 1024)
 #define PBDRV_CONFIG_BLOCK_DEVICE_W25QXX_STM32_SIZE (256 * 1024)
+// Two sectors right after it are used as a journal for small values that
+// are saved while a program runs.
+#define PBDRV_CONFIG_BLOCK_DEVICE_W25QXX_STM32_JOURNAL_ADDRESS (768 * 1024)
+#define PBDRV_CONFIG_BLOCK_DEVICE_JOURNAL_NUM_SECTORS (2)
+#define PBDRV_CONFIG_BLOCK_DEVICE_JOURNAL_SECTOR_SIZE (4 * 1024)
+// The rest of the reserved area holds resources that are read on demand.
+#define PBDRV_CONFIG_BLOCK_DEVICE_W25QXX_STM32_RESOURCE_ADDRESS (776 * 1024)
+#define PBDRV_CONFIG_BLOCK_DEVICE_RESOURCE_SIZE (248 * 1024)
+#define PBDRV_CONFIG_BLOCK_DEVICE_RESOURCE_CACHE_BLOCKS (4)
 
 #define PBDRV_CONFIG_BUTTON                         (1)
 #define PBDRV_CONFIG_BUTTON_GPIO                    (1)
@@ -69,6 +78,7 @@
 #define PBDRV_CONFIG_IMU_LSM6S3TR_C_STM32_SIGN_X    (1)
 #define PBDRV_CONFIG_IMU_LSM6S3TR_C_STM32_SIGN_Y    (-1)
 #define PBDRV_CONFIG_IMU_LSM6S3TR_C_STM32_SIGN_Z    (-1)
+#define PBDRV_CONFIG_IMU_LSM6S3TR_C_STM32_FIFO_FRAMES (4)
 
 #define PBDRV_CONFIG_IOPORT                         (1)
 #define PBDRV_CONFIG_IOPORT_HAS_ADC                 (0)
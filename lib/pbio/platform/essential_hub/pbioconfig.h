@@ -1,11 +1,12 @@
 // SPDX-License-Identifier: MIT
-// Copyright (c) 2019-2025 The Pybricks Authors
+// Copyright (c) 2019-2026 The Pybricks Authors
 
 #define PBIO_CONFIG_BATTERY                 (1)
 #define PBIO_CONFIG_DCMOTOR                 (1)
 #define PBIO_CONFIG_DCMOTOR_NUM_DEV         (2)
 #define PBIO_CONFIG_DRIVEBASE_SPIKE         (1)
 #define PBIO_CONFIG_IMU                     (1)
+#define PBIO_CONFIG_IMU_RECORD_NUM_SAMPLES  (128)
 #define PBIO_CONFIG_LIGHT                   (1)
 #define PBIO_CONFIG_LOGGER                  (1)
 #define PBIO_CONFIG_LIGHT_MATRIX            (0)
@@ -25,5 +26,6 @@
 #define PBIO_CONFIG_SERVO_PUP               (1)
 #define PBIO_CONFIG_SERVO_PUP_MOVE_HUB      (0)
 #define PBIO_CONFIG_TACHO                   (1)
+#define PBIO_CONFIG_TRIGGER_NUM_DEV         (4)
 
 #define PBIO_CONFIG_ENABLE_SYS              (1)
@@ -1,5 +1,5 @@
 // SPDX-License-Identifier: MIT
-// Copyright (c) 2021-2023 The Pybricks Authors
+// Copyright (c) 2021-2026 The Pybricks Authors
 
 #define PBSYS_CONFIG_FEATURE_BUILTIN_USER_PROGRAM_REPL             (1)
 #define PBSYS_CONFIG_FEATURE_BUILTIN_USER_PROGRAM_PORT_VIEW        (1)
@@ -19,6 +19,8 @@
 #define PBSYS_CONFIG_STORAGE                        (1)
 #define PBSYS_CONFIG_STORAGE_NUM_SLOTS              (1)
 #define PBSYS_CONFIG_STORAGE_USER_DATA_SIZE         (512)
+#define PBSYS_CONFIG_STORAGE_BACKGROUND_WRITE       (1)
+#define PBSYS_CONFIG_STORAGE_KV_SIZE                (2048)
 #define PBSYS_CONFIG_STATUS_LIGHT                   (1)
 #define PBSYS_CONFIG_STATUS_LIGHT_BATTERY           (1)
 #define PBSYS_CONFIG_STATUS_LIGHT_BLUETOOTH         (0)
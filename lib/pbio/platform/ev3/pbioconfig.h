@@ -1,5 +1,5 @@
 // SPDX-License-Identifier: MIT
-// Copyright (c) 2023-2024 The Pybricks Authors
+// Copyright (c) 2023-2026 The Pybricks Authors
 
 #define PBIO_CONFIG_BATTERY                 (1)
 #define PBIO_CONFIG_DCMOTOR                 (1)
@@ -16,14 +16,18 @@
 #define PBIO_CONFIG_PORT_DCM_PUP            (0)
 #define PBIO_CONFIG_PORT_DCM_EV3            (1)
 #define PBIO_CONFIG_PORT_DCM_NUM_DEV        (4)
+#define PBIO_CONFIG_PORT_I2C_POLL_SIZE      (32)
 #define PBIO_CONFIG_PORT_LUMP               (1)
 #define PBIO_CONFIG_PORT_LUMP_MODE_INFO     (1)
 #define PBIO_CONFIG_PORT_LUMP_NUM_DEV       (4)
+#define PBIO_CONFIG_SAMPLER_NUM_DEV         (2)
+#define PBIO_CONFIG_SAMPLER_BUF_SIZE        (4096)
 #define PBIO_CONFIG_SERVO                   (1)
 #define PBIO_CONFIG_SERVO_NUM_DEV           (4)
 #define PBIO_CONFIG_SERVO_EV3_NXT           (1)
 #define PBIO_CONFIG_SERVO_PUP               (0)
 #define PBIO_CONFIG_SERVO_PUP_MOVE_HUB      (0)
 #define PBIO_CONFIG_TACHO                   (1)
+#define PBIO_CONFIG_TRIGGER_NUM_DEV         (4)
 
 #define PBIO_CONFIG_ENABLE_SYS              (1)
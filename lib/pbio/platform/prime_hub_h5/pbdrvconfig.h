@@ -51,6 +51,15 @@
 // just needs to be big enough to back up the user program on shutdown.
 #define PBDRV_CONFIG_BLOCK_DEVICE_W25QXX_STM32_START_ADDRESS (512 * 1024)
 #define PBDRV_CONFIG_BLOCK_DEVICE_W25QXX_STM32_SIZE (256 * 1024)
+// Two sectors right after it are used as a journal for small values that
+// are saved while a program runs.
+#define PBDRV_CONFIG_BLOCK_DEVICE_W25QXX_STM32_JOURNAL_ADDRESS (768 * 1024)
+#define PBDRV_CONFIG_BLOCK_DEVICE_JOURNAL_NUM_SECTORS (2)
+#define PBDRV_CONFIG_BLOCK_DEVICE_JOURNAL_SECTOR_SIZE (4 * 1024)
+// The rest of the reserved area holds resources that are read on demand.
+#define PBDRV_CONFIG_BLOCK_DEVICE_W25QXX_STM32_RESOURCE_ADDRESS (776 * 1024)
+#define PBDRV_CONFIG_BLOCK_DEVICE_RESOURCE_SIZE (248 * 1024)
+#define PBDRV_CONFIG_BLOCK_DEVICE_RESOURCE_CACHE_BLOCKS (4)
 
 #define PBDRV_CONFIG_BUTTON                         (1)
 #define PBDRV_CONFIG_BUTTON_RESISTOR_LADDER         (1)
@@ -74,6 +83,7 @@
 #define PBDRV_CONFIG_IMU_LSM6S3TR_C_STM32_SIGN_X    (-1)
 #define PBDRV_CONFIG_IMU_LSM6S3TR_C_STM32_SIGN_Y    (1)
 #define PBDRV_CONFIG_IMU_LSM6S3TR_C_STM32_SIGN_Z    (-1)
+#define PBDRV_CONFIG_IMU_LSM6S3TR_C_STM32_FIFO_FRAMES (4)
 
 #define PBDRV_CONFIG_IOPORT                         (1)
 #define PBDRV_CONFIG_IOPORT_HAS_ADC                 (0)
@@ -6,6 +6,7 @@
 #define PBIO_CONFIG_DCMOTOR_NUM_DEV         (6)
 #define PBIO_CONFIG_DRIVEBASE_SPIKE         (1)
 #define PBIO_CONFIG_IMU                     (1)
+#define PBIO_CONFIG_IMU_RECORD_NUM_SAMPLES  (256)
 #define PBIO_CONFIG_LIGHT                   (1)
 #define PBIO_CONFIG_LOGGER                  (1)
 #define PBIO_CONFIG_LIGHT_MATRIX            (1)
@@ -20,11 +21,14 @@
 #define PBIO_CONFIG_PORT_LUMP               (1)
 #define PBIO_CONFIG_PORT_LUMP_MODE_INFO     (1)
 #define PBIO_CONFIG_PORT_LUMP_NUM_DEV       (PBIO_CONFIG_PORT_NUM_DEV)
+#define PBIO_CONFIG_SAMPLER_NUM_DEV         (2)
+#define PBIO_CONFIG_SAMPLER_BUF_SIZE        (2048)
 #define PBIO_CONFIG_SERVO                   (1)
 #define PBIO_CONFIG_SERVO_NUM_DEV           (6)
 #define PBIO_CONFIG_SERVO_EV3_NXT           (0)
 #define PBIO_CONFIG_SERVO_PUP               (1)
 #define PBIO_CONFIG_SERVO_PUP_MOVE_HUB      (0)
 #define PBIO_CONFIG_TACHO                   (1)
+#define PBIO_CONFIG_TRIGGER_NUM_DEV         (4)
 
 #define PBIO_CONFIG_ENABLE_SYS              (1)
@@ -1,5 +1,5 @@
 // SPDX-License-Identifier: MIT
-// Copyright (c) 2019-2022 The Pybricks Authors
+// Copyright (c) 2019-2026 The Pybricks Authors
 
 #define PBDRV_CONFIG_ADC                            (1)
 #define PBDRV_CONFIG_ADC_STM32_HAL                  (1)
@@ -53,6 +53,7 @@
 #define PBDRV_CONFIG_IMU_LSM6S3TR_C_STM32_SIGN_X    (-1)
 #define PBDRV_CONFIG_IMU_LSM6S3TR_C_STM32_SIGN_Y    (-1)
 #define PBDRV_CONFIG_IMU_LSM6S3TR_C_STM32_SIGN_Z    (1)
+#define PBDRV_CONFIG_IMU_LSM6S3TR_C_STM32_FIFO_FRAMES (4)
 
 #define PBDRV_CONFIG_IOPORT                         (1)
 #define PBDRV_CONFIG_IOPORT_HAS_ADC                 (0)
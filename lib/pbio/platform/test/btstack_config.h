@@ -1,5 +1,5 @@
 // SPDX-License-Identifier: MIT
-// Copyright (c) 2020 The Pybricks Authors
+// Copyright (c) 2020-2026 The Pybricks Authors
 
 // BlueKitchen BTStack config
 
@@ -14,6 +14,7 @@
 #define ENABLE_CLASSIC
 #define ENABLE_BLE
 #define ENABLE_LE_CENTRAL
+#define ENABLE_LE_DATA_LENGTH_EXTENSION
 #define ENABLE_LE_PERIPHERAL
 #define ENABLE_PRINTF_HEXDUMP
 
@@ -1,9 +1,14 @@
 // SPDX-License-Identifier: MIT
-// Copyright (c) 2019-2022 The Pybricks Authors
+// Copyright (c) 2019-2026 The Pybricks Authors
 
 #define PBDRV_CONFIG_BATTERY                                (1)
 #define PBDRV_CONFIG_BATTERY_TEST                           (1)
 
+#define PBDRV_CONFIG_BLOCK_DEVICE                           (1)
+#define PBDRV_CONFIG_BLOCK_DEVICE_TEST                      (1)
+#define PBDRV_CONFIG_BLOCK_DEVICE_JOURNAL_NUM_SECTORS       (2)
+#define PBDRV_CONFIG_BLOCK_DEVICE_JOURNAL_SECTOR_SIZE       (1024)
+
 #define PBDRV_CONFIG_BUTTON                                 (1)
 #define PBDRV_CONFIG_BUTTON_TEST                            (1)
 
@@ -23,6 +28,12 @@
 #define PBDRV_CONFIG_GPIO                                   (1)
 #define PBDRV_CONFIG_GPIO_VIRTUAL                           (1)
 
+#define PBDRV_CONFIG_I2C                                    (1)
+#define PBDRV_CONFIG_I2C_TEST                               (1)
+
+#define PBDRV_CONFIG_IMU                                    (1)
+#define PBDRV_CONFIG_IMU_VIRTUAL_SIMULATION                 (1)
+
 #define PBDRV_CONFIG_IOPORT                                 (1)
 #define PBDRV_CONFIG_IOPORT_NUM_DEV                         (6)
 
@@ -37,6 +48,7 @@
 #define PBDRV_CONFIG_MOTOR_DRIVER                           (1)
 #define PBDRV_CONFIG_MOTOR_DRIVER_NUM_DEV                   (6)
 #define PBDRV_CONFIG_MOTOR_DRIVER_VIRTUAL_SIMULATION        (1)
+#define PBDRV_CONFIG_MOTOR_DRIVER_VIRTUAL_SIMULATION_CHASSIS (1)
 
 #define PBDRV_CONFIG_PWM                                    (1)
 #define PBDRV_CONFIG_PWM_NUM_DEV                            (1)
@@ -4,7 +4,10 @@
 #define PBIO_CONFIG_DCMOTOR_NUM_DEV         (6)
 #define PBIO_CONFIG_DRIVEBASE_SPIKE         (0)
 #define PBIO_CONFIG_IMAGE                   (1)
-#define PBIO_CONFIG_IMU                     (0)
+// Enabled so drive base tests can use the gyro. The simulated chassis feeds
+// the IMU driver with the ground truth rotation of the robot.
+#define PBIO_CONFIG_IMU                     (1)
+#define PBIO_CONFIG_IMU_RECORD_NUM_SAMPLES  (64)
 #define PBIO_CONFIG_LIGHT                   (1)
 #define PBIO_CONFIG_LOGGER                  (1)
 #define PBIO_CONFIG_LIGHT_MATRIX            (1)
@@ -16,12 +19,16 @@
 #define PBIO_CONFIG_PORT_DCM_PUP            (0)
 #define PBIO_CONFIG_PORT_DCM_EV3            (0)
 #define PBIO_CONFIG_PORT_DCM_NUM_DEV        (0)
+#define PBIO_CONFIG_PORT_I2C_POLL_SIZE      (32)
 #define PBIO_CONFIG_PORT_LUMP               (1)
 #define PBIO_CONFIG_PORT_LUMP_MODE_INFO     (1)
 #define PBIO_CONFIG_PORT_LUMP_NUM_DEV       (1)
+#define PBIO_CONFIG_SAMPLER_NUM_DEV         (2)
+#define PBIO_CONFIG_SAMPLER_BUF_SIZE        (256)
 #define PBIO_CONFIG_SERVO                   (1)
 #define PBIO_CONFIG_SERVO_NUM_DEV           (6)
 #define PBIO_CONFIG_SERVO_EV3_NXT           (1)
 #define PBIO_CONFIG_SERVO_PUP               (1)
 #define PBIO_CONFIG_SERVO_PUP_MOVE_HUB      (1)
 #define PBIO_CONFIG_TACHO                   (1)
+#define PBIO_CONFIG_TRIGGER_NUM_DEV         (4)
@@ -1,5 +1,5 @@
 // SPDX-License-Identifier: MIT
-// Copyright (c) 2020-2023 The Pybricks Authors
+// Copyright (c) 2020-2026 The Pybricks Authors
 
 #define PBSYS_CONFIG_FEATURE_BUILTIN_USER_PROGRAM_REPL             (0)
 #define PBSYS_CONFIG_FEATURE_BUILTIN_USER_PROGRAM_PORT_VIEW        (0)
@@ -14,6 +14,9 @@
 #define PBSYS_CONFIG_HUB_LIGHT_MATRIX               (0)
 #define PBSYS_CONFIG_MAIN                           (0)
 #define PBSYS_CONFIG_STORAGE                        (0)
+#define PBSYS_CONFIG_STORAGE_NUM_SLOTS              (1)
+#define PBSYS_CONFIG_STORAGE_USER_DATA_SIZE         (4)
+#define PBSYS_CONFIG_STORAGE_KV_SIZE                (256)
 #define PBSYS_CONFIG_STATUS_LIGHT                   (1)
 #define PBSYS_CONFIG_USER_PROGRAM                   (0)
 #define PBSYS_CONFIG_PROGRAM_STOP                   (0)
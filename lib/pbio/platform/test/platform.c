@@ -1,5 +1,5 @@
 // SPDX-License-Identifier: MIT
-// Copyright (c) 2023 The Pybricks Authors
+// Copyright (c) 2023-2026 The Pybricks Authors
 
 #include <pbdrv/ioport.h>
 #include <pbio/port_interface.h>
@@ -12,6 +12,9 @@ const pbdrv_gpio_t pbdrv_ioport_platform_data_vcc_pin = {
     .pin = 0,
 };
 
+// The GPIO driver is virtual, so the pins need no configuration.
+static const pbdrv_ioport_pins_t port_d_pins;
+
 const pbdrv_ioport_platform_data_t pbdrv_ioport_platform_data[PBDRV_CONFIG_IOPORT_NUM_DEV] = {
     {
         .port_id = PBIO_PORT_ID_A,
@@ -48,10 +51,10 @@ const pbdrv_ioport_platform_data_t pbdrv_ioport_platform_data[PBDRV_CONFIG_IOPOR
         .motor_driver_index = 3,
         .external_port_index = 0,
         .counter_driver_index = PBDRV_IOPORT_INDEX_NOT_AVAILABLE,
-        .i2c_driver_index = PBDRV_IOPORT_INDEX_NOT_AVAILABLE,
+        .i2c_driver_index = 0,
         .uart_driver_index = 0,
-        .pins = NULL,
-        .supported_modes = PBIO_PORT_MODE_LEGO_DCM | PBIO_PORT_MODE_UART,
+        .pins = &port_d_pins,
+        .supported_modes = PBIO_PORT_MODE_LEGO_DCM | PBIO_PORT_MODE_UART | PBIO_PORT_MODE_I2C,
     },
     {
         .port_id = PBIO_PORT_ID_E,
@@ -130,6 +133,23 @@ const pbdrv_motor_driver_virtual_simulation_platform_data_t
     },
 };
 
+// Motors A and B can drive a small differential drive robot. Tests that use
+// it must enable it, so the motors spin freely by default.
+const pbdrv_motor_driver_virtual_simulation_chassis_platform_data_t
+    pbdrv_motor_driver_virtual_simulation_chassis_platform_data = {
+    .enabled = false,
+    .left_index = 0,
+    .right_index = 1,
+    .left_direction = -1,
+    .right_direction = 1,
+    .wheel_diameter = 56,
+    .axle_track = 112,
+    .wheel_stiffness = 50,
+    .wheel_damping = 2,
+    .d_forward_speed_d_torque = 0.05,
+    .d_turn_speed_d_torque = 0.1,
+};
+
 const pbdrv_led_array_pwm_platform_data_t pbdrv_led_array_pwm_platform_data[PBDRV_CONFIG_LED_ARRAY_PWM_NUM_DEV] = {
     {
         .pwm_chs = (const uint8_t[]) {
@@ -0,0 +1,86 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2026 The Pybricks Authors
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <pbio/color.h>
+#include <pbio/error.h>
+#include <pbio/int_math.h>
+
+/**
+ * Resets calibration to the given references, without color correction.
+ *
+ * @param [out] cal      The calibration to reset.
+ * @param [in]  black    Raw RGB readings of a black surface.
+ * @param [in]  white    Raw RGB readings of a white surface.
+ */
+void pbio_color_calibration_reset(pbio_color_calibration_t *cal, const int16_t *black, const int16_t *white) {
+    for (size_t i = 0; i < 3; i++) {
+        cal->black[i] = black[i];
+        cal->white[i] = white[i];
+    }
+    for (size_t i = 0; i < 9; i++) {
+        cal->matrix[i] = i % 4 == 0 ? PBIO_COLOR_CALIBRATION_SCALE : 0;
+    }
+}
+
+/**
+ * Sets the calibration. Nothing is changed if the references are not valid.
+ *
+ * @param [out] cal      The calibration to set.
+ * @param [in]  black    Raw RGB readings of a black surface.
+ * @param [in]  white    Raw RGB readings of a white surface.
+ * @param [in]  matrix   Color correction matrix in row major order, scaled
+ *                       by ::PBIO_COLOR_CALIBRATION_SCALE.
+ * @return               ::PBIO_SUCCESS on success or ::PBIO_ERROR_INVALID_ARG
+ *                       if white is not brighter than black for all channels.
+ */
+pbio_error_t pbio_color_calibration_set(pbio_color_calibration_t *cal, const int16_t *black, const int16_t *white, const int16_t *matrix) {
+    for (size_t i = 0; i < 3; i++) {
+        if (white[i] <= black[i]) {
+            return PBIO_ERROR_INVALID_ARG;
+        }
+    }
+    for (size_t i = 0; i < 3; i++) {
+        cal->black[i] = black[i];
+        cal->white[i] = white[i];
+    }
+    for (size_t i = 0; i < 9; i++) {
+        cal->matrix[i] = matrix[i];
+    }
+    return PBIO_SUCCESS;
+}
+
+/**
+ * Gets calibrated HSV from raw RGB readings.
+ *
+ * @param [in]  cal      The calibration.
+ * @param [in]  raw      Raw RGB readings.
+ * @param [out] hsv      The calibrated color.
+ */
+void pbio_color_calibration_get_hsv(const pbio_color_calibration_t *cal, const int16_t *raw, pbio_color_hsv_t *hsv) {
+
+    // Scale each channel so that black is 0 and white is full scale. Allow
+    // some headroom above white for the color correction, but bound it so
+    // the products below can't overflow.
+    int32_t scaled[3];
+    for (size_t i = 0; i < 3; i++) {
+        scaled[i] = (raw[i] - cal->black[i]) * PBIO_COLOR_CALIBRATION_SCALE / (cal->white[i] - cal->black[i]);
+        scaled[i] = pbio_int_math_bind(scaled[i], 0, 2 * PBIO_COLOR_CALIBRATION_SCALE);
+    }
+
+    // Apply color correction and scale to the range of pbio_color_rgb_t.
+    uint8_t rgb[3];
+    for (size_t i = 0; i < 3; i++) {
+        const int16_t *row = &cal->matrix[i * 3];
+        int32_t value = (row[0] * scaled[0] + row[1] * scaled[1] + row[2] * scaled[2]) / PBIO_COLOR_CALIBRATION_SCALE;
+        rgb[i] = pbio_int_math_bind(value, 0, PBIO_COLOR_CALIBRATION_SCALE) * 255 / PBIO_COLOR_CALIBRATION_SCALE;
+    }
+    const pbio_color_rgb_t calibrated = {
+        .r = rgb[0],
+        .g = rgb[1],
+        .b = rgb[2],
+    };
+    pbio_color_rgb_to_hsv(&calibrated, hsv);
+}
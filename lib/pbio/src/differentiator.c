@@ -1,5 +1,5 @@
 // SPDX-License-Identifier: MIT
-// Copyright (c) 2022-2023 The Pybricks Authors
+// Copyright (c) 2022-2026 The Pybricks Authors
 
 // SPDX-License-Identifier: BSD-3-Clause
 // Copyright (c) 2022-2023 LEGO System A/S
@@ -15,26 +15,63 @@
 #include <pbio/util.h>
 
 /**
- * Internal function to get the speed with a variable window size. Window
- * size must be validated externally for this function to be used safely.
+ * Gets the ring buffer index of a sample some number of samples ago.
  *
  * @param [in]  dif            The differentiator instance.
- * @param [in]  window_size    Window size in number of samples (Must be > 0 and <= buffer size!).
- * @param [out] speed          Average speed across given time window in mdeg/s.
+ * @param [in]  age            Number of samples ago (Must be < buffer size!).
+ * @return                     Index of the requested sample.
+ */
+static uint8_t pbio_differentiator_get_index(pbio_differentiator_t *dif, uint8_t age) {
+    return (dif->index + PBIO_ARRAY_SIZE(dif->history) - age) % PBIO_ARRAY_SIZE(dif->history);
+}
+
+/**
+ * Internal function to get the average speed with a variable window size.
+ * Window size must be validated externally for this function to be used safely.
+ *
+ * @param [in]  dif            The differentiator instance.
+ * @param [in]  window_size    Window size in number of samples (Must be > 0 and < buffer size!).
+ * @return                     Average speed across given time window in mdeg/s.
  */
 static int32_t pbio_differentiator_calc_speed(pbio_differentiator_t *dif, uint8_t window_size) {
 
-    // Sum differences including start and endpoint.
-    uint8_t start_index = (dif->index - (window_size - 1) + PBIO_ARRAY_SIZE(dif->history)) % PBIO_ARRAY_SIZE(dif->history);
-    int32_t total = dif->history[dif->index];
-    for (uint8_t i = start_index; i != dif->index; i = (i + 1) % PBIO_ARRAY_SIZE(dif->history)) {
-        total += dif->history[i];
-    }
+    // The running sums wrap around, but their difference is the sum of all
+    // increments across the window, which always fits.
+    int32_t total = (int32_t)(dif->history[dif->index] - dif->history[pbio_differentiator_get_index(dif, window_size)]);
 
     // Each sample has units of mdeg, so take average and convert to mdeg/s.
     return total * (1000 / PBIO_CONFIG_CONTROL_LOOP_TIME_MS) / window_size;
 }
 
+/**
+ * Internal function to get the speed as the slope of the least squares line
+ * fit through the positions in the window. Window size must be validated
+ * externally for this function to be used safely.
+ *
+ * Unlike the average speed, this visits each sample in the window. It is
+ * only used on demand, not in the control loop.
+ *
+ * @param [in]  dif            The differentiator instance.
+ * @param [in]  window_size    Window size in number of samples (Must be > 0 and < buffer size!).
+ * @return                     Fitted speed across given time window in mdeg/s.
+ */
+static int32_t pbio_differentiator_calc_speed_regression(pbio_differentiator_t *dif, uint8_t window_size) {
+
+    // For n = window_size + 1 evenly spaced positions x_k, the slope is
+    // sum((k - (n - 1) / 2) * x_k) / sum((k - (n - 1) / 2)^2). Positions are
+    // taken relative to the newest sample so they fit without wrapping.
+    int64_t total = 0;
+    for (uint8_t age = 1; age <= window_size; age++) {
+        int32_t position = (int32_t)(dif->history[pbio_differentiator_get_index(dif, age)] - dif->history[dif->index]);
+        total += (int64_t)(window_size - 2 * age) * position;
+    }
+
+    // Denominator is n * (n^2 - 1) / 12, with the factor 2 from the weights
+    // above cancelled out. Then convert mdeg per sample to mdeg/s.
+    int64_t n = window_size + 1;
+    return total * 6 * (1000 / PBIO_CONFIG_CONTROL_LOOP_TIME_MS) / (n * (n * n - 1));
+}
+
 /**
  * Updates the angle buffer and calculates the average speed across buffer.
  *
@@ -44,13 +81,15 @@ static int32_t pbio_differentiator_calc_speed(pbio_differentiator_t *dif, uint8_
  */
 int32_t pbio_differentiator_update_and_get_speed(pbio_differentiator_t *dif, const pbio_angle_t *angle) {
 
-    // Increment index where latest difference will be stored.
+    // Increment index where latest running sum will be stored.
+    uint32_t total = dif->history[dif->index];
     dif->index = (dif->index + 1) % PBIO_ARRAY_SIZE(dif->history);
 
-    // The difference is stored in millidegrees. Even at 6000 deg/s (well
-    // above the physical limits of the motors we use), this at most
-    // 6000 * 1000 * 0.005 = 30000, which fits in a 16-bit signed integer.
-    dif->history[dif->index] = pbio_int_math_clamp(pbio_angle_diff_mdeg(angle, &dif->prev_angle), INT16_MAX);
+    // The difference is in millidegrees. Even at 6000 deg/s (well above the
+    // physical limits of the motors we use), this at most
+    // 6000 * 1000 * 0.005 = 30000, so it is clamped to 16 bits to ensure that
+    // the sum across the whole buffer always fits.
+    dif->history[dif->index] = total + pbio_int_math_clamp(pbio_angle_diff_mdeg(angle, &dif->prev_angle), INT16_MAX);
     dif->prev_angle = *angle;
 
     // Calculate the speed.
@@ -63,20 +102,29 @@ int32_t pbio_differentiator_update_and_get_speed(pbio_differentiator_t *dif, con
  *
  * @param [in]  dif            The differentiator instance.
  * @param [in]  window         Window size in milliseconds.
- * @param [out] speed          Average speed across given time window.
+ * @param [in]  mode           Speed estimation method.
+ * @param [out] speed          Speed across given time window.
  * @return                     ::PBIO_SUCCESS if successful, ::PBIO_ERROR_INVALID_ARG if window is 0 or bigger than the buffer size.
  */
-pbio_error_t pbio_differentiator_get_speed(pbio_differentiator_t *dif, uint32_t window, int32_t *speed) {
+pbio_error_t pbio_differentiator_get_speed(pbio_differentiator_t *dif, uint32_t window, pbio_differentiator_mode_t mode, int32_t *speed) {
 
     // Round window to nearest sample size.
-    uint8_t window_size = (window + PBIO_CONFIG_CONTROL_LOOP_TIME_MS / 2) / PBIO_CONFIG_CONTROL_LOOP_TIME_MS;
+    uint32_t window_size = (window + PBIO_CONFIG_CONTROL_LOOP_TIME_MS / 2) / PBIO_CONFIG_CONTROL_LOOP_TIME_MS;
     if (window_size == 0 || window_size > PBIO_ARRAY_SIZE(dif->history) - 1) {
         return PBIO_ERROR_INVALID_ARG;
     }
 
-    // Speed is determined as position delta across the given window.
-    *speed = pbio_differentiator_calc_speed(dif, window_size);
-    return PBIO_SUCCESS;
+    switch (mode) {
+        case PBIO_DIFFERENTIATOR_MODE_AVERAGE:
+            // Speed is determined as position delta across the given window.
+            *speed = pbio_differentiator_calc_speed(dif, window_size);
+            return PBIO_SUCCESS;
+        case PBIO_DIFFERENTIATOR_MODE_REGRESSION:
+            *speed = pbio_differentiator_calc_speed_regression(dif, window_size);
+            return PBIO_SUCCESS;
+        default:
+            return PBIO_ERROR_INVALID_ARG;
+    }
 }
 
 /**
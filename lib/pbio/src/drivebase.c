@@ -1,5 +1,5 @@
 // SPDX-License-Identifier: MIT
-// Copyright (c) 2018-2023 The Pybricks Authors
+// Copyright (c) 2018-2026 The Pybricks Authors
 
 // SPDX-License-Identifier: BSD-3-Clause
 // Copyright (c) 2020-2023 LEGO System A/S
@@ -12,6 +12,7 @@
 #include <pbio/int_math.h>
 #include <pbio/imu.h>
 #include <pbio/servo.h>
+#include <pbio/trigger.h>
 
 #if PBIO_CONFIG_NUM_DRIVEBASES > 0
 
@@ -190,6 +191,81 @@ static pbio_error_t pbio_drivebase_get_state_control(pbio_drivebase_t *db, pbio_
     return PBIO_SUCCESS;
 }
 
+/**
+ * Gets the pose heading that goes with a heading state.
+ *
+ * @param [in]  db              The drivebase instance
+ * @param [in]  heading         Heading in heading control steps.
+ * @return                      Pose heading in millidegrees.
+ */
+static int64_t pbio_drivebase_get_pose_heading(pbio_drivebase_t *db, const pbio_angle_t *heading) {
+    int64_t heading_steps = (int64_t)heading->rotations * 360000 + heading->millidegrees;
+    return heading_steps * 1000 / db->control_heading.settings.ctl_steps_per_app_step + db->pose_heading_offset;
+}
+
+/**
+ * Starts pose integration from the current state, so that future updates
+ * only add the motion from here on. This must be called whenever the
+ * reported distance or heading jumps, such as after a reset.
+ *
+ * The pose heading is unaffected by the jump, so the pose continues from
+ * where it was.
+ *
+ * @param [in]  db              The drivebase instance
+ * @return                      Error code.
+ */
+static pbio_error_t pbio_drivebase_sync_pose(pbio_drivebase_t *db) {
+    pbio_control_state_t state_distance;
+    pbio_control_state_t state_heading;
+    pbio_error_t err = pbio_drivebase_get_state_control(db, &state_distance, &state_heading);
+    if (err != PBIO_SUCCESS) {
+        return err;
+    }
+
+    // Pose heading before the jump, which is kept.
+    int64_t pose_heading = pbio_drivebase_get_pose_heading(db, &db->pose_heading_prev);
+
+    db->pose_heading_offset = 0;
+    db->pose_heading_offset = pose_heading - pbio_drivebase_get_pose_heading(db, &state_heading.position);
+    db->pose_distance_prev = state_distance.position;
+    db->pose_heading_prev = state_heading.position;
+    return PBIO_SUCCESS;
+}
+
+/**
+ * Integrates the x and y position of the drivebase from the distance traveled
+ * since the previous update and the average heading during that time.
+ *
+ * @param [in]  db              The drivebase instance
+ * @param [in]  state_distance  Current distance state.
+ * @param [in]  state_heading   Current heading state, from the gyro if used.
+ */
+static void pbio_drivebase_update_pose(pbio_drivebase_t *db, const pbio_control_state_t *state_distance, const pbio_control_state_t *state_heading) {
+
+    // Distance traveled since the previous update.
+    int32_t delta = pbio_angle_diff_mdeg(&state_distance->position, &db->pose_distance_prev);
+
+    // Turning in place does not change the position, so skip the heading
+    // conversion, which is the costly part of this update.
+    if (delta == 0) {
+        db->pose_heading_prev = state_heading->position;
+        return;
+    }
+
+    // Heading halfway through this update. Only the angle within one
+    // rotation matters, so overflowing rotations are harmless.
+    pbio_angle_t heading_mid;
+    pbio_angle_avg(&db->pose_heading_prev, &state_heading->position, &heading_mid);
+    int32_t heading = pbio_drivebase_get_pose_heading(db, &heading_mid) % 360000;
+
+    // Heading is clockwise positive, so turning right moves towards -y.
+    db->pose_x += (int64_t)delta * pbio_int_math_cos_mdeg(heading);
+    db->pose_y -= (int64_t)delta * pbio_int_math_sin_mdeg(heading);
+
+    db->pose_distance_prev = state_distance->position;
+    db->pose_heading_prev = state_heading->position;
+}
+
 /**
  * Stop the drivebase from updating its controllers.
  *
@@ -361,12 +437,17 @@ pbio_error_t pbio_drivebase_get_drivebase(pbio_drivebase_t **db_address, pbio_se
         return PBIO_ERROR_INVALID_ARG;
     }
 
+    // By default, don't use gyro for steering control.
+    db->gyro_heading_type = PBIO_IMU_HEADING_TYPE_NONE;
+
     // Reset offsets so current distance and angle are 0. This relies on the
     // geometry, so it is done after the scaling is set.
     pbio_drivebase_reset(db, 0, 0);
 
-    // By default, don't use gyro for steering control.
-    db->gyro_heading_type = PBIO_IMU_HEADING_TYPE_NONE;
+    // Start at the origin of the pose.
+    db->pose_x = 0;
+    db->pose_y = 0;
+    db->pose_heading_offset = 0;
 
     return PBIO_SUCCESS;
 }
@@ -395,7 +476,9 @@ pbio_error_t pbio_drivebase_set_use_gyro(pbio_drivebase_t *db, pbio_imu_heading_
     }
 
     db->gyro_heading_type = heading_type;
-    return PBIO_SUCCESS;
+
+    // The heading source changed, so continue the pose from here.
+    return pbio_drivebase_sync_pose(db);
 }
 
 /**
@@ -417,6 +500,9 @@ pbio_error_t pbio_drivebase_stop(pbio_drivebase_t *db, pbio_control_on_completio
         return PBIO_ERROR_INVALID_ARG;
     }
 
+    // The ongoing maneuver ends, so its stop trigger no longer applies.
+    db->stop_trigger = NULL;
+
     // Holding is the same as traveling by 0 degrees.
     if (on_completion == PBIO_CONTROL_ON_COMPLETION_HOLD) {
         return pbio_drivebase_drive_straight(db, 0, on_completion);
@@ -446,21 +532,14 @@ bool pbio_drivebase_is_done(const pbio_drivebase_t *db) {
 /**
  * Updates one drivebase in the control loop.
  *
- * This reads the physical and estimated state, and updates the controller if
- * it is active.
+ * This reads the physical and estimated state, updates the pose, and updates
+ * the controller if it is active.
  *
  * @param [in]  db          The drivebase instance
+ * @param [in]  time_now    Time of this control loop iteration.
  * @return                  Error code.
  */
-static pbio_error_t pbio_drivebase_update(pbio_drivebase_t *db) {
-
-    // If passive, no need to update.
-    if (!pbio_drivebase_control_is_active(db)) {
-        return PBIO_SUCCESS;
-    }
-
-    // Get current time
-    uint32_t time_now = pbio_control_get_time_ticks();
+static pbio_error_t pbio_drivebase_update(pbio_drivebase_t *db, uint32_t time_now) {
 
     // Get drive base state
     pbio_control_state_t state_distance;
@@ -470,6 +549,15 @@ static pbio_error_t pbio_drivebase_update(pbio_drivebase_t *db) {
         return err;
     }
 
+    // The pose is updated even when passive, so it keeps track of the robot
+    // being moved by hand or by a motor that is controlled individually.
+    pbio_drivebase_update_pose(db, &state_distance, &state_heading);
+
+    // If passive, no need to update controllers.
+    if (!pbio_drivebase_control_is_active(db)) {
+        return PBIO_SUCCESS;
+    }
+
     // Get reference and torque signals for distance control.
     pbio_trajectory_reference_t ref_distance;
     int32_t distance_torque;
@@ -524,10 +612,85 @@ static pbio_error_t pbio_drivebase_update(pbio_drivebase_t *db) {
         distance_torque - heading_torque + feed_forward_right);
 }
 
+/**
+ * Ends the ongoing maneuver early if its stop trigger fired.
+ *
+ * @param [in]  db          The drivebase instance.
+ */
+static void pbio_drivebase_check_stop_trigger(pbio_drivebase_t *db) {
+
+    // Nothing to do if there is no trigger or the maneuver already ended.
+    if (!db->stop_trigger || !pbio_drivebase_control_is_active(db)) {
+        db->stop_trigger = NULL;
+        return;
+    }
+
+    // Check the most recent sensor value right now instead of waiting for
+    // the sensor to report new data.
+    pbio_trigger_update(db->stop_trigger);
+
+    int32_t value;
+    uint32_t time;
+    pbio_error_t err = pbio_trigger_get_result(db->stop_trigger, &value, &time);
+    if (err == PBIO_ERROR_AGAIN) {
+        return;
+    }
+    db->stop_trigger = NULL;
+
+    // If the trigger was canceled, let the maneuver complete normally.
+    // Otherwise it fired or the sensor failed, so stop here.
+    if (err != PBIO_ERROR_CANCELED) {
+        pbio_drivebase_stop(db, db->stop_trigger_on_completion);
+    }
+}
+
+/**
+ * Ends the ongoing maneuver early when the given trigger fires.
+ *
+ * This must be called right after starting the maneuver. The trigger is
+ * checked on every control loop iteration, and it is cleared when the
+ * maneuver completes, when a new one starts, or when the trigger is stopped.
+ *
+ * @param [in]  db             The drivebase instance.
+ * @param [in]  trigger        The trigger, or NULL to clear it.
+ * @param [in]  on_completion  How to stop when the trigger fires. Continue
+ *                             is treated as hold, since the maneuver stops.
+ * @return                     ::PBIO_SUCCESS on success.
+ *                             ::PBIO_ERROR_INVALID_OP if the trigger is no
+ *                             longer waiting for its condition.
+ */
+pbio_error_t pbio_drivebase_set_stop_trigger(pbio_drivebase_t *db, struct _pbio_trigger_t *trigger, pbio_control_on_completion_t on_completion) {
+    int32_t value;
+    uint32_t time;
+    if (trigger && pbio_trigger_get_result(trigger, &value, &time) != PBIO_ERROR_AGAIN) {
+        return PBIO_ERROR_INVALID_OP;
+    }
+    db->stop_trigger = trigger;
+    db->stop_trigger_on_completion = on_completion == PBIO_CONTROL_ON_COMPLETION_CONTINUE ?
+        PBIO_CONTROL_ON_COMPLETION_HOLD : on_completion;
+    return PBIO_SUCCESS;
+}
+
+/**
+ * Clears the given trigger from all drivebases, so the maneuvers that used it
+ * continue normally. Called when the trigger is released.
+ *
+ * @param [in]  trigger        The trigger.
+ */
+void pbio_drivebase_clear_stop_trigger(struct _pbio_trigger_t *trigger) {
+    for (uint8_t i = 0; i < PBIO_CONFIG_NUM_DRIVEBASES; i++) {
+        if (drivebases[i].stop_trigger == trigger) {
+            drivebases[i].stop_trigger = NULL;
+        }
+    }
+}
+
 /**
  * Updates all currently active (previously set up) drivebases.
+ *
+ * @param [in]  time_now    Time of this control loop iteration.
  */
-void pbio_drivebase_update_all(void) {
+void pbio_drivebase_update_all(uint32_t time_now) {
     // Go through all drive base candidates
     for (uint8_t i = 0; i < PBIO_CONFIG_NUM_DRIVEBASES; i++) {
 
@@ -535,7 +698,8 @@ void pbio_drivebase_update_all(void) {
 
         // If it's registered for updates, run its update loop
         if (pbio_drivebase_update_loop_is_running(db)) {
-            pbio_drivebase_update(db);
+            pbio_drivebase_check_stop_trigger(db);
+            pbio_drivebase_update(db, time_now);
         }
     }
 }
@@ -561,6 +725,9 @@ static pbio_error_t pbio_drivebase_drive_relative(pbio_drivebase_t *db, int32_t
     // Stop servo control in case it was running.
     pbio_drivebase_stop_servo_control(db);
 
+    // A new maneuver starts, so the previous stop trigger no longer applies.
+    db->stop_trigger = NULL;
+
     // Get current time
     uint32_t time_now = pbio_control_get_time_ticks();
 
@@ -672,6 +839,9 @@ pbio_error_t pbio_drivebase_drive_turn(pbio_drivebase_t *db, int32_t angle, bool
     // Stop servo control in case it was running.
     pbio_drivebase_stop_servo_control(db);
 
+    // A new maneuver starts, so the previous stop trigger no longer applies.
+    db->stop_trigger = NULL;
+
     // Get current time
     uint32_t time_now = pbio_control_get_time_ticks();
 
@@ -805,6 +975,9 @@ static pbio_error_t pbio_drivebase_drive_time_common(pbio_drivebase_t *db, int32
     // Stop servo control in case it was running.
     pbio_drivebase_stop_servo_control(db);
 
+    // A new maneuver starts, so the previous stop trigger no longer applies.
+    db->stop_trigger = NULL;
+
     // Get current time
     uint32_t time_now = pbio_control_get_time_ticks();
 
@@ -932,6 +1105,62 @@ pbio_error_t pbio_drivebase_reset(pbio_drivebase_t *db, int32_t distance, int32_
         pbio_imu_set_heading(angle);
     }
 
+    // Distance and heading have jumped, so continue the pose from here.
+    return pbio_drivebase_sync_pose(db);
+}
+
+/**
+ * Gets the position of the drivebase, integrated from the distance traveled
+ * and the heading since the pose was reset.
+ *
+ * The pose heading follows the drivebase angle, which comes from the gyro if
+ * it is used for heading control, but starts from the heading given to
+ * ::pbio_drivebase_reset_pose.
+ *
+ * @param [in]  db          The drivebase instance.
+ * @param [out] x           Position in mm along the initial forward direction.
+ * @param [out] y           Position in mm along the initial left direction.
+ * @param [out] heading     Angle in degrees with respect to the x axis.
+ * @return                  Error code.
+ */
+pbio_error_t pbio_drivebase_get_pose(pbio_drivebase_t *db, int32_t *x, int32_t *y, int32_t *heading) {
+
+    if (!pbio_drivebase_update_loop_is_running(db)) {
+        return PBIO_ERROR_NO_DEV;
+    }
+
+    int64_t steps_per_mm = (int64_t)db->control_distance.settings.ctl_steps_per_app_step * 10000;
+    *x = db->pose_x / steps_per_mm;
+    *y = db->pose_y / steps_per_mm;
+    *heading = pbio_drivebase_get_pose_heading(db, &db->pose_heading_prev) / 1000;
+    return PBIO_SUCCESS;
+}
+
+/**
+ * Resets the pose without affecting the ongoing maneuver.
+ *
+ * The drivebase distance and angle are not changed. The x and y axes are
+ * defined by the given heading.
+ *
+ * @param [in]  db          The drivebase instance.
+ * @param [in]  x           Position in mm along the x axis.
+ * @param [in]  y           Position in mm along the y axis.
+ * @param [in]  heading     Angle in degrees with respect to the x axis.
+ * @return                  Error code.
+ */
+pbio_error_t pbio_drivebase_reset_pose(pbio_drivebase_t *db, int32_t x, int32_t y, int32_t heading) {
+
+    if (!pbio_drivebase_update_loop_is_running(db)) {
+        return PBIO_ERROR_NO_DEV;
+    }
+
+    // Keep the drivebase angle, but make the pose heading start from here.
+    int64_t heading_now = pbio_drivebase_get_pose_heading(db, &db->pose_heading_prev) - db->pose_heading_offset;
+    db->pose_heading_offset = (int64_t)heading * 1000 - heading_now;
+
+    int64_t steps_per_mm = (int64_t)db->control_distance.settings.ctl_steps_per_app_step * 10000;
+    db->pose_x = x * steps_per_mm;
+    db->pose_y = y * steps_per_mm;
     return PBIO_SUCCESS;
 }
 
@@ -1,5 +1,5 @@
 // SPDX-License-Identifier: MIT
-// Copyright (c) 2022-2023 The Pybricks Authors
+// Copyright (c) 2022-2026 The Pybricks Authors
 
 #include <stdbool.h>
 #include <string.h>
@@ -126,6 +126,50 @@ static pbio_geometry_matrix_3x3_t pbio_imu_rotation = {
     .m31 = 0.0f, .m32 = 0.0f, .m33 = 1.0f,
 };
 
+#if PBIO_CONFIG_IMU_RECORD_NUM_SAMPLES
+
+/**
+ * Ring buffer of raw samples recorded while recording is active.
+ */
+static pbio_imu_sample_t record_samples[PBIO_CONFIG_IMU_RECORD_NUM_SAMPLES];
+
+/**
+ * Total number of samples written to the ring buffer since recording started.
+ */
+static uint32_t record_num_written;
+
+/**
+ * Total number of samples read from the ring buffer since recording started.
+ */
+static uint32_t record_num_read;
+
+/**
+ * Whether new samples are added to the ring buffer.
+ */
+static bool record_active;
+
+/**
+ * Adds one frame of raw data to the ring buffer, if there is room for it.
+ *
+ * If the buffer is full, the new sample is dropped. The application can
+ * detect this as a gap in the sample times.
+ *
+ * @param [in]  data        Unscaled gyro (xyz) and acceleration (xyz) samples.
+ * @param [in]  time        Time at which the sample was taken (us).
+ */
+static void pbio_imu_record_add(const int16_t *data, uint32_t time) {
+    if (record_num_written - record_num_read >= PBIO_CONFIG_IMU_RECORD_NUM_SAMPLES) {
+        return;
+    }
+    pbio_imu_sample_t *sample = &record_samples[record_num_written % PBIO_CONFIG_IMU_RECORD_NUM_SAMPLES];
+    sample->time = time;
+    memcpy(sample->angular_velocity, &data[0], sizeof(sample->angular_velocity));
+    memcpy(sample->acceleration, &data[3], sizeof(sample->acceleration));
+    record_num_written++;
+}
+
+#endif // PBIO_CONFIG_IMU_RECORD_NUM_SAMPLES
+
 
 /**
  * The "neutral" base orientation of the hub, describing how it is mounted
@@ -250,8 +294,14 @@ static void update_heading_projection(void) {
     pbio_geometry_xyz_t x_inertial;
     pbio_geometry_vector_map(&pbio_imu_rotation, &x_application, &x_inertial);
 
-    // Project onto the horizontal plane and use atan2 to get the angle.
-    float heading_now = pbio_geometry_radians_to_degrees(atan2f(-x_inertial.y, x_inertial.x));
+    // Project onto the horizontal plane and use atan2 to get the angle. The
+    // components are at most 1, so scale them up to use integer atan2, which
+    // is much faster than atan2f on hubs without a floating point unit. With
+    // a scale of 2**24, there is plenty of headroom below INT32_MAX for
+    // rounding errors. The result is accurate to about 0.003 degrees as long
+    // as the projection is at least 2**-8 long, which means the x-axis is
+    // tilted less than about 89.8 degrees. See test_atan2_unit_vector.
+    float heading_now = pbio_int_math_atan2_mdeg(-x_inertial.y * (1 << 24), x_inertial.x * (1 << 24)) * 0.001f;
 
     // Update full rotation counter if the projection jumps across the 180/-180 boundary.
     if (heading_now < -90 && heading_projection > 90) {
@@ -262,8 +312,25 @@ static void update_heading_projection(void) {
     heading_projection = heading_now;
 }
 
-// Called by driver to process one frame of unfiltered gyro and accelerometer data.
-static void pbio_imu_handle_frame_data_func(int16_t *data) {
+/**
+ * Calibration factors that are the same for every frame in a batch.
+ */
+typedef struct {
+    /** Accelerometer offset to subtract (mm/s^2). */
+    pbio_geometry_xyz_t acceleration_offset;
+    /** Accelerometer scale to multiply by after subtracting the offset. */
+    pbio_geometry_xyz_t acceleration_scale;
+    /** Gyro scale to multiply by after subtracting the bias. */
+    pbio_geometry_xyz_t angular_velocity_scale;
+} pbio_imu_frame_calibration_t;
+
+/**
+ * Processes one frame of unfiltered gyro and accelerometer data.
+ *
+ * @param [in]  data        Unscaled gyro (xyz) and acceleration (xyz) samples.
+ * @param [in]  cal         Calibration factors, or NULL if settings are not loaded.
+ */
+static void pbio_imu_handle_frame(const int16_t *data, const pbio_imu_frame_calibration_t *cal) {
 
     // Initialize quaternion from first gravity sample as a best-effort estimate.
     // From here, fusion will gradually converge the quaternion to the true value.
@@ -278,23 +345,18 @@ static void pbio_imu_handle_frame_data_func(int16_t *data) {
         quaternion_initialized = true;
     }
 
-    // Compute current orientation matrix to obtain the current heading.
+    // Compute current orientation matrix to obtain the gravity estimate.
     pbio_geometry_quaternion_to_rotation_matrix(&quaternion, &pbio_imu_rotation);
 
-    // Projects application x-axis into the inertial frame to compute the heading.
-    update_heading_projection();
-
     for (uint8_t i = 0; i < PBIO_ARRAY_SIZE(angular_velocity_calibrated.values); i++) {
         // Update angular velocity and acceleration cache so user can read them.
         angular_velocity_uncalibrated.values[i] = data[i] * imu_config->gyro_scale;
         acceleration_uncalibrated.values[i] = data[i + 3] * imu_config->accel_scale;
 
         // Once settings loaded, maintain calibrated cached values.
-        if (persistent_settings) {
-            float acceleration_offset = (persistent_settings->gravity_pos.values[i] + persistent_settings->gravity_neg.values[i]) / 2;
-            float acceleration_scale = (persistent_settings->gravity_pos.values[i] - persistent_settings->gravity_neg.values[i]) / 2;
-            acceleration_calibrated.values[i] = (acceleration_uncalibrated.values[i] - acceleration_offset) * standard_gravity / acceleration_scale;
-            angular_velocity_calibrated.values[i] = (angular_velocity_uncalibrated.values[i] - gyro_bias.values[i]) * 360.0f / persistent_settings->angular_velocity_scale.values[i];
+        if (cal) {
+            acceleration_calibrated.values[i] = (acceleration_uncalibrated.values[i] - cal->acceleration_offset.values[i]) * cal->acceleration_scale.values[i];
+            angular_velocity_calibrated.values[i] = (angular_velocity_uncalibrated.values[i] - gyro_bias.values[i]) * cal->angular_velocity_scale.values[i];
         } else {
             acceleration_calibrated.values[i] = acceleration_uncalibrated.values[i];
             angular_velocity_calibrated.values[i] = angular_velocity_uncalibrated.values[i];
@@ -358,6 +420,48 @@ static void pbio_imu_handle_frame_data_func(int16_t *data) {
     pbio_geometry_quaternion_normalize(&quaternion);
 }
 
+// Called by driver to process one or more frames of unfiltered gyro and accelerometer data.
+static void pbio_imu_handle_frame_data_func(int16_t *data, uint32_t num_frames) {
+
+    // The calibration is the same for all frames, so the divisions it takes
+    // to get the calibration factors are done only once per batch.
+    pbio_imu_frame_calibration_t calibration;
+    if (persistent_settings) {
+        for (uint8_t i = 0; i < PBIO_ARRAY_SIZE(calibration.acceleration_offset.values); i++) {
+            float acceleration_offset = (persistent_settings->gravity_pos.values[i] + persistent_settings->gravity_neg.values[i]) / 2;
+            float acceleration_scale = (persistent_settings->gravity_pos.values[i] - persistent_settings->gravity_neg.values[i]) / 2;
+            calibration.acceleration_offset.values[i] = acceleration_offset;
+            calibration.acceleration_scale.values[i] = standard_gravity / acceleration_scale;
+            calibration.angular_velocity_scale.values[i] = 360.0f / persistent_settings->angular_velocity_scale.values[i];
+        }
+    }
+
+    #if PBIO_CONFIG_IMU_RECORD_NUM_SAMPLES
+    // Frames were sampled one sample time apart, ending with the last one.
+    if (record_active) {
+        uint32_t time_now = pbdrv_clock_get_us();
+        uint32_t sample_time_us = imu_config->sample_time * 1000000.0f;
+        for (uint32_t f = 0; f < num_frames; f++) {
+            pbio_imu_record_add(&data[f * 6], time_now - (num_frames - 1 - f) * sample_time_us);
+        }
+    }
+    #endif
+
+    for (uint32_t f = 0; f < num_frames; f++) {
+        pbio_imu_handle_frame(&data[f * 6], persistent_settings ? &calibration : NULL);
+    }
+
+    if (!quaternion_initialized) {
+        return;
+    }
+
+    // Projects application x-axis into the inertial frame to compute the
+    // heading. This is only needed once per batch. Batches are short enough
+    // that the heading can't change by more than 180 degrees in between, so
+    // crossing the 180/-180 boundary is still detected.
+    update_heading_projection();
+}
+
 // This counter is a measure for calibration accuracy, roughly equivalent
 // to the accumulative number of seconds it has been stationary in total.
 static uint32_t stationary_counter = 0;
@@ -751,4 +855,90 @@ void pbio_orientation_imu_get_orientation(pbio_geometry_matrix_3x3_t *rotation)
     *rotation = pbio_imu_rotation;
 }
 
+#if PBIO_CONFIG_IMU_RECORD_NUM_SAMPLES
+
+/**
+ * Starts recording every raw IMU sample in the background. Any samples that
+ * were recorded earlier but not yet read are discarded.
+ *
+ * @returns     ::PBIO_ERROR_NO_DEV if the IMU is not available,
+ *              otherwise ::PBIO_SUCCESS.
+ */
+pbio_error_t pbio_imu_record_start(void) {
+    if (!imu_dev) {
+        return PBIO_ERROR_NO_DEV;
+    }
+    record_num_written = 0;
+    record_num_read = 0;
+    record_active = true;
+    return PBIO_SUCCESS;
+}
+
+/**
+ * Stops recording raw IMU samples. Samples that were already recorded can
+ * still be read.
+ */
+void pbio_imu_record_stop(void) {
+    record_active = false;
+}
+
+/**
+ * Gets the number of recorded samples that have not been read yet.
+ *
+ * @returns     The number of samples.
+ */
+uint32_t pbio_imu_record_get_count(void) {
+    return record_num_written - record_num_read;
+}
+
+/**
+ * Reads recorded samples, oldest first, and removes them from the buffer.
+ *
+ * @param [out] samples     Array to store the samples in.
+ * @param [in]  max_samples Maximum number of samples to read.
+ * @returns                 The number of samples read.
+ */
+uint32_t pbio_imu_record_read(pbio_imu_sample_t *samples, uint32_t max_samples) {
+    uint32_t count = pbio_int_math_min(pbio_imu_record_get_count(), max_samples);
+
+    // Copy in up to two parts in case the data wraps around the end.
+    uint32_t start = record_num_read % PBIO_CONFIG_IMU_RECORD_NUM_SAMPLES;
+    uint32_t first = pbio_int_math_min(count, PBIO_CONFIG_IMU_RECORD_NUM_SAMPLES - start);
+    memcpy(samples, &record_samples[start], first * sizeof(pbio_imu_sample_t));
+    memcpy(&samples[first], &record_samples[0], (count - first) * sizeof(pbio_imu_sample_t));
+
+    record_num_read += count;
+    return count;
+}
+
+#else // PBIO_CONFIG_IMU_RECORD_NUM_SAMPLES
+
+pbio_error_t pbio_imu_record_start(void) {
+    return PBIO_ERROR_NOT_SUPPORTED;
+}
+
+void pbio_imu_record_stop(void) {
+}
+
+uint32_t pbio_imu_record_get_count(void) {
+    return 0;
+}
+
+uint32_t pbio_imu_record_read(pbio_imu_sample_t *samples, uint32_t max_samples) {
+    return 0;
+}
+
+#endif // PBIO_CONFIG_IMU_RECORD_NUM_SAMPLES
+
+/**
+ * Gets the scale factors to convert recorded raw samples to physical units.
+ *
+ * @param [out] angular_velocity_scale  Scale from raw units to deg/s.
+ * @param [out] acceleration_scale      Scale from raw units to mm/s^2.
+ */
+void pbio_imu_record_get_scale(float *angular_velocity_scale, float *acceleration_scale) {
+    *angular_velocity_scale = imu_config ? imu_config->gyro_scale : 0.0f;
+    *acceleration_scale = imu_config ? imu_config->accel_scale : 0.0f;
+}
+
 #endif // PBIO_CONFIG_IMU
@@ -1,5 +1,5 @@
 // SPDX-License-Identifier: MIT
-// Copyright (c) 2018-2023 The Pybricks Authors
+// Copyright (c) 2018-2026 The Pybricks Authors
 
 // SPDX-License-Identifier: BSD-3-Clause
 // Copyright (c) 2020-2023 LEGO System A/S
@@ -154,28 +154,6 @@ int32_t pbio_int_math_sqrt(int32_t n) {
     }
 }
 
-/**
- * Sample points along the curve y = atan(x / 1024) * 8.
- *
- * This is used to get the atan2(b, a) curve in the first quadrant. The
- * intermediate scaling is used to avoid excessive rounding errors.
- *
- * x = Ratios b / a, upscaled by 1024.
- * y = Matching atan(b / b) output, upscaled by 8 * 180 / pi (eighth of a degree).
- */
-static const pbio_int_math_point_t atan_points[] = {
-    { .x = 0, .y = 0 },
-    { .x = 409, .y = 178 },
-    { .x = 972, .y = 348 },
-    { .x = 1638, .y = 472 },
-    { .x = 2560, .y = 545 },
-    { .x = 3891, .y = 605 },
-    { .x = 5120, .y = 632 },
-    { .x = 7168, .y = 660 },
-    { .x = 15360, .y = 692 },
-    { .x = 25600, .y = 705 },
-};
-
 /**
  * Interpolates a constant set of (X, Y) sample points on a curve y = f(x)
  * to estimate y for given input value x.
@@ -210,46 +188,81 @@ int32_t pbio_int_math_interpolate(const pbio_int_math_point_t *points, size_t le
 }
 
 /**
- * Gets atan2 in degrees from integer inputs.
+ * Values of atan(i / 64) for i = 0, 1, ..., 64 in millidegrees.
+ */
+static const uint16_t atan_table[] = {
+    0, 895, 1790, 2684, 3576, 4467, 5356, 6242,
+    7125, 8005, 8881, 9752, 10620, 11482, 12339, 13191,
+    14036, 14876, 15709, 16535, 17354, 18166, 18970, 19767,
+    20556, 21337, 22109, 22874, 23629, 24376, 25115, 25844,
+    26565, 27277, 27979, 28673, 29358, 30033, 30700, 31357,
+    32005, 32645, 33275, 33896, 34509, 35112, 35707, 36293,
+    36870, 37439, 37999, 38550, 39094, 39629, 40156, 40675,
+    41186, 41689, 42184, 42672, 43152, 43625, 44091, 44549,
+    45000,
+};
+
+/**
+ * Gets atan2 in millidegrees from integer inputs.
+ *
+ * The inputs are reduced to the first octant, where the ratio of the smaller
+ * to the larger input is looked up in a table and linearly interpolated. The
+ * maximum error is about 0.002 degrees if the largest input has a magnitude
+ * of at least 2**16. Smaller inputs are only as accurate as their ratio.
  *
  * @param [in]  y  Opposite side of the triangle.
  * @param [in]  x  Adjacent side of the triangle.
- * @return         atan2(y, x) in degrees.
+ * @return         atan2(y, x) in millidegrees, in the range [-180000, 180000].
  */
-int32_t pbio_int_math_atan2(int32_t y, int32_t x) {
+int32_t pbio_int_math_atan2_mdeg(int32_t y, int32_t x) {
 
-    // On y zero, the triangle is flat. Use X to find sign.
+    // On y zero, the triangle is flat. Use X to find sign. Like the original
+    // integer atan2, this gives -180 for negative x and for the origin.
     if (y == 0) {
-        return x > 0 ? 0 : -180;
+        return x > 0 ? 0 : -180000;
     }
 
-    // On x zero, the triangle height tends to infinity. Use y for sign.
-    if (x == 0) {
-        return 90 * pbio_int_math_sign(y);
+    // Work with the magnitudes and reduce them to 16 bits so that the ratio
+    // below fits in 32 bits.
+    uint32_t abs_x = x < 0 ? -(uint32_t)x : (uint32_t)x;
+    uint32_t abs_y = y < 0 ? -(uint32_t)y : (uint32_t)y;
+    while (abs_x >= (1 << 16) || abs_y >= (1 << 16)) {
+        abs_x >>= 1;
+        abs_y >>= 1;
     }
 
-    // Get absolute ratio of y / x, upscaled to preserve resolution.
-    int32_t ratio = 1024 * y / x;
-    if (ratio < 0) {
-        ratio = -ratio;
+    // Get the ratio of the smaller to the larger value, scaled by 2**16.
+    bool swap = abs_y > abs_x;
+    uint32_t small = swap ? abs_x : abs_y;
+    uint32_t large = swap ? abs_y : abs_x;
+    uint32_t ratio = ((small << 16) + large / 2) / large;
+
+    // Interpolate between the nearest table entries.
+    uint32_t index = ratio >> 10;
+    int32_t angle = atan_table[index];
+    if (index < PBIO_ARRAY_SIZE(atan_table) - 1) {
+        angle += ((int32_t)(atan_table[index + 1] - atan_table[index]) * (int32_t)(ratio & 1023) + 512) >> 10;
     }
 
-    // Interpolate and scale to get corresponding atan value.
-    int32_t atan = pbio_int_math_interpolate(atan_points, PBIO_ARRAY_SIZE(atan_points), ratio) / 8;
-
-    // We took the absolute ratio, but must now account for sign.
-    // So, negate if x and y had opposite sign.
-    if ((x > 0) != (y > 0)) {
-        atan = -atan;
+    // Map the first octant back to the original quadrant.
+    if (swap) {
+        angle = 90000 - angle;
     }
-
-    // For small angles, we're done.
-    if (x > 0) {
-        return atan;
+    if (x < 0) {
+        angle = 180000 - angle;
     }
+    return y < 0 ? -angle : angle;
+}
 
-    // Get atan2 result for larger angles.
-    return atan > 0 ? atan - 180 : atan + 180;
+/**
+ * Gets atan2 in degrees from integer inputs.
+ *
+ * @param [in]  y  Opposite side of the triangle.
+ * @param [in]  x  Adjacent side of the triangle.
+ * @return         atan2(y, x) in degrees.
+ */
+int32_t pbio_int_math_atan2(int32_t y, int32_t x) {
+    return pbio_int_math_atan2_mdeg(y, x) / 1000;
 }
 
 /**
@@ -301,44 +314,87 @@ int32_t pbio_int_math_mult_then_div(int32_t a, int32_t b, int32_t c) {
 }
 
 /**
- * Approximates first 90-degree segment of a sine in degrees, output
- * upscaled by 10000.
+ * Values of sin(i) for i = 0, 1, ..., 90 degrees, upscaled by 10000.
+ */
+static const int16_t sin_table[] = {
+    0, 175, 349, 523, 698, 872, 1045, 1219, 1392, 1564,
+    1736, 1908, 2079, 2250, 2419, 2588, 2756, 2924, 3090, 3256,
+    3420, 3584, 3746, 3907, 4067, 4226, 4384, 4540, 4695, 4848,
+    5000, 5150, 5299, 5446, 5592, 5736, 5878, 6018, 6157, 6293,
+    6428, 6561, 6691, 6820, 6947, 7071, 7193, 7314, 7431, 7547,
+    7660, 7771, 7880, 7986, 8090, 8192, 8290, 8387, 8480, 8572,
+    8660, 8746, 8829, 8910, 8988, 9063, 9135, 9205, 9272, 9336,
+    9397, 9455, 9511, 9563, 9613, 9659, 9703, 9744, 9781, 9816,
+    9848, 9877, 9903, 9925, 9945, 9962, 9976, 9986, 9994, 9998,
+    10000,
+};
+
+/**
+ * Gets the sine of an angle in the first quadrant, output upscaled by 10000.
  *
- * @param [in]  x        Angle in degrees (0-90).
- * @returns              Approximately sin(x) * 10000.
+ * @param [in]  x        Angle in millidegrees (0-90000).
+ * @returns              sin(x) * 10000.
  */
-static int32_t pbio_int_math_sin_deg_branch0(int32_t x) {
-    return (201 - x) * x;
+static int32_t pbio_int_math_sin_mdeg_quadrant(int32_t x) {
+    int32_t index = x / 1000;
+    int32_t result = sin_table[index];
+    if (index < (int32_t)PBIO_ARRAY_SIZE(sin_table) - 1) {
+        result += (sin_table[index + 1] - sin_table[index]) * (x % 1000) / 1000;
+    }
+    return result;
 }
 
-// integer sine approximation from degrees to (-10000, 10000)
-
 /**
- * Approximates sine of an angle in degrees, output upscaled by 10000.
+ * Gets sine of an angle in millidegrees, output upscaled by 10000.
  *
- * @param [in]  x        Angle in degrees.
- * @returns              Approximately sin(x) * 10000.
+ * This interpolates a table of whole degrees, so the error is below one unit.
+ *
+ * @param [in]  x        Angle in millidegrees.
+ * @returns              sin(x) * 10000.
  */
-int32_t pbio_int_math_sin_deg(int32_t x) {
-    x = x % 360;
-    if (x < 90) {
-        return pbio_int_math_sin_deg_branch0(x);
+int32_t pbio_int_math_sin_mdeg(int32_t x) {
+    x %= 360000;
+    if (x < 0) {
+        x += 360000;
+    }
+    if (x < 90000) {
+        return pbio_int_math_sin_mdeg_quadrant(x);
     }
-    if (x < 180) {
-        return pbio_int_math_sin_deg_branch0(180 - x);
+    if (x < 180000) {
+        return pbio_int_math_sin_mdeg_quadrant(180000 - x);
     }
-    if (x < 270) {
-        return -pbio_int_math_sin_deg_branch0(x - 180);
+    if (x < 270000) {
+        return -pbio_int_math_sin_mdeg_quadrant(x - 180000);
     }
-    return -pbio_int_math_sin_deg_branch0(360 - x);
+    return -pbio_int_math_sin_mdeg_quadrant(360000 - x);
+}
+
+/**
+ * Gets cosine of an angle in millidegrees, output upscaled by 10000.
+ *
+ * @param [in]  x        Angle in millidegrees.
+ * @returns              cos(x) * 10000.
+ */
+int32_t pbio_int_math_cos_mdeg(int32_t x) {
+    return pbio_int_math_sin_mdeg(x % 360000 + 90000);
+}
+
+/**
+ * Gets sine of an angle in degrees, output upscaled by 10000.
+ *
+ * @param [in]  x        Angle in degrees.
+ * @returns              sin(x) * 10000.
+ */
+int32_t pbio_int_math_sin_deg(int32_t x) {
+    return pbio_int_math_sin_mdeg(x % 360 * 1000);
 }
 
 /**
- * Approximates cosine of an angle in degrees, output upscaled by 10000.
+ * Gets cosine of an angle in degrees, output upscaled by 10000.
  *
  * @param [in]  x        Angle in degrees.
- * @returns              Approximately cos(x) * 10000.
+ * @returns              cos(x) * 10000.
  */
 int32_t pbio_int_math_cos_deg(int32_t x) {
-    return pbio_int_math_sin_deg(x + 90);
+    return pbio_int_math_sin_mdeg(x % 360 * 1000 + 90000);
 }
@@ -13,6 +13,8 @@
 #include <pbio/light_animation.h>
 #include <pbio/motor_process.h>
 #include <pbio/port_interface.h>
+#include <pbio/sampler.h>
+#include <pbio/trigger.h>
 
 #define DEBUG 0
 
@@ -83,6 +85,9 @@ pbio_error_t pbio_main_stop_application_resources(void) {
 
     pbio_port_stop_user_actions(true);
     pbio_main_soft_stop();
+    pbio_imu_record_stop();
+    pbio_sampler_stop_all();
+    pbio_trigger_stop_all();
 
     pbio_error_t err;
     pbio_os_state_t state = 0;
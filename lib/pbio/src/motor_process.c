@@ -1,5 +1,5 @@
 // SPDX-License-Identifier: MIT
-// Copyright (c) 2018-2025 The Pybricks Authors
+// Copyright (c) 2018-2026 The Pybricks Authors
 
 #include <pbdrv/clock.h>
 
@@ -16,6 +16,7 @@ static pbio_os_process_t pbio_motor_process;
 static pbio_error_t pbio_motor_process_thread(pbio_os_state_t *state, void *context) {
 
     static pbio_os_timer_t timer;
+    uint32_t time_now;
 
     PBIO_OS_ASYNC_BEGIN(state);
 
@@ -23,11 +24,14 @@ static pbio_error_t pbio_motor_process_thread(pbio_os_state_t *state, void *cont
     timer.duration = PBIO_CONFIG_CONTROL_LOOP_TIME_MS;
 
     for (;;) {
+        // All updates in this iteration use the same time stamp.
+        time_now = pbio_control_get_time_ticks();
+
         // Update drivebase
-        pbio_drivebase_update_all();
+        pbio_drivebase_update_all(time_now);
 
         // Update servos
-        pbio_servo_update_all();
+        pbio_servo_update_all(time_now);
 
         // Increment start time instead waiting from here, making the
         // loop time closer to the target on average.
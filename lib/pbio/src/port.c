@@ -1,6 +1,9 @@
 // SPDX-License-Identifier: MIT
-// Copyright (c) 2018-2025 The Pybricks Authors
+// Copyright (c) 2018-2026 The Pybricks Authors
 
+#include <string.h>
+
+#include <pbdrv/clock.h>
 #include <pbdrv/counter.h>
 #include <pbdrv/i2c.h>
 #include <pbdrv/ioport.h>
@@ -35,6 +38,77 @@
 
 #if PBIO_CONFIG_PORT
 
+#if PBIO_CONFIG_PORT_I2C_POLL_SIZE
+
+/**
+ * Background I2C commands that run periodically, so that the most recent
+ * result can be read at any time without waiting for the bus.
+ *
+ * While polling, the same process also runs one-off transactions on behalf of
+ * user code, so the two never compete for the bus.
+ */
+typedef struct {
+    /**
+     * Process that runs the transactions.
+     */
+    pbio_os_process_t process;
+    /**
+     * Timer for the polling interval.
+     */
+    pbio_os_timer_t timer;
+    /**
+     * Child protothread for the I2C driver operation.
+     */
+    pbio_os_state_t child;
+    /**
+     * Pointer to data read by the driver. Only valid on completion.
+     */
+    uint8_t *rdata;
+    /**
+     * Whether polling is active. The process may keep running for a while
+     * after polling is stopped, to finish the ongoing transfer.
+     */
+    bool active;
+    /**
+     * Polled commands, run back to back as one list. Their write data points
+     * into write_data.
+     */
+    pbdrv_i2c_command_t commands[PBIO_PORT_I2C_POLL_MAX_COMMANDS];
+    uint8_t num_commands;
+    bool nxt_quirk;
+    uint8_t write_data[PBIO_CONFIG_PORT_I2C_POLL_SIZE];
+    /**
+     * Data read by the ongoing poll. Only copied to read_data if all commands
+     * succeeded, so a failed poll never leaves a partial result.
+     */
+    uint8_t poll_data[PBIO_CONFIG_PORT_I2C_POLL_SIZE];
+    /**
+     * Most recent successful polling result and the time it was read. The
+     * time is zero if nothing was read yet.
+     */
+    uint8_t read_len;
+    uint8_t read_data[PBIO_CONFIG_PORT_I2C_POLL_SIZE];
+    uint32_t read_time;
+    /**
+     * Result of the most recent polled transaction. ::PBIO_ERROR_AGAIN if
+     * none completed yet.
+     */
+    pbio_error_t err;
+    /**
+     * One-off transaction requested by user code. Same format as above.
+     */
+    bool request_pending;
+    uint8_t request_address;
+    bool request_nxt_quirk;
+    uint8_t request_write_len;
+    uint8_t request_read_len;
+    uint8_t request_write_data[PBIO_CONFIG_PORT_I2C_POLL_SIZE];
+    uint8_t request_read_data[PBIO_CONFIG_PORT_I2C_POLL_SIZE];
+    pbio_error_t request_err;
+} pbio_port_i2c_poll_t;
+
+#endif // PBIO_CONFIG_PORT_I2C_POLL_SIZE
+
 /**
  * Port instance.
  */
@@ -88,6 +162,12 @@ struct _pbio_port_t {
      * LEGO UART Messaging Protocol device instance.
      */
     pbio_port_lump_dev_t *lump_dev;
+    #if PBIO_CONFIG_PORT_I2C_POLL_SIZE
+    /**
+     * Background I2C poller.
+     */
+    pbio_port_i2c_poll_t i2c_poll;
+    #endif
 };
 
 static pbio_port_t ports[PBIO_CONFIG_PORT_NUM_DEV];
@@ -251,6 +331,268 @@ pbio_error_t pbio_port_get_i2c_dev(pbio_port_t *port, pbdrv_i2c_dev_t **i2c_dev)
     return pbdrv_ioport_p5p6_set_mode(port->pdata->pins, PBDRV_IOPORT_P5P6_MODE_I2C);
 }
 
+#if PBIO_CONFIG_PORT_I2C_POLL_SIZE
+
+/**
+ * Runs the polled I2C commands at the configured interval, and one-off
+ * transactions in between as they are requested.
+ */
+static pbio_error_t pbio_port_i2c_poll_thread(pbio_os_state_t *state, void *context) {
+
+    pbio_port_t *port = context;
+    pbio_port_i2c_poll_t *poll = &port->i2c_poll;
+
+    // NB: This thread is shared for all ports, so use the poll state
+    // variables instead of static variables.
+
+    pbio_error_t err;
+
+    PBIO_OS_ASYNC_BEGIN(state);
+
+    for (;;) {
+        // Wait for the next poll, or run a one-off request sooner.
+        PBIO_OS_AWAIT_UNTIL(state, poll->request_pending || !poll->active || pbio_os_timer_is_expired(&poll->timer));
+
+        if (poll->request_pending) {
+            poll->rdata = NULL;
+            PBIO_OS_AWAIT(state, &poll->child, err = pbdrv_i2c_write_then_read(&poll->child, port->i2c_dev,
+                poll->request_address, poll->request_write_data, poll->request_write_len,
+                &poll->rdata, poll->request_read_len, poll->request_nxt_quirk));
+            if (err == PBIO_SUCCESS && poll->request_read_len) {
+                memcpy(poll->request_read_data, poll->rdata, poll->request_read_len);
+            }
+            poll->request_err = err;
+            poll->request_pending = false;
+            continue;
+        }
+
+        // Polling was stopped and no more requests are pending.
+        if (!poll->active) {
+            break;
+        }
+
+        // Interval is measured between the start of each poll.
+        pbio_os_timer_extend(&poll->timer);
+        if (pbio_os_timer_is_expired(&poll->timer)) {
+            // Don't try to catch up if we fell behind, e.g. due to requests.
+            pbio_os_timer_reset(&poll->timer);
+        }
+
+        PBIO_OS_AWAIT(state, &poll->child, err = pbdrv_i2c_run_commands(&poll->child, port->i2c_dev,
+            poll->commands, poll->num_commands, 1,
+            poll->poll_data, sizeof(poll->poll_data), poll->nxt_quirk));
+        if (!poll->active) {
+            // Stopped while polling, so nobody needs the result.
+            continue;
+        }
+        if (err == PBIO_SUCCESS) {
+            memcpy(poll->read_data, poll->poll_data, poll->read_len);
+            poll->read_time = pbdrv_clock_get_ms();
+        }
+        poll->err = err;
+    }
+
+    PBIO_OS_ASYNC_END(PBIO_SUCCESS);
+}
+
+/**
+ * Checks whether the poll process is still running, which may be shortly
+ * after polling was stopped.
+ */
+static bool pbio_port_i2c_poll_is_running(pbio_port_i2c_poll_t *poll) {
+    return poll->active || poll->process.err == PBIO_ERROR_AGAIN;
+}
+
+/**
+ * Starts polling I2C devices on this port in the background.
+ *
+ * Polling must not be active, and the previous poll process must have
+ * finished, as indicated by ::pbio_port_i2c_poll_is_active. The commands
+ * and their write data are copied, so they need not remain valid after this
+ * call.
+ *
+ * @param [in]  port         The port instance.
+ * @param [in]  commands     Commands to run back to back on each poll. The
+ *                           data read by all of them is concatenated.
+ * @param [in]  num_commands Number of @p commands.
+ * @param [in]  interval     Time between the start of each poll, in ms.
+ * @param [in]  nxt_quirk    Whether to use NXT I2C transaction quirk.
+ * @return                   ::PBIO_SUCCESS on success.
+ *                           ::PBIO_ERROR_INVALID_ARG if there are too many
+ *                           commands or too much data.
+ *                           ::PBIO_ERROR_BUSY if the previous poll process
+ *                           is still running.
+ *                           Other errors as for ::pbio_port_get_i2c_dev.
+ */
+pbio_error_t pbio_port_i2c_poll_start(pbio_port_t *port, const pbdrv_i2c_command_t *commands, size_t num_commands, uint32_t interval, bool nxt_quirk) {
+
+    pbdrv_i2c_dev_t *i2c_dev;
+    pbio_error_t err = pbio_port_get_i2c_dev(port, &i2c_dev);
+    if (err != PBIO_SUCCESS) {
+        return err;
+    }
+
+    if (num_commands == 0 || num_commands > PBIO_PORT_I2C_POLL_MAX_COMMANDS) {
+        return PBIO_ERROR_INVALID_ARG;
+    }
+
+    size_t write_len = 0;
+    size_t read_len = 0;
+    for (size_t i = 0; i < num_commands; i++) {
+        write_len += commands[i].write_len;
+        read_len += commands[i].read_len;
+    }
+    if (write_len > PBIO_CONFIG_PORT_I2C_POLL_SIZE || read_len > PBIO_CONFIG_PORT_I2C_POLL_SIZE) {
+        return PBIO_ERROR_INVALID_ARG;
+    }
+
+    // The commands can't be replaced while the process may still be using
+    // them, and a new transfer can't start before the ongoing one completes.
+    pbio_port_i2c_poll_t *poll = &port->i2c_poll;
+    if (pbio_port_i2c_poll_is_running(poll)) {
+        return PBIO_ERROR_BUSY;
+    }
+
+    write_len = 0;
+    for (size_t i = 0; i < num_commands; i++) {
+        poll->commands[i] = commands[i];
+        poll->commands[i].write_data = &poll->write_data[write_len];
+        memcpy(&poll->write_data[write_len], commands[i].write_data, commands[i].write_len);
+        write_len += commands[i].write_len;
+    }
+    poll->num_commands = num_commands;
+    poll->nxt_quirk = nxt_quirk;
+    poll->read_len = read_len;
+    poll->read_time = 0;
+    poll->err = PBIO_ERROR_AGAIN;
+    poll->active = true;
+
+    // First poll happens right away.
+    pbio_os_timer_set(&poll->timer, interval);
+    poll->timer.start -= interval;
+    pbio_os_process_start(&poll->process, pbio_port_i2c_poll_thread, port);
+    return PBIO_SUCCESS;
+}
+
+/**
+ * Stops background polling on this port, if active.
+ *
+ * No new polls are started, but the ongoing one is allowed to complete, so
+ * the bus is free when the poll process ends. One-off requests are still
+ * run until then.
+ *
+ * @param [in]  port        The port instance.
+ */
+void pbio_port_i2c_poll_stop(pbio_port_t *port) {
+    pbio_port_i2c_poll_t *poll = &port->i2c_poll;
+    if (!poll->active) {
+        return;
+    }
+    poll->active = false;
+    pbio_os_request_poll();
+}
+
+/**
+ * Checks whether the poller owns the I2C bus on this port. This remains true
+ * for a short while after polling is stopped, until the ongoing transfer
+ * completes. Until then, use ::pbio_port_i2c_poll_request for one-off
+ * transactions.
+ *
+ * @param [in]  port        The port instance.
+ * @return                  Whether the poll process is running.
+ */
+bool pbio_port_i2c_poll_is_active(pbio_port_t *port) {
+    return pbio_port_i2c_poll_is_running(&port->i2c_poll);
+}
+
+/**
+ * Gets the most recent result of the polled commands without waiting.
+ *
+ * @param [in]  port        The port instance.
+ * @param [out] data        The data read.
+ * @param [out] len         Length of @p data.
+ * @param [out] time        Time (ms) at which the data was read.
+ * @return                  ::PBIO_SUCCESS on success.
+ *                          ::PBIO_ERROR_INVALID_OP if polling is not active.
+ *                          ::PBIO_ERROR_AGAIN if no data was read yet.
+ *                          Otherwise the error of the most recent poll if
+ *                          none succeeded yet.
+ */
+pbio_error_t pbio_port_i2c_poll_get_data(pbio_port_t *port, const uint8_t **data, size_t *len, uint32_t *time) {
+    pbio_port_i2c_poll_t *poll = &port->i2c_poll;
+    if (!poll->active) {
+        return PBIO_ERROR_INVALID_OP;
+    }
+
+    // Keep returning the last good value on the occasional failed poll.
+    if (!poll->read_time) {
+        return poll->err;
+    }
+
+    *data = poll->read_data;
+    *len = poll->read_len;
+    *time = poll->read_time;
+    return PBIO_SUCCESS;
+}
+
+/**
+ * Requests a one-off transaction to be run by the poller. Use this instead of
+ * ::pbdrv_i2c_write_then_read while polling is active.
+ *
+ * The result can be awaited with ::pbio_port_i2c_poll_request_get_result.
+ *
+ * @param [in]  port        The port instance.
+ * @param [in]  address     I2C device address (unshifted).
+ * @param [in]  write_data  Data to write.
+ * @param [in]  write_len   Length of @p write_data.
+ * @param [in]  read_len    Number of bytes to read.
+ * @param [in]  nxt_quirk   Whether to use NXT I2C transaction quirk.
+ * @return                  ::PBIO_SUCCESS if the request was scheduled.
+ *                          ::PBIO_ERROR_BUSY if another request is ongoing.
+ *                          ::PBIO_ERROR_INVALID_ARG if the data is too long.
+ *                          ::PBIO_ERROR_INVALID_OP if the poll process is
+ *                          not running.
+ */
+pbio_error_t pbio_port_i2c_poll_request(pbio_port_t *port, uint8_t address, const uint8_t *write_data, size_t write_len, size_t read_len, bool nxt_quirk) {
+    pbio_port_i2c_poll_t *poll = &port->i2c_poll;
+    if (!pbio_port_i2c_poll_is_running(poll)) {
+        return PBIO_ERROR_INVALID_OP;
+    }
+    if (poll->request_pending) {
+        return PBIO_ERROR_BUSY;
+    }
+    if (write_len > PBIO_CONFIG_PORT_I2C_POLL_SIZE || read_len > PBIO_CONFIG_PORT_I2C_POLL_SIZE) {
+        return PBIO_ERROR_INVALID_ARG;
+    }
+
+    poll->request_address = address;
+    poll->request_nxt_quirk = nxt_quirk;
+    poll->request_write_len = write_len;
+    poll->request_read_len = read_len;
+    memcpy(poll->request_write_data, write_data, write_len);
+    poll->request_err = PBIO_ERROR_AGAIN;
+    poll->request_pending = true;
+    pbio_os_request_poll();
+    return PBIO_SUCCESS;
+}
+
+/**
+ * Gets the result of a one-off transaction requested with
+ * ::pbio_port_i2c_poll_request.
+ *
+ * @param [in]  port        The port instance.
+ * @param [out] data        The data read. Valid until the next request.
+ * @return                  ::PBIO_ERROR_AGAIN while the request is ongoing,
+ *                          otherwise the result of the transaction.
+ */
+pbio_error_t pbio_port_i2c_poll_request_get_result(pbio_port_t *port, const uint8_t **data) {
+    pbio_port_i2c_poll_t *poll = &port->i2c_poll;
+    *data = poll->request_read_data;
+    return poll->request_err;
+}
+
+#endif // PBIO_CONFIG_PORT_I2C_POLL_SIZE
+
 /**
  * Gets the LUMP device connected to this port, if any.
  *
@@ -277,6 +619,29 @@ pbio_error_t pbio_port_get_lump_device(pbio_port_t *port, lego_device_type_id_t
     return PBIO_SUCCESS;
 }
 
+/**
+ * Gets the device connection manager of this port, if any.
+ *
+ * @param [in]    port        The port instance.
+ * @param [out]   dcm         The device connection manager.
+ * @return                    ::PBIO_SUCCESS on success, otherwise
+ *                            ::PBIO_ERROR_INVALID_OP if the port is not in LEGO mode.
+ *                            ::PBIO_ERROR_NOT_SUPPORTED if this port does not detect passive devices.
+ */
+pbio_error_t pbio_port_get_dcm(pbio_port_t *port, pbio_port_dcm_t **dcm) {
+
+    if (port->mode != PBIO_PORT_MODE_LEGO_DCM) {
+        return PBIO_ERROR_INVALID_OP;
+    }
+
+    if (!port->connection_manager) {
+        return PBIO_ERROR_NOT_SUPPORTED;
+    }
+
+    *dcm = port->connection_manager;
+    return PBIO_SUCCESS;
+}
+
 /**
  * Gets the DC motor or light device connected to this port, if any.
  *
@@ -529,6 +894,11 @@ void pbio_port_stop_user_actions(bool reset) {
     for (uint8_t i = 0; i < PBIO_CONFIG_PORT_NUM_DEV; i++) {
         pbio_port_t *port = &ports[i];
 
+        // Background I2C polling is started by user code, so stop it too.
+        if (reset) {
+            pbio_port_i2c_poll_stop(port);
+        }
+
         // Don't reset devices that always need power like powered sensors.
         if (port->lump_dev && pbio_port_lump_get_power_requirements(port->lump_dev) != PBIO_PORT_POWER_REQUIREMENTS_NONE) {
             continue;
@@ -591,6 +961,7 @@ pbio_error_t pbio_port_set_mode(pbio_port_t *port, pbio_port_mode_t mode) {
 
     // Disable thread activity by attaching a thread that does nothing.
     pbio_os_process_start(&port->process, pbio_port_process_none_thread, port);
+    pbio_port_i2c_poll_stop(port);
     port->mode = mode;
 
     switch (mode) {
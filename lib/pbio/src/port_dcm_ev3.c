@@ -1,11 +1,12 @@
 // SPDX-License-Identifier: MIT
-// Copyright (c) 2025 The Pybricks Authors
+// Copyright (c) 2025-2026 The Pybricks Authors
 
 #include <pbio/config.h>
 
 #include <pbio/port_interface.h>
 #include <pbio/port_dcm.h>
 #include <pbio/int_math.h>
+#include <pbio/trigger.h>
 
 #include <pbdrv/adc.h>
 #include <pbdrv/clock.h>
@@ -460,6 +461,7 @@ pbio_error_t pbio_port_dcm_thread(pbio_os_state_t *state, pbio_os_timer_t *timer
         if (!pbdrv_gpio_input(gpio)) {
             dcm->count = 0;
         }
+        pbio_trigger_dcm_data_received(dcm);
         PBIO_OS_AWAIT_MS(state, timer, DCM_LOOP_TIME_MS);
     }
     debug_pr("Device disconnected\n");
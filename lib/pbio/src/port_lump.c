@@ -1,5 +1,5 @@
 // SPDX-License-Identifier: MIT
-// Copyright (c) 2018-2025 The Pybricks Authors
+// Copyright (c) 2018-2026 The Pybricks Authors
 
 #include <pbio/config.h>
 
@@ -13,6 +13,7 @@
 
 #include <pbio/port_interface.h>
 #include <pbio/port_lump.h>
+#include <pbio/trigger.h>
 
 #include <pbdrv/clock.h>
 #include <pbdrv/ioport.h>
@@ -652,6 +653,9 @@ static void pbio_port_lump_lump_parse_msg(pbio_port_lump_dev_t *lump_dev) {
             lump_dev->mode = mode;
             pbio_port_lump_handle_known_data(lump_dev);
 
+            // Check triggers as soon as new data arrives.
+            pbio_trigger_lump_data_received(lump_dev);
+
             lump_dev->data_rec = true;
             break;
     }
@@ -873,8 +877,12 @@ sync:
     // Schedule baud rate change.
     PBIO_OS_AWAIT_MS(state, timer, 10);
 
-    // Change the baud rate.
-    pbdrv_uart_set_baud_rate(uart_dev, lump_dev->new_baud_rate);
+    // Change the baud rate. Not all ports can do all rates in the valid range.
+    err = pbdrv_uart_set_baud_rate(uart_dev, lump_dev->new_baud_rate);
+    if (err != PBIO_SUCCESS) {
+        debug_pr("Baud rate not supported by this port.\n");
+        return err;
+    }
     debug_pr("set baud: %" PRIu32 "\n", lump_dev->new_baud_rate);
 
     // Request switch to default mode for this device if any.
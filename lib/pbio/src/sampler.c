@@ -0,0 +1,440 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2026 The Pybricks Authors
+
+#include <pbio/config.h>
+
+#if PBIO_CONFIG_SAMPLER_NUM_DEV
+
+#include <string.h>
+
+#include <pbdrv/clock.h>
+
+#include <pbio/int_math.h>
+#include <pbio/os.h>
+#include <pbio/port_interface.h>
+#include <pbio/port_lump.h>
+#include <pbio/sampler.h>
+
+/**
+ * What kind of value is sampled.
+ */
+typedef enum {
+    /**
+     * Raw data of one mode of a LEGO UART device.
+     */
+    PBIO_SAMPLER_SOURCE_LUMP,
+    /**
+     * Analog value of a passive device, in mV.
+     */
+    PBIO_SAMPLER_SOURCE_ANALOG,
+} pbio_sampler_source_t;
+
+/**
+ * Background sampler instance.
+ */
+struct _pbio_sampler_t {
+    /**
+     * Process that takes the samples.
+     */
+    pbio_os_process_t process;
+    /**
+     * Timer for the sample period.
+     */
+    pbio_os_timer_t timer;
+    /**
+     * Port to sample. NULL if this sampler is not in use.
+     */
+    pbio_port_t *port;
+    /**
+     * Whether the process is taking samples.
+     */
+    bool active;
+    /**
+     * What kind of value is sampled.
+     */
+    pbio_sampler_source_t source;
+    /**
+     * LUMP device and mode to sample, if any.
+     */
+    pbio_port_lump_dev_t *lump_dev;
+    uint8_t mode;
+    /**
+     * Expected passive device type and whether to power it, if any.
+     */
+    lego_device_type_id_t type_id;
+    bool analog_active;
+    /**
+     * Size of one sample, including the timestamp.
+     */
+    uint32_t sample_size;
+    /**
+     * Number of samples that fit in the buffer.
+     */
+    uint32_t capacity;
+    /**
+     * Total number of samples written and read since sampling started.
+     */
+    uint32_t num_written;
+    uint32_t num_read;
+    /**
+     * Number of samples that were skipped because the buffer was full.
+     */
+    uint32_t num_dropped;
+    /**
+     * Error of the most recent sample that could not be taken, if any.
+     */
+    pbio_error_t err;
+    /**
+     * Samples, each being a timestamp in microseconds followed by the value.
+     */
+    uint8_t data[PBIO_CONFIG_SAMPLER_BUF_SIZE];
+};
+
+static pbio_sampler_t samplers[PBIO_CONFIG_SAMPLER_NUM_DEV];
+
+/**
+ * Reads the value of the sampled device.
+ *
+ * @param [in]  sampler     The sampler instance.
+ * @param [out] value       Buffer of sample_size - PBIO_SAMPLER_TIME_SIZE bytes.
+ * @return                  ::PBIO_SUCCESS or error from the port.
+ */
+static pbio_error_t pbio_sampler_get_value(pbio_sampler_t *sampler, uint8_t *value) {
+
+    uint32_t size = sampler->sample_size - PBIO_SAMPLER_TIME_SIZE;
+
+    if (sampler->source == PBIO_SAMPLER_SOURCE_ANALOG) {
+        uint32_t analog;
+        pbio_error_t err = pbio_port_get_analog_value(sampler->port, sampler->type_id, sampler->analog_active, &analog);
+        if (err != PBIO_SUCCESS) {
+            return err;
+        }
+        memcpy(value, &analog, size);
+        return PBIO_SUCCESS;
+    }
+
+    void *data;
+    pbio_error_t err = pbio_port_lump_get_data(sampler->lump_dev, sampler->mode, &data);
+    if (err != PBIO_SUCCESS) {
+        return err;
+    }
+    memcpy(value, data, size);
+    return PBIO_SUCCESS;
+}
+
+/**
+ * Takes one sample and adds it to the buffer, if there is room for it.
+ *
+ * If the buffer is full, the sample is dropped. The application can detect
+ * this as a gap in the sample times.
+ *
+ * @param [in]  sampler     The sampler instance.
+ */
+static void pbio_sampler_add_sample(pbio_sampler_t *sampler) {
+
+    if (sampler->num_written - sampler->num_read >= sampler->capacity) {
+        sampler->num_dropped++;
+        return;
+    }
+
+    uint32_t time = pbdrv_clock_get_us();
+    uint8_t *sample = &sampler->data[(sampler->num_written % sampler->capacity) * sampler->sample_size];
+
+    // Samples are not written if the device is not ready, for example
+    // while it is changing modes.
+    pbio_error_t err = pbio_sampler_get_value(sampler, &sample[PBIO_SAMPLER_TIME_SIZE]);
+    if (err != PBIO_SUCCESS) {
+        sampler->err = err;
+        return;
+    }
+
+    memcpy(sample, &time, PBIO_SAMPLER_TIME_SIZE);
+    sampler->num_written++;
+}
+
+/**
+ * Takes samples at a fixed rate.
+ */
+static pbio_error_t pbio_sampler_thread(pbio_os_state_t *state, void *context) {
+
+    pbio_sampler_t *sampler = context;
+
+    // NB: This thread is shared for all samplers, so use the sampler state
+    // variables instead of static variables.
+
+    PBIO_OS_ASYNC_BEGIN(state);
+
+    for (;;) {
+        PBIO_OS_AWAIT_UNTIL(state, pbio_os_timer_is_expired(&sampler->timer));
+
+        // Period is measured between scheduled sample times rather than
+        // between wake ups, so that late samples don't shift the ones after.
+        pbio_os_timer_extend(&sampler->timer);
+        if (pbio_os_timer_is_expired(&sampler->timer)) {
+            // Don't try to catch up if we fell behind by a whole period.
+            pbio_os_timer_reset(&sampler->timer);
+        }
+
+        pbio_sampler_add_sample(sampler);
+    }
+
+    // Unreachable.
+    PBIO_OS_ASYNC_END(PBIO_ERROR_FAILED);
+}
+
+/**
+ * Gets an unused sampler, or the sampler already used for this port.
+ *
+ * @param [in]  port        The port to sample.
+ * @return                  The sampler or NULL if all are in use.
+ */
+static pbio_sampler_t *pbio_sampler_get_free(pbio_port_t *port) {
+
+    pbio_sampler_t *unused = NULL;
+
+    for (uint8_t i = 0; i < PBIO_CONFIG_SAMPLER_NUM_DEV; i++) {
+        pbio_sampler_t *sampler = &samplers[i];
+        // Only one sampler per port, so replace it.
+        if (sampler->port == port) {
+            pbio_sampler_stop(sampler);
+            return sampler;
+        }
+        if (!sampler->port && !unused) {
+            unused = sampler;
+        }
+    }
+    return unused;
+}
+
+/**
+ * Starts sampling on the given sampler.
+ *
+ * @param [in]  sampler     The sampler instance, with the source configured.
+ * @param [in]  value_size  Size of the sampled value.
+ * @param [in]  period      Sample period in ms.
+ */
+static void pbio_sampler_start(pbio_sampler_t *sampler, uint32_t value_size, uint32_t period) {
+    sampler->sample_size = PBIO_SAMPLER_TIME_SIZE + value_size;
+    sampler->capacity = PBIO_CONFIG_SAMPLER_BUF_SIZE / sampler->sample_size;
+    sampler->num_written = 0;
+    sampler->num_read = 0;
+    sampler->num_dropped = 0;
+    sampler->err = PBIO_SUCCESS;
+    sampler->active = true;
+
+    // First sample is taken right away.
+    pbio_os_timer_set(&sampler->timer, period);
+    sampler->timer.start -= period;
+    pbio_os_process_start(&sampler->process, pbio_sampler_thread, sampler);
+}
+
+/**
+ * Starts sampling one mode of a LEGO UART device in the background.
+ *
+ * Each sample holds the raw data of the mode, as given by the mode info. The
+ * mode is set if needed. Samples are skipped if user code sets another mode.
+ *
+ * Replaces any sampler already running on this port.
+ *
+ * @param [out] sampler     The sampler instance.
+ * @param [in]  port        The port to sample.
+ * @param [in]  mode        The mode to sample.
+ * @param [in]  period      Sample period in ms.
+ * @return                  ::PBIO_SUCCESS on success.
+ *                          ::PBIO_ERROR_INVALID_ARG if the period or mode is not valid.
+ *                          ::PBIO_ERROR_BUSY if all samplers are in use.
+ *                          Otherwise errors as for ::pbio_port_get_lump_device.
+ */
+pbio_error_t pbio_sampler_start_lump(pbio_sampler_t **sampler, pbio_port_t *port, uint8_t mode, uint32_t period) {
+
+    if (period == 0) {
+        return PBIO_ERROR_INVALID_ARG;
+    }
+
+    lego_device_type_id_t type_id = LEGO_DEVICE_TYPE_ID_ANY_LUMP_UART;
+    pbio_port_lump_dev_t *lump_dev;
+    pbio_error_t err = pbio_port_get_lump_device(port, &type_id, &lump_dev);
+    if (err != PBIO_SUCCESS) {
+        return err;
+    }
+
+    uint8_t num_modes;
+    uint8_t current_mode;
+    pbio_port_lump_mode_info_t *mode_info;
+    err = pbio_port_lump_get_info(lump_dev, &num_modes, &current_mode, &mode_info);
+    if (err != PBIO_SUCCESS) {
+        return err;
+    }
+    if (mode >= num_modes) {
+        return PBIO_ERROR_INVALID_ARG;
+    }
+
+    err = pbio_port_lump_set_mode(lump_dev, mode);
+    if (err != PBIO_SUCCESS) {
+        return err;
+    }
+
+    pbio_sampler_t *s = pbio_sampler_get_free(port);
+    if (!s) {
+        return PBIO_ERROR_BUSY;
+    }
+
+    s->port = port;
+    s->source = PBIO_SAMPLER_SOURCE_LUMP;
+    s->lump_dev = lump_dev;
+    s->mode = mode;
+    pbio_sampler_start(s, mode_info[mode].num_values * pbio_port_lump_data_size(mode_info[mode].data_type), period);
+    *sampler = s;
+    return PBIO_SUCCESS;
+}
+
+/**
+ * Starts sampling the analog value of a passive device in the background.
+ *
+ * Each sample holds the value in mV as a uint32.
+ *
+ * Replaces any sampler already running on this port.
+ *
+ * @param [out] sampler     The sampler instance.
+ * @param [in]  port        The port to sample.
+ * @param [in]  type_id     The expected device type.
+ * @param [in]  active      Whether to power the device, as for ::pbio_port_get_analog_value.
+ * @param [in]  period      Sample period in ms.
+ * @return                  ::PBIO_SUCCESS on success.
+ *                          ::PBIO_ERROR_INVALID_ARG if the period is not valid.
+ *                          ::PBIO_ERROR_BUSY if all samplers are in use.
+ *                          Otherwise errors as for ::pbio_port_get_analog_value.
+ */
+pbio_error_t pbio_sampler_start_analog(pbio_sampler_t **sampler, pbio_port_t *port, lego_device_type_id_t type_id, bool active, uint32_t period) {
+
+    if (period == 0) {
+        return PBIO_ERROR_INVALID_ARG;
+    }
+
+    // Test that the device is there before sampling it.
+    uint32_t value;
+    pbio_error_t err = pbio_port_get_analog_value(port, type_id, active, &value);
+    if (err != PBIO_SUCCESS) {
+        return err;
+    }
+
+    pbio_sampler_t *s = pbio_sampler_get_free(port);
+    if (!s) {
+        return PBIO_ERROR_BUSY;
+    }
+
+    s->port = port;
+    s->source = PBIO_SAMPLER_SOURCE_ANALOG;
+    s->type_id = type_id;
+    s->analog_active = active;
+    pbio_sampler_start(s, sizeof(value), period);
+    *sampler = s;
+    return PBIO_SUCCESS;
+}
+
+/**
+ * Stops sampling and releases the sampler. Samples that were already taken
+ * can still be read until the sampler is used again.
+ *
+ * @param [in]  sampler     The sampler instance.
+ */
+void pbio_sampler_stop(pbio_sampler_t *sampler) {
+    if (!sampler->active) {
+        return;
+    }
+    pbio_os_process_start(&sampler->process, pbio_port_process_none_thread, sampler);
+    sampler->active = false;
+    sampler->port = NULL;
+}
+
+/**
+ * Stops all samplers. Called when the user application ends.
+ */
+void pbio_sampler_stop_all(void) {
+    for (uint8_t i = 0; i < PBIO_CONFIG_SAMPLER_NUM_DEV; i++) {
+        pbio_sampler_stop(&samplers[i]);
+    }
+}
+
+/**
+ * Checks whether the sampler is taking samples.
+ *
+ * @param [in]  sampler     The sampler instance.
+ * @return                  Whether sampling is active.
+ */
+bool pbio_sampler_is_active(pbio_sampler_t *sampler) {
+    return sampler->active;
+}
+
+/**
+ * Gets the size of one sample, including the timestamp.
+ *
+ * @param [in]  sampler     The sampler instance.
+ * @return                  The size in bytes.
+ */
+uint32_t pbio_sampler_get_sample_size(pbio_sampler_t *sampler) {
+    return sampler->sample_size;
+}
+
+/**
+ * Gets the number of samples that have not been read yet.
+ *
+ * @param [in]  sampler     The sampler instance.
+ * @return                  The number of samples.
+ */
+uint32_t pbio_sampler_get_count(pbio_sampler_t *sampler) {
+    return sampler->num_written - sampler->num_read;
+}
+
+/**
+ * Gets the number of samples that were skipped because the buffer was full.
+ *
+ * @param [in]  sampler     The sampler instance.
+ * @return                  The number of samples.
+ */
+uint32_t pbio_sampler_get_num_dropped(pbio_sampler_t *sampler) {
+    return sampler->num_dropped;
+}
+
+/**
+ * Gets the error of the most recent sample that could not be taken.
+ *
+ * @param [in]  sampler     The sampler instance.
+ * @return                  ::PBIO_SUCCESS if all samples were taken so far,
+ *                          otherwise the error from the port.
+ */
+pbio_error_t pbio_sampler_get_error(pbio_sampler_t *sampler) {
+    return sampler->err;
+}
+
+/**
+ * Clears the sampling error, so that only new errors are reported.
+ *
+ * @param [in]  sampler     The sampler instance.
+ */
+void pbio_sampler_clear_error(pbio_sampler_t *sampler) {
+    sampler->err = PBIO_SUCCESS;
+}
+
+/**
+ * Reads samples, oldest first, and removes them from the buffer.
+ *
+ * @param [in]  sampler     The sampler instance.
+ * @param [out] data        Buffer to store the samples in, back to back.
+ * @param [in]  max_samples Maximum number of samples to read.
+ * @return                  The number of samples read.
+ */
+uint32_t pbio_sampler_read(pbio_sampler_t *sampler, uint8_t *data, uint32_t max_samples) {
+    uint32_t count = pbio_int_math_min(pbio_sampler_get_count(sampler), max_samples);
+
+    // Copy in up to two parts in case the data wraps around the end.
+    uint32_t start = sampler->num_read % sampler->capacity;
+    uint32_t first = pbio_int_math_min(count, sampler->capacity - start);
+    memcpy(data, &sampler->data[start * sampler->sample_size], first * sampler->sample_size);
+    memcpy(&data[first * sampler->sample_size], &sampler->data[0], (count - first) * sampler->sample_size);
+
+    sampler->num_read += count;
+    return count;
+}
+
+#endif // PBIO_CONFIG_SAMPLER_NUM_DEV
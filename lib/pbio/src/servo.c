@@ -1,5 +1,5 @@
 // SPDX-License-Identifier: MIT
-// Copyright (c) 2018-2023 The Pybricks Authors
+// Copyright (c) 2018-2026 The Pybricks Authors
 
 // SPDX-License-Identifier: BSD-3-Clause
 // Copyright (c) 2020-2023 LEGO System A/S
@@ -16,6 +16,7 @@
 #include <pbio/observer.h>
 #include <pbio/parent.h>
 #include <pbio/servo.h>
+#include <pbio/trigger.h>
 
 #if PBIO_CONFIG_SERVO
 
@@ -64,17 +65,17 @@ bool pbio_servo_update_loop_is_running(pbio_servo_t *srv) {
     return srv->run_update_loop;
 }
 
-static pbio_error_t pbio_servo_update(pbio_servo_t *srv) {
-
-    // Get current time
-    uint32_t time_now = pbio_control_get_time_ticks();
+/**
+ * Updates the controller and observer of one servo.
+ *
+ * @param [in]  srv         The servo instance.
+ * @param [in]  time_now    Time of this control loop iteration.
+ * @param [in]  state       State sampled in this control loop iteration.
+ * @return                  Error code.
+ */
+static pbio_error_t pbio_servo_update(pbio_servo_t *srv, uint32_t time_now, const pbio_control_state_t *state) {
 
-    // Read the physical and estimated state
-    pbio_control_state_t state;
-    pbio_error_t err = pbio_servo_get_state_control(srv, &state);
-    if (err != PBIO_SUCCESS) {
-        return err;
-    }
+    pbio_error_t err;
 
     // Trajectory reference point
     pbio_trajectory_reference_t ref;
@@ -89,7 +90,7 @@ static pbio_error_t pbio_servo_update(pbio_servo_t *srv) {
         // Calculate feedback control signal
         pbio_dcmotor_actuation_t requested_actuation;
         bool external_pause = false;
-        pbio_control_update(&srv->control, time_now, &state, &ref, &requested_actuation, &feedback_torque, &external_pause);
+        pbio_control_update(&srv->control, time_now, state, &ref, &requested_actuation, &feedback_torque, &external_pause);
 
         // Get required feedforward torque for current reference
         feedforward_torque = pbio_observer_get_feedforward_torque(srv->observer.model, ref.speed, ref.acceleration);
@@ -126,61 +127,118 @@ static pbio_error_t pbio_servo_update(pbio_servo_t *srv) {
             // Column 1: Current time.
             time_now,
             // Column 2: Motor angle in degrees.
-            pbio_control_settings_ctl_to_app_long(&srv->control.settings, &state.position),
+            pbio_control_settings_ctl_to_app_long(&srv->control.settings, &state->position),
             // Column 3: Motor speed in degrees/second.
-            pbio_control_settings_ctl_to_app(&srv->control.settings, state.speed),
+            pbio_control_settings_ctl_to_app(&srv->control.settings, state->speed),
             // Column 4: Actuation type (LSB 0--1), stall state (LSB 2).
             applied_actuation | ((int32_t)stalled << 2),
             // Column 5: Actuation voltage.
             voltage,
             // Column 6: Estimated position in degrees.
-            pbio_control_settings_ctl_to_app_long(&srv->control.settings, &state.position_estimate),
+            pbio_control_settings_ctl_to_app_long(&srv->control.settings, &state->position_estimate),
             // Column 7: Estimated speed in degrees/second.
-            pbio_control_settings_ctl_to_app(&srv->control.settings, state.speed_estimate),
+            pbio_control_settings_ctl_to_app(&srv->control.settings, state->speed_estimate),
             // Column 8: Feedback torque (uNm).
             feedback_torque,
             // Column 9: Feedforward torque (uNm).
             feedforward_torque,
             // Column 10: Observer error feedback voltage torque (mV).
-            pbio_observer_get_feedback_voltage(&srv->observer, &state.position),
+            pbio_observer_get_feedback_voltage(&srv->observer, &state->position),
         };
         pbio_logger_add_row(&srv->log, log_data);
     }
 
     // Update the state observer
-    pbio_observer_update(&srv->observer, time_now, &state.position, applied_actuation, voltage);
+    pbio_observer_update(&srv->observer, time_now, &state->position, applied_actuation, voltage);
 
     return PBIO_SUCCESS;
 }
 
+/**
+ * Stops the update loop of a servo after a failed update.
+ *
+ * @param [in]  srv         The servo instance.
+ */
+static void pbio_servo_update_failed(pbio_servo_t *srv) {
+    // If the update failed, don't update it anymore.
+    pbio_servo_update_loop_set_state(srv, false);
+
+    // Coast the motor, letting errors pass.
+    pbio_dcmotor_coast(srv->dcmotor);
+
+    // Stop the control state.
+    pbio_control_reset(&srv->control);
+
+    // Stop higher level controls, such as drive bases.
+    pbio_parent_stop(&srv->parent, false);
+}
+
+/**
+ * Ends the ongoing command early if its stop trigger fired.
+ *
+ * @param [in]  srv         The servo instance.
+ */
+static void pbio_servo_check_stop_trigger(pbio_servo_t *srv) {
+
+    // Nothing to do if there is no trigger or the command already ended.
+    if (!srv->stop_trigger || !pbio_control_is_active(&srv->control)) {
+        srv->stop_trigger = NULL;
+        return;
+    }
+
+    // Check the most recent sensor value right now instead of waiting for
+    // the sensor to report new data.
+    pbio_trigger_update(srv->stop_trigger);
+
+    int32_t value;
+    uint32_t time;
+    pbio_error_t err = pbio_trigger_get_result(srv->stop_trigger, &value, &time);
+    if (err == PBIO_ERROR_AGAIN) {
+        return;
+    }
+
+    // The trigger is done, so it no longer applies to this command.
+    pbio_control_on_completion_t on_completion = srv->stop_trigger_on_completion;
+    srv->stop_trigger = NULL;
+
+    // If the trigger was canceled, just let the command complete normally.
+    // Otherwise it fired or the sensor failed, so stop here. Errors are
+    // caught by the update below.
+    if (err != PBIO_ERROR_CANCELED) {
+        pbio_servo_stop(srv, on_completion);
+    }
+}
+
 /**
  * Updates the servo state and controller.
  *
- * This gets called once on every control loop.
+ * This gets called once on every control loop. All servos are sampled first,
+ * so that their angles are read as close together in time as possible. Then
+ * all controllers and observers are updated using the same timestamp.
+ *
+ * @param [in]  time_now    Time of this control loop iteration.
  */
-void pbio_servo_update_all(void) {
-    pbio_error_t err;
+void pbio_servo_update_all(uint32_t time_now) {
+
+    // States of all servos sampled in this iteration.
+    static pbio_control_state_t states[PBIO_CONFIG_SERVO_NUM_DEV];
 
-    // Go through all motors.
+    // Sample all motors that are registered.
     for (uint8_t i = 0; i < PBIO_CONFIG_SERVO_NUM_DEV; i++) {
         pbio_servo_t *srv = &servos[i];
+        if (srv->run_update_loop && pbio_servo_get_state_control(srv, &states[i]) != PBIO_SUCCESS) {
+            pbio_servo_update_failed(srv);
+        }
+    }
 
-        // Run update loop only if registered.
+    // Run control and observer updates for all motors that are still running.
+    for (uint8_t i = 0; i < PBIO_CONFIG_SERVO_NUM_DEV; i++) {
+        pbio_servo_t *srv = &servos[i];
         if (srv->run_update_loop) {
-            err = pbio_servo_update(srv);
-            if (err != PBIO_SUCCESS) {
-                // If the update failed, don't update it anymore.
-                pbio_servo_update_loop_set_state(srv, false);
-
-                // Coast the motor, letting errors pass.
-                pbio_dcmotor_coast(srv->dcmotor);
-
-                // Stop the control state.
-                pbio_control_reset(&srv->control);
-
-                // Stop higher level controls, such as drive bases.
-                pbio_parent_stop(&srv->parent, false);
-            }
+            pbio_servo_check_stop_trigger(srv);
+        }
+        if (srv->run_update_loop && pbio_servo_update(srv, time_now, &states[i]) != PBIO_SUCCESS) {
+            pbio_servo_update_failed(srv);
         }
     }
 }
@@ -485,11 +543,12 @@ pbio_error_t pbio_servo_get_state_user(pbio_servo_t *srv, int32_t *angle, int32_
  *
  * @param [in]  srv         The servo instance.
  * @param [in]  window      Window size in milliseconds.
+ * @param [in]  mode        Speed estimation method.
  * @param [out] speed       Calculated speed in degrees per second.
  * @return                  Error code.
  */
-pbio_error_t pbio_servo_get_speed_user(pbio_servo_t *srv, uint32_t window, int32_t *speed) {
-    pbio_error_t err = pbio_differentiator_get_speed(&srv->observer.differentiator, window, speed);
+pbio_error_t pbio_servo_get_speed_user(pbio_servo_t *srv, uint32_t window, pbio_differentiator_mode_t mode, int32_t *speed) {
+    pbio_error_t err = pbio_differentiator_get_speed(&srv->observer.differentiator, window, mode, speed);
     if (err != PBIO_SUCCESS) {
         return err;
     }
@@ -545,6 +604,9 @@ pbio_error_t pbio_servo_stop(pbio_servo_t *srv, pbio_control_on_completion_t on_
         return err;
     }
 
+    // A new command starts, so the previous stop trigger no longer applies.
+    srv->stop_trigger = NULL;
+
     // Handle HOLD case. Also enforce hold if the stop type was CONTINUE since
     // this function needs to make it stop in all cases.
     if (on_completion == PBIO_CONTROL_ON_COMPLETION_HOLD ||
@@ -600,6 +662,9 @@ static pbio_error_t pbio_servo_run_time_common(pbio_servo_t *srv, int32_t speed,
         return err;
     }
 
+    // A new command starts, so the previous stop trigger no longer applies.
+    srv->stop_trigger = NULL;
+
     // Get current time
     uint32_t time_now = pbio_control_get_time_ticks();
 
@@ -700,6 +765,9 @@ pbio_error_t pbio_servo_run_target(pbio_servo_t *srv, int32_t speed, int32_t tar
         return err;
     }
 
+    // A new command starts, so the previous stop trigger no longer applies.
+    srv->stop_trigger = NULL;
+
     // Get current time
     uint32_t time_now = pbio_control_get_time_ticks();
 
@@ -750,6 +818,9 @@ pbio_error_t pbio_servo_run_angle(pbio_servo_t *srv, int32_t speed, int32_t angl
         return err;
     }
 
+    // A new command starts, so the previous stop trigger no longer applies.
+    srv->stop_trigger = NULL;
+
     // Get current time.
     uint32_t time_now = pbio_control_get_time_ticks();
 
@@ -795,10 +866,52 @@ pbio_error_t pbio_servo_track_target(pbio_servo_t *srv, int32_t target) {
         return err;
     }
 
+    // A new command starts, so the previous stop trigger no longer applies.
+    srv->stop_trigger = NULL;
+
     // Start hold command.
     return pbio_control_start_position_control_hold(&srv->control, pbio_control_get_time_ticks(), target);
 }
 
+/**
+ * Ends the ongoing command early when the given trigger fires.
+ *
+ * This must be called right after starting the command. The trigger is
+ * checked on every control loop iteration, and it is cleared when the command
+ * completes, when a new command starts, or when the trigger is stopped.
+ *
+ * @param [in]  srv            The servo instance.
+ * @param [in]  trigger        The trigger, or NULL to clear it.
+ * @param [in]  on_completion  How to stop when the trigger fires.
+ * @return                     ::PBIO_SUCCESS on success.
+ *                             ::PBIO_ERROR_INVALID_OP if the trigger is no
+ *                             longer waiting for its condition.
+ */
+pbio_error_t pbio_servo_set_stop_trigger(pbio_servo_t *srv, struct _pbio_trigger_t *trigger, pbio_control_on_completion_t on_completion) {
+    int32_t value;
+    uint32_t time;
+    if (trigger && pbio_trigger_get_result(trigger, &value, &time) != PBIO_ERROR_AGAIN) {
+        return PBIO_ERROR_INVALID_OP;
+    }
+    srv->stop_trigger = trigger;
+    srv->stop_trigger_on_completion = on_completion;
+    return PBIO_SUCCESS;
+}
+
+/**
+ * Clears the given trigger from all servos, so the commands that used it
+ * continue normally. Called when the trigger is released.
+ *
+ * @param [in]  trigger        The trigger.
+ */
+void pbio_servo_clear_stop_trigger(struct _pbio_trigger_t *trigger) {
+    for (uint8_t i = 0; i < PBIO_CONFIG_SERVO_NUM_DEV; i++) {
+        if (servos[i].stop_trigger == trigger) {
+            servos[i].stop_trigger = NULL;
+        }
+    }
+}
+
 /**
  * Checks whether servo is stalled. If the servo is actively controlled,
  * it is stalled when the controller cannot maintain the target speed or
@@ -0,0 +1,447 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2026 The Pybricks Authors
+
+#include <pbio/config.h>
+
+#if PBIO_CONFIG_TRIGGER_NUM_DEV
+
+#include <math.h>
+#include <string.h>
+
+#include <pbdrv/clock.h>
+
+#include <pbio/drivebase.h>
+#include <pbio/port_interface.h>
+#include <pbio/port_lump.h>
+#include <pbio/trigger.h>
+
+/**
+ * Sensor value trigger instance.
+ */
+struct _pbio_trigger_t {
+    /**
+     * Port of the sensor. NULL if this trigger is not in use.
+     */
+    pbio_port_t *port;
+    /**
+     * Whether the trigger is waiting for the condition.
+     */
+    bool armed;
+    /**
+     * For LEGO UART devices, the device, mode, value index and data type.
+     * NULL for passive devices.
+     */
+    pbio_port_lump_dev_t *lump_dev;
+    uint8_t mode;
+    uint8_t index;
+    lump_data_type_t data_type;
+    /**
+     * For passive devices, the connection manager, expected device type and
+     * whether to power it.
+     */
+    pbio_port_dcm_t *dcm;
+    lego_device_type_id_t type_id;
+    bool analog_active;
+    /**
+     * Condition on the value.
+     */
+    pbio_trigger_condition_t condition;
+    int32_t threshold;
+    /**
+     * Whether the condition was false since the trigger was armed. This is
+     * initially false for edge triggers, so they only fire on a change.
+     */
+    bool was_clear;
+    /**
+     * Motors to stop when the trigger fires, and how to stop them.
+     */
+    pbio_servo_t *servos[PBIO_TRIGGER_NUM_SERVOS];
+    uint8_t num_servos;
+    pbio_control_on_completion_t on_completion;
+    /**
+     * Value and time in ms when the trigger fired.
+     */
+    int32_t value;
+    uint32_t time;
+    /**
+     * ::PBIO_SUCCESS if fired, otherwise the reason it stopped.
+     */
+    pbio_error_t err;
+};
+
+static pbio_trigger_t triggers[PBIO_CONFIG_TRIGGER_NUM_DEV];
+
+/**
+ * Gets the current value of the sensor.
+ *
+ * @param [in]  trigger     The trigger instance.
+ * @param [out] value       The value.
+ * @return                  ::PBIO_SUCCESS or error from the port.
+ */
+static pbio_error_t pbio_trigger_get_value(pbio_trigger_t *trigger, int32_t *value) {
+
+    if (!trigger->lump_dev) {
+        uint32_t analog;
+        pbio_error_t err = pbio_port_get_analog_value(trigger->port, trigger->type_id, trigger->analog_active, &analog);
+        *value = analog;
+        return err;
+    }
+
+    void *data;
+    pbio_error_t err = pbio_port_lump_get_data(trigger->lump_dev, trigger->mode, &data);
+    if (err != PBIO_SUCCESS) {
+        return err;
+    }
+
+    switch (trigger->data_type) {
+        case LUMP_DATA_TYPE_DATA8:
+            *value = ((int8_t *)data)[trigger->index];
+            break;
+        case LUMP_DATA_TYPE_DATA16:
+            *value = ((int16_t *)data)[trigger->index];
+            break;
+        case LUMP_DATA_TYPE_DATA32:
+            *value = ((int32_t *)data)[trigger->index];
+            break;
+        case LUMP_DATA_TYPE_DATAF: {
+            // Truncate to integer, saturating at the limits. There is no
+            // valid value to compare NaN with, so wait for the next one.
+            float f = ((float *)data)[trigger->index];
+            if (isnan(f)) {
+                return PBIO_ERROR_AGAIN;
+            }
+            if (f >= 2147483648.0f) {
+                *value = INT32_MAX;
+            } else if (f <= -2147483648.0f) {
+                *value = INT32_MIN;
+            } else {
+                *value = f;
+            }
+            break;
+        }
+        default:
+            return PBIO_ERROR_NOT_SUPPORTED;
+    }
+    return PBIO_SUCCESS;
+}
+
+/**
+ * Checks whether a value meets the condition of the trigger.
+ *
+ * @param [in]  trigger     The trigger instance.
+ * @param [in]  value       The value.
+ * @return                  Whether the condition is met.
+ */
+static bool pbio_trigger_condition_is_met(pbio_trigger_t *trigger, int32_t value) {
+    switch (trigger->condition) {
+        case PBIO_TRIGGER_CONDITION_ABOVE:
+            return value > trigger->threshold;
+        case PBIO_TRIGGER_CONDITION_BELOW:
+            return value < trigger->threshold;
+        case PBIO_TRIGGER_CONDITION_EQUAL:
+            return value == trigger->threshold;
+        case PBIO_TRIGGER_CONDITION_NOT_EQUAL:
+            return value != trigger->threshold;
+        default:
+            return false;
+    }
+}
+
+/**
+ * Checks the latest sensor value and fires the trigger if the condition is
+ * met, stopping the motors associated with it.
+ *
+ * This is called whenever new data arrives, but may also be called from
+ * elsewhere to check the condition at a specific time.
+ *
+ * @param [in]  trigger     The trigger instance.
+ */
+void pbio_trigger_update(pbio_trigger_t *trigger) {
+
+    if (!trigger->armed) {
+        return;
+    }
+
+    int32_t value;
+    pbio_error_t err = pbio_trigger_get_value(trigger, &value);
+
+    // Keep waiting while the device is not ready, for example while it is
+    // changing modes, or if user code is temporarily using another mode.
+    if (err == PBIO_ERROR_AGAIN || err == PBIO_ERROR_INVALID_OP) {
+        return;
+    }
+
+    // Stop on all other errors, such as the device being unplugged.
+    if (err != PBIO_SUCCESS) {
+        trigger->err = err;
+        trigger->armed = false;
+        return;
+    }
+
+    if (!pbio_trigger_condition_is_met(trigger, value)) {
+        trigger->was_clear = true;
+        return;
+    }
+
+    if (!trigger->was_clear) {
+        return;
+    }
+
+    trigger->value = value;
+    trigger->time = pbdrv_clock_get_ms();
+    trigger->err = PBIO_SUCCESS;
+    trigger->armed = false;
+
+    // Errors are ignored here. The motor awaitables report them if needed.
+    for (uint8_t i = 0; i < trigger->num_servos; i++) {
+        pbio_servo_stop(trigger->servos[i], trigger->on_completion);
+    }
+}
+
+/**
+ * Updates all triggers that use the given LEGO UART device. Called when it
+ * receives new data.
+ *
+ * @param [in]  lump_dev    The LEGO UART device instance.
+ */
+void pbio_trigger_lump_data_received(pbio_port_lump_dev_t *lump_dev) {
+    for (uint8_t i = 0; i < PBIO_CONFIG_TRIGGER_NUM_DEV; i++) {
+        pbio_trigger_t *trigger = &triggers[i];
+        if (trigger->armed && trigger->lump_dev == lump_dev) {
+            pbio_trigger_update(trigger);
+        }
+    }
+}
+
+/**
+ * Updates all triggers that use a passive device on the given connection
+ * manager. Called whenever it samples the device.
+ *
+ * @param [in]  dcm         The device connection manager.
+ */
+void pbio_trigger_dcm_data_received(pbio_port_dcm_t *dcm) {
+    for (uint8_t i = 0; i < PBIO_CONFIG_TRIGGER_NUM_DEV; i++) {
+        pbio_trigger_t *trigger = &triggers[i];
+        if (trigger->armed && !trigger->lump_dev && trigger->dcm == dcm) {
+            pbio_trigger_update(trigger);
+        }
+    }
+}
+
+/**
+ * Gets an unused trigger and prepares it for the given port.
+ *
+ * @param [in]  port        The port of the sensor.
+ * @return                  The trigger or NULL if all are in use.
+ */
+static pbio_trigger_t *pbio_trigger_get_free(pbio_port_t *port) {
+    for (uint8_t i = 0; i < PBIO_CONFIG_TRIGGER_NUM_DEV; i++) {
+        pbio_trigger_t *trigger = &triggers[i];
+        if (!trigger->port) {
+            memset(trigger, 0, sizeof(pbio_trigger_t));
+            trigger->port = port;
+            return trigger;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * Arms a prepared trigger and checks the current value right away.
+ *
+ * @param [in]  trigger       The trigger instance, with the source configured.
+ * @param [in]  condition     The condition on the value.
+ * @param [in]  threshold     The value to compare against.
+ * @param [in]  edge          Whether the condition must become true, rather than be true.
+ * @param [in]  servos        The motors to stop when it fires.
+ * @param [in]  num_servos    The number of motors.
+ * @param [in]  on_completion Coast, brake, or hold, as for ::pbio_servo_stop.
+ */
+static void pbio_trigger_start(pbio_trigger_t *trigger, pbio_trigger_condition_t condition, int32_t threshold, bool edge, pbio_servo_t **servos, uint8_t num_servos, pbio_control_on_completion_t on_completion) {
+    for (uint8_t i = 0; i < num_servos; i++) {
+        trigger->servos[i] = servos[i];
+    }
+    trigger->num_servos = num_servos;
+    trigger->on_completion = on_completion;
+    trigger->condition = condition;
+    trigger->threshold = threshold;
+    trigger->was_clear = !edge;
+    trigger->err = PBIO_ERROR_AGAIN;
+    trigger->armed = true;
+    pbio_trigger_update(trigger);
+}
+
+/**
+ * Starts a trigger on one value of a LEGO UART device mode.
+ *
+ * The mode is set if needed. Floating point values are truncated to integers.
+ *
+ * @param [out] trigger     The trigger instance.
+ * @param [in]  port        The port of the sensor.
+ * @param [in]  mode        The mode to use.
+ * @param [in]  index       Index of the value within the mode data.
+ * @param [in]  condition   The condition on the value.
+ * @param [in]  threshold   The value to compare against.
+ * @param [in]  edge        If true, fire only when the condition changes from
+ *                          false to true. Otherwise also fire if it is true
+ *                          right away.
+ * @param [in]  servos      Motors to stop as soon as the trigger fires,
+ *                          including when it fires right away.
+ * @param [in]  num_servos  The number of motors.
+ * @param [in]  on_completion Coast, brake, or hold, as for ::pbio_servo_stop.
+ * @return                  ::PBIO_SUCCESS on success.
+ *                          ::PBIO_ERROR_INVALID_ARG if the mode or index is
+ *                          not valid or if there are too many motors.
+ *                          ::PBIO_ERROR_BUSY if all triggers are in use.
+ *                          Otherwise errors as for ::pbio_port_get_lump_device.
+ */
+pbio_error_t pbio_trigger_start_lump(pbio_trigger_t **trigger, pbio_port_t *port, uint8_t mode, uint8_t index, pbio_trigger_condition_t condition, int32_t threshold, bool edge, pbio_servo_t **servos, uint8_t num_servos, pbio_control_on_completion_t on_completion) {
+
+    if (num_servos > PBIO_TRIGGER_NUM_SERVOS) {
+        return PBIO_ERROR_INVALID_ARG;
+    }
+
+    lego_device_type_id_t type_id = LEGO_DEVICE_TYPE_ID_ANY_LUMP_UART;
+    pbio_port_lump_dev_t *lump_dev;
+    pbio_error_t err = pbio_port_get_lump_device(port, &type_id, &lump_dev);
+    if (err != PBIO_SUCCESS) {
+        return err;
+    }
+
+    uint8_t num_modes;
+    uint8_t current_mode;
+    pbio_port_lump_mode_info_t *mode_info;
+    err = pbio_port_lump_get_info(lump_dev, &num_modes, &current_mode, &mode_info);
+    if (err != PBIO_SUCCESS) {
+        return err;
+    }
+    if (mode >= num_modes || index >= mode_info[mode].num_values) {
+        return PBIO_ERROR_INVALID_ARG;
+    }
+
+    err = pbio_port_lump_set_mode(lump_dev, mode);
+    if (err != PBIO_SUCCESS) {
+        return err;
+    }
+
+    pbio_trigger_t *t = pbio_trigger_get_free(port);
+    if (!t) {
+        return PBIO_ERROR_BUSY;
+    }
+
+    t->lump_dev = lump_dev;
+    t->mode = mode;
+    t->index = index;
+    t->data_type = mode_info[mode].data_type;
+    pbio_trigger_start(t, condition, threshold, edge, servos, num_servos, on_completion);
+    *trigger = t;
+    return PBIO_SUCCESS;
+}
+
+/**
+ * Starts a trigger on the analog value of a passive device, in mV.
+ *
+ * This is only available where the device connection manager reports new
+ * samples, which is currently only on EV3.
+ *
+ * @param [out] trigger     The trigger instance.
+ * @param [in]  port        The port of the sensor.
+ * @param [in]  type_id     The expected device type.
+ * @param [in]  active      Whether to power the device, as for ::pbio_port_get_analog_value.
+ * @param [in]  condition   The condition on the value.
+ * @param [in]  threshold   The value to compare against.
+ * @param [in]  edge        Whether the condition must become true, as for ::pbio_trigger_start_lump.
+ * @param [in]  servos      Motors to stop, as for ::pbio_trigger_start_lump.
+ * @param [in]  num_servos  The number of motors.
+ * @param [in]  on_completion Coast, brake, or hold, as for ::pbio_servo_stop.
+ * @return                  ::PBIO_SUCCESS on success.
+ *                          ::PBIO_ERROR_NOT_SUPPORTED if not available on this platform.
+ *                          ::PBIO_ERROR_INVALID_ARG if there are too many motors.
+ *                          ::PBIO_ERROR_BUSY if all triggers are in use.
+ *                          Otherwise errors as for ::pbio_port_get_analog_value.
+ */
+pbio_error_t pbio_trigger_start_analog(pbio_trigger_t **trigger, pbio_port_t *port, lego_device_type_id_t type_id, bool active, pbio_trigger_condition_t condition, int32_t threshold, bool edge, pbio_servo_t **servos, uint8_t num_servos, pbio_control_on_completion_t on_completion) {
+
+    // Only the EV3 connection manager calls pbio_trigger_dcm_data_received.
+    if (!PBIO_CONFIG_PORT_DCM_EV3) {
+        return PBIO_ERROR_NOT_SUPPORTED;
+    }
+
+    if (num_servos > PBIO_TRIGGER_NUM_SERVOS) {
+        return PBIO_ERROR_INVALID_ARG;
+    }
+
+    // Test that the device is there before using it.
+    uint32_t value;
+    pbio_error_t err = pbio_port_get_analog_value(port, type_id, active, &value);
+    if (err != PBIO_SUCCESS) {
+        return err;
+    }
+
+    pbio_port_dcm_t *dcm;
+    err = pbio_port_get_dcm(port, &dcm);
+    if (err != PBIO_SUCCESS) {
+        return err;
+    }
+
+    pbio_trigger_t *t = pbio_trigger_get_free(port);
+    if (!t) {
+        return PBIO_ERROR_BUSY;
+    }
+
+    t->dcm = dcm;
+    t->type_id = type_id;
+    t->analog_active = active;
+    pbio_trigger_start(t, condition, threshold, edge, servos, num_servos, on_completion);
+    *trigger = t;
+    return PBIO_SUCCESS;
+}
+
+/**
+ * Disarms the trigger and releases it.
+ *
+ * Motor commands that would end when this trigger fires continue normally,
+ * so they are not affected if the trigger is reused later.
+ *
+ * @param [in]  trigger     The trigger instance.
+ */
+void pbio_trigger_stop(pbio_trigger_t *trigger) {
+    if (trigger->armed) {
+        trigger->err = PBIO_ERROR_CANCELED;
+        trigger->armed = false;
+    }
+    trigger->port = NULL;
+
+    pbio_servo_clear_stop_trigger(trigger);
+    #if PBIO_CONFIG_NUM_DRIVEBASES
+    pbio_drivebase_clear_stop_trigger(trigger);
+    #endif
+}
+
+/**
+ * Stops all triggers. Called when the user application ends.
+ */
+void pbio_trigger_stop_all(void) {
+    for (uint8_t i = 0; i < PBIO_CONFIG_TRIGGER_NUM_DEV; i++) {
+        pbio_trigger_stop(&triggers[i]);
+    }
+}
+
+/**
+ * Gets the result of the trigger.
+ *
+ * @param [in]  trigger     The trigger instance.
+ * @param [out] value       The value that fired the trigger.
+ * @param [out] time        The time in ms when it fired.
+ * @return                  ::PBIO_SUCCESS if fired.
+ *                          ::PBIO_ERROR_AGAIN if still waiting.
+ *                          ::PBIO_ERROR_CANCELED if stopped before it fired.
+ *                          Otherwise the error that stopped the trigger.
+ */
+pbio_error_t pbio_trigger_get_result(pbio_trigger_t *trigger, int32_t *value, uint32_t *time) {
+    *value = trigger->value;
+    *time = trigger->time;
+    return trigger->err;
+}
+
+#endif // PBIO_CONFIG_TRIGGER_NUM_DEV
@@ -1,5 +1,5 @@
 // SPDX-License-Identifier: MIT
-// Copyright (c) 2021 The Pybricks Authors
+// Copyright (c) 2021-2026 The Pybricks Authors
 
 #include <stdbool.h>
 #include <stdint.h>
@@ -91,3 +91,30 @@ bool pbio_oneshot(bool value, bool *state) {
 bool pbio_util_time_has_passed(uint32_t sample, uint32_t base) {
     return sample - base < UINT32_MAX / 2;
 }
+
+/**
+ * Computes the CRC-32 (IEEE 802.3) checksum of a buffer.
+ *
+ * This uses a 16-entry table, processing four bits at a time. This is several
+ * times faster than the bitwise version while costing only 64 bytes of flash.
+ *
+ * @param [in]  crc     The CRC of the preceding data, or 0 to start a new one.
+ * @param [in]  data    The data.
+ * @param [in]  size    The size of the data in bytes.
+ * @return              The updated CRC.
+ */
+uint32_t pbio_crc32(uint32_t crc, const uint8_t *data, uint32_t size) {
+    static const uint32_t table[16] = {
+        0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC,
+        0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+        0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C,
+        0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C,
+    };
+
+    crc = ~crc;
+    for (uint32_t i = 0; i < size; i++) {
+        crc = table[(crc ^ data[i]) & 0x0F] ^ (crc >> 4);
+        crc = table[(crc ^ (data[i] >> 4)) & 0x0F] ^ (crc >> 4);
+    }
+    return ~crc;
+}
@@ -1,5 +1,5 @@
 // SPDX-License-Identifier: MIT
-// Copyright (c) 2018-2022 The Pybricks Authors
+// Copyright (c) 2018-2026 The Pybricks Authors
 
 #include <pbsys/config.h>
 
@@ -23,6 +23,8 @@
 #include <pbsys/status.h>
 #include <pbsys/storage.h>
 
+#include "storage.h"
+
 /**
  * State of incoming program data.
  */
@@ -74,6 +76,19 @@ void pbsys_storage_poll(void) {
 static pbsys_storage_data_map_t *map;
 static bool data_map_write_on_shutdown = false;
 
+#if PBSYS_CONFIG_STORAGE_BACKGROUND_WRITE
+/**
+ * How long the data must be left unchanged before it is saved in the
+ * background, so that a burst of changes leads to just one write.
+ */
+#define PBSYS_STORAGE_BACKGROUND_WRITE_DELAY_MS (1000)
+
+/**
+ * Restarted each time the data changes.
+ */
+static pbio_os_timer_t background_write_timer;
+#endif // PBSYS_CONFIG_STORAGE_BACKGROUND_WRITE
+
 /**
  * Gets program size or the total size of the sequentially stored slots.
  *
@@ -115,6 +130,9 @@ pbsys_storage_settings_t *pbsys_storage_settings_get_settings(void) {
  */
 void pbsys_storage_request_write(void) {
     data_map_write_on_shutdown = true;
+    #if PBSYS_CONFIG_STORAGE_BACKGROUND_WRITE
+    pbio_os_timer_set(&background_write_timer, PBSYS_STORAGE_BACKGROUND_WRITE_DELAY_MS);
+    #endif // PBSYS_CONFIG_STORAGE_BACKGROUND_WRITE
 }
 
 /**
@@ -359,12 +377,58 @@ void pbsys_storage_get_program_data(pbsys_main_program_t *program) {
     program->user_ram_end = ((void *)map) + PBDRV_CONFIG_BLOCK_DEVICE_RAM_SIZE;
 }
 
+#if PBSYS_CONFIG_STORAGE_BACKGROUND_WRITE
+
+static pbio_os_process_t pbsys_storage_background_write_process;
+
+/**
+ * This process saves data while the hub is idle, so that there is little or
+ * nothing left to do on shutdown.
+ */
+static pbio_error_t pbsys_storage_background_write_process_thread(pbio_os_state_t *state, void *context) {
+
+    pbio_error_t err;
+
+    static pbio_os_state_t sub;
+
+    PBIO_OS_ASYNC_BEGIN(state);
+
+    for (;;) {
+        // Wait for changes that have settled while nothing else is going on.
+        PBIO_OS_AWAIT_UNTIL(state, data_map_write_on_shutdown &&
+            pbio_os_timer_is_expired(&background_write_timer) &&
+            !pbsys_status_test(PBIO_PYBRICKS_STATUS_USER_PROGRAM_RUNNING) &&
+            !pbsys_status_test(PBIO_PYBRICKS_STATUS_FILE_IO_IN_PROGRESS) &&
+            !pbsys_status_test(PBIO_PYBRICKS_STATUS_SHUTDOWN_REQUEST));
+
+        // Changes made from here on are saved next time.
+        data_map_write_on_shutdown = false;
+
+        // The driver yields after each flash operation, so this runs along
+        // with everything else. It is fine if a program starts meanwhile.
+        pbsys_status_set(PBIO_PYBRICKS_STATUS_STORAGE_WRITE_IN_PROGRESS);
+        PBIO_OS_AWAIT(state, &sub, err = pbdrv_block_device_write_all(&sub,
+            sizeof(pbsys_storage_data_map_t) + pbsys_storage_get_used_program_data_size()));
+        pbsys_status_clear(PBIO_PYBRICKS_STATUS_STORAGE_WRITE_IN_PROGRESS);
+
+        // Leave it to shutdown to try again.
+        if (err != PBIO_SUCCESS) {
+            data_map_write_on_shutdown = true;
+            return err;
+        }
+    }
+
+    PBIO_OS_ASYNC_END(PBIO_SUCCESS);
+}
+
+#endif // PBSYS_CONFIG_STORAGE_BACKGROUND_WRITE
+
 /**
  * This process saves data on shutdown.
  */
 static pbio_error_t pbsys_storage_deinit_process_thread(pbio_os_state_t *state, void *context) {
 
-    pbio_error_t err = PBIO_ERROR_AGAIN;
+    pbio_error_t err = PBIO_SUCCESS;
 
     static pbio_os_state_t sub;
 
@@ -372,10 +436,18 @@ static pbio_error_t pbsys_storage_deinit_process_thread(pbio_os_state_t *state,
 
     PBIO_OS_ASYNC_BEGIN(state);
 
-    write_size = sizeof(pbsys_storage_data_map_t) + pbsys_storage_get_used_program_data_size();
-
-    // Write the data.
-    PBIO_OS_AWAIT(state, &sub, err = pbdrv_block_device_write_all(&sub, write_size));
+    // Let saving in the background finish first. Saved values are written
+    // before powering off, too.
+    PBIO_OS_AWAIT_UNTIL(state, pbsys_storage_kv_is_idle() &&
+        !pbsys_status_test(PBIO_PYBRICKS_STATUS_STORAGE_WRITE_IN_PROGRESS));
+
+    // Write the data if anything changed since then.
+    if (data_map_write_on_shutdown) {
+        pbsys_status_set(PBIO_PYBRICKS_STATUS_STORAGE_WRITE_IN_PROGRESS);
+        write_size = sizeof(pbsys_storage_data_map_t) + pbsys_storage_get_used_program_data_size();
+        PBIO_OS_AWAIT(state, &sub, err = pbdrv_block_device_write_all(&sub, write_size));
+        pbsys_status_clear(PBIO_PYBRICKS_STATUS_STORAGE_WRITE_IN_PROGRESS);
+    }
 
     // Deinitialization done.
     pbio_busy_count_down();
@@ -398,6 +470,13 @@ void pbsys_storage_init(void) {
 
     // Apply loaded settings as necesary.
     pbsys_storage_settings_apply_loaded_settings(&map->settings);
+
+    // Start loading saved values from the journal.
+    pbsys_storage_kv_init();
+
+    #if PBSYS_CONFIG_STORAGE_BACKGROUND_WRITE
+    pbio_os_process_start(&pbsys_storage_background_write_process, pbsys_storage_background_write_process_thread, NULL);
+    #endif // PBSYS_CONFIG_STORAGE_BACKGROUND_WRITE
 }
 
 static pbio_os_process_t pbsys_storage_deinit_process;
@@ -407,8 +486,8 @@ static pbio_os_process_t pbsys_storage_deinit_process;
  */
 void pbsys_storage_deinit(void) {
 
-    // If writing not requested, don't write.
-    if (!data_map_write_on_shutdown) {
+    // If writing not requested and nothing is being written, don't write.
+    if (!data_map_write_on_shutdown && !pbsys_status_test(PBIO_PYBRICKS_STATUS_STORAGE_WRITE_IN_PROGRESS)) {
         return;
     }
 
@@ -1,9 +1,10 @@
 // SPDX-License-Identifier: MIT
-// Copyright (c) 2022 The Pybricks Authors
+// Copyright (c) 2022-2026 The Pybricks Authors
 
 #ifndef _PBSYS_SYS_STORAGE_H_
 #define _PBSYS_SYS_STORAGE_H_
 
+#include <stdbool.h>
 #include <stdint.h>
 
 #include <pbio/error.h>
@@ -51,4 +52,18 @@ static inline void pbsys_storage_get_program_data(pbsys_main_program_t *program)
 
 #endif // PBSYS_CONFIG_STORAGE
 
+#if PBSYS_CONFIG_STORAGE_KV_SIZE
+
+void pbsys_storage_kv_init(void);
+bool pbsys_storage_kv_is_idle(void);
+
+#else
+static inline void pbsys_storage_kv_init(void) {
+}
+static inline bool pbsys_storage_kv_is_idle(void) {
+    return true;
+}
+
+#endif // PBSYS_CONFIG_STORAGE_KV_SIZE
+
 #endif // _PBSYS_SYS_STORAGE_H_
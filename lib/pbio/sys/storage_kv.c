@@ -0,0 +1,403 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2026 The Pybricks Authors
+
+// Log-structured key-value store in the journal area of the block device.
+//
+// One of the journal sectors is active at a time. It starts with a header
+// that holds a sequence number, followed by records that are only ever
+// appended. Saving a value therefore takes just one or two page programs. Each
+// record has a checksum, so a record that was partially written when power was
+// lost is ignored on the next boot.
+//
+// When the active sector fills up, the latest value of each key is copied to
+// the next sector. Its header is written last, so the old sector stays valid
+// until the new one is complete.
+//
+// A copy of the active sector is kept in RAM, so that values can be looked up
+// without accessing the flash.
+
+#include <pbsys/config.h>
+
+#if PBSYS_CONFIG_STORAGE_KV_SIZE
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <pbdrv/block_device.h>
+
+#include <pbio/busy_count.h>
+#include <pbio/os.h>
+#include <pbio/util.h>
+
+#include <pbsys/storage.h>
+
+#include "storage.h"
+
+#if PBSYS_CONFIG_STORAGE_KV_SIZE > PBDRV_CONFIG_BLOCK_DEVICE_JOURNAL_SECTOR_SIZE
+#error "Key-value store must fit in one journal sector."
+#endif
+
+/**
+ * Marks a valid sector header. Reads as "PBKV" on flash.
+ */
+#define KV_MAGIC (0x564B4250)
+
+/**
+ * Sector header: magic (4 bytes), sequence number (4 bytes).
+ */
+#define KV_HEADER_SIZE (8)
+
+/**
+ * Record header: key size (1 byte), value size (1 byte), CRC-32 (4 bytes).
+ *
+ * The key and value follow the header. The CRC covers the sizes, the key, and
+ * the value. A key size of 0xFF means that the rest of the sector is erased.
+ */
+#define KV_RECORD_HEADER_SIZE (6)
+
+static struct {
+    /** Copy of the active sector, including its header. */
+    uint8_t data[PBSYS_CONFIG_STORAGE_KV_SIZE];
+    /** Number of bytes used in data, or 0 if the store is not available. */
+    uint32_t size;
+    /** Number of bytes of data that are saved in the active sector. */
+    uint32_t size_saved;
+    /** Offset of the active sector in the journal. */
+    uint32_t sector;
+    /** Whether data must be copied to the next sector before appending. */
+    bool rewrite;
+    /** Result of the most recent flash operation. */
+    pbio_error_t err;
+} kv;
+
+/**
+ * Gets the size of the record at the given offset.
+ *
+ * @param [in]  offset  Offset of the record in the store.
+ * @return              Size of the record including its header.
+ */
+static uint32_t kv_record_size(uint32_t offset) {
+    return KV_RECORD_HEADER_SIZE + kv.data[offset] + kv.data[offset + 1];
+}
+
+/**
+ * Computes the checksum of the record at the given offset.
+ *
+ * @param [in]  offset  Offset of the record in the store.
+ * @return              CRC-32 of the sizes, key, and value.
+ */
+static uint32_t kv_record_crc(uint32_t offset) {
+    uint32_t crc = pbio_crc32(0, &kv.data[offset], 2);
+    return pbio_crc32(crc, &kv.data[offset + KV_RECORD_HEADER_SIZE], kv.data[offset] + kv.data[offset + 1]);
+}
+
+/**
+ * Finds the most recent record for a key.
+ *
+ * @param [in]  key       The key.
+ * @param [in]  key_size  Size of the key.
+ * @param [in]  start     Offset from which to start searching.
+ * @return                Offset of the record, or 0 if not found.
+ */
+static uint32_t kv_find(const uint8_t *key, uint32_t key_size, uint32_t start) {
+    uint32_t found = 0;
+    for (uint32_t offset = start; offset < kv.size; offset += kv_record_size(offset)) {
+        if (kv.data[offset] == key_size && !memcmp(&kv.data[offset + KV_RECORD_HEADER_SIZE], key, key_size)) {
+            found = offset;
+        }
+    }
+    return found;
+}
+
+/**
+ * Keeps only the most recent value of each key and drops deleted keys.
+ *
+ * If this frees up space, the result must be written to the next sector.
+ */
+static void kv_compact(void) {
+    uint32_t size = KV_HEADER_SIZE;
+
+    for (uint32_t offset = KV_HEADER_SIZE; offset < kv.size; offset += kv_record_size(offset)) {
+        // Skip deleted keys and keys that have a newer record.
+        if (kv.data[offset + 1] == 0 ||
+            kv_find(&kv.data[offset + KV_RECORD_HEADER_SIZE], kv.data[offset], offset + kv_record_size(offset))) {
+            continue;
+        }
+        // Records only move down, so later records are not affected.
+        memmove(&kv.data[size], &kv.data[offset], kv_record_size(offset));
+        size += kv_record_size(offset);
+    }
+
+    if (size == kv.size) {
+        return;
+    }
+
+    kv.size = size;
+    kv.rewrite = true;
+}
+
+/**
+ * Loads the active sector from the journal.
+ *
+ * @param [in]  state   Protothread state.
+ * @return              ::PBIO_SUCCESS on success or a driver error.
+ */
+static pbio_error_t kv_load(pbio_os_state_t *state) {
+
+    static pbio_os_state_t sub;
+    static uint32_t offset;
+    static uint32_t sequence;
+    static uint8_t header[KV_HEADER_SIZE];
+    pbio_error_t err;
+
+    PBIO_OS_ASYNC_BEGIN(state);
+
+    // Find the valid sector with the newest sequence number.
+    kv.size = 0;
+    for (offset = 0; offset < PBDRV_CONFIG_BLOCK_DEVICE_JOURNAL_NUM_SECTORS * PBDRV_CONFIG_BLOCK_DEVICE_JOURNAL_SECTOR_SIZE;
+         offset += PBDRV_CONFIG_BLOCK_DEVICE_JOURNAL_SECTOR_SIZE) {
+        PBIO_OS_AWAIT(state, &sub, err = pbdrv_block_device_journal_read(&sub, offset, header, sizeof(header)));
+        if (err != PBIO_SUCCESS) {
+            return err;
+        }
+        if (pbio_get_uint32_le(&header[0]) != KV_MAGIC) {
+            continue;
+        }
+        if (kv.size == 0 || (int32_t)(pbio_get_uint32_le(&header[4]) - sequence) > 0) {
+            sequence = pbio_get_uint32_le(&header[4]);
+            kv.sector = offset;
+            kv.size = KV_HEADER_SIZE;
+        }
+    }
+
+    // If nothing was saved yet, start with an empty store. This formats the
+    // first sector once.
+    if (kv.size == 0) {
+        pbio_set_uint32_le(&kv.data[0], KV_MAGIC);
+        pbio_set_uint32_le(&kv.data[4], 0);
+        kv.sector = (PBDRV_CONFIG_BLOCK_DEVICE_JOURNAL_NUM_SECTORS - 1) * PBDRV_CONFIG_BLOCK_DEVICE_JOURNAL_SECTOR_SIZE;
+        kv.size = KV_HEADER_SIZE;
+        kv.size_saved = KV_HEADER_SIZE;
+        kv.rewrite = true;
+        return PBIO_SUCCESS;
+    }
+
+    PBIO_OS_AWAIT(state, &sub, err = pbdrv_block_device_journal_read(&sub, kv.sector, kv.data, sizeof(kv.data)));
+    if (err != PBIO_SUCCESS) {
+        kv.size = 0;
+        return err;
+    }
+
+    // Find the end of the log. If the last record is incomplete, the
+    // remaining space may not be erased, so copy the valid records to the
+    // next sector before appending anything.
+    while (kv.size + KV_RECORD_HEADER_SIZE <= sizeof(kv.data) && kv.data[kv.size] != 0xFF) {
+        if (kv.data[kv.size] == 0 || kv.size + kv_record_size(kv.size) > sizeof(kv.data) ||
+            kv_record_crc(kv.size) != pbio_get_uint32_le(&kv.data[kv.size + 2])) {
+            kv.rewrite = true;
+            break;
+        }
+        kv.size += kv_record_size(kv.size);
+    }
+    kv.size_saved = kv.size;
+
+    PBIO_OS_ASYNC_END(PBIO_SUCCESS);
+}
+
+static pbio_os_process_t pbsys_storage_kv_process;
+
+/**
+ * Loads the store and then saves changes to the journal as they come in.
+ */
+static pbio_error_t pbsys_storage_kv_process_thread(pbio_os_state_t *state, void *context) {
+
+    static pbio_os_state_t sub;
+    static uint32_t size;
+    static uint32_t sector;
+    pbio_error_t err;
+
+    PBIO_OS_ASYNC_BEGIN(state);
+
+    PBIO_OS_AWAIT(state, &sub, kv.err = kv_load(&sub));
+    pbio_busy_count_down();
+
+    // Store is not available if loading failed.
+    if (kv.err != PBIO_SUCCESS) {
+        return kv.err;
+    }
+
+    for (;;) {
+        PBIO_OS_AWAIT_UNTIL(state, kv.rewrite || kv.size_saved < kv.size);
+        pbio_busy_count_up();
+
+        // Values saved from here on are written next time.
+        size = kv.size;
+
+        if (kv.rewrite) {
+            sector = (kv.sector + PBDRV_CONFIG_BLOCK_DEVICE_JOURNAL_SECTOR_SIZE) %
+                (PBDRV_CONFIG_BLOCK_DEVICE_JOURNAL_NUM_SECTORS * PBDRV_CONFIG_BLOCK_DEVICE_JOURNAL_SECTOR_SIZE);
+            pbio_set_uint32_le(&kv.data[4], pbio_get_uint32_le(&kv.data[4]) + 1);
+
+            PBIO_OS_AWAIT(state, &sub, err = pbdrv_block_device_journal_erase(&sub, sector));
+            if (err == PBIO_SUCCESS && size > KV_HEADER_SIZE) {
+                PBIO_OS_AWAIT(state, &sub, err = pbdrv_block_device_journal_write(&sub,
+                    sector + KV_HEADER_SIZE, &kv.data[KV_HEADER_SIZE], size - KV_HEADER_SIZE));
+            }
+            // Writing the header last makes this sector the active one.
+            if (err == PBIO_SUCCESS) {
+                PBIO_OS_AWAIT(state, &sub, err = pbdrv_block_device_journal_write(&sub, sector, kv.data, KV_HEADER_SIZE));
+            }
+            if (err == PBIO_SUCCESS) {
+                kv.sector = sector;
+            }
+        } else {
+            PBIO_OS_AWAIT(state, &sub, err = pbdrv_block_device_journal_write(&sub,
+                kv.sector + kv.size_saved, &kv.data[kv.size_saved], size - kv.size_saved));
+        }
+
+        // On failure, the flash no longer matches what is in RAM, so the
+        // store is made unavailable. The error is reported to whoever is
+        // waiting for the save to complete.
+        if (err != PBIO_SUCCESS) {
+            kv.err = err;
+            kv.size = 0;
+            kv.size_saved = 0;
+            kv.rewrite = false;
+            pbio_busy_count_down();
+            return err;
+        }
+
+        kv.size_saved = size;
+        kv.rewrite = false;
+
+        pbio_busy_count_down();
+    }
+
+    // Unreachable.
+    PBIO_OS_ASYNC_END(PBIO_ERROR_FAILED);
+}
+
+/**
+ * Starts loading the key-value store.
+ */
+void pbsys_storage_kv_init(void) {
+    pbio_busy_count_up();
+    pbio_os_process_start(&pbsys_storage_kv_process, pbsys_storage_kv_process_thread, NULL);
+}
+
+/**
+ * Tests whether all values have been saved to storage.
+ *
+ * @return  True if nothing is being written, false otherwise.
+ */
+bool pbsys_storage_kv_is_idle(void) {
+    return !kv.rewrite && kv.size_saved == kv.size;
+}
+
+/**
+ * Gets the most recently saved value of a key.
+ *
+ * @param [in]  key         The key.
+ * @param [in]  key_size    Size of the key.
+ * @param [out] value       The value, or NULL if the key was not found. Only
+ *                          valid until the next value is saved.
+ * @param [out] value_size  Size of the value.
+ * @return                  ::PBIO_SUCCESS on success, whether found or not.
+ *                          ::PBIO_ERROR_IO if the store could not be loaded or saved.
+ */
+pbio_error_t pbsys_storage_kv_get(const uint8_t *key, uint32_t key_size, const uint8_t **value, uint32_t *value_size) {
+    *value = NULL;
+    *value_size = 0;
+
+    if (kv.size == 0) {
+        return PBIO_ERROR_IO;
+    }
+
+    uint32_t offset = kv_find(key, key_size, KV_HEADER_SIZE);
+    if (offset == 0 || kv.data[offset + 1] == 0) {
+        return PBIO_SUCCESS;
+    }
+
+    *value = &kv.data[offset + KV_RECORD_HEADER_SIZE + kv.data[offset]];
+    *value_size = kv.data[offset + 1];
+    return PBIO_SUCCESS;
+}
+
+/**
+ * Saves a value for a key. This takes effect immediately for
+ * ::pbsys_storage_kv_get, while it is written to storage in the background.
+ * Use ::pbsys_storage_kv_await_saved to wait until it is safely stored.
+ *
+ * @param [in]  key         The key. Must be 1 to 254 bytes.
+ * @param [in]  key_size    Size of the key.
+ * @param [in]  value       The value. Must be at most 255 bytes.
+ * @param [in]  value_size  Size of the value. Choose 0 to delete the key.
+ * @return                  ::PBIO_SUCCESS on success.
+ *                          ::PBIO_ERROR_INVALID_ARG if the key or value size is invalid.
+ *                          ::PBIO_ERROR_BUSY if the store is full and still being written.
+ *                          ::PBIO_ERROR_FAILED if the store is full.
+ *                          ::PBIO_ERROR_IO if the store could not be loaded or saved.
+ */
+pbio_error_t pbsys_storage_kv_set(const uint8_t *key, uint32_t key_size, const uint8_t *value, uint32_t value_size) {
+
+    if (key_size == 0 || key_size >= 0xFF || value_size > 0xFF) {
+        return PBIO_ERROR_INVALID_ARG;
+    }
+
+    if (kv.size == 0) {
+        return PBIO_ERROR_IO;
+    }
+
+    uint32_t record_size = KV_RECORD_HEADER_SIZE + key_size + value_size;
+
+    // If it doesn't fit, drop old values first. This moves data around in RAM,
+    // so it can only be done if nothing is currently being written.
+    if (kv.size + record_size > sizeof(kv.data)) {
+        if (!pbsys_storage_kv_is_idle()) {
+            return PBIO_ERROR_BUSY;
+        }
+        kv_compact();
+        if (kv.size + record_size > sizeof(kv.data)) {
+            return PBIO_ERROR_FAILED;
+        }
+    }
+
+    // Append the record. Data beyond kv.size is not being written, so this is
+    // safe even if a previous record is still being saved.
+    uint8_t *record = &kv.data[kv.size];
+    record[0] = key_size;
+    record[1] = value_size;
+    memcpy(&record[KV_RECORD_HEADER_SIZE], key, key_size);
+    if (value_size) {
+        memcpy(&record[KV_RECORD_HEADER_SIZE + key_size], value, value_size);
+    }
+    pbio_set_uint32_le(&record[2], kv_record_crc(kv.size));
+    kv.size += record_size;
+
+    pbio_os_request_poll();
+    return PBIO_SUCCESS;
+}
+
+/**
+ * Waits until all values have been saved to storage.
+ *
+ * @param [in]  state   Protothread state.
+ * @return              ::PBIO_SUCCESS on success or a driver error if writing failed.
+ */
+pbio_error_t pbsys_storage_kv_await_saved(pbio_os_state_t *state) {
+
+    pbio_error_t err;
+
+    PBIO_OS_ASYNC_BEGIN(state);
+
+    PBIO_OS_AWAIT_UNTIL(state, pbsys_storage_kv_is_idle());
+
+    // Report error only once.
+    err = kv.err;
+    kv.err = PBIO_SUCCESS;
+
+    PBIO_OS_ASYNC_END(err);
+}
+
+#endif // PBSYS_CONFIG_STORAGE_KV_SIZE
@@ -1,5 +1,5 @@
 // SPDX-License-Identifier: MIT
-// Copyright (c) 2020-2021 The Pybricks Authors
+// Copyright (c) 2020-2026 The Pybricks Authors
 
 #include <assert.h>
 #include <stdbool.h>
@@ -104,6 +104,25 @@ bool pbio_test_bluetooth_is_advertising_enabled(void) {
     return advertising_enabled;
 }
 
+static uint8_t advertising_data[31];
+static uint8_t advertising_data_size;
+static uint32_t advertising_data_count;
+
+/**
+ * Gets the advertising data most recently received by the Bluetooth chip.
+ */
+void pbio_test_bluetooth_get_advertising_data(const uint8_t **data, uint8_t *size) {
+    *data = advertising_data;
+    *size = advertising_data_size;
+}
+
+/**
+ * This count increases each time the hub sets the advertising data.
+ */
+uint32_t pbio_test_bluetooth_get_advertising_data_count(void) {
+    return advertising_data_count;
+}
+
 bool pbio_test_bluetooth_is_connected(void) {
     return hci_connection_for_handle(0x0400) != NULL;
 }
@@ -337,6 +356,9 @@ static void handle_send(const uint8_t *buffer, uint16_t length) {
                     break;
                 case 0x2008: // LE Set Advertising Data
                     log_debug("advertising data, len %d", buffer[4]);
+                    advertising_data_size = buffer[4] < sizeof(advertising_data) ? buffer[4] : sizeof(advertising_data);
+                    memcpy(advertising_data, &buffer[5], advertising_data_size);
+                    advertising_data_count++;
                     queue_command_complete(opcode, 0x00);
                     break;
                 case 0x2009: // LE Set Scan Response Data
@@ -0,0 +1,83 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2026 The Pybricks Authors
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <tinytest.h>
+#include <tinytest_macros.h>
+
+#include <pbdrv/clock.h>
+#include <pbdrv/i2c.h>
+#include <pbio/os.h>
+#include <pbio/util.h>
+#include <test-pbio.h>
+
+#include "../../drv/i2c/i2c_test.h"
+
+static pbio_error_t test_i2c_command_list(pbio_os_state_t *state, void *context) {
+
+    static pbio_os_state_t sub;
+    static pbdrv_i2c_dev_t *i2c_dev;
+    static uint8_t *registers;
+    static uint32_t start;
+    static uint8_t result[8];
+    pbio_error_t err;
+
+    static const uint8_t select_first[] = { 0x20 };
+    static const uint8_t write_second[] = { 0x30, 0xAA };
+    static const uint8_t select_second[] = { 0x30 };
+    static const pbdrv_i2c_command_t commands[] = {
+        // Read two registers.
+        { .address = PBDRV_I2C_TEST_ADDRESS, .write_data = select_first, .write_len = 1, .read_len = 2 },
+        // Write a register and wait before going on.
+        { .address = PBDRV_I2C_TEST_ADDRESS, .write_data = write_second, .write_len = 2, .delay = 5 },
+        // Read back what was written, and the register after it.
+        { .address = PBDRV_I2C_TEST_ADDRESS, .write_data = select_second, .write_len = 1, .read_len = 1 },
+        { .address = PBDRV_I2C_TEST_ADDRESS, .read_len = 1 },
+    };
+    static const pbdrv_i2c_command_t bad_address[] = {
+        { .address = PBDRV_I2C_TEST_ADDRESS, .write_data = select_first, .write_len = 1, .read_len = 1 },
+        { .address = PBDRV_I2C_TEST_ADDRESS + 1, .write_data = select_first, .write_len = 1, .read_len = 1 },
+        { .address = PBDRV_I2C_TEST_ADDRESS, .write_data = select_first, .write_len = 1, .read_len = 1 },
+    };
+
+    PBIO_OS_ASYNC_BEGIN(state);
+
+    tt_uint_op(pbdrv_i2c_get_instance(0, &i2c_dev), ==, PBIO_SUCCESS);
+    registers = pbdrv_i2c_test_get_registers(i2c_dev);
+    registers[0x20] = 1;
+    registers[0x21] = 2;
+    registers[0x31] = 7;
+
+    // Whole list runs twice with a single await. The data read by all
+    // commands is collected in order.
+    start = pbdrv_clock_get_ms();
+    PBIO_OS_AWAIT(state, &sub, err = pbdrv_i2c_run_commands(&sub, i2c_dev, commands, PBIO_ARRAY_SIZE(commands), 2, result, sizeof(result), false));
+    tt_want_uint_op(err, ==, PBIO_SUCCESS);
+    tt_want_uint_op(pbdrv_i2c_test_get_transaction_count(i2c_dev), ==, 8);
+    tt_want_uint_op(registers[0x30], ==, 0xAA);
+    static const uint8_t expected[] = { 1, 2, 0xAA, 7, 1, 2, 0xAA, 7 };
+    tt_want(memcmp(result, expected, sizeof(expected)) == 0);
+    tt_want_uint_op(pbdrv_clock_get_ms() - start, >=, 2 * (4 * PBDRV_I2C_TEST_TRANSACTION_TIME + 5));
+
+    // Nothing runs if the result doesn't fit.
+    PBIO_OS_AWAIT(state, &sub, err = pbdrv_i2c_run_commands(&sub, i2c_dev, commands, PBIO_ARRAY_SIZE(commands), 3, result, sizeof(result), false));
+    tt_want_uint_op(err, ==, PBIO_ERROR_INVALID_ARG);
+    tt_want_uint_op(pbdrv_i2c_test_get_transaction_count(i2c_dev), ==, 8);
+
+    // The list stops at the first failed command.
+    PBIO_OS_AWAIT(state, &sub, err = pbdrv_i2c_run_commands(&sub, i2c_dev, bad_address, PBIO_ARRAY_SIZE(bad_address), 1, result, sizeof(result), false));
+    tt_want_uint_op(err, ==, PBIO_ERROR_IO);
+    tt_want_uint_op(pbdrv_i2c_test_get_transaction_count(i2c_dev), ==, 10);
+
+end:
+
+    PBIO_OS_ASYNC_END(PBIO_SUCCESS);
+}
+
+struct testcase_t pbdrv_i2c_tests[] = {
+    PBIO_THREAD_TEST(test_i2c_command_list),
+    END_OF_TESTCASES
+};
@@ -1,5 +1,5 @@
 // SPDX-License-Identifier: MIT
-// Copyright (c) 2020-2021 The Pybricks Authors
+// Copyright (c) 2020-2026 The Pybricks Authors
 
 #include <stdio.h>
 
@@ -609,6 +609,99 @@ static void test_color_hsv_cost(void *env) {
     tt_want_int_op(dist, <, 410000000);
 }
 
+static void test_color_calibration(void *env) {
+    static const int16_t black[] = { 100, 200, 300 };
+    static const int16_t white[] = { 500, 600, 700 };
+    static const int16_t swap_red_blue[] = {
+        0, 0, PBIO_COLOR_CALIBRATION_SCALE,
+        0, PBIO_COLOR_CALIBRATION_SCALE, 0,
+        PBIO_COLOR_CALIBRATION_SCALE, 0, 0,
+    };
+    pbio_color_calibration_t cal;
+    pbio_color_hsv_t hsv;
+
+    // Reset has no color correction.
+    pbio_color_calibration_reset(&cal, black, white);
+    for (int i = 0; i < 9; i++) {
+        tt_want_int_op(cal.matrix[i], ==, i % 4 == 0 ? PBIO_COLOR_CALIBRATION_SCALE : 0);
+    }
+
+    // References are scaled to black and white, and readings outside of
+    // them are bound.
+    int16_t raw_white[] = { 500, 600, 700 };
+    pbio_color_calibration_get_hsv(&cal, raw_white, &hsv);
+    tt_want_int_op(hsv.s, ==, 0);
+    tt_want_int_op(hsv.v, ==, 100);
+
+    int16_t raw_black[] = { 50, 100, 300 };
+    pbio_color_calibration_get_hsv(&cal, raw_black, &hsv);
+    tt_want_int_op(hsv.v, ==, 0);
+
+    int16_t raw_gray[] = { 300, 400, 500 };
+    pbio_color_calibration_get_hsv(&cal, raw_gray, &hsv);
+    tt_want_int_op(hsv.s, ==, 0);
+    tt_want(pbio_test_int_is_close(hsv.v, 50, 1));
+
+    int16_t raw_bright[] = { 900, 1000, 1100 };
+    pbio_color_calibration_get_hsv(&cal, raw_bright, &hsv);
+    tt_want_int_op(hsv.v, ==, 100);
+
+    // Only the red channel is above black.
+    int16_t raw_red[] = { 500, 200, 300 };
+    pbio_color_calibration_get_hsv(&cal, raw_red, &hsv);
+    tt_want_int_op(hsv.h, ==, 0);
+    tt_want_int_op(hsv.s, ==, 100);
+    tt_want_int_op(hsv.v, ==, 100);
+
+    // Matrix is applied after scaling.
+    tt_want_int_op(pbio_color_calibration_set(&cal, black, white, swap_red_blue), ==, PBIO_SUCCESS);
+    pbio_color_calibration_get_hsv(&cal, raw_red, &hsv);
+    tt_want_int_op(hsv.h, ==, 240);
+    tt_want_int_op(hsv.s, ==, 100);
+    tt_want_int_op(hsv.v, ==, 100);
+
+    // Gains above one saturate instead of overflowing.
+    static const int16_t gain[] = {
+        INT16_MAX, 0, 0,
+        0, INT16_MAX, 0,
+        0, 0, INT16_MAX,
+    };
+    tt_want_int_op(pbio_color_calibration_set(&cal, black, white, gain), ==, PBIO_SUCCESS);
+    pbio_color_calibration_get_hsv(&cal, raw_bright, &hsv);
+    tt_want_int_op(hsv.s, ==, 0);
+    tt_want_int_op(hsv.v, ==, 100);
+
+    // Set values read back unchanged.
+    tt_want_int_op(pbio_color_calibration_set(&cal, black, white, swap_red_blue), ==, PBIO_SUCCESS);
+    for (int i = 0; i < 3; i++) {
+        tt_want_int_op(cal.black[i], ==, black[i]);
+        tt_want_int_op(cal.white[i], ==, white[i]);
+    }
+    for (int i = 0; i < 9; i++) {
+        tt_want_int_op(cal.matrix[i], ==, swap_red_blue[i]);
+    }
+
+    // White must be brighter than black in every channel. Errors leave the
+    // calibration as it was.
+    static const int16_t equal[] = { 500, 200, 700 };
+    static const int16_t darker[] = { 500, 600, 299 };
+    static const int16_t identity[] = {
+        PBIO_COLOR_CALIBRATION_SCALE, 0, 0,
+        0, PBIO_COLOR_CALIBRATION_SCALE, 0,
+        0, 0, PBIO_COLOR_CALIBRATION_SCALE,
+    };
+    tt_want_int_op(pbio_color_calibration_set(&cal, black, equal, identity), ==, PBIO_ERROR_INVALID_ARG);
+    tt_want_int_op(pbio_color_calibration_set(&cal, black, darker, identity), ==, PBIO_ERROR_INVALID_ARG);
+    tt_want_int_op(pbio_color_calibration_set(&cal, white, black, identity), ==, PBIO_ERROR_INVALID_ARG);
+    for (int i = 0; i < 3; i++) {
+        tt_want_int_op(cal.black[i], ==, black[i]);
+        tt_want_int_op(cal.white[i], ==, white[i]);
+    }
+    for (int i = 0; i < 9; i++) {
+        tt_want_int_op(cal.matrix[i], ==, swap_red_blue[i]);
+    }
+}
+
 struct testcase_t pbio_color_tests[] = {
     PBIO_TEST(test_rgb_to_hsv),
     PBIO_TEST(test_hsv_to_rgb),
@@ -616,5 +709,6 @@ struct testcase_t pbio_color_tests[] = {
     PBIO_TEST(test_color_to_rgb),
     PBIO_TEST(test_color_hsv_compression),
     PBIO_TEST(test_color_hsv_cost),
+    PBIO_TEST(test_color_calibration),
     END_OF_TESTCASES
 };
@@ -0,0 +1,85 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2026 The Pybricks Authors
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include <pbio/angle.h>
+#include <pbio/config.h>
+#include <pbio/differentiator.h>
+#include <pbio/error.h>
+#include <test-pbio.h>
+
+#include <tinytest.h>
+#include <tinytest_macros.h>
+
+/**
+ * Tests that both speed estimates match a constant speed ramp, including
+ * after the running sum has wrapped around many times.
+ */
+static void test_differentiator_constant_speed(void *env) {
+    pbio_differentiator_t dif;
+    pbio_angle_t angle = { 0 };
+    int32_t speed;
+
+    pbio_differentiator_reset(&dif, &angle);
+    tt_want_int_op(pbio_differentiator_update_and_get_speed(&dif, &angle), ==, 0);
+
+    // Go at 5000 deg/s for long enough that the 32-bit sums wrap around.
+    int32_t increment = 5000 * PBIO_CONFIG_CONTROL_LOOP_TIME_MS;
+    for (uint32_t i = 0; i < 200000; i++) {
+        pbio_angle_add_mdeg(&angle, increment);
+        tt_want_int_op(pbio_differentiator_update_and_get_speed(&dif, &angle), ==, i < PBIO_CONFIG_DIFFERENTIATOR_WINDOW_SIZE ? 5000000 * (i + 1) / PBIO_CONFIG_DIFFERENTIATOR_WINDOW_SIZE : 5000000);
+    }
+
+    // All window sizes and methods should give the same speed.
+    for (uint32_t window = PBIO_CONFIG_CONTROL_LOOP_TIME_MS; window < 300; window += PBIO_CONFIG_CONTROL_LOOP_TIME_MS) {
+        pbio_angle_add_mdeg(&angle, increment);
+        pbio_differentiator_update_and_get_speed(&dif, &angle);
+        tt_want_int_op(pbio_differentiator_get_speed(&dif, window, PBIO_DIFFERENTIATOR_MODE_AVERAGE, &speed), ==, PBIO_SUCCESS);
+        tt_want_int_op(speed, ==, 5000000);
+        tt_want_int_op(pbio_differentiator_get_speed(&dif, window, PBIO_DIFFERENTIATOR_MODE_REGRESSION, &speed), ==, PBIO_SUCCESS);
+        tt_want_int_op(speed, ==, 5000000);
+    }
+
+    // Windows that exceed the buffer are not allowed.
+    tt_want_int_op(pbio_differentiator_get_speed(&dif, 0, PBIO_DIFFERENTIATOR_MODE_AVERAGE, &speed), ==, PBIO_ERROR_INVALID_ARG);
+    tt_want_int_op(pbio_differentiator_get_speed(&dif, PBIO_CONFIG_DIFFERENTIATOR_BUFFER_SIZE * PBIO_CONFIG_CONTROL_LOOP_TIME_MS, PBIO_DIFFERENTIATOR_MODE_AVERAGE, &speed), ==, PBIO_ERROR_INVALID_ARG);
+    tt_want_int_op(pbio_differentiator_get_speed(&dif, UINT32_MAX - 1000, PBIO_DIFFERENTIATOR_MODE_AVERAGE, &speed), ==, PBIO_ERROR_INVALID_ARG);
+}
+
+/**
+ * Tests that the regression estimate rejects an outlier at the window edge
+ * better than the average speed.
+ */
+static void test_differentiator_regression(void *env) {
+    pbio_differentiator_t dif;
+    pbio_angle_t angle = { 0 };
+    int32_t average;
+    int32_t regression;
+
+    pbio_differentiator_reset(&dif, &angle);
+
+    // Hold still except for one sample that jumps by 10 degrees.
+    for (uint32_t i = 0; i < PBIO_CONFIG_DIFFERENTIATOR_BUFFER_SIZE; i++) {
+        pbio_differentiator_update_and_get_speed(&dif, &angle);
+    }
+    pbio_angle_add_mdeg(&angle, 10000);
+    pbio_differentiator_update_and_get_speed(&dif, &angle);
+    pbio_angle_add_mdeg(&angle, -10000);
+    pbio_differentiator_update_and_get_speed(&dif, &angle);
+    pbio_angle_add_mdeg(&angle, 10000);
+    pbio_differentiator_update_and_get_speed(&dif, &angle);
+
+    tt_want_int_op(pbio_differentiator_get_speed(&dif, 50, PBIO_DIFFERENTIATOR_MODE_AVERAGE, &average), ==, PBIO_SUCCESS);
+    tt_want_int_op(pbio_differentiator_get_speed(&dif, 50, PBIO_DIFFERENTIATOR_MODE_REGRESSION, &regression), ==, PBIO_SUCCESS);
+    tt_want_int_op(average, ==, 10000 * (1000 / 50));
+    tt_want_int_op(regression, <, average);
+    tt_want_int_op(regression, >, 0);
+}
+
+struct testcase_t pbio_differentiator_tests[] = {
+    PBIO_TEST(test_differentiator_constant_speed),
+    PBIO_TEST(test_differentiator_regression),
+    END_OF_TESTCASES
+};
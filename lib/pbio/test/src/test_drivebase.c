@@ -1,5 +1,5 @@
 // SPDX-License-Identifier: MIT
-// Copyright (c) 2020-2022 The Pybricks Authors
+// Copyright (c) 2020-2026 The Pybricks Authors
 
 #include <errno.h>
 #include <signal.h>
@@ -239,8 +239,186 @@ end:
     PBIO_OS_ASYNC_END(PBIO_SUCCESS);
 }
 
+/**
+ * Drives the simulated chassis on motors A and B using the gyro for heading
+ * control and compares the result with the ground truth pose.
+ */
+static pbio_error_t test_drivebase_chassis(pbio_os_state_t *state, void *context) {
+
+    static pbio_os_timer_t timer;
+
+    static pbio_servo_t *srv_left;
+    static pbio_servo_t *srv_right;
+    static pbio_drivebase_t *db;
+    static pbio_port_t *port;
+
+    static double x;
+    static double y;
+    static double heading;
+    static int32_t pose_x;
+    static int32_t pose_y;
+    static int32_t pose_heading;
+
+    PBIO_OS_ASYNC_BEGIN(state);
+
+    // Put the wheels on the ground.
+    pbdrv_motor_driver_virtual_simulation_chassis_set_enabled(true);
+
+    // Initialize the servos.
+    lego_device_type_id_t id = LEGO_DEVICE_TYPE_ID_ANY_ENCODED_MOTOR;
+    tt_uint_op(pbio_port_get_port(PBIO_PORT_ID_A, &port), ==, PBIO_SUCCESS);
+    tt_uint_op(pbio_port_get_servo(port, &id, &srv_left), ==, PBIO_SUCCESS);
+    tt_uint_op(pbio_servo_setup(srv_left, id, PBIO_DIRECTION_COUNTERCLOCKWISE, 1000, true, 0), ==, PBIO_SUCCESS);
+    tt_uint_op(pbio_port_get_port(PBIO_PORT_ID_B, &port), ==, PBIO_SUCCESS);
+    tt_uint_op(pbio_port_get_servo(port, &id, &srv_right), ==, PBIO_SUCCESS);
+    tt_uint_op(pbio_servo_setup(srv_right, id, PBIO_DIRECTION_CLOCKWISE, 1000, true, 0), ==, PBIO_SUCCESS);
+
+    // Set up the drivebase to match the simulated chassis and use the gyro.
+    tt_uint_op(pbio_drivebase_get_drivebase(&db, srv_left, srv_right, 56000, 112000), ==, PBIO_SUCCESS);
+    tt_uint_op(pbio_drivebase_set_use_gyro(db, PBIO_IMU_HEADING_TYPE_1D), ==, PBIO_SUCCESS);
+    tt_uint_op(pbio_drivebase_reset(db, 0, 0), ==, PBIO_SUCCESS);
+
+    // Drive a corner.
+    tt_uint_op(pbio_drivebase_drive_straight(db, 500, PBIO_CONTROL_ON_COMPLETION_HOLD), ==, PBIO_SUCCESS);
+    PBIO_OS_AWAIT_UNTIL(state, pbio_drivebase_is_done(db));
+    tt_uint_op(pbio_drivebase_drive_turn(db, 90, false, PBIO_CONTROL_ON_COMPLETION_HOLD), ==, PBIO_SUCCESS);
+    PBIO_OS_AWAIT_UNTIL(state, pbio_drivebase_is_done(db));
+    tt_uint_op(pbio_drivebase_drive_straight(db, 500, PBIO_CONTROL_ON_COMPLETION_HOLD), ==, PBIO_SUCCESS);
+    PBIO_OS_AWAIT_UNTIL(state, pbio_drivebase_is_done(db));
+    PBIO_OS_AWAIT_MS(state, &timer, 200);
+
+    // Heading is clockwise positive, so the robot should end up at -y.
+    pbdrv_motor_driver_virtual_simulation_chassis_get_pose(&x, &y, &heading);
+    tt_want(pbio_test_int_is_close((int32_t)x, 500, 10));
+    tt_want(pbio_test_int_is_close((int32_t)y, -500, 10));
+    tt_want(pbio_test_int_is_close((int32_t)heading, 90, 2));
+    tt_want(pbio_test_int_is_close((int32_t)pbio_imu_get_heading(PBIO_IMU_HEADING_TYPE_1D), 90, 2));
+
+    // The odometry should match the ground truth.
+    tt_uint_op(pbio_drivebase_get_pose(db, &pose_x, &pose_y, &pose_heading), ==, PBIO_SUCCESS);
+    tt_want(pbio_test_int_is_close(pose_x, x, 5));
+    tt_want(pbio_test_int_is_close(pose_y, y, 5));
+    tt_want(pbio_test_int_is_close(pose_heading, heading, 2));
+
+    // Resetting the pose moves the origin but not the robot, and it does not
+    // stop the drivebase from holding its position.
+    tt_want(pbio_control_is_active(&db->control_distance));
+    tt_uint_op(pbio_drivebase_reset_pose(db, 100, 200, 0), ==, PBIO_SUCCESS);
+    tt_want(pbio_control_is_active(&db->control_distance));
+    tt_uint_op(pbio_drivebase_get_pose(db, &pose_x, &pose_y, &pose_heading), ==, PBIO_SUCCESS);
+    tt_want_int_op(pose_x, ==, 100);
+    tt_want_int_op(pose_y, ==, 200);
+    tt_want_int_op(pose_heading, ==, 0);
+
+    // Driving forward now moves along the new x axis.
+    tt_uint_op(pbio_drivebase_drive_straight(db, 300, PBIO_CONTROL_ON_COMPLETION_HOLD), ==, PBIO_SUCCESS);
+    PBIO_OS_AWAIT_UNTIL(state, pbio_drivebase_is_done(db));
+    PBIO_OS_AWAIT_MS(state, &timer, 200);
+    tt_uint_op(pbio_drivebase_get_pose(db, &pose_x, &pose_y, &pose_heading), ==, PBIO_SUCCESS);
+    tt_want(pbio_test_int_is_close(pose_x, 400, 5));
+    tt_want(pbio_test_int_is_close(pose_y, 200, 5));
+    tt_want(pbio_test_int_is_close(pose_heading, 0, 2));
+
+    // With the heading reset to 90 degrees, driving forward moves towards -y.
+    tt_uint_op(pbio_drivebase_reset_pose(db, 0, 0, 90), ==, PBIO_SUCCESS);
+    tt_uint_op(pbio_drivebase_drive_straight(db, 200, PBIO_CONTROL_ON_COMPLETION_HOLD), ==, PBIO_SUCCESS);
+    PBIO_OS_AWAIT_UNTIL(state, pbio_drivebase_is_done(db));
+    PBIO_OS_AWAIT_MS(state, &timer, 200);
+    tt_uint_op(pbio_drivebase_get_pose(db, &pose_x, &pose_y, &pose_heading), ==, PBIO_SUCCESS);
+    tt_want(pbio_test_int_is_close(pose_x, 0, 5));
+    tt_want(pbio_test_int_is_close(pose_y, -200, 5));
+    tt_want(pbio_test_int_is_close(pose_heading, 90, 2));
+
+end:
+
+    // Lift the wheels again so later tests get freely spinning motors.
+    pbdrv_motor_driver_virtual_simulation_chassis_set_enabled(false);
+
+    PBIO_OS_ASYNC_END(PBIO_SUCCESS);
+}
+
+/**
+ * Resets the drivebase angle and changes the heading source in the middle of
+ * a drive, and checks that the pose carries on from where it was.
+ */
+static pbio_error_t test_drivebase_pose_continuity(pbio_os_state_t *state, void *context) {
+
+    static pbio_os_timer_t timer;
+
+    static pbio_servo_t *srv_left;
+    static pbio_servo_t *srv_right;
+    static pbio_drivebase_t *db;
+    static pbio_port_t *port;
+
+    static double x;
+    static double y;
+    static double heading;
+    static int32_t pose_x;
+    static int32_t pose_y;
+    static int32_t pose_heading;
+
+    PBIO_OS_ASYNC_BEGIN(state);
+
+    pbdrv_motor_driver_virtual_simulation_chassis_set_enabled(true);
+
+    lego_device_type_id_t id = LEGO_DEVICE_TYPE_ID_ANY_ENCODED_MOTOR;
+    tt_uint_op(pbio_port_get_port(PBIO_PORT_ID_A, &port), ==, PBIO_SUCCESS);
+    tt_uint_op(pbio_port_get_servo(port, &id, &srv_left), ==, PBIO_SUCCESS);
+    tt_uint_op(pbio_servo_setup(srv_left, id, PBIO_DIRECTION_COUNTERCLOCKWISE, 1000, true, 0), ==, PBIO_SUCCESS);
+    tt_uint_op(pbio_port_get_port(PBIO_PORT_ID_B, &port), ==, PBIO_SUCCESS);
+    tt_uint_op(pbio_port_get_servo(port, &id, &srv_right), ==, PBIO_SUCCESS);
+    tt_uint_op(pbio_servo_setup(srv_right, id, PBIO_DIRECTION_CLOCKWISE, 1000, true, 0), ==, PBIO_SUCCESS);
+    tt_uint_op(pbio_drivebase_get_drivebase(&db, srv_left, srv_right, 56000, 112000), ==, PBIO_SUCCESS);
+
+    // Drive a corner using the motors for heading.
+    tt_uint_op(pbio_drivebase_drive_straight(db, 300, PBIO_CONTROL_ON_COMPLETION_HOLD), ==, PBIO_SUCCESS);
+    PBIO_OS_AWAIT_UNTIL(state, pbio_drivebase_is_done(db));
+    tt_uint_op(pbio_drivebase_drive_turn(db, 90, false, PBIO_CONTROL_ON_COMPLETION_HOLD), ==, PBIO_SUCCESS);
+    PBIO_OS_AWAIT_UNTIL(state, pbio_drivebase_is_done(db));
+
+    // Reset the drivebase angle while driving. The pose heading stays.
+    tt_uint_op(pbio_drivebase_drive_forever(db, 200, 0), ==, PBIO_SUCCESS);
+    PBIO_OS_AWAIT_MS(state, &timer, 500);
+    tt_uint_op(pbio_drivebase_reset(db, 0, 0), ==, PBIO_SUCCESS);
+    tt_uint_op(pbio_drivebase_get_pose(db, &pose_x, &pose_y, &pose_heading), ==, PBIO_SUCCESS);
+    tt_want(pbio_test_int_is_close(pose_heading, 90, 2));
+
+    // Switch to the gyro while driving. Its heading differs from the reset
+    // drivebase angle, but the pose heading still stays.
+    tt_uint_op(pbio_drivebase_drive_forever(db, 200, 0), ==, PBIO_SUCCESS);
+    PBIO_OS_AWAIT_MS(state, &timer, 500);
+    tt_uint_op(pbio_drivebase_set_use_gyro(db, PBIO_IMU_HEADING_TYPE_1D), ==, PBIO_SUCCESS);
+    tt_uint_op(pbio_drivebase_get_pose(db, &pose_x, &pose_y, &pose_heading), ==, PBIO_SUCCESS);
+    tt_want(pbio_test_int_is_close(pose_heading, 90, 2));
+
+    // Keep driving and turn once more. The odometry still matches the ground
+    // truth, including the motion while coasting after each switch.
+    tt_uint_op(pbio_drivebase_drive_straight(db, 200, PBIO_CONTROL_ON_COMPLETION_HOLD), ==, PBIO_SUCCESS);
+    PBIO_OS_AWAIT_UNTIL(state, pbio_drivebase_is_done(db));
+    tt_uint_op(pbio_drivebase_drive_turn(db, -90, false, PBIO_CONTROL_ON_COMPLETION_HOLD), ==, PBIO_SUCCESS);
+    PBIO_OS_AWAIT_UNTIL(state, pbio_drivebase_is_done(db));
+    tt_uint_op(pbio_drivebase_drive_straight(db, 200, PBIO_CONTROL_ON_COMPLETION_HOLD), ==, PBIO_SUCCESS);
+    PBIO_OS_AWAIT_UNTIL(state, pbio_drivebase_is_done(db));
+    PBIO_OS_AWAIT_MS(state, &timer, 200);
+
+    pbdrv_motor_driver_virtual_simulation_chassis_get_pose(&x, &y, &heading);
+    tt_want(pbio_test_int_is_close((int32_t)heading, 0, 2));
+    tt_uint_op(pbio_drivebase_get_pose(db, &pose_x, &pose_y, &pose_heading), ==, PBIO_SUCCESS);
+    tt_want(pbio_test_int_is_close(pose_x, x, 10));
+    tt_want(pbio_test_int_is_close(pose_y, y, 10));
+    tt_want(pbio_test_int_is_close(pose_heading, heading, 2));
+
+end:
+
+    pbdrv_motor_driver_virtual_simulation_chassis_set_enabled(false);
+
+    PBIO_OS_ASYNC_END(PBIO_SUCCESS);
+}
+
 struct testcase_t pbio_drivebase_tests[] = {
     PBIO_THREAD_TEST(test_drivebase_basics),
     PBIO_THREAD_TEST(test_drivebase_stalling),
+    PBIO_THREAD_TEST(test_drivebase_chassis),
+    PBIO_THREAD_TEST(test_drivebase_pose_continuity),
     END_OF_TESTCASES
 };
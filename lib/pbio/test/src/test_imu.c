@@ -0,0 +1,81 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2026 The Pybricks Authors
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include <tinytest.h>
+#include <tinytest_macros.h>
+
+#include <pbio/imu.h>
+#include <pbio/os.h>
+#include <test-pbio.h>
+
+static pbio_error_t test_imu_record(pbio_os_state_t *state, void *context) {
+
+    static pbio_os_timer_t timer;
+    static pbio_imu_sample_t samples[PBIO_CONFIG_IMU_RECORD_NUM_SAMPLES + 1];
+    static float gyro_scale;
+    static float accel_scale;
+    uint32_t count;
+
+    PBIO_OS_ASYNC_BEGIN(state);
+
+    // Nothing is recorded until started.
+    PBIO_OS_AWAIT_MS(state, &timer, 10);
+    tt_want_uint_op(pbio_imu_record_get_count(), ==, 0);
+
+    // The simulated IMU produces one sample per millisecond.
+    tt_uint_op(pbio_imu_record_start(), ==, PBIO_SUCCESS);
+    PBIO_OS_AWAIT_MS(state, &timer, 20);
+    count = pbio_imu_record_get_count();
+    tt_want(count >= 19 && count <= 21);
+
+    // Samples are read oldest first, one sample time apart. The simulated
+    // hub is flat and stationary, so it only measures gravity.
+    pbio_imu_record_get_scale(&gyro_scale, &accel_scale);
+    tt_want_uint_op(pbio_imu_record_read(samples, 10), ==, 10);
+    tt_want_uint_op(pbio_imu_record_get_count(), ==, count - 10);
+    for (uint32_t i = 0; i < 10; i++) {
+        if (i > 0) {
+            tt_want_uint_op(samples[i].time - samples[i - 1].time, ==, 1000);
+        }
+        tt_want_int_op(samples[i].angular_velocity[2], ==, 0);
+        tt_want(pbio_test_int_is_close((int32_t)(samples[i].acceleration[2] * accel_scale), 9807, 10));
+    }
+
+    // Reading continues where the previous read ended.
+    tt_want_uint_op(pbio_imu_record_read(samples, 1), ==, 1);
+    tt_want_uint_op(pbio_imu_record_read(&samples[1], PBIO_CONFIG_IMU_RECORD_NUM_SAMPLES), ==, count - 11);
+    tt_want_uint_op(samples[1].time - samples[0].time, ==, 1000);
+
+    // When the buffer is full, new samples are dropped.
+    PBIO_OS_AWAIT_MS(state, &timer, PBIO_CONFIG_IMU_RECORD_NUM_SAMPLES * 2);
+    tt_want_uint_op(pbio_imu_record_get_count(), ==, PBIO_CONFIG_IMU_RECORD_NUM_SAMPLES);
+    tt_want_uint_op(pbio_imu_record_read(samples, PBIO_CONFIG_IMU_RECORD_NUM_SAMPLES + 1), ==, PBIO_CONFIG_IMU_RECORD_NUM_SAMPLES);
+    tt_want_uint_op(samples[PBIO_CONFIG_IMU_RECORD_NUM_SAMPLES - 1].time - samples[0].time, ==, (PBIO_CONFIG_IMU_RECORD_NUM_SAMPLES - 1) * 1000);
+
+    // Samples wrap around the end of the buffer.
+    PBIO_OS_AWAIT_MS(state, &timer, 10);
+    tt_want_uint_op(pbio_imu_record_read(samples, 5), ==, 5);
+    PBIO_OS_AWAIT_MS(state, &timer, PBIO_CONFIG_IMU_RECORD_NUM_SAMPLES - 20);
+    count = pbio_imu_record_read(samples, PBIO_CONFIG_IMU_RECORD_NUM_SAMPLES);
+    tt_want(count > PBIO_CONFIG_IMU_RECORD_NUM_SAMPLES / 2);
+    for (uint32_t i = 1; i < count; i++) {
+        tt_want_uint_op(samples[i].time - samples[i - 1].time, ==, 1000);
+    }
+
+    // Nothing more is recorded once stopped.
+    pbio_imu_record_stop();
+    PBIO_OS_AWAIT_MS(state, &timer, 10);
+    tt_want_uint_op(pbio_imu_record_get_count(), ==, 0);
+
+end:
+
+    PBIO_OS_ASYNC_END(PBIO_SUCCESS);
+}
+
+struct testcase_t pbio_imu_tests[] = {
+    PBIO_THREAD_TEST(test_imu_record),
+    END_OF_TESTCASES
+};
@@ -1,5 +1,5 @@
 // SPDX-License-Identifier: MIT
-// Copyright (c) 2019-2023 The Pybricks Authors
+// Copyright (c) 2019-2026 The Pybricks Authors
 
 #include <assert.h>
 #include <stdbool.h>
@@ -10,6 +10,9 @@
 
 #include <pbio/port_interface.h>
 #include <pbio/port_lump.h>
+#include <pbio/sampler.h>
+#include <pbio/servo.h>
+#include <pbio/trigger.h>
 
 #include <tinytest.h>
 #include <tinytest_macros.h>
@@ -214,6 +217,7 @@ static pbio_error_t test_boost_color_distance_sensor(pbio_os_state_t *state, voi
     static const uint8_t msg89[] = { 0x43, 0x08, 0xB4 }; // set mode 8
     static const uint8_t msg90[] = { 0x46, 0x08, 0xB1 }; // extended mode info
     static const uint8_t msg91[] = { 0xD0, 0x00, 0x00, 0x00, 0x00, 0x2F }; // mode 8 data
+    static const uint8_t msg92[] = { 0xD0, 0x01, 0x02, 0x03, 0x04, 0x2B }; // mode 8 data
 
     // used in SIMULATE_RX/TX_MSG macros
     static pbio_os_state_t child;
@@ -225,6 +229,15 @@ static pbio_error_t test_boost_color_distance_sensor(pbio_os_state_t *state, voi
     static uint8_t current_mode;
     static uint8_t num_modes;
 
+    static pbio_sampler_t *sampler;
+    static pbio_trigger_t *trigger;
+    static pbio_port_t *motor_port;
+    static pbio_servo_t *srv;
+    int32_t value;
+    static pbio_os_timer_t timer;
+    static uint8_t samples[8 * 8];
+    uint32_t time;
+
     pbio_error_t err;
 
     PBIO_OS_ASYNC_BEGIN(state);
@@ -449,6 +462,105 @@ static pbio_error_t test_boost_color_distance_sensor(pbio_os_state_t *state, voi
     tt_uint_op(pbio_port_lump_get_info(lump_dev, &num_modes, &current_mode, &mode_info), ==, PBIO_SUCCESS);
     tt_uint_op(current_mode, ==, 8);
 
+    // sample mode 8 in the background, starting right away
+    tt_uint_op(pbio_sampler_start_lump(&sampler, port, 8, 10), ==, PBIO_SUCCESS);
+    tt_uint_op(pbio_sampler_get_sample_size(sampler), ==, 4 + 4);
+    PBIO_OS_AWAIT_MS(state, &timer, 25);
+    tt_uint_op(pbio_sampler_get_count(sampler), ==, 3);
+
+    // new data should show up in the next sample
+    SIMULATE_RX_MSG(msg92);
+    PBIO_OS_AWAIT_MS(state, &timer, 10);
+    tt_uint_op(pbio_sampler_get_count(sampler), ==, 4);
+
+    tt_uint_op(pbio_sampler_read(sampler, samples, 8), ==, 4);
+    tt_uint_op(pbio_sampler_get_count(sampler), ==, 0);
+    tt_uint_op(pbio_sampler_get_error(sampler), ==, PBIO_SUCCESS);
+    for (int i = 1; i < 4; i++) {
+        uint32_t prev;
+        memcpy(&prev, &samples[(i - 1) * 8], sizeof(prev));
+        memcpy(&time, &samples[i * 8], sizeof(time));
+        tt_want_uint_op(time - prev, ==, 10000);
+    }
+    tt_want_uint_op(samples[0 * 8 + 4], ==, 0);
+    tt_want_uint_op(samples[3 * 8 + 4], ==, 1);
+    tt_want_uint_op(samples[3 * 8 + 7], ==, 4);
+
+    pbio_sampler_stop(sampler);
+    tt_want(!pbio_sampler_is_active(sampler));
+
+    // edge trigger should not fire on the current value
+    tt_uint_op(pbio_trigger_start_lump(&trigger, port, 8, 0, PBIO_TRIGGER_CONDITION_EQUAL, 1, true, NULL, 0, PBIO_CONTROL_ON_COMPLETION_COAST), ==, PBIO_SUCCESS);
+    tt_uint_op(pbio_trigger_get_result(trigger, &value, &time), ==, PBIO_ERROR_AGAIN);
+
+    // but should fire when the condition is met again
+    SIMULATE_RX_MSG(msg91);
+    PBIO_OS_AWAIT_MS(state, &timer, 5);
+    tt_uint_op(pbio_trigger_get_result(trigger, &value, &time), ==, PBIO_ERROR_AGAIN);
+    SIMULATE_RX_MSG(msg92);
+    PBIO_OS_AWAIT_MS(state, &timer, 5);
+    tt_uint_op(pbio_trigger_get_result(trigger, &value, &time), ==, PBIO_SUCCESS);
+    tt_want_int_op(value, ==, 1);
+    pbio_trigger_stop(trigger);
+
+    // level trigger fires right away if the condition is already met
+    tt_uint_op(pbio_trigger_start_lump(&trigger, port, 8, 3, PBIO_TRIGGER_CONDITION_ABOVE, 3, false, NULL, 0, PBIO_CONTROL_ON_COMPLETION_COAST), ==, PBIO_SUCCESS);
+    tt_uint_op(pbio_trigger_get_result(trigger, &value, &time), ==, PBIO_SUCCESS);
+    tt_want_int_op(value, ==, 4);
+    pbio_trigger_stop(trigger);
+
+    // stopping a trigger before it fires cancels it
+    tt_uint_op(pbio_trigger_start_lump(&trigger, port, 8, 0, PBIO_TRIGGER_CONDITION_BELOW, 0, false, NULL, 0, PBIO_CONTROL_ON_COMPLETION_COAST), ==, PBIO_SUCCESS);
+    tt_uint_op(pbio_trigger_get_result(trigger, &value, &time), ==, PBIO_ERROR_AGAIN);
+    pbio_trigger_stop(trigger);
+    tt_uint_op(pbio_trigger_get_result(trigger, &value, &time), ==, PBIO_ERROR_CANCELED);
+
+    // invalid value index
+    tt_uint_op(pbio_trigger_start_lump(&trigger, port, 8, 4, PBIO_TRIGGER_CONDITION_ABOVE, 0, false, NULL, 0, PBIO_CONTROL_ON_COMPLETION_COAST), ==, PBIO_ERROR_INVALID_ARG);
+
+    // motor command ends when its trigger fires
+    type_id = LEGO_DEVICE_TYPE_ID_ANY_ENCODED_MOTOR;
+    tt_uint_op(pbio_port_get_port(PBIO_PORT_ID_A, &motor_port), ==, PBIO_SUCCESS);
+    tt_uint_op(pbio_port_get_servo(motor_port, &type_id, &srv), ==, PBIO_SUCCESS);
+    tt_uint_op(pbio_servo_setup(srv, LEGO_DEVICE_TYPE_ID_SPIKE_M_MOTOR, PBIO_DIRECTION_CLOCKWISE, 1000, true, 0), ==, PBIO_SUCCESS);
+    tt_uint_op(pbio_trigger_start_lump(&trigger, port, 8, 0, PBIO_TRIGGER_CONDITION_EQUAL, 1, true, NULL, 0, PBIO_CONTROL_ON_COMPLETION_COAST), ==, PBIO_SUCCESS);
+    tt_uint_op(pbio_servo_run_time(srv, 500, 5000, PBIO_CONTROL_ON_COMPLETION_COAST), ==, PBIO_SUCCESS);
+    tt_uint_op(pbio_servo_set_stop_trigger(srv, trigger, PBIO_CONTROL_ON_COMPLETION_COAST), ==, PBIO_SUCCESS);
+    SIMULATE_RX_MSG(msg91);
+    PBIO_OS_AWAIT_MS(state, &timer, 20);
+    tt_want(pbio_control_is_active(&srv->control));
+    SIMULATE_RX_MSG(msg92);
+    PBIO_OS_AWAIT_MS(state, &timer, 20);
+    tt_want(!pbio_control_is_active(&srv->control));
+    tt_want(srv->stop_trigger == NULL);
+
+    // trigger that already fired can't end another command
+    tt_uint_op(pbio_servo_run_time(srv, 500, 5000, PBIO_CONTROL_ON_COMPLETION_COAST), ==, PBIO_SUCCESS);
+    tt_uint_op(pbio_servo_set_stop_trigger(srv, trigger, PBIO_CONTROL_ON_COMPLETION_COAST), ==, PBIO_ERROR_INVALID_OP);
+    pbio_trigger_stop(trigger);
+
+    // stopping the trigger lets the command continue, even if the trigger is
+    // reused and fires right away
+    tt_uint_op(pbio_trigger_start_lump(&trigger, port, 8, 0, PBIO_TRIGGER_CONDITION_BELOW, 0, false, NULL, 0, PBIO_CONTROL_ON_COMPLETION_COAST), ==, PBIO_SUCCESS);
+    tt_uint_op(pbio_servo_set_stop_trigger(srv, trigger, PBIO_CONTROL_ON_COMPLETION_COAST), ==, PBIO_SUCCESS);
+    pbio_trigger_stop(trigger);
+    tt_want(srv->stop_trigger == NULL);
+    tt_uint_op(pbio_trigger_start_lump(&trigger, port, 8, 3, PBIO_TRIGGER_CONDITION_ABOVE, 3, false, NULL, 0, PBIO_CONTROL_ON_COMPLETION_COAST), ==, PBIO_SUCCESS);
+    tt_uint_op(pbio_trigger_get_result(trigger, &value, &time), ==, PBIO_SUCCESS);
+    PBIO_OS_AWAIT_MS(state, &timer, 20);
+    tt_want(pbio_control_is_active(&srv->control));
+    pbio_trigger_stop(trigger);
+
+    // motors given to the trigger stop right away if the condition is
+    // already met
+    tt_uint_op(pbio_trigger_start_lump(&trigger, port, 8, 3, PBIO_TRIGGER_CONDITION_ABOVE, 3, false, &srv, 1, PBIO_CONTROL_ON_COMPLETION_COAST), ==, PBIO_SUCCESS);
+    tt_uint_op(pbio_trigger_get_result(trigger, &value, &time), ==, PBIO_SUCCESS);
+    tt_want(!pbio_control_is_active(&srv->control));
+    pbio_trigger_stop(trigger);
+
+    // analog values are not reported on this platform
+    tt_uint_op(pbio_trigger_start_analog(&trigger, port, LEGO_DEVICE_TYPE_ID_NXT_ANALOG, false, PBIO_TRIGGER_CONDITION_ABOVE, 0, false, NULL, 0, PBIO_CONTROL_ON_COMPLETION_COAST), ==, PBIO_ERROR_NOT_SUPPORTED);
+
 
 end:
 
@@ -1042,8 +1154,9 @@ pbio_error_t pbdrv_uart_get_instance(uint8_t id, pbdrv_uart_dev_t **uart_dev) {
     return PBIO_SUCCESS;
 }
 
-void pbdrv_uart_set_baud_rate(pbdrv_uart_dev_t *uart_dev, uint32_t baud) {
+pbio_error_t pbdrv_uart_set_baud_rate(pbdrv_uart_dev_t *uart_dev, uint32_t baud) {
     uart_dev->baud = baud;
+    return PBIO_SUCCESS;
 }
 
 void pbdrv_uart_flush(pbdrv_uart_dev_t *uart_dev) {
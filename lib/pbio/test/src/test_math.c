@@ -1,5 +1,5 @@
 // SPDX-License-Identifier: MIT
-// Copyright (c) 2020-2022 The Pybricks Authors
+// Copyright (c) 2020-2026 The Pybricks Authors
 
 #include <stdio.h>
 
@@ -80,6 +80,114 @@ static void test_atan2(void *env) {
             tt_want_int_op(error, <=, 2);
         }
     }
+
+    // On the negative x-axis and at the origin, the result is -180, as used
+    // by the Move Hub tilt.
+    tt_want_int_op(pbio_int_math_atan2(0, -1), ==, -180);
+    tt_want_int_op(pbio_int_math_atan2(0, -1000), ==, -180);
+    tt_want_int_op(pbio_int_math_atan2(0, 0), ==, -180);
+    tt_want_int_op(pbio_int_math_atan2(0, 1), ==, 0);
+}
+
+static void test_atan2_mdeg(void *env) {
+
+    // Test a circle at various scales, including those used by the IMU.
+    for (int32_t scale = 1 << 16; scale < (1 << 30); scale *= 2) {
+        for (int32_t angle_in = -179999; angle_in <= 180000; angle_in += 7) {
+            double rad = (double)angle_in * M_PI / 180000;
+            int32_t angle_out = pbio_int_math_atan2_mdeg(sin(rad) * scale, cos(rad) * scale);
+
+            // Get resulting error.
+            int32_t error = pbio_int_math_abs(angle_in - angle_out);
+            if (error >= 180000) {
+                error -= 360000;
+            }
+            tt_want_int_op(error, <=, 2);
+        }
+    }
+
+    // Axes and extremes.
+    tt_want_int_op(pbio_int_math_atan2_mdeg(0, 0), ==, -180000);
+    tt_want_int_op(pbio_int_math_atan2_mdeg(0, 1), ==, 0);
+    tt_want_int_op(pbio_int_math_atan2_mdeg(1, 0), ==, 90000);
+    tt_want_int_op(pbio_int_math_atan2_mdeg(0, -1), ==, -180000);
+    tt_want_int_op(pbio_int_math_atan2_mdeg(-1, 0), ==, -90000);
+    tt_want_int_op(pbio_int_math_atan2_mdeg(INT32_MIN, INT32_MIN), ==, -135000);
+    tt_want_int_op(pbio_int_math_atan2_mdeg(INT32_MAX, INT32_MAX), ==, 45000);
+}
+
+/**
+ * Compares atan2 against atan2f for inputs of all sizes and signs.
+ */
+static void test_atan2_accuracy(void *env) {
+
+    // Inputs from 2**16 up to the largest int32, with both signs.
+    int32_t inputs[64];
+    size_t num_inputs = 0;
+    for (double value = 1 << 16; value <= INT32_MAX; value *= 1.7) {
+        inputs[num_inputs++] = value;
+        inputs[num_inputs++] = -value;
+    }
+    inputs[num_inputs++] = INT32_MAX;
+    inputs[num_inputs++] = -INT32_MAX;
+
+    for (size_t i = 0; i < num_inputs; i++) {
+        for (size_t j = 0; j < num_inputs; j++) {
+            int32_t y = inputs[i];
+            int32_t x = inputs[j];
+            int32_t expected = lroundf(atan2f(y, x) * 180000 / (float)M_PI);
+            int32_t error = pbio_int_math_abs(pbio_int_math_atan2_mdeg(y, x) - expected);
+            if (error >= 180000) {
+                error -= 360000;
+            }
+            tt_want_int_op(pbio_int_math_abs(error), <=, 2);
+        }
+    }
+}
+
+/**
+ * Tests atan2 on unit vectors scaled by 2**24, as used by the IMU heading
+ * projection. The scale leaves headroom for components slightly larger than
+ * one due to rounding. Near vertical, the horizontal projection gets short,
+ * but it stays accurate down to a length of 2**-8, or about 89.8 degrees of
+ * tilt. The inputs are truncated to integers, so allow one more millidegree
+ * than for exact inputs.
+ */
+static void test_atan2_unit_vector(void *env) {
+
+    const float scale = 1 << 24;
+    const float lengths[] = { 1.0001f, 1.0f, 0.5f, 0.1f, 0.01f, 1.0f / 256 };
+
+    for (size_t i = 0; i < sizeof(lengths) / sizeof(lengths[0]); i++) {
+        for (int32_t angle_in = -179999; angle_in <= 180000; angle_in += 37) {
+            float rad = angle_in * (float)M_PI / 180000;
+            float y = sinf(rad) * lengths[i];
+            float x = cosf(rad) * lengths[i];
+            int32_t expected = lroundf(atan2f(y, x) * 180000 / (float)M_PI);
+            int32_t error = pbio_int_math_abs(pbio_int_math_atan2_mdeg(y * scale, x * scale) - expected);
+            if (error >= 180000) {
+                error -= 360000;
+            }
+            tt_want_int_op(pbio_int_math_abs(error), <=, 3);
+        }
+    }
+}
+
+static void test_sin_cos(void *env) {
+
+    // Whole degrees are exact up to rounding, including negative angles.
+    for (int32_t angle = -720; angle <= 720; angle++) {
+        double rad = (double)angle * M_PI / 180;
+        tt_want_int_op(pbio_int_math_sin_deg(angle), ==, lround(sin(rad) * 10000));
+        tt_want_int_op(pbio_int_math_cos_deg(angle), ==, lround(cos(rad) * 10000));
+    }
+
+    // Interpolated values are within one unit.
+    for (int32_t angle = -720000; angle <= 720000; angle += 13) {
+        double rad = (double)angle * M_PI / 180000;
+        tt_want_int_op(pbio_int_math_abs(pbio_int_math_sin_mdeg(angle) - sin(rad) * 10000), <=, 1);
+        tt_want_int_op(pbio_int_math_abs(pbio_int_math_cos_mdeg(angle) - cos(rad) * 10000), <=, 1);
+    }
 }
 
 static void test_mult_and_scale(void *env) {
@@ -122,8 +230,12 @@ static void test_mult_and_scale(void *env) {
 
 struct testcase_t pbio_int_math_tests[] = {
     PBIO_TEST(test_atan2),
+    PBIO_TEST(test_atan2_mdeg),
+    PBIO_TEST(test_atan2_accuracy),
+    PBIO_TEST(test_atan2_unit_vector),
     PBIO_TEST(test_clamp),
     PBIO_TEST(test_mult_and_scale),
+    PBIO_TEST(test_sin_cos),
     PBIO_TEST(test_sqrt),
     END_OF_TESTCASES
 };
@@ -0,0 +1,151 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2026 The Pybricks Authors
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <tinytest.h>
+#include <tinytest_macros.h>
+
+#include <pbdrv/i2c.h>
+#include <pbio/os.h>
+#include <pbio/port_interface.h>
+#include <pbio/util.h>
+#include <test-pbio.h>
+
+#include "../../drv/i2c/i2c_test.h"
+
+static const uint8_t select_first[] = { 0x20 };
+static const uint8_t select_second[] = { 0x40 };
+
+static pbio_error_t test_port_i2c_poll(pbio_os_state_t *state, void *context) {
+
+    static pbio_os_timer_t timer;
+    static pbio_port_t *port;
+    static pbdrv_i2c_dev_t *i2c_dev;
+    static uint8_t *registers;
+    static uint32_t count;
+    const uint8_t *data;
+    size_t len;
+    uint32_t time;
+
+    // Two registers that are not next to each other, read on each poll.
+    static const pbdrv_i2c_command_t commands[] = {
+        { .address = PBDRV_I2C_TEST_ADDRESS, .write_data = select_first, .write_len = 1, .read_len = 2 },
+        { .address = PBDRV_I2C_TEST_ADDRESS, .write_data = select_second, .write_len = 1, .read_len = 1 },
+    };
+    static const pbdrv_i2c_command_t too_many[PBIO_PORT_I2C_POLL_MAX_COMMANDS + 1] = {
+        { .address = PBDRV_I2C_TEST_ADDRESS, .read_len = 1 },
+    };
+    static const pbdrv_i2c_command_t too_long[] = {
+        { .address = PBDRV_I2C_TEST_ADDRESS, .read_len = PBIO_CONFIG_PORT_I2C_POLL_SIZE },
+        { .address = PBDRV_I2C_TEST_ADDRESS, .read_len = 1 },
+    };
+
+    PBIO_OS_ASYNC_BEGIN(state);
+
+    tt_uint_op(pbio_port_get_port(PBIO_PORT_ID_D, &port), ==, PBIO_SUCCESS);
+    tt_uint_op(pbio_port_set_mode(port, PBIO_PORT_MODE_I2C), ==, PBIO_SUCCESS);
+    tt_uint_op(pbio_port_get_i2c_dev(port, &i2c_dev), ==, PBIO_SUCCESS);
+    registers = pbdrv_i2c_test_get_registers(i2c_dev);
+    registers[0x20] = 1;
+    registers[0x21] = 2;
+    registers[0x40] = 3;
+
+    // Too many commands or too much data.
+    tt_want_uint_op(pbio_port_i2c_poll_start(port, too_many, PBIO_ARRAY_SIZE(too_many), 10, false), ==, PBIO_ERROR_INVALID_ARG);
+    tt_want_uint_op(pbio_port_i2c_poll_start(port, too_long, PBIO_ARRAY_SIZE(too_long), 10, false), ==, PBIO_ERROR_INVALID_ARG);
+    tt_want(!pbio_port_i2c_poll_is_active(port));
+
+    // Nothing read until the first poll completes.
+    tt_uint_op(pbio_port_i2c_poll_start(port, commands, PBIO_ARRAY_SIZE(commands), 10, false), ==, PBIO_SUCCESS);
+    tt_want_uint_op(pbio_port_i2c_poll_get_data(port, &data, &len, &time), ==, PBIO_ERROR_AGAIN);
+
+    // Data from all commands is concatenated.
+    PBIO_OS_AWAIT_UNTIL(state, pbio_port_i2c_poll_get_data(port, &data, &len, &time) == PBIO_SUCCESS);
+    tt_want_uint_op(len, ==, 3);
+    tt_want(memcmp(data, (const uint8_t[]) { 1, 2, 3 }, 3) == 0);
+
+    // All commands run back to back on each poll.
+    count = pbdrv_i2c_test_get_transaction_count(i2c_dev);
+    registers[0x40] = 4;
+    PBIO_OS_AWAIT_MS(state, &timer, 10);
+    tt_want_uint_op(pbdrv_i2c_test_get_transaction_count(i2c_dev), ==, count + 2);
+    tt_want_uint_op(pbio_port_i2c_poll_get_data(port, &data, &len, &time), ==, PBIO_SUCCESS);
+    tt_want(memcmp(data, (const uint8_t[]) { 1, 2, 4 }, 3) == 0);
+
+    pbio_port_i2c_poll_stop(port);
+    tt_want_uint_op(pbio_port_i2c_poll_get_data(port, &data, &len, &time), ==, PBIO_ERROR_INVALID_OP);
+
+end:
+
+    PBIO_OS_ASYNC_END(PBIO_SUCCESS);
+}
+
+static pbio_error_t test_port_i2c_poll_stop(pbio_os_state_t *state, void *context) {
+
+    static pbio_os_state_t sub;
+    static pbio_port_t *port;
+    static pbdrv_i2c_dev_t *i2c_dev;
+    static uint8_t *registers;
+    static uint32_t count;
+    static uint8_t *rdata;
+    const uint8_t *data;
+    size_t len;
+    uint32_t time;
+    pbio_error_t err;
+
+    static const pbdrv_i2c_command_t commands[] = {
+        { .address = PBDRV_I2C_TEST_ADDRESS, .write_data = select_first, .write_len = 1, .read_len = 2 },
+    };
+
+    PBIO_OS_ASYNC_BEGIN(state);
+
+    tt_uint_op(pbio_port_get_port(PBIO_PORT_ID_D, &port), ==, PBIO_SUCCESS);
+    tt_uint_op(pbio_port_set_mode(port, PBIO_PORT_MODE_I2C), ==, PBIO_SUCCESS);
+    tt_uint_op(pbio_port_get_i2c_dev(port, &i2c_dev), ==, PBIO_SUCCESS);
+    registers = pbdrv_i2c_test_get_registers(i2c_dev);
+    registers[0x20] = 1;
+    registers[0x40] = 3;
+
+    // Stop while the first poll is still in progress.
+    count = pbdrv_i2c_test_get_transaction_count(i2c_dev);
+    tt_uint_op(pbio_port_i2c_poll_start(port, commands, PBIO_ARRAY_SIZE(commands), 10, false), ==, PBIO_SUCCESS);
+    PBIO_OS_AWAIT_UNTIL(state, pbdrv_i2c_test_get_transaction_count(i2c_dev) == count + 1);
+    pbio_port_i2c_poll_stop(port);
+
+    // The poller still owns the bus until the transfer completes, so it can't
+    // be restarted yet, but one-off requests are still accepted.
+    tt_want(pbio_port_i2c_poll_is_active(port));
+    tt_want_uint_op(pbio_port_i2c_poll_get_data(port, &data, &len, &time), ==, PBIO_ERROR_INVALID_OP);
+    tt_want_uint_op(pbio_port_i2c_poll_start(port, commands, PBIO_ARRAY_SIZE(commands), 10, false), ==, PBIO_ERROR_BUSY);
+    tt_uint_op(pbio_port_i2c_poll_request(port, PBDRV_I2C_TEST_ADDRESS, select_second, 1, 1, false), ==, PBIO_SUCCESS);
+    PBIO_OS_AWAIT_UNTIL(state, (err = pbio_port_i2c_poll_request_get_result(port, &data)) != PBIO_ERROR_AGAIN);
+    tt_want_uint_op(err, ==, PBIO_SUCCESS);
+    tt_want_uint_op(data[0], ==, 3);
+
+    // Then it lets go without starting another poll.
+    PBIO_OS_AWAIT_UNTIL(state, !pbio_port_i2c_poll_is_active(port));
+    tt_want_uint_op(pbdrv_i2c_test_get_transaction_count(i2c_dev), ==, count + 2);
+
+    // So the bus is free for direct access right away.
+    rdata = NULL;
+    PBIO_OS_AWAIT(state, &sub, err = pbdrv_i2c_write_then_read(&sub, i2c_dev, PBDRV_I2C_TEST_ADDRESS, select_first, 1, &rdata, 1, false));
+    tt_want_uint_op(err, ==, PBIO_SUCCESS);
+    tt_want_uint_op(rdata[0], ==, 1);
+
+    // And polling can be started again.
+    tt_want_uint_op(pbio_port_i2c_poll_start(port, commands, PBIO_ARRAY_SIZE(commands), 10, false), ==, PBIO_SUCCESS);
+    pbio_port_i2c_poll_stop(port);
+
+end:
+
+    PBIO_OS_ASYNC_END(PBIO_SUCCESS);
+}
+
+struct testcase_t pbio_port_tests[] = {
+    PBIO_THREAD_TEST(test_port_i2c_poll),
+    PBIO_THREAD_TEST(test_port_i2c_poll_stop),
+    END_OF_TESTCASES
+};
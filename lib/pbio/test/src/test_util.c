@@ -1,5 +1,5 @@
 // SPDX-License-Identifier: MIT
-// Copyright (c) 2021 The Pybricks Authors
+// Copyright (c) 2021-2026 The Pybricks Authors
 
 #include <stdio.h>
 #include <string.h>
@@ -63,9 +63,23 @@ static void test_oneshot(void *env) {
     tt_want(pbio_oneshot(true, &test_oneshot));
 }
 
+static void test_crc32(void *env) {
+    static const uint8_t check[] = "123456789";
+
+    // Standard check value for CRC-32.
+    tt_want_int_op(pbio_crc32(0, check, 9), ==, 0xCBF43926);
+
+    // Computing it in parts gives the same result.
+    tt_want_int_op(pbio_crc32(pbio_crc32(0, check, 4), &check[4], 5), ==, 0xCBF43926);
+
+    // Empty data does not change the CRC.
+    tt_want_int_op(pbio_crc32(0, check, 0), ==, 0);
+}
+
 struct testcase_t pbio_util_tests[] = {
     PBIO_TEST(test_uuid128_reverse_compare),
     PBIO_TEST(test_uuid128_reverse_copy),
     PBIO_TEST(test_oneshot),
+    PBIO_TEST(test_crc32),
     END_OF_TESTCASES
 };
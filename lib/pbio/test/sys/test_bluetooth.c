@@ -1,8 +1,9 @@
 // SPDX-License-Identifier: MIT
-// Copyright (c) 2021 The Pybricks Authors
+// Copyright (c) 2021-2026 The Pybricks Authors
 
 #include <stdbool.h>
 #include <stdio.h>
+#include <string.h>
 
 #include <btstack.h>
 
@@ -89,7 +90,65 @@ static pbio_error_t test_bluetooth(pbio_os_state_t *state, void *context) {
     PBIO_OS_ASYNC_END(PBIO_SUCCESS);
 }
 
+static bool advertising_data_equals(const uint8_t *data, uint8_t size, const uint8_t *expected, uint8_t expected_size) {
+    return size == expected_size && !memcmp(data, expected, size);
+}
+
+static pbio_error_t test_bluetooth_broadcast(pbio_os_state_t *state, void *context) {
+
+    static pbio_os_state_t sub;
+    static uint32_t i;
+    const uint8_t *data;
+    uint8_t size;
+
+    static const uint8_t data_a[] = { 2, 0x01, 0x06 };
+    static const uint8_t data_b[] = { 4, 0xff, 0xbb, 0xbb, 0xbb };
+    static const uint8_t data_c[] = { 8, 0xff, 0xcc, 0xcc, 0xcc, 0xcc, 0xcc, 0xcc, 0xcc };
+
+    PBIO_OS_ASYNC_BEGIN(state);
+
+    tt_want_uint_op(pbio_test_bluetooth_get_control_state(), ==, PBIO_TEST_BLUETOOTH_STATE_ON);
+
+    tt_uint_op(pbdrv_bluetooth_start_broadcasting(data_a, sizeof(data_a)), ==, PBIO_SUCCESS);
+    PBIO_OS_AWAIT(state, &sub, pbdrv_bluetooth_await_advertise_or_scan_command(&sub, NULL));
+    tt_want(pbio_test_bluetooth_is_advertising_enabled());
+    pbio_test_bluetooth_get_advertising_data(&data, &size);
+    tt_want(advertising_data_equals(data, size, data_a, sizeof(data_a)));
+
+    // Change the data faster than it can be sent. Each update that reaches
+    // the chip must be one of the given payloads, not a mix of two.
+    for (i = 0; i < 100; i++) {
+        if (i % 2) {
+            tt_uint_op(pbdrv_bluetooth_start_broadcasting(data_b, sizeof(data_b)), ==, PBIO_SUCCESS);
+        } else {
+            tt_uint_op(pbdrv_bluetooth_start_broadcasting(data_c, sizeof(data_c)), ==, PBIO_SUCCESS);
+        }
+        PBIO_OS_AWAIT_ONCE(state);
+        pbio_test_bluetooth_get_advertising_data(&data, &size);
+        tt_want(advertising_data_equals(data, size, data_a, sizeof(data_a)) ||
+            advertising_data_equals(data, size, data_b, sizeof(data_b)) ||
+            advertising_data_equals(data, size, data_c, sizeof(data_c)));
+    }
+
+    // The most recent data is sent eventually.
+    PBIO_OS_AWAIT_UNTIL(state, ({
+        pbio_test_bluetooth_get_advertising_data(&data, &size);
+        advertising_data_equals(data, size, data_b, sizeof(data_b));
+    }));
+
+    // Sending the same data again does nothing.
+    i = pbio_test_bluetooth_get_advertising_data_count();
+    tt_uint_op(pbdrv_bluetooth_start_broadcasting(data_b, sizeof(data_b)), ==, PBIO_SUCCESS);
+    PBIO_OS_AWAIT_ONCE(state);
+    tt_want_uint_op(pbio_test_bluetooth_get_advertising_data_count(), ==, i);
+
+end:
+
+    PBIO_OS_ASYNC_END(PBIO_SUCCESS);
+}
+
 struct testcase_t pbdrv_bluetooth_tests[] = {
     PBIO_THREAD_TEST(test_bluetooth),
+    PBIO_THREAD_TEST(test_bluetooth_broadcast),
     END_OF_TESTCASES
 };
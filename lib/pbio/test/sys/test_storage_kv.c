@@ -0,0 +1,153 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2026 The Pybricks Authors
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <tinytest.h>
+#include <tinytest_macros.h>
+
+#include <pbio/os.h>
+#include <pbsys/storage.h>
+#include <test-pbio.h>
+
+#include "../../drv/block_device/block_device_test.h"
+#include "../../sys/storage.h"
+
+static const uint8_t key[] = { 'k', 'e', 'y' };
+
+static const uint8_t *value;
+static uint32_t value_size;
+
+// Starts the store as if the hub just booted.
+static pbio_error_t kv_boot(pbio_os_state_t *state) {
+
+    PBIO_OS_ASYNC_BEGIN(state);
+
+    pbsys_storage_kv_init();
+    PBIO_OS_AWAIT_ONCE(state);
+    PBIO_OS_AWAIT_UNTIL(state, pbsys_storage_kv_get(key, sizeof(key), &value, &value_size) == PBIO_SUCCESS);
+
+    PBIO_OS_ASYNC_END(PBIO_SUCCESS);
+}
+
+static pbio_error_t test_storage_kv_save(pbio_os_state_t *state, void *context) {
+
+    static pbio_os_state_t sub;
+    static uint8_t data[32];
+    static uint32_t i;
+    pbio_error_t err;
+
+    PBIO_OS_ASYNC_BEGIN(state);
+
+    // Nothing saved yet.
+    PBIO_OS_AWAIT(state, &sub, kv_boot(&sub));
+    tt_want(value == NULL);
+    PBIO_OS_AWAIT(state, &sub, err = pbsys_storage_kv_await_saved(&sub));
+    tt_want_uint_op(err, ==, PBIO_SUCCESS);
+
+    // Saving more than fits in the store at once also compacts it.
+    for (i = 0; i < 50; i++) {
+        memset(data, i, sizeof(data));
+        tt_want_uint_op(pbsys_storage_kv_set(key, sizeof(key), data, sizeof(data)), ==, PBIO_SUCCESS);
+        PBIO_OS_AWAIT(state, &sub, err = pbsys_storage_kv_await_saved(&sub));
+        tt_want_uint_op(err, ==, PBIO_SUCCESS);
+    }
+
+    // Latest value is still there after a reboot.
+    PBIO_OS_AWAIT(state, &sub, kv_boot(&sub));
+    tt_want_uint_op(value_size, ==, sizeof(data));
+    tt_want(value && memcmp(value, data, sizeof(data)) == 0);
+
+    // Deleted value stays deleted.
+    tt_want_uint_op(pbsys_storage_kv_set(key, sizeof(key), NULL, 0), ==, PBIO_SUCCESS);
+    PBIO_OS_AWAIT(state, &sub, err = pbsys_storage_kv_await_saved(&sub));
+    tt_want_uint_op(err, ==, PBIO_SUCCESS);
+    PBIO_OS_AWAIT(state, &sub, kv_boot(&sub));
+    tt_want(value == NULL);
+
+    PBIO_OS_ASYNC_END(PBIO_SUCCESS);
+}
+
+static pbio_error_t test_storage_kv_write_error(pbio_os_state_t *state, void *context) {
+
+    static pbio_os_state_t sub;
+    static const uint8_t saved[] = { 1, 2, 3 };
+    static const uint8_t failed[] = { 4, 5, 6 };
+    pbio_error_t err;
+
+    PBIO_OS_ASYNC_BEGIN(state);
+
+    PBIO_OS_AWAIT(state, &sub, kv_boot(&sub));
+    tt_want_uint_op(pbsys_storage_kv_set(key, sizeof(key), saved, sizeof(saved)), ==, PBIO_SUCCESS);
+    PBIO_OS_AWAIT(state, &sub, err = pbsys_storage_kv_await_saved(&sub));
+    tt_want_uint_op(err, ==, PBIO_SUCCESS);
+
+    // Failed append is reported once and makes the store unavailable.
+    pbdrv_block_device_test_set_journal_error(PBIO_ERROR_IO);
+    tt_want_uint_op(pbsys_storage_kv_set(key, sizeof(key), failed, sizeof(failed)), ==, PBIO_SUCCESS);
+    PBIO_OS_AWAIT(state, &sub, err = pbsys_storage_kv_await_saved(&sub));
+    tt_want_uint_op(err, ==, PBIO_ERROR_IO);
+    tt_want_uint_op(pbsys_storage_kv_get(key, sizeof(key), &value, &value_size), ==, PBIO_ERROR_IO);
+    tt_want_uint_op(pbsys_storage_kv_set(key, sizeof(key), failed, sizeof(failed)), ==, PBIO_ERROR_IO);
+    PBIO_OS_AWAIT(state, &sub, err = pbsys_storage_kv_await_saved(&sub));
+    tt_want_uint_op(err, ==, PBIO_SUCCESS);
+
+    // Last value that was saved successfully is loaded after a reboot.
+    pbdrv_block_device_test_set_journal_error(PBIO_SUCCESS);
+    PBIO_OS_AWAIT(state, &sub, kv_boot(&sub));
+    tt_want_uint_op(value_size, ==, sizeof(saved));
+    tt_want(value && memcmp(value, saved, sizeof(saved)) == 0);
+
+    PBIO_OS_ASYNC_END(PBIO_SUCCESS);
+}
+
+static pbio_error_t test_storage_kv_rewrite_error(pbio_os_state_t *state, void *context) {
+
+    static pbio_os_state_t sub;
+    static uint8_t data[32];
+    static uint32_t i;
+    pbio_error_t err;
+
+    PBIO_OS_ASYNC_BEGIN(state);
+
+    PBIO_OS_AWAIT(state, &sub, kv_boot(&sub));
+
+    // Fill the store, so that the next value is only saved after copying
+    // the latest values to the other sector.
+    for (i = 0; (i + 2) * (6 + sizeof(key) + sizeof(data)) + 8 <= PBSYS_CONFIG_STORAGE_KV_SIZE; i++) {
+        memset(data, i, sizeof(data));
+        tt_want_uint_op(pbsys_storage_kv_set(key, sizeof(key), data, sizeof(data)), ==, PBIO_SUCCESS);
+        PBIO_OS_AWAIT(state, &sub, err = pbsys_storage_kv_await_saved(&sub));
+        tt_want_uint_op(err, ==, PBIO_SUCCESS);
+    }
+    memset(data, i, sizeof(data));
+    tt_want_uint_op(pbsys_storage_kv_set(key, sizeof(key), data, sizeof(data)), ==, PBIO_SUCCESS);
+    PBIO_OS_AWAIT(state, &sub, err = pbsys_storage_kv_await_saved(&sub));
+    tt_want_uint_op(err, ==, PBIO_SUCCESS);
+
+    // Failed rewrite makes the store unavailable.
+    pbdrv_block_device_test_set_journal_error(PBIO_ERROR_IO);
+    memset(data, 0xAA, sizeof(data));
+    tt_want_uint_op(pbsys_storage_kv_set(key, sizeof(key), data, sizeof(data)), ==, PBIO_SUCCESS);
+    PBIO_OS_AWAIT(state, &sub, err = pbsys_storage_kv_await_saved(&sub));
+    tt_want_uint_op(err, ==, PBIO_ERROR_IO);
+    tt_want_uint_op(pbsys_storage_kv_set(key, sizeof(key), data, sizeof(data)), ==, PBIO_ERROR_IO);
+
+    // The old sector is still intact after a reboot.
+    pbdrv_block_device_test_set_journal_error(PBIO_SUCCESS);
+    memset(data, i, sizeof(data));
+    PBIO_OS_AWAIT(state, &sub, kv_boot(&sub));
+    tt_want_uint_op(value_size, ==, sizeof(data));
+    tt_want(value && memcmp(value, data, sizeof(data)) == 0);
+
+    PBIO_OS_ASYNC_END(PBIO_SUCCESS);
+}
+
+struct testcase_t pbsys_storage_kv_tests[] = {
+    PBIO_THREAD_TEST(test_storage_kv_save),
+    PBIO_THREAD_TEST(test_storage_kv_write_error),
+    PBIO_THREAD_TEST(test_storage_kv_rewrite_error),
+    END_OF_TESTCASES
+};
@@ -1,5 +1,5 @@
 // SPDX-License-Identifier: MIT
-// Copyright (c) 2019-2021 The Pybricks Authors
+// Copyright (c) 2019-2026 The Pybricks Authors
 
 #include <stdio.h>
 #include <stdlib.h>
@@ -91,42 +91,52 @@ struct testcase_setup_t pbio_test_setup = {
 };
 
 extern struct testcase_t pbdrv_bluetooth_btstack_tests[];
+extern struct testcase_t pbdrv_i2c_tests[];
 extern struct testcase_t pbdrv_pwm_tests[];
 extern struct testcase_t pbio_angle_tests[];
 extern struct testcase_t pbio_battery_tests[];
 extern struct testcase_t pbio_cobs_tests[];
 extern struct testcase_t pbio_color_tests[];
+extern struct testcase_t pbio_differentiator_tests[];
 extern struct testcase_t pbio_drivebase_tests[];
 extern struct testcase_t pbio_image_tests[];
+extern struct testcase_t pbio_imu_tests[];
 extern struct testcase_t pbio_light_animation_tests[];
 extern struct testcase_t pbio_color_light_tests[];
 extern struct testcase_t pbio_light_matrix_tests[];
 extern struct testcase_t pbio_int_math_tests[];
+extern struct testcase_t pbio_port_tests[];
 extern struct testcase_t pbio_port_lump_tests[];
 extern struct testcase_t pbio_servo_tests[];
 extern struct testcase_t pbio_trajectory_tests[];
 extern struct testcase_t pbio_util_tests[];
 extern struct testcase_t pbdrv_bluetooth_tests[];
 extern struct testcase_t pbsys_status_tests[];
+extern struct testcase_t pbsys_storage_kv_tests[];
 static struct testgroup_t test_groups[] = {
     { "drv/bluetooth/", pbdrv_bluetooth_btstack_tests },
+    { "drv/i2c/", pbdrv_i2c_tests },
     { "drv/pwm/", pbdrv_pwm_tests },
     { "src/angle/", pbio_angle_tests },
     { "src/battery/", pbio_battery_tests },
     { "src/cobs/", pbio_cobs_tests },
     { "src/color/", pbio_color_tests },
+    { "src/differentiator/", pbio_differentiator_tests },
     { "src/drivebase/", pbio_drivebase_tests },
     { "src/image/", pbio_image_tests },
+    { "src/imu/", pbio_imu_tests },
     { "src/light/", pbio_light_animation_tests },
     { "src/light/", pbio_color_light_tests },
     { "src/light/", pbio_light_matrix_tests },
     { "src/math/", pbio_int_math_tests },
+    { "src/port/", pbio_port_tests },
     { "src/port_lump/", pbio_port_lump_tests },
     { "src/servo/", pbio_servo_tests },
     { "src/trajectory/", pbio_trajectory_tests },
     { "src/util/", pbio_util_tests, },
     { "sys/bluetooth/", pbdrv_bluetooth_tests, },
     { "sys/status/", pbsys_status_tests, },
+    { "sys/storage_kv/", pbsys_storage_kv_tests, },
     END_OF_GROUPS
 };
 
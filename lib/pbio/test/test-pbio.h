@@ -1,5 +1,5 @@
 // SPDX-License-Identifier: MIT
-// Copyright (c) 2020-2021 The Pybricks Authors
+// Copyright (c) 2020-2026 The Pybricks Authors
 
 #ifndef _TEST_PBIO_H_
 #define _TEST_PBIO_H_
@@ -27,6 +27,8 @@ extern struct testcase_setup_t pbio_test_setup;
 // these can be used by tests that use the bluetooth driver
 
 bool pbio_test_bluetooth_is_advertising_enabled(void);
+void pbio_test_bluetooth_get_advertising_data(const uint8_t **data, uint8_t *size);
+uint32_t pbio_test_bluetooth_get_advertising_data_count(void);
 bool pbio_test_bluetooth_is_connected(void);
 void pbio_test_bluetooth_connect(void);
 void pbio_test_bluetooth_enable_uart_service_notifications(void);
@@ -1,5 +1,5 @@
 // SPDX-License-Identifier: MIT
-// Copyright (c) 2018-2023 The Pybricks Authors
+// Copyright (c) 2018-2026 The Pybricks Authors
 
 #ifndef PYBRICKS_INCLUDED_PYBRICKS_COMMON_H
 #define PYBRICKS_INCLUDED_PYBRICKS_COMMON_H
@@ -13,6 +13,7 @@
 #include <pbio/button.h>
 #include <pbio/color.h>
 #include <pbio/light.h>
+#include <pbio/trigger.h>
 
 #include "py/obj.h"
 
@@ -26,6 +27,7 @@
 #include <pybricks/common/pb_type_device.h>
 
 void pb_package_pybricks_init(bool import_all);
+void pb_package_pybricks_deinit(void);
 
 #if PYBRICKS_PY_COMMON_CHARGER
 
@@ -103,6 +105,9 @@ typedef struct {
     pbio_dcmotor_t *dcmotor;
     pbio_port_id_t port_id;
     pb_type_async_t *last_awaitable;
+    // Trigger given to the most recent command. Referenced here so that it
+    // is not garbage collected while the command is running.
+    mp_obj_t until;
     #if PYBRICKS_PY_COMMON_MOTOR_MODEL
     mp_obj_t model;
     #endif
@@ -118,6 +123,7 @@ extern const mp_obj_type_t pb_type_Motor;
 extern const mp_obj_type_t pb_type_DCMotor;
 
 pbio_servo_t *pb_type_motor_get_servo(mp_obj_t motor_in);
+pbio_trigger_t *pb_type_motor_get_until(mp_obj_t until_in);
 
 #endif // PYBRICKS_PY_COMMON_MOTORS
 
@@ -137,6 +143,7 @@ mp_obj_t pb_type_IMU_obj_new(mp_obj_t hub_in, mp_obj_t top_side_axis, mp_obj_t f
 #if PYBRICKS_PY_COMMON_SYSTEM
 
 extern const mp_obj_module_t pb_type_System;
+void pb_type_System_resources_deinit(void);
 
 #endif // PYBRICKS_PY_COMMON_SYSTEM
 
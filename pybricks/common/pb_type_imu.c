@@ -1,5 +1,5 @@
 // SPDX-License-Identifier: MIT
-// Copyright (c) 2020-2023 The Pybricks Authors
+// Copyright (c) 2020-2026 The Pybricks Authors
 
 #include "py/mpconfig.h"
 
@@ -18,6 +18,7 @@
 #include <pbsys/program_stop.h>
 
 #include "py/obj.h"
+#include "py/objstr.h"
 
 #include <pybricks/common.h>
 #include <pybricks/tools/pb_type_matrix.h>
@@ -334,14 +335,57 @@ static mp_obj_t pb_type_imu_reset_heading(size_t n_args, const mp_obj_t *pos_arg
 }
 static MP_DEFINE_CONST_FUN_OBJ_KW(pb_type_imu_reset_heading_obj, 1, pb_type_imu_reset_heading);
 
+// pybricks._common.IMU.record
+static mp_obj_t pb_type_imu_record(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    PB_PARSE_ARGS_METHOD(n_args, pos_args, kw_args,
+        pb_type_imu_obj_t, self,
+        PB_ARG_DEFAULT_TRUE(active));
+
+    (void)self;
+
+    if (!mp_obj_is_true(active_in)) {
+        pbio_imu_record_stop();
+        return mp_const_none;
+    }
+
+    pb_assert(pbio_imu_record_start());
+
+    // Return scale factors so the user can convert the raw samples.
+    float angular_velocity_scale;
+    float acceleration_scale;
+    pbio_imu_record_get_scale(&angular_velocity_scale, &acceleration_scale);
+    mp_obj_t scale[] = {
+        mp_obj_new_float_from_f(angular_velocity_scale),
+        mp_obj_new_float_from_f(acceleration_scale),
+    };
+    return mp_obj_new_tuple(MP_ARRAY_SIZE(scale), scale);
+}
+static MP_DEFINE_CONST_FUN_OBJ_KW(pb_type_imu_record_obj, 1, pb_type_imu_record);
+
+// pybricks._common.IMU.samples
+static mp_obj_t pb_type_imu_samples(mp_obj_t self_in) {
+
+    // Copy all samples recorded so far in one go. Each sample is a little
+    // endian uint32 time in microseconds followed by six raw int16 values.
+    uint32_t count = pbio_imu_record_get_count();
+    vstr_t vstr;
+    vstr_init_len(&vstr, count * sizeof(pbio_imu_sample_t));
+    count = pbio_imu_record_read((pbio_imu_sample_t *)vstr.buf, count);
+    vstr.len = count * sizeof(pbio_imu_sample_t);
+    return mp_obj_new_bytes_from_vstr(&vstr);
+}
+static MP_DEFINE_CONST_FUN_OBJ_1(pb_type_imu_samples_obj, pb_type_imu_samples);
+
 // dir(pybricks.common.IMU)
 static const mp_rom_map_elem_t pb_type_imu_locals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR_acceleration),     MP_ROM_PTR(&pb_type_imu_acceleration_obj)    },
     { MP_ROM_QSTR(MP_QSTR_angular_velocity), MP_ROM_PTR(&pb_type_imu_angular_velocity_obj)},
     { MP_ROM_QSTR(MP_QSTR_heading),          MP_ROM_PTR(&pb_type_imu_heading_obj)         },
     { MP_ROM_QSTR(MP_QSTR_ready),            MP_ROM_PTR(&pb_type_imu_ready_obj)           },
+    { MP_ROM_QSTR(MP_QSTR_record),           MP_ROM_PTR(&pb_type_imu_record_obj)          },
     { MP_ROM_QSTR(MP_QSTR_reset_heading),    MP_ROM_PTR(&pb_type_imu_reset_heading_obj)   },
     { MP_ROM_QSTR(MP_QSTR_rotation),         MP_ROM_PTR(&pb_type_imu_rotation_obj)        },
+    { MP_ROM_QSTR(MP_QSTR_samples),          MP_ROM_PTR(&pb_type_imu_samples_obj)         },
     { MP_ROM_QSTR(MP_QSTR_settings),         MP_ROM_PTR(&pb_type_imu_settings_obj)        },
     { MP_ROM_QSTR(MP_QSTR_stationary),       MP_ROM_PTR(&pb_type_imu_stationary_obj)      },
     { MP_ROM_QSTR(MP_QSTR_tilt),             MP_ROM_PTR(&pb_type_imu_tilt_obj)            },
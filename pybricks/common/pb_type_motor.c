@@ -1,5 +1,5 @@
 // SPDX-License-Identifier: MIT
-// Copyright (c) 2018-2023 The Pybricks Authors
+// Copyright (c) 2018-2026 The Pybricks Authors
 
 #include "py/mpconfig.h"
 
@@ -16,6 +16,7 @@
 #include "py/obj.h"
 
 #include <pybricks/common.h>
+#include <pybricks/iodevices/iodevices.h>
 #include <pybricks/parameters.h>
 #include <pybricks/pupdevices.h>
 #include <pybricks/tools.h>
@@ -29,6 +30,20 @@ pbio_servo_t *pb_type_motor_get_servo(mp_obj_t motor_in) {
     return ((pb_type_Motor_obj_t *)pb_obj_get_base_class_obj(motor_in, &pb_type_Motor))->srv;
 }
 
+// Gets the trigger that ends a motor or drive base command early, or NULL
+// if it should run until it completes.
+pbio_trigger_t *pb_type_motor_get_until(mp_obj_t until_in) {
+    if (until_in == mp_const_none) {
+        return NULL;
+    }
+    #if PYBRICKS_PY_IODEVICES_TRIGGER
+    return pb_type_iodevices_Trigger_get_trigger(until_in);
+    #else
+    pb_assert(PBIO_ERROR_NOT_SUPPORTED);
+    return NULL;
+    #endif
+}
+
 // Gets the number of millidegrees of the motor, for each whole degree
 // of rotation at the gear train output. For example, if the gear train
 // slows the motor down using a 12 teeth and a 36 teeth gear, the result
@@ -149,6 +164,7 @@ static mp_obj_t pb_type_Motor_make_new(const mp_obj_type_t *type, size_t n_args,
     #endif
 
     self->last_awaitable = NULL;
+    self->until = mp_const_none;
 
     return MP_OBJ_FROM_PTR(self);
 }
@@ -252,10 +268,18 @@ static MP_DEFINE_CONST_FUN_OBJ_KW(pb_type_Motor_reset_angle_obj, 1, pb_type_Moto
 static mp_obj_t pb_type_Motor_speed(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
     PB_PARSE_ARGS_METHOD(n_args, pos_args, kw_args,
         pb_type_Motor_obj_t, self,
-        PB_ARG_DEFAULT_INT(window, 100));
+        PB_ARG_DEFAULT_INT(window, 100),
+        PB_ARG_DEFAULT_FALSE(fit));
+
+    // Fitting a line through all positions in the window is less sensitive
+    // to noise than the average, which helps for short windows.
+    pbio_differentiator_mode_t mode = PBIO_DIFFERENTIATOR_MODE_AVERAGE;
+    if (mp_obj_is_true(fit_in)) {
+        mode = PBIO_DIFFERENTIATOR_MODE_REGRESSION;
+    }
 
     int32_t speed;
-    pb_assert(pbio_servo_get_speed_user(self->srv, pb_obj_get_positive_int(window_in), &speed));
+    pb_assert(pbio_servo_get_speed_user(self->srv, pb_obj_get_positive_int(window_in), mode, &speed));
     return mp_obj_new_int(speed);
 }
 static MP_DEFINE_CONST_FUN_OBJ_KW(pb_type_Motor_speed_obj, 1, pb_type_Motor_speed);
@@ -323,15 +347,21 @@ static mp_obj_t pb_type_Motor_run_time(size_t n_args, const mp_obj_t *pos_args,
         PB_ARG_REQUIRED(speed),
         PB_ARG_REQUIRED(time),
         PB_ARG_DEFAULT_OBJ(then, pb_Stop_HOLD_obj),
-        PB_ARG_DEFAULT_TRUE(wait));
+        PB_ARG_DEFAULT_TRUE(wait),
+        PB_ARG_DEFAULT_NONE(until));
 
     mp_int_t speed = pb_obj_get_int(speed_in);
     mp_int_t time = pbio_int_math_max(pb_obj_get_int(time_in), 0);
 
     pbio_control_on_completion_t then = pb_type_enum_get_value(then_in, &pb_enum_type_Stop);
 
+    // Optionally stop early when a trigger fires.
+    pbio_trigger_t *until = pb_type_motor_get_until(until_in);
+
     // Call pbio with parsed user/default arguments
     pb_assert(pbio_servo_run_time(self->srv, speed, time, then));
+    pb_assert(pbio_servo_set_stop_trigger(self->srv, until, then));
+    self->until = until_in;
 
     // Old way to do parallel movement is to start and not wait on anything.
     if (!mp_obj_is_true(wait_in)) {
@@ -377,14 +407,20 @@ static mp_obj_t pb_type_Motor_run_angle(size_t n_args, const mp_obj_t *pos_args,
         PB_ARG_REQUIRED(speed),
         PB_ARG_REQUIRED(rotation_angle),
         PB_ARG_DEFAULT_OBJ(then, pb_Stop_HOLD_obj),
-        PB_ARG_DEFAULT_TRUE(wait));
+        PB_ARG_DEFAULT_TRUE(wait),
+        PB_ARG_DEFAULT_NONE(until));
 
     mp_int_t speed = pb_obj_get_int(speed_in);
     mp_int_t angle = pb_obj_get_int(rotation_angle_in);
     pbio_control_on_completion_t then = pb_type_enum_get_value(then_in, &pb_enum_type_Stop);
 
+    // Optionally stop early when a trigger fires.
+    pbio_trigger_t *until = pb_type_motor_get_until(until_in);
+
     // Call pbio with parsed user/default arguments
     pb_assert(pbio_servo_run_angle(self->srv, speed, angle, then));
+    pb_assert(pbio_servo_set_stop_trigger(self->srv, until, then));
+    self->until = until_in;
 
     // Old way to do parallel movement is to start and not wait on anything.
     if (!mp_obj_is_true(wait_in)) {
@@ -402,14 +438,20 @@ static mp_obj_t pb_type_Motor_run_target(size_t n_args, const mp_obj_t *pos_args
         PB_ARG_REQUIRED(speed),
         PB_ARG_REQUIRED(target_angle),
         PB_ARG_DEFAULT_OBJ(then, pb_Stop_HOLD_obj),
-        PB_ARG_DEFAULT_TRUE(wait));
+        PB_ARG_DEFAULT_TRUE(wait),
+        PB_ARG_DEFAULT_NONE(until));
 
     mp_int_t speed = pb_obj_get_int(speed_in);
     mp_int_t target_angle = pb_obj_get_int(target_angle_in);
     pbio_control_on_completion_t then = pb_type_enum_get_value(then_in, &pb_enum_type_Stop);
 
+    // Optionally stop early when a trigger fires.
+    pbio_trigger_t *until = pb_type_motor_get_until(until_in);
+
     // Call pbio with parsed user/default arguments
     pb_assert(pbio_servo_run_target(self->srv, speed, target_angle, then));
+    pb_assert(pbio_servo_set_stop_trigger(self->srv, until, then));
+    self->until = until_in;
 
     // Old way to do parallel movement is to start and not wait on anything.
     if (!mp_obj_is_true(wait_in)) {
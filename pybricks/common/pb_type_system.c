@@ -1,5 +1,5 @@
 // SPDX-License-Identifier: MIT
-// Copyright (c) 2018-2022 The Pybricks Authors
+// Copyright (c) 2018-2026 The Pybricks Authors
 
 #include "py/mpconfig.h"
 
@@ -7,8 +7,10 @@
 
 #include <string.h>
 
+#include <pbdrv/block_device.h>
 #include <pbdrv/bluetooth.h>
 #include <pbdrv/reset.h>
+#include <pbio/os.h>
 #include <pbsys/main.h>
 #include <pbsys/program_stop.h>
 #include <pbsys/status.h>
@@ -20,6 +22,7 @@
 
 #include <pybricks/common.h>
 #include <pybricks/parameters.h>
+#include <pybricks/tools/pb_type_async.h>
 #include <pybricks/util_pb/pb_error.h>
 #include <pybricks/util_mp/pb_kwarg_helper.h>
 #include <pybricks/util_mp/pb_obj_helper.h>
@@ -155,6 +158,126 @@ static mp_obj_t pb_type_System_storage(size_t n_args, const mp_obj_t *pos_args,
 }
 static MP_DEFINE_CONST_FUN_OBJ_KW(pb_type_System_storage_obj, 0, pb_type_System_storage);
 
+#if PBDRV_CONFIG_BLOCK_DEVICE_RESOURCE_SIZE
+
+// Read or write request for the resource area.
+typedef struct {
+    mp_obj_base_t base;
+    uint32_t offset;
+    bool write;
+    // Data to write. Referenced to keep the buffer alive.
+    mp_obj_t write_obj;
+    mp_buffer_info_t write_buf;
+    // Buffer for the data that is read.
+    vstr_t read_buf;
+} pb_type_System_resources_request_obj_t;
+
+static MP_DEFINE_CONST_OBJ_TYPE(pb_type_System_resources_request, MP_QSTR_resources, MP_TYPE_FLAG_NONE);
+
+// The flash is shared with the system, so an operation must not be abandoned
+// halfway, even if the awaitable is canceled. It runs in this process instead.
+static pbio_os_process_t pb_type_System_resources_process;
+
+static pbio_error_t pb_type_System_resources_process_thread(pbio_os_state_t *state, void *context) {
+
+    static pbio_os_state_t sub;
+    pb_type_System_resources_request_obj_t *request = context;
+    pbio_error_t err;
+
+    PBIO_OS_ASYNC_BEGIN(state);
+
+    if (request->write) {
+        PBIO_OS_AWAIT(state, &sub, err = pbdrv_block_device_resource_write(&sub,
+            request->offset, request->write_buf.buf, request->write_buf.len));
+    } else {
+        PBIO_OS_AWAIT(state, &sub, err = pbdrv_block_device_resource_read(&sub,
+            request->offset, (uint8_t *)request->read_buf.buf, request->read_buf.len));
+    }
+
+    PBIO_OS_ASYNC_END(err);
+}
+
+static pbio_error_t pb_type_System_resources_iter_once(pbio_os_state_t *state, mp_obj_t parent_obj) {
+    pbio_error_t err = pb_type_System_resources_process.err;
+    if (err != PBIO_ERROR_AGAIN) {
+        // Done, so the request no longer needs to be kept alive.
+        MP_STATE_VM(pb_type_System_resources_request) = MP_OBJ_NULL;
+    }
+    return err;
+}
+
+static mp_obj_t pb_type_System_resources_return_map(mp_obj_t parent_obj) {
+    pb_type_System_resources_request_obj_t *request = MP_OBJ_TO_PTR(parent_obj);
+    if (request->write) {
+        return mp_const_none;
+    }
+    return mp_obj_new_bytes_from_vstr(&request->read_buf);
+}
+
+static mp_obj_t pb_type_System_resources(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    PB_PARSE_ARGS_FUNCTION(n_args, pos_args, kw_args,
+        PB_ARG_REQUIRED(offset),
+        PB_ARG_DEFAULT_NONE(read),
+        PB_ARG_DEFAULT_NONE(write));
+
+    mp_int_t offset = mp_obj_get_int(offset_in);
+    if (offset < 0) {
+        pb_assert(PBIO_ERROR_INVALID_ARG);
+    }
+
+    // Only one operation at a time. A canceled one may still be finishing.
+    if (pb_type_System_resources_process.err == PBIO_ERROR_AGAIN) {
+        pb_assert(PBIO_ERROR_BUSY);
+    }
+
+    pb_type_System_resources_request_obj_t *request = mp_obj_malloc(pb_type_System_resources_request_obj_t, &pb_type_System_resources_request);
+    request->offset = offset;
+
+    if (read_in != mp_const_none && write_in == mp_const_none) {
+        // Handle read.
+        mp_int_t size = mp_obj_get_int(read_in);
+        if (size <= 0) {
+            pb_assert(PBIO_ERROR_INVALID_ARG);
+        }
+        request->write = false;
+        vstr_init_len(&request->read_buf, size);
+    } else if (write_in != mp_const_none && read_in == mp_const_none) {
+        // Handle write.
+        request->write = true;
+        request->write_obj = write_in;
+        mp_get_buffer_raise(write_in, &request->write_buf, MP_BUFFER_READ);
+    } else {
+        mp_raise_TypeError(MP_ERROR_TEXT("Must set either read (int) or write (bytes)."));
+    }
+
+    // Keep the request alive until the process is done with it.
+    MP_STATE_VM(pb_type_System_resources_request) = MP_OBJ_FROM_PTR(request);
+    pbio_os_process_start(&pb_type_System_resources_process, pb_type_System_resources_process_thread, request);
+
+    pb_type_async_t config = {
+        .parent_obj = MP_OBJ_FROM_PTR(request),
+        .iter_once = pb_type_System_resources_iter_once,
+        .return_map = pb_type_System_resources_return_map,
+    };
+    return pb_type_async_wait_or_await(&config, NULL, false);
+}
+static MP_DEFINE_CONST_FUN_OBJ_KW(pb_type_System_resources_obj, 0, pb_type_System_resources);
+
+/**
+ * Waits for a resource operation that was canceled by the user program, so
+ * that it completes before the heap it uses is freed.
+ */
+void pb_type_System_resources_deinit(void) {
+    while (pb_type_System_resources_process.err == PBIO_ERROR_AGAIN) {
+        pbio_os_run_processes_and_wait_for_event();
+    }
+    MP_STATE_VM(pb_type_System_resources_request) = MP_OBJ_NULL;
+}
+
+MP_REGISTER_ROOT_POINTER(mp_obj_t pb_type_System_resources_request);
+
+#endif // PBDRV_CONFIG_BLOCK_DEVICE_RESOURCE_SIZE
+
 static mp_obj_t pb_type_System_reset_storage(void) {
     pbsys_storage_reset_storage();
     return mp_const_none;
@@ -189,6 +312,9 @@ static const mp_rom_map_elem_t common_System_locals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR_reset_storage), MP_ROM_PTR(&pb_type_System_reset_storage_obj) },
     { MP_ROM_QSTR(MP_QSTR_shutdown), MP_ROM_PTR(&pb_type_System_shutdown_obj) },
     { MP_ROM_QSTR(MP_QSTR_storage), MP_ROM_PTR(&pb_type_System_storage_obj) },
+    #if PBDRV_CONFIG_BLOCK_DEVICE_RESOURCE_SIZE
+    { MP_ROM_QSTR(MP_QSTR_resources), MP_ROM_PTR(&pb_type_System_resources_obj) },
+    #endif // PBDRV_CONFIG_BLOCK_DEVICE_RESOURCE_SIZE
     #endif
     #if PYBRICKS_PY_COMMON_SYSTEM_UMM_INFO
     { MP_ROM_QSTR(MP_QSTR_umm_info), MP_ROM_PTR(&pb_type_System_umm_info_obj) },
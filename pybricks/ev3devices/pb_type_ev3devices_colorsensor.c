@@ -1,5 +1,5 @@
 // SPDX-License-Identifier: MIT
-// Copyright (c) 2018-2025 The Pybricks Authors
+// Copyright (c) 2018-2026 The Pybricks Authors
 
 #include "py/mpconfig.h"
 
@@ -13,18 +13,31 @@
 
 #include <pybricks/util_mp/pb_kwarg_helper.h>
 #include <pybricks/util_mp/pb_obj_helper.h>
+#include <pybricks/util_pb/pb_color_map.h>
 
 // Class structure for ColorSensor
 typedef struct _ev3devices_ColorSensor_obj_t {
     pb_type_device_obj_base_t device_base;
+    #if PYBRICKS_PY_DEVICES_COLOR_CALIBRATION
+    pbio_color_calibration_t calibration;
+    #endif
 } ev3devices_ColorSensor_obj_t;
 
+#if PYBRICKS_PY_DEVICES_COLOR_CALIBRATION
+// Default raw RGB references, matching the scaling used by rgb().
+static const int16_t ev3devices_ColorSensor_black[] = { 1, 3, 7 };
+static const int16_t ev3devices_ColorSensor_white[] = { 389, 360, 198 };
+#endif
+
 // pybricks.ev3devices.ColorSensor.__init__
 static mp_obj_t ev3devices_ColorSensor_make_new(const mp_obj_type_t *type, size_t n_args, size_t n_kw, const mp_obj_t *args) {
     PB_PARSE_ARGS_CLASS(n_args, n_kw, args,
         PB_ARG_REQUIRED(port));
     ev3devices_ColorSensor_obj_t *self = mp_obj_malloc(ev3devices_ColorSensor_obj_t, type);
     pb_type_device_init_class(&self->device_base, port_in, LEGO_DEVICE_TYPE_ID_EV3_COLOR_SENSOR);
+    #if PYBRICKS_PY_DEVICES_COLOR_CALIBRATION
+    pbio_color_calibration_reset(&self->calibration, ev3devices_ColorSensor_black, ev3devices_ColorSensor_white);
+    #endif
     return MP_OBJ_FROM_PTR(self);
 }
 
@@ -70,12 +83,14 @@ static PB_DEFINE_CONST_TYPE_DEVICE_METHOD_OBJ(get_reflection_obj, LEGO_DEVICE_MO
 
 // pybricks.ev3devices.ColorSensor.rgb
 static mp_obj_t get_rgb(mp_obj_t self_in) {
-    int16_t *rgb = pb_type_device_get_data(self_in, LEGO_DEVICE_MODE_EV3_COLOR_SENSOR__RGB_RAW);
+    int16_t *raw = pb_type_device_get_data(self_in, LEGO_DEVICE_MODE_EV3_COLOR_SENSOR__RGB_RAW);
     mp_obj_t tup[3];
 
-    rgb[0] = (int)((0.258 * rgb[0]) - 0.3);
-    rgb[1] = (int)((0.280 * rgb[1]) - 0.8);
-    rgb[2] = (int)((0.523 * rgb[2]) - 3.7);
+    // Scale into a local copy so the raw data stays intact for other methods.
+    int16_t rgb[3];
+    rgb[0] = (int)((0.258 * raw[0]) - 0.3);
+    rgb[1] = (int)((0.280 * raw[1]) - 0.8);
+    rgb[2] = (int)((0.523 * raw[2]) - 3.7);
 
     for (uint8_t i = 0; i < 3; i++) {
         rgb[i] = (rgb[i] > 100 ? 100 : rgb[i]);
@@ -86,12 +101,80 @@ static mp_obj_t get_rgb(mp_obj_t self_in) {
 }
 static PB_DEFINE_CONST_TYPE_DEVICE_METHOD_OBJ(get_rgb_obj, LEGO_DEVICE_MODE_EV3_COLOR_SENSOR__RGB_RAW, get_rgb);
 
+#if PYBRICKS_PY_DEVICES_COLOR_CALIBRATION
+// Helper for getting calibrated HSV from the raw RGB values.
+static void get_hsv_calibrated(mp_obj_t self_in, pbio_color_hsv_t *hsv) {
+    ev3devices_ColorSensor_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    int16_t *raw = pb_type_device_get_data(self_in, LEGO_DEVICE_MODE_EV3_COLOR_SENSOR__RGB_RAW);
+    pbio_color_calibration_get_hsv(&self->calibration, raw, hsv);
+}
+
+// pybricks.ev3devices.ColorSensor.hsv
+static mp_obj_t get_hsv(mp_obj_t self_in) {
+    pb_type_Color_obj_t *color = pb_type_Color_new_empty();
+    get_hsv_calibrated(self_in, &color->hsv);
+    return MP_OBJ_FROM_PTR(color);
+}
+static PB_DEFINE_CONST_TYPE_DEVICE_METHOD_OBJ(get_hsv_obj, LEGO_DEVICE_MODE_EV3_COLOR_SENSOR__RGB_RAW, get_hsv);
+
+// pybricks.ev3devices.ColorSensor.calibrate
+static mp_obj_t calibrate(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    PB_PARSE_ARGS_METHOD(n_args, pos_args, kw_args,
+        ev3devices_ColorSensor_obj_t, self,
+        PB_ARG_DEFAULT_NONE(white),
+        PB_ARG_DEFAULT_NONE(black),
+        PB_ARG_DEFAULT_NONE(matrix));
+
+    // Only measure if a reference should be taken from the current reading.
+    const int16_t *raw = ev3devices_ColorSensor_black;
+    if (white_in == mp_const_true || black_in == mp_const_true) {
+        raw = pb_type_device_get_data_blocking(MP_OBJ_FROM_PTR(self), LEGO_DEVICE_MODE_EV3_COLOR_SENSOR__RGB_RAW);
+    }
+    return pb_color_calibration_method(&self->calibration, raw, white_in, black_in, matrix_in);
+}
+static MP_DEFINE_CONST_FUN_OBJ_KW(calibrate_obj, 1, calibrate);
+
+// pybricks.ev3devices.ColorSensor.hsv_into
+static mp_obj_t hsv_into(mp_obj_t sensors_in, mp_obj_t buffer_in) {
+    mp_obj_t *sensors;
+    size_t num_sensors;
+    mp_obj_get_array(sensors_in, &num_sensors, &sensors);
+
+    // Each sensor gives h, s, and v as signed 16-bit values.
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(buffer_in, &bufinfo, MP_BUFFER_WRITE);
+    if (bufinfo.len < num_sensors * 3 * sizeof(int16_t)) {
+        mp_raise_msg(&mp_type_ValueError, MP_ERROR_TEXT("Buffer too small"));
+    }
+
+    for (size_t i = 0; i < num_sensors; i++) {
+        mp_obj_t sensor = pb_obj_get_base_class_obj(sensors[i], &pb_type_ev3devices_ColorSensor);
+
+        // Returns right away if the sensor is already in RGB mode, which is
+        // the normal case for repeated calls.
+        pb_type_device_get_data_blocking(sensor, LEGO_DEVICE_MODE_EV3_COLOR_SENSOR__RGB_RAW);
+
+        pbio_color_hsv_t hsv;
+        get_hsv_calibrated(sensor, &hsv);
+        pb_color_calibration_store_hsv(&hsv, &bufinfo, i);
+    }
+    return mp_const_none;
+}
+static MP_DEFINE_CONST_FUN_OBJ_2(hsv_into_fun_obj, hsv_into);
+static MP_DEFINE_CONST_STATICMETHOD_OBJ(hsv_into_obj, MP_ROM_PTR(&hsv_into_fun_obj));
+#endif // PYBRICKS_PY_DEVICES_COLOR_CALIBRATION
+
 // dir(pybricks.ev3devices.ColorSensor)
 static const mp_rom_map_elem_t ev3devices_ColorSensor_locals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR_reflection), MP_ROM_PTR(&get_reflection_obj) },
     { MP_ROM_QSTR(MP_QSTR_ambient),    MP_ROM_PTR(&get_ambient_obj)    },
     { MP_ROM_QSTR(MP_QSTR_color),      MP_ROM_PTR(&get_color_obj)      },
     { MP_ROM_QSTR(MP_QSTR_rgb),        MP_ROM_PTR(&get_rgb_obj)        },
+    #if PYBRICKS_PY_DEVICES_COLOR_CALIBRATION
+    { MP_ROM_QSTR(MP_QSTR_hsv),        MP_ROM_PTR(&get_hsv_obj)        },
+    { MP_ROM_QSTR(MP_QSTR_calibrate),  MP_ROM_PTR(&calibrate_obj)      },
+    { MP_ROM_QSTR(MP_QSTR_hsv_into),   MP_ROM_PTR(&hsv_into_obj)       },
+    #endif
 };
 static MP_DEFINE_CONST_DICT(ev3devices_ColorSensor_locals_dict, ev3devices_ColorSensor_locals_dict_table);
 
@@ -1,5 +1,5 @@
 // SPDX-License-Identifier: MIT
-// Copyright (c) 2018-2025 The Pybricks Authors
+// Copyright (c) 2018-2026 The Pybricks Authors
 
 #ifndef PYBRICKS_INCLUDED_PYBRICKS_IODEVICES_H
 #define PYBRICKS_INCLUDED_PYBRICKS_IODEVICES_H
@@ -16,6 +16,16 @@
 extern const mp_obj_type_t pb_type_iodevices_PUPDevice;
 #endif
 
+#if PYBRICKS_PY_IODEVICES_SAMPLER
+extern const mp_obj_type_t pb_type_iodevices_Sampler;
+#endif
+
+#if PYBRICKS_PY_IODEVICES_TRIGGER
+#include <pbio/trigger.h>
+extern const mp_obj_type_t pb_type_iodevices_Trigger;
+pbio_trigger_t *pb_type_iodevices_Trigger_get_trigger(mp_obj_t trigger_in);
+#endif
+
 #if PYBRICKS_PY_IODEVICES_UART_DEVICE
 extern const mp_obj_type_t pb_type_uart_device;
 #endif
@@ -1,5 +1,5 @@
 // SPDX-License-Identifier: MIT
-// Copyright (c) 2018-2020 The Pybricks Authors
+// Copyright (c) 2018-2026 The Pybricks Authors
 
 #include "py/mpconfig.h"
 
@@ -85,6 +85,12 @@ static const mp_rom_map_elem_t iodevices_globals_table[] = {
     #if PYBRICKS_PY_IODEVICES_PUP_DEVICE
     { MP_ROM_QSTR(MP_QSTR_PUPDevice),        MP_ROM_PTR(&pb_type_iodevices_PUPDevice)      },
     #endif
+    #if PYBRICKS_PY_IODEVICES_SAMPLER
+    { MP_ROM_QSTR(MP_QSTR_Sampler),          MP_ROM_PTR(&pb_type_iodevices_Sampler)        },
+    #endif
+    #if PYBRICKS_PY_IODEVICES_TRIGGER
+    { MP_ROM_QSTR(MP_QSTR_Trigger),          MP_ROM_PTR(&pb_type_iodevices_Trigger)        },
+    #endif
     #if PYBRICKS_PY_IODEVICES_UART_DEVICE
     { MP_ROM_QSTR(MP_QSTR_UARTDevice),       MP_ROM_PTR(&pb_type_uart_device)              },
     #endif
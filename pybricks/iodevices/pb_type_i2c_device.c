@@ -1,5 +1,5 @@
 // SPDX-License-Identifier: MIT
-// Copyright (c) 2018-2025 The Pybricks Authors
+// Copyright (c) 2018-2026 The Pybricks Authors
 
 #include "py/mpconfig.h"
 
@@ -48,11 +48,17 @@ typedef struct {
      * immediately copied to the driver on the first call to the protothread.
      */
     pbdrv_i2c_dev_t *i2c_dev;
+    pbio_port_t *port;
     uint8_t address;
     bool nxt_quirk;
     size_t write_len;
     size_t read_len;
     uint8_t *read_buf;
+    /**
+     * Whether the ongoing operation was handed to the background poller
+     * instead of the I2C driver.
+     */
+    bool via_poller;
     /**
      * Maps bytes read to the user return object.
      */
@@ -85,6 +91,7 @@ mp_obj_t pb_type_i2c_device_make_new(mp_obj_t sensor_obj, mp_obj_t port_in, uint
 
     device_obj_t *device = mp_obj_malloc(device_obj_t, &pb_type_i2c_device);
     device->i2c_dev = i2c_dev;
+    device->port = port;
     device->address = address;
     device->nxt_quirk = nxt_quirk;
     device->sensor_obj = sensor_obj;
@@ -121,6 +128,13 @@ static pbio_error_t pb_type_i2c_device_iterate_once(pbio_os_state_t *state, mp_o
 
     device_obj_t *device = MP_OBJ_TO_PTR(i2c_device_obj);
 
+    if (device->via_poller) {
+        const uint8_t *data;
+        pbio_error_t err = pbio_port_i2c_poll_request_get_result(device->port, &data);
+        device->read_buf = (uint8_t *)data;
+        return err;
+    }
+
     return pbdrv_i2c_write_then_read(
         state, device->i2c_dev,
         device->address,
@@ -154,20 +168,28 @@ mp_obj_t pb_type_i2c_device_start_operation(mp_obj_t i2c_device_obj, const uint8
     pb_assert_type(i2c_device_obj, &pb_type_i2c_device);
     device_obj_t *device = MP_OBJ_TO_PTR(i2c_device_obj);
 
-    // Kick off the operation. This will immediately raise if a transaction is
-    // in progress.
     pbio_os_state_t state = 0;
-    uint8_t *read_buf = NULL;
-    pbio_error_t err = pbdrv_i2c_write_then_read(
-        &state, device->i2c_dev, device->address,
-        (uint8_t *)write_data, write_len,
-        &read_buf, read_len, device->nxt_quirk);
-
-    // Expect yield after the initial call.
-    if (err == PBIO_SUCCESS) {
-        pb_assert(PBIO_ERROR_FAILED);
-    } else if (err != PBIO_ERROR_AGAIN) {
-        pb_assert(err);
+    bool via_poller = pbio_port_i2c_poll_is_active(device->port);
+
+    if (via_poller) {
+        // The poller owns the bus, so let it run this transaction in between
+        // polls. This will immediately raise if a request is in progress.
+        pb_assert(pbio_port_i2c_poll_request(device->port, device->address, write_data, write_len, read_len, device->nxt_quirk));
+    } else {
+        // Kick off the operation. This will immediately raise if a transaction
+        // is in progress.
+        uint8_t *read_buf = NULL;
+        pbio_error_t err = pbdrv_i2c_write_then_read(
+            &state, device->i2c_dev, device->address,
+            (uint8_t *)write_data, write_len,
+            &read_buf, read_len, device->nxt_quirk);
+
+        // Expect yield after the initial call.
+        if (err == PBIO_SUCCESS) {
+            pb_assert(PBIO_ERROR_FAILED);
+        } else if (err != PBIO_ERROR_AGAIN) {
+            pb_assert(err);
+        }
     }
 
     // The initial operation above can fail if an I2C transaction is already in
@@ -177,6 +199,7 @@ mp_obj_t pb_type_i2c_device_start_operation(mp_obj_t i2c_device_obj, const uint8
     device->read_len = read_len;
     device->write_len = write_len;
     device->read_buf = NULL;
+    device->via_poller = via_poller;
     device->return_map = return_map;
 
     pb_type_async_t config = {
@@ -225,6 +248,16 @@ static mp_obj_t pb_type_i2c_device_return_user_map(mp_obj_t callable_obj, const
     return mp_call_function_1(callable_obj, mp_obj_new_bytes(data, len));
 }
 
+/**
+ * I2C result mapping that copies the data into the buffer given to readinto().
+ */
+static mp_obj_t pb_type_i2c_device_return_into_buffer(mp_obj_t buffer_obj, const uint8_t *data, size_t len) {
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(buffer_obj, &bufinfo, MP_BUFFER_WRITE);
+    memcpy(bufinfo.buf, data, MIN(len, bufinfo.len));
+    return MP_OBJ_NEW_SMALL_INT(len);
+}
+
 // pybricks.iodevices.I2CDevice.read
 static mp_obj_t read(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
     PB_PARSE_ARGS_METHOD(n_args, pos_args, kw_args,
@@ -257,6 +290,37 @@ static mp_obj_t read(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args)
 }
 static MP_DEFINE_CONST_FUN_OBJ_KW(read_obj, 0, read);
 
+// pybricks.iodevices.I2CDevice.readinto
+static mp_obj_t readinto(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    PB_PARSE_ARGS_METHOD(n_args, pos_args, kw_args,
+        device_obj_t, device,
+        PB_ARG_DEFAULT_NONE(reg),
+        PB_ARG_REQUIRED(buffer)
+        );
+
+    uint8_t *write_data = reg_in == mp_const_none ?
+        NULL :
+        &(uint8_t) { mp_obj_get_int(reg_in) };
+    size_t write_len = reg_in == mp_const_none ? 0 : 1;
+
+    // Reads as many bytes as fit in the buffer.
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(buffer_in, &bufinfo, MP_BUFFER_WRITE);
+
+    // As in read(), sensor_obj is passed to the mapping, so use it to keep
+    // the buffer. This also keeps it from being garbage collected.
+    device->sensor_obj = buffer_in;
+
+    return pb_type_i2c_device_start_operation(
+        MP_OBJ_FROM_PTR(device),
+        write_data,
+        write_len,
+        bufinfo.len,
+        pb_type_i2c_device_return_into_buffer
+        );
+}
+static MP_DEFINE_CONST_FUN_OBJ_KW(readinto_obj, 0, readinto);
+
 // pybricks.iodevices.I2CDevice.write
 static mp_obj_t write(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
     PB_PARSE_ARGS_METHOD(n_args, pos_args, kw_args,
@@ -293,10 +357,110 @@ static mp_obj_t write(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args
 }
 static MP_DEFINE_CONST_FUN_OBJ_KW(write_obj, 0, write);
 
+// pybricks.iodevices.I2CDevice.start_polling
+static mp_obj_t start_polling(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    PB_PARSE_ARGS_METHOD(n_args, pos_args, kw_args,
+        device_obj_t, device,
+        PB_ARG_DEFAULT_NONE(reg),
+        PB_ARG_DEFAULT_INT(length, 1),
+        PB_ARG_DEFAULT_INT(interval, 100)
+        );
+
+    // Same transaction as read(), but repeated in the background. If several
+    // registers are given, they are all read back to back on each poll.
+    mp_obj_t *regs = NULL;
+    size_t num_regs = 0;
+    if (reg_in != mp_const_none && !mp_obj_is_int(reg_in)) {
+        mp_obj_get_array(reg_in, &num_regs, &regs);
+        if (num_regs == 0 || num_regs > PBIO_PORT_I2C_POLL_MAX_COMMANDS) {
+            pb_assert(PBIO_ERROR_INVALID_ARG);
+        }
+    }
+
+    size_t length = pb_obj_get_positive_int(length_in);
+    if (length > UINT8_MAX) {
+        pb_assert(PBIO_ERROR_INVALID_ARG);
+    }
+
+    uint8_t write_data[PBIO_PORT_I2C_POLL_MAX_COMMANDS];
+    pbdrv_i2c_command_t commands[PBIO_PORT_I2C_POLL_MAX_COMMANDS];
+    size_t num_commands = num_regs ? num_regs : 1;
+    for (size_t i = 0; i < num_commands; i++) {
+        mp_obj_t reg = num_regs ? regs[i] : reg_in;
+        write_data[i] = reg == mp_const_none ? 0 : mp_obj_get_int(reg);
+        commands[i] = (pbdrv_i2c_command_t) {
+            .write_data = &write_data[i],
+            .address = device->address,
+            .write_len = reg == mp_const_none ? 0 : 1,
+            .read_len = length,
+        };
+    }
+
+    // Replace existing polling, if any. This has to wait for its ongoing
+    // transfer to complete, which takes at most a few milliseconds.
+    pbio_port_i2c_poll_stop(device->port);
+    while (pbio_port_i2c_poll_is_active(device->port)) {
+        mp_hal_delay_ms(1);
+    }
+
+    pb_assert(pbio_port_i2c_poll_start(
+        device->port,
+        commands,
+        num_commands,
+        pb_obj_get_positive_int(interval_in),
+        device->nxt_quirk
+        ));
+
+    return mp_const_none;
+}
+static MP_DEFINE_CONST_FUN_OBJ_KW(start_polling_obj, 0, start_polling);
+
+// pybricks.iodevices.I2CDevice.stop_polling
+static mp_obj_t stop_polling(mp_obj_t self_in) {
+    device_obj_t *device = MP_OBJ_TO_PTR(self_in);
+    pbio_port_i2c_poll_stop(device->port);
+    return mp_const_none;
+}
+static MP_DEFINE_CONST_FUN_OBJ_1(stop_polling_obj, stop_polling);
+
+// pybricks.iodevices.I2CDevice.latest
+static mp_obj_t latest(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    PB_PARSE_ARGS_METHOD(n_args, pos_args, kw_args,
+        device_obj_t, device,
+        PB_ARG_DEFAULT_NONE(map)
+        );
+
+    const uint8_t *data;
+    size_t len;
+    uint32_t time;
+    pbio_error_t err = pbio_port_i2c_poll_get_data(device->port, &data, &len, &time);
+
+    // Nothing was read yet since polling started.
+    if (err == PBIO_ERROR_AGAIN) {
+        return mp_const_none;
+    }
+    pb_assert(err);
+
+    // Get the age first, so allocating or mapping doesn't make it look newer.
+    mp_obj_t age = mp_obj_new_int(mp_hal_ticks_ms() - time);
+    mp_obj_t value = mp_obj_new_bytes(data, len);
+    if (mp_obj_is_callable(map_in)) {
+        value = mp_call_function_1(map_in, value);
+    }
+
+    mp_obj_t items[] = { value, age };
+    return mp_obj_new_tuple(MP_ARRAY_SIZE(items), items);
+}
+static MP_DEFINE_CONST_FUN_OBJ_KW(latest_obj, 0, latest);
+
 // dir(pybricks.iodevices.I2CDevice)
 static const mp_rom_map_elem_t locals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR_read), MP_ROM_PTR(&read_obj) },
+    { MP_ROM_QSTR(MP_QSTR_readinto), MP_ROM_PTR(&readinto_obj) },
     { MP_ROM_QSTR(MP_QSTR_write), MP_ROM_PTR(&write_obj) },
+    { MP_ROM_QSTR(MP_QSTR_start_polling), MP_ROM_PTR(&start_polling_obj) },
+    { MP_ROM_QSTR(MP_QSTR_stop_polling), MP_ROM_PTR(&stop_polling_obj) },
+    { MP_ROM_QSTR(MP_QSTR_latest), MP_ROM_PTR(&latest_obj) },
 };
 static MP_DEFINE_CONST_DICT(locals_dict, locals_dict_table);
 
@@ -1,5 +1,5 @@
 // SPDX-License-Identifier: MIT
-// Copyright (c) 2021-2024 The Pybricks Authors
+// Copyright (c) 2021-2026 The Pybricks Authors
 
 #include "py/mpconfig.h"
 
@@ -108,6 +108,10 @@ typedef struct {
      * Light object (property of Remote class).
      */
     mp_obj_t light;
+    /**
+     * Detectable colors (used by MarioHub class).
+     */
+    pb_color_map_t color_map;
     /**
      * Application specific data, like cached button state, populated by notifications.
      */
@@ -827,7 +831,7 @@ static mp_obj_t pb_type_mario_hub_color(mp_obj_t self_in) {
     }
     pbio_color_hsv_t hsv;
     pb_type_mario_hub_color_get_hsv_data(self, &hsv);
-    return pb_color_map_get_color(&self->buttons, &hsv);
+    return pb_color_map_get_color(&self->color_map, &hsv);
 }
 static MP_DEFINE_CONST_FUN_OBJ_1(pb_type_mario_hub_color_obj, pb_type_mario_hub_color);
 
@@ -846,7 +850,7 @@ static mp_obj_t pb_type_mario_hub_detectable_colors(size_t n_args, const mp_obj_
     PB_PARSE_ARGS_METHOD(n_args, pos_args, kw_args,
         pb_type_lwp3device_obj_t, self,
         PB_ARG_DEFAULT_NONE(colors));
-    return pb_color_map_detectable_colors_method(&self->buttons, colors_in);
+    return pb_color_map_detectable_colors_method(&self->color_map, colors_in);
 }
 static MP_DEFINE_CONST_FUN_OBJ_KW(pb_type_mario_hub_detectable_colors_obj, 1, pb_type_mario_hub_detectable_colors);
 
@@ -875,9 +879,7 @@ static mp_obj_t pb_type_mario_hub_make_new(const mp_obj_type_t *type, size_t n_a
     pb_type_lwp3device_set_name_filter_and_timeout(self, name_in, timeout_in);
     pb_type_lwp3device_intialize_connection(MP_OBJ_FROM_PTR(self), connect_in);
 
-    // Reusing the buttons object which is not used on Mario to hold the
-    // detectable color mapping.
-    pb_color_map_save_default(&self->buttons);
+    pb_color_map_save_default(&self->color_map);
 
     return MP_OBJ_FROM_PTR(self);
 }
@@ -1,5 +1,5 @@
 // SPDX-License-Identifier: MIT
-// Copyright (c) 2018-2023 The Pybricks Authors
+// Copyright (c) 2018-2026 The Pybricks Authors
 
 #include "py/mpconfig.h"
 
@@ -34,6 +34,9 @@ typedef struct _iodevices_PUPDevice_obj_t {
     lego_device_type_id_t passive_id;
     // Device port.
     pbio_port_t *port;
+    // Buffer given to readinto(). Kept here so it can't be garbage collected
+    // while waiting for the data.
+    mp_obj_t readinto_obj;
 } iodevices_PUPDevice_obj_t;
 
 /**
@@ -76,6 +79,7 @@ static mp_obj_t iodevices_PUPDevice_make_new(const mp_obj_type_t *type, size_t n
     // Get the port instance.
     pbio_port_id_t port_id = pb_type_enum_get_value(port_in, &pb_enum_type_Port);
     pb_assert(pbio_port_get_port(port_id, &self->port));
+    self->readinto_obj = MP_OBJ_NULL;
 
     // For backwards compatibility, allow class to be used with passive devices.
     if (init_passive_pup_device(self)) {
@@ -165,6 +169,35 @@ static mp_obj_t get_pup_data_tuple(mp_obj_t self_in) {
     return mp_obj_new_tuple(mode_info[current_mode].num_values, values);
 }
 
+static mp_obj_t get_pup_data_into_buffer(mp_obj_t self_in) {
+    iodevices_PUPDevice_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    void *data = pb_type_device_get_data(self_in, self->last_mode);
+
+    pbio_port_lump_mode_info_t *mode_info;
+    uint8_t current_mode;
+    uint8_t num_modes;
+    lego_device_type_id_t type_id = LEGO_DEVICE_TYPE_ID_ANY_LUMP_UART;
+    pb_assert(pbio_port_lump_assert_type_id(self->device_base.lump_dev, &type_id));
+    pb_assert(pbio_port_lump_get_info(self->device_base.lump_dev, &num_modes, &current_mode, &mode_info));
+
+    mp_obj_t buffer_obj = self->readinto_obj;
+    self->readinto_obj = MP_OBJ_NULL;
+
+    // Size was checked when the read started, but the buffer or device may
+    // have changed since.
+    size_t size = mode_info[current_mode].num_values * pbio_port_lump_data_size(mode_info[current_mode].data_type);
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(buffer_obj, &bufinfo, MP_BUFFER_WRITE);
+    if (bufinfo.len < size) {
+        pb_assert(PBIO_ERROR_INVALID_ARG);
+    }
+
+    // Values are copied as is, so they can be accessed without allocation if
+    // the buffer is an array with the typecode matching the mode data type.
+    memcpy(bufinfo.buf, data, size);
+    return MP_OBJ_NEW_SMALL_INT(mode_info[current_mode].num_values);
+}
+
 // pybricks.iodevices.PUPDevice.read
 static mp_obj_t iodevices_PUPDevice_read(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
     PB_PARSE_ARGS_METHOD(n_args, pos_args, kw_args,
@@ -201,6 +234,50 @@ static mp_obj_t iodevices_PUPDevice_read(size_t n_args, const mp_obj_t *pos_args
 }
 MP_DEFINE_CONST_FUN_OBJ_KW(iodevices_PUPDevice_read_obj, 1, iodevices_PUPDevice_read);
 
+// pybricks.iodevices.PUPDevice.readinto
+static mp_obj_t iodevices_PUPDevice_readinto(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    PB_PARSE_ARGS_METHOD(n_args, pos_args, kw_args,
+        iodevices_PUPDevice_obj_t, self,
+        PB_ARG_REQUIRED(mode),
+        PB_ARG_REQUIRED(buffer));
+
+    // Passive devices don't have raw data to copy.
+    if (self->passive_id != LEGO_DEVICE_TYPE_ID_LPF2_UNKNOWN_UART) {
+        pb_assert(PBIO_ERROR_INVALID_OP);
+    }
+
+    uint8_t mode = mp_obj_get_int(mode_in);
+
+    pbio_port_lump_mode_info_t *mode_info;
+    uint8_t current_mode;
+    uint8_t num_modes;
+    lego_device_type_id_t type_id = LEGO_DEVICE_TYPE_ID_ANY_LUMP_UART;
+    pb_assert(pbio_port_lump_assert_type_id(self->device_base.lump_dev, &type_id));
+    pb_assert(pbio_port_lump_get_info(self->device_base.lump_dev, &num_modes, &current_mode, &mode_info));
+
+    if (mode >= num_modes) {
+        mp_raise_msg(&mp_type_ValueError, MP_ERROR_TEXT("Invalid mode"));
+    }
+
+    // Raise now rather than after waiting for the data.
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(buffer_in, &bufinfo, MP_BUFFER_WRITE);
+    if (bufinfo.len < mode_info[mode].num_values * pbio_port_lump_data_size(mode_info[mode].data_type)) {
+        mp_raise_msg(&mp_type_ValueError, MP_ERROR_TEXT("Buffer too small"));
+    }
+
+    self->last_mode = mode;
+    self->readinto_obj = buffer_in;
+
+    const pb_type_device_method_obj_t method = {
+        {&pb_type_device_method},
+        .mode = self->last_mode,
+        .get_values = get_pup_data_into_buffer,
+    };
+    return pb_type_device_method_call(MP_OBJ_FROM_PTR(&method), 1, 0, pos_args);
+}
+MP_DEFINE_CONST_FUN_OBJ_KW(iodevices_PUPDevice_readinto_obj, 1, iodevices_PUPDevice_readinto);
+
 // pybricks.iodevices.PUPDevice.write
 static mp_obj_t iodevices_PUPDevice_write(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
     PB_PARSE_ARGS_METHOD(n_args, pos_args, kw_args,
@@ -304,6 +381,7 @@ MP_DEFINE_CONST_FUN_OBJ_1(iodevices_PUPDevice_reset_obj, iodevices_PUPDevice_res
 // dir(pybricks.iodevices.PUPDevice)
 static const mp_rom_map_elem_t iodevices_PUPDevice_locals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR_read),       MP_ROM_PTR(&iodevices_PUPDevice_read_obj) },
+    { MP_ROM_QSTR(MP_QSTR_readinto),   MP_ROM_PTR(&iodevices_PUPDevice_readinto_obj) },
     { MP_ROM_QSTR(MP_QSTR_write),      MP_ROM_PTR(&iodevices_PUPDevice_write_obj)},
     { MP_ROM_QSTR(MP_QSTR_info),       MP_ROM_PTR(&iodevices_PUPDevice_info_obj)},
     { MP_ROM_QSTR(MP_QSTR_reset),      MP_ROM_PTR(&iodevices_PUPDevice_reset_obj)},
@@ -0,0 +1,129 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2026 The Pybricks Authors
+
+#include "py/mpconfig.h"
+
+#if PYBRICKS_PY_IODEVICES_SAMPLER
+
+#include "py/obj.h"
+
+#include <pbio/port_interface.h>
+#include <pbio/sampler.h>
+
+#include <pybricks/common.h>
+#include <pybricks/parameters.h>
+#include <pybricks/tools.h>
+
+#include <pybricks/util_mp/pb_kwarg_helper.h>
+#include <pybricks/util_mp/pb_obj_helper.h>
+#include <pybricks/util_pb/pb_error.h>
+
+// pybricks.iodevices.Sampler class object
+typedef struct _iodevices_Sampler_obj_t {
+    mp_obj_base_t base;
+    pbio_sampler_t *sampler;
+} iodevices_Sampler_obj_t;
+
+// Gets the sampler, raising if it was already stopped.
+static pbio_sampler_t *iodevices_Sampler_get_sampler(mp_obj_t self_in) {
+    iodevices_Sampler_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    if (!self->sampler) {
+        pb_assert(PBIO_ERROR_INVALID_OP);
+    }
+    return self->sampler;
+}
+
+// pybricks.iodevices.Sampler.__init__
+static mp_obj_t iodevices_Sampler_make_new(const mp_obj_type_t *type, size_t n_args, size_t n_kw, const mp_obj_t *args) {
+    PB_PARSE_ARGS_CLASS(n_args, n_kw, args,
+        PB_ARG_REQUIRED(port),
+        PB_ARG_DEFAULT_NONE(mode),
+        PB_ARG_DEFAULT_INT(period, 10),
+        PB_ARG_DEFAULT_FALSE(active)
+        );
+
+    pb_module_tools_assert_blocking();
+
+    pbio_port_t *port;
+    pb_assert(pbio_port_get_port(pb_type_enum_get_value(port_in, &pb_enum_type_Port), &port));
+
+    mp_int_t period = mp_obj_get_int(period_in);
+    if (period <= 0) {
+        pb_assert(PBIO_ERROR_INVALID_ARG);
+    }
+
+    iodevices_Sampler_obj_t *self = mp_obj_malloc_with_finaliser(iodevices_Sampler_obj_t, type);
+    self->sampler = NULL;
+
+    // Sample a mode of a LEGO UART device, or the analog value otherwise.
+    if (mode_in != mp_const_none) {
+        pb_assert(pbio_sampler_start_lump(&self->sampler, port, mp_obj_get_int(mode_in), period));
+    } else {
+        pb_assert(pbio_sampler_start_analog(&self->sampler, port, LEGO_DEVICE_TYPE_ID_NXT_ANALOG, mp_obj_is_true(active_in), period));
+    }
+
+    return MP_OBJ_FROM_PTR(self);
+}
+
+// pybricks.iodevices.Sampler.read
+static mp_obj_t iodevices_Sampler_read(mp_obj_t self_in) {
+    pbio_sampler_t *sampler = iodevices_Sampler_get_sampler(self_in);
+
+    // Copy all samples recorded so far in one go. Each sample is a little
+    // endian uint32 timestamp in microseconds followed by the raw value.
+    uint32_t count = pbio_sampler_get_count(sampler);
+    uint32_t size = pbio_sampler_get_sample_size(sampler);
+
+    // Raise errors only once all samples before it have been read. Each
+    // error is raised once, so sampling can go on if the device recovers.
+    pbio_error_t err = pbio_sampler_get_error(sampler);
+    if (count == 0 && err != PBIO_SUCCESS) {
+        pbio_sampler_clear_error(sampler);
+        pb_assert(err);
+    }
+
+    vstr_t vstr;
+    vstr_init_len(&vstr, count * size);
+    count = pbio_sampler_read(sampler, (uint8_t *)vstr.buf, count);
+    vstr.len = count * size;
+    return mp_obj_new_bytes_from_vstr(&vstr);
+}
+static MP_DEFINE_CONST_FUN_OBJ_1(iodevices_Sampler_read_obj, iodevices_Sampler_read);
+
+// pybricks.iodevices.Sampler.dropped
+static mp_obj_t iodevices_Sampler_dropped(mp_obj_t self_in) {
+    pbio_sampler_t *sampler = iodevices_Sampler_get_sampler(self_in);
+    return mp_obj_new_int(pbio_sampler_get_num_dropped(sampler));
+}
+static MP_DEFINE_CONST_FUN_OBJ_1(iodevices_Sampler_dropped_obj, iodevices_Sampler_dropped);
+
+// pybricks.iodevices.Sampler.stop
+// pybricks.iodevices.Sampler.__del__
+static mp_obj_t iodevices_Sampler_stop(mp_obj_t self_in) {
+    iodevices_Sampler_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    // Release the sampler so it can be used by another object.
+    if (self->sampler) {
+        pbio_sampler_stop(self->sampler);
+        self->sampler = NULL;
+    }
+    return mp_const_none;
+}
+static MP_DEFINE_CONST_FUN_OBJ_1(iodevices_Sampler_stop_obj, iodevices_Sampler_stop);
+
+// dir(pybricks.iodevices.Sampler)
+static const mp_rom_map_elem_t iodevices_Sampler_locals_dict_table[] = {
+    { MP_ROM_QSTR(MP_QSTR___del__), MP_ROM_PTR(&iodevices_Sampler_stop_obj)    },
+    { MP_ROM_QSTR(MP_QSTR_read),    MP_ROM_PTR(&iodevices_Sampler_read_obj)    },
+    { MP_ROM_QSTR(MP_QSTR_dropped), MP_ROM_PTR(&iodevices_Sampler_dropped_obj) },
+    { MP_ROM_QSTR(MP_QSTR_stop),    MP_ROM_PTR(&iodevices_Sampler_stop_obj)    },
+};
+static MP_DEFINE_CONST_DICT(iodevices_Sampler_locals_dict, iodevices_Sampler_locals_dict_table);
+
+// type(pybricks.iodevices.Sampler)
+MP_DEFINE_CONST_OBJ_TYPE(pb_type_iodevices_Sampler,
+    MP_QSTR_Sampler,
+    MP_TYPE_FLAG_NONE,
+    make_new, iodevices_Sampler_make_new,
+    locals_dict, &iodevices_Sampler_locals_dict);
+
+#endif // PYBRICKS_PY_IODEVICES_SAMPLER
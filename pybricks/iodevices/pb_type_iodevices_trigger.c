@@ -0,0 +1,208 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2026 The Pybricks Authors
+
+#include "py/mpconfig.h"
+
+#if PYBRICKS_PY_IODEVICES_TRIGGER
+
+#include "py/obj.h"
+
+#include <pbio/port_interface.h>
+#include <pbio/trigger.h>
+
+#include <pybricks/common.h>
+#include <pybricks/iodevices/iodevices.h>
+#include <pybricks/parameters.h>
+#include <pybricks/tools.h>
+#include <pybricks/tools/pb_type_async.h>
+
+#include <pybricks/util_mp/pb_kwarg_helper.h>
+#include <pybricks/util_mp/pb_obj_helper.h>
+#include <pybricks/util_pb/pb_error.h>
+
+// pybricks.iodevices.Trigger class object
+typedef struct _iodevices_Trigger_obj_t {
+    mp_obj_base_t base;
+    pbio_trigger_t *trigger;
+    pb_type_async_t *iter;
+} iodevices_Trigger_obj_t;
+
+// Gets the trigger so a motor command can stop when it fires. Raises if it
+// was canceled or already fired, since the command would not stop on it.
+pbio_trigger_t *pb_type_iodevices_Trigger_get_trigger(mp_obj_t trigger_in) {
+    iodevices_Trigger_obj_t *self = MP_OBJ_TO_PTR(pb_obj_get_base_class_obj(trigger_in, &pb_type_iodevices_Trigger));
+    if (!self->trigger) {
+        pb_assert(PBIO_ERROR_CANCELED);
+    }
+    int32_t value;
+    uint32_t time;
+    if (pbio_trigger_get_result(self->trigger, &value, &time) != PBIO_ERROR_AGAIN) {
+        pb_assert(PBIO_ERROR_INVALID_OP);
+    }
+    return self->trigger;
+}
+
+// pybricks.iodevices.Trigger.__init__
+static mp_obj_t iodevices_Trigger_make_new(const mp_obj_type_t *type, size_t n_args, size_t n_kw, const mp_obj_t *args) {
+    PB_PARSE_ARGS_CLASS(n_args, n_kw, args,
+        PB_ARG_REQUIRED(port),
+        PB_ARG_DEFAULT_NONE(mode),
+        PB_ARG_DEFAULT_INT(index, 0),
+        PB_ARG_DEFAULT_NONE(above),
+        PB_ARG_DEFAULT_NONE(below),
+        PB_ARG_DEFAULT_NONE(equals),
+        PB_ARG_DEFAULT_NONE(not_equals),
+        PB_ARG_DEFAULT_FALSE(edge),
+        PB_ARG_DEFAULT_FALSE(active),
+        PB_ARG_DEFAULT_NONE(stop),
+        PB_ARG_DEFAULT_OBJ(then, pb_Stop_BRAKE_obj)
+        );
+
+    pb_module_tools_assert_blocking();
+
+    pbio_port_t *port;
+    pb_assert(pbio_port_get_port(pb_type_enum_get_value(port_in, &pb_enum_type_Port), &port));
+
+    // Exactly one condition must be given.
+    pbio_trigger_condition_t condition = PBIO_TRIGGER_CONDITION_ABOVE;
+    mp_obj_t threshold_in = mp_const_none;
+    size_t num_conditions = 0;
+    if (above_in != mp_const_none) {
+        condition = PBIO_TRIGGER_CONDITION_ABOVE;
+        threshold_in = above_in;
+        num_conditions++;
+    }
+    if (below_in != mp_const_none) {
+        condition = PBIO_TRIGGER_CONDITION_BELOW;
+        threshold_in = below_in;
+        num_conditions++;
+    }
+    if (equals_in != mp_const_none) {
+        condition = PBIO_TRIGGER_CONDITION_EQUAL;
+        threshold_in = equals_in;
+        num_conditions++;
+    }
+    if (not_equals_in != mp_const_none) {
+        condition = PBIO_TRIGGER_CONDITION_NOT_EQUAL;
+        threshold_in = not_equals_in;
+        num_conditions++;
+    }
+    if (num_conditions != 1) {
+        mp_raise_ValueError(MP_ERROR_TEXT("give one of above, below, equals, or not_equals"));
+    }
+    int32_t threshold = pb_obj_get_int(threshold_in);
+    bool edge = mp_obj_is_true(edge_in);
+
+    // Get the motors to stop, if any, before claiming a trigger.
+    pbio_servo_t *servos[PBIO_TRIGGER_NUM_SERVOS];
+    size_t num_servos = 0;
+    if (pb_obj_is_array(stop_in)) {
+        mp_obj_t *motors;
+        mp_obj_get_array(stop_in, &num_servos, &motors);
+        if (num_servos > PBIO_TRIGGER_NUM_SERVOS) {
+            mp_raise_msg_varg(&mp_type_ValueError, MP_ERROR_TEXT("stop must be a list of up to %d motors"), PBIO_TRIGGER_NUM_SERVOS);
+        }
+        for (size_t i = 0; i < num_servos; i++) {
+            servos[i] = pb_type_motor_get_servo(motors[i]);
+        }
+    } else if (stop_in != mp_const_none) {
+        servos[0] = pb_type_motor_get_servo(stop_in);
+        num_servos = 1;
+    }
+    pbio_control_on_completion_t then = pb_type_enum_get_value(then_in, &pb_enum_type_Stop);
+
+    iodevices_Trigger_obj_t *self = mp_obj_malloc_with_finaliser(iodevices_Trigger_obj_t, type);
+    self->trigger = NULL;
+    self->iter = NULL;
+
+    // Use a mode of a LEGO UART device, or the analog value otherwise.
+    if (mode_in != mp_const_none) {
+        pb_assert(pbio_trigger_start_lump(&self->trigger, port, mp_obj_get_int(mode_in), mp_obj_get_int(index_in), condition, threshold, edge, servos, num_servos, then));
+    } else {
+        pb_assert(pbio_trigger_start_analog(&self->trigger, port, LEGO_DEVICE_TYPE_ID_NXT_ANALOG, mp_obj_is_true(active_in), condition, threshold, edge, servos, num_servos, then));
+    }
+
+    return MP_OBJ_FROM_PTR(self);
+}
+
+// pybricks.iodevices.Trigger.cancel
+// pybricks.iodevices.Trigger.__del__
+static mp_obj_t iodevices_Trigger_cancel(mp_obj_t self_in) {
+    iodevices_Trigger_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    // Release the trigger so it can be used by another object.
+    if (self->trigger) {
+        pbio_trigger_stop(self->trigger);
+        self->trigger = NULL;
+    }
+    return mp_const_none;
+}
+static MP_DEFINE_CONST_FUN_OBJ_1(iodevices_Trigger_cancel_obj, iodevices_Trigger_cancel);
+
+static pbio_error_t iodevices_Trigger_wait_iterate_once(pbio_os_state_t *state, mp_obj_t parent_obj) {
+    iodevices_Trigger_obj_t *self = MP_OBJ_TO_PTR(parent_obj);
+    if (!self->trigger) {
+        return PBIO_ERROR_CANCELED;
+    }
+    int32_t value;
+    uint32_t time;
+    return pbio_trigger_get_result(self->trigger, &value, &time);
+}
+
+static mp_obj_t iodevices_Trigger_wait_return_map(mp_obj_t parent_obj) {
+    iodevices_Trigger_obj_t *self = MP_OBJ_TO_PTR(parent_obj);
+    int32_t value;
+    uint32_t time;
+    pbio_trigger_get_result(self->trigger, &value, &time);
+    return mp_obj_new_int(value);
+}
+
+// pybricks.iodevices.Trigger.wait
+static mp_obj_t iodevices_Trigger_wait(mp_obj_t self_in) {
+    iodevices_Trigger_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    if (!self->trigger) {
+        pb_assert(PBIO_ERROR_CANCELED);
+    }
+    pb_type_async_t config = {
+        .parent_obj = self_in,
+        .iter_once = iodevices_Trigger_wait_iterate_once,
+        .close = iodevices_Trigger_cancel,
+        .return_map = iodevices_Trigger_wait_return_map,
+    };
+    return pb_type_async_wait_or_await(&config, &self->iter, false);
+}
+static MP_DEFINE_CONST_FUN_OBJ_1(iodevices_Trigger_wait_obj, iodevices_Trigger_wait);
+
+// pybricks.iodevices.Trigger.triggered
+static mp_obj_t iodevices_Trigger_triggered(mp_obj_t self_in) {
+    iodevices_Trigger_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    if (!self->trigger) {
+        return mp_const_false;
+    }
+    int32_t value;
+    uint32_t time;
+    pbio_error_t err = pbio_trigger_get_result(self->trigger, &value, &time);
+    if (err == PBIO_ERROR_AGAIN || err == PBIO_ERROR_CANCELED) {
+        return mp_const_false;
+    }
+    pb_assert(err);
+    return mp_const_true;
+}
+static MP_DEFINE_CONST_FUN_OBJ_1(iodevices_Trigger_triggered_obj, iodevices_Trigger_triggered);
+
+// dir(pybricks.iodevices.Trigger)
+static const mp_rom_map_elem_t iodevices_Trigger_locals_dict_table[] = {
+    { MP_ROM_QSTR(MP_QSTR___del__),   MP_ROM_PTR(&iodevices_Trigger_cancel_obj)    },
+    { MP_ROM_QSTR(MP_QSTR_cancel),    MP_ROM_PTR(&iodevices_Trigger_cancel_obj)    },
+    { MP_ROM_QSTR(MP_QSTR_triggered), MP_ROM_PTR(&iodevices_Trigger_triggered_obj) },
+    { MP_ROM_QSTR(MP_QSTR_wait),      MP_ROM_PTR(&iodevices_Trigger_wait_obj)      },
+};
+static MP_DEFINE_CONST_DICT(iodevices_Trigger_locals_dict, iodevices_Trigger_locals_dict_table);
+
+// type(pybricks.iodevices.Trigger)
+MP_DEFINE_CONST_OBJ_TYPE(pb_type_iodevices_Trigger,
+    MP_QSTR_Trigger,
+    MP_TYPE_FLAG_NONE,
+    make_new, iodevices_Trigger_make_new,
+    locals_dict, &iodevices_Trigger_locals_dict);
+
+#endif // PYBRICKS_PY_IODEVICES_TRIGGER
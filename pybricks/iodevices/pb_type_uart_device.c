@@ -1,15 +1,18 @@
 // SPDX-License-Identifier: MIT
-// Copyright (c) 2018-2025 The Pybricks Authors
+// Copyright (c) 2018-2026 The Pybricks Authors
 
 #include "py/mpconfig.h"
 
 #if PYBRICKS_PY_IODEVICES
 
+#include <string.h>
+
 #include "py/mphal.h"
 #include "py/objstr.h"
 #include "py/runtime.h"
 
 #include <pbdrv/uart.h>
+#include <pbio/cobs.h>
 #include <pbio/port_interface.h>
 
 #include <pybricks/common.h>
@@ -31,8 +34,30 @@ typedef struct _pb_type_uart_device_obj_t {
     mp_obj_t write_obj;
     pb_type_async_t *read_iter;
     mp_obj_str_t *read_obj;
+    mp_obj_t readinto_obj;
+    uint8_t *read_buf;
+    size_t read_len;
     const byte *wait_data;
     size_t wait_len;
+    // Optional buffer for received bytes, used instead of the driver default.
+    uint8_t *rx_buffer;
+    // Bytes received by read_frame(). This may hold the start of the next
+    // frame, since data is read in bulk. In COBS mode, the buffer is twice
+    // as big and the second half holds the decoded frame.
+    uint8_t *frame_buf;
+    size_t frame_max_len;
+    // Number of bytes in the buffer, of which the first frame_scan bytes are
+    // known not to contain the delimiter.
+    size_t frame_len;
+    size_t frame_scan;
+    // Number of bytes of the previous frame to drop before the next one.
+    size_t frame_end;
+    size_t frame_result_len;
+    uint8_t frame_delimiter;
+    bool frame_cobs;
+    // Whether the current frame is too long and is being skipped.
+    bool frame_skip;
+    pbio_os_timer_t frame_timer;
 } pb_type_uart_device_obj_t;
 
 // pybricks.iodevices.UARTDevice.set_baudrate
@@ -43,7 +68,8 @@ static mp_obj_t pb_type_uart_device_set_baudrate(mp_obj_t self_in, mp_obj_t baud
     if (baud_rate < 1) {
         pb_assert(PBIO_ERROR_INVALID_ARG);
     }
-    pbdrv_uart_set_baud_rate(self->uart_dev, baud_rate);
+    // Raises if this port can't produce the requested rate.
+    pb_assert(pbdrv_uart_set_baud_rate(self->uart_dev, baud_rate));
     return mp_const_none;
 }
 static MP_DEFINE_CONST_FUN_OBJ_2(pb_type_uart_device_set_baudrate_obj, pb_type_uart_device_set_baudrate);
@@ -55,10 +81,15 @@ static mp_obj_t pb_type_uart_device_make_new(const mp_obj_type_t *type, size_t n
         PB_ARG_REQUIRED(port),
         PB_ARG_DEFAULT_INT(baudrate, 115200),
         PB_ARG_DEFAULT_NONE(timeout),
-        PB_ARG_DEFAULT_INT(power_pin, PBIO_PORT_POWER_REQUIREMENTS_NONE));
+        PB_ARG_DEFAULT_INT(power_pin, PBIO_PORT_POWER_REQUIREMENTS_NONE),
+        PB_ARG_DEFAULT_NONE(rx_buffer_size));
 
-    // Get device, which inits UART port
-    pb_type_uart_device_obj_t *self = mp_obj_malloc(pb_type_uart_device_obj_t, type);
+    // Get device, which inits UART port. Finaliser is used to release the
+    // receive buffer, if any, before it is garbage collected.
+    pb_type_uart_device_obj_t *self = mp_obj_malloc_with_finaliser(pb_type_uart_device_obj_t, type);
+    self->rx_buffer = NULL;
+    self->frame_buf = NULL;
+    self->frame_max_len = 0;
 
     if (timeout_in == mp_const_none) {
         // In the uart driver implementation, 0 means no timeout.
@@ -80,9 +111,21 @@ static mp_obj_t pb_type_uart_device_make_new(const mp_obj_type_t *type, size_t n
     pb_type_uart_device_set_baudrate(MP_OBJ_FROM_PTR(self), baudrate_in);
     pbdrv_uart_flush(self->uart_dev);
 
+    // Optionally use a bigger buffer, so that fast incoming data isn't lost
+    // while the program is busy.
+    if (rx_buffer_size_in != mp_const_none) {
+        mp_int_t size = pb_obj_get_int(rx_buffer_size_in);
+        if (size < 2) {
+            pb_assert(PBIO_ERROR_INVALID_ARG);
+        }
+        self->rx_buffer = m_new(uint8_t, size);
+        pb_assert(pbdrv_uart_set_rx_buffer(self->uart_dev, self->rx_buffer, size));
+    }
+
     // Awaitables associated with reading and writing.
     self->write_iter = NULL;
     self->read_iter = NULL;
+    self->readinto_obj = MP_OBJ_NULL;
     self->wait_len = 0;
 
     pbio_port_p1p2_set_power(self->port, pb_module_iodevices_get_requested_power_pin(power_pin_in));
@@ -137,7 +180,7 @@ static MP_DEFINE_CONST_FUN_OBJ_1(pb_type_uart_device_waiting_obj, pb_type_uart_d
 
 static pbio_error_t pb_type_uart_device_read_iter_once(pbio_os_state_t *state, mp_obj_t self_in) {
     pb_type_uart_device_obj_t *self = MP_OBJ_TO_PTR(self_in);
-    return pbdrv_uart_read(state, self->uart_dev, (uint8_t *)self->read_obj->data, self->read_obj->len, self->timeout);
+    return pbdrv_uart_read(state, self->uart_dev, self->read_buf, self->read_len, self->timeout);
 }
 
 static mp_obj_t pb_type_uart_device_read_return_map(mp_obj_t self_in) {
@@ -156,6 +199,8 @@ static mp_obj_t pb_type_uart_device_read(size_t n_args, const mp_obj_t *pos_args
 
     // Allocate new buffer that we'll read into.
     self->read_obj = pb_obj_new_bytes_prepare(pb_obj_get_positive_int(length_in));
+    self->read_buf = (uint8_t *)self->read_obj->data;
+    self->read_len = self->read_obj->len;
 
     pb_type_async_t config = {
         .iter_once = pb_type_uart_device_read_iter_once,
@@ -166,6 +211,33 @@ static mp_obj_t pb_type_uart_device_read(size_t n_args, const mp_obj_t *pos_args
 }
 static MP_DEFINE_CONST_FUN_OBJ_KW(pb_type_uart_device_read_obj, 1, pb_type_uart_device_read);
 
+static mp_obj_t pb_type_uart_device_readinto_return_map(mp_obj_t self_in) {
+    pb_type_uart_device_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    self->readinto_obj = MP_OBJ_NULL;
+    return MP_OBJ_NEW_SMALL_INT(self->read_len);
+}
+
+// pybricks.iodevices.UARTDevice.readinto
+static mp_obj_t pb_type_uart_device_readinto(mp_obj_t self_in, mp_obj_t buffer_in) {
+    pb_type_uart_device_obj_t *self = MP_OBJ_TO_PTR(self_in);
+
+    // Fill the whole buffer. Keep a reference so it can't be garbage
+    // collected while the read is in progress.
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(buffer_in, &bufinfo, MP_BUFFER_WRITE);
+    self->readinto_obj = buffer_in;
+    self->read_buf = bufinfo.buf;
+    self->read_len = bufinfo.len;
+
+    pb_type_async_t config = {
+        .iter_once = pb_type_uart_device_read_iter_once,
+        .parent_obj = self_in,
+        .return_map = pb_type_uart_device_readinto_return_map,
+    };
+    return pb_type_async_wait_or_await(&config, &self->read_iter, true);
+}
+static MP_DEFINE_CONST_FUN_OBJ_2(pb_type_uart_device_readinto_obj, pb_type_uart_device_readinto);
+
 // pybricks.iodevices.UARTDevice.read_all
 static mp_obj_t pb_type_uart_device_read_all(mp_obj_t self_in) {
 
@@ -187,10 +259,19 @@ static mp_obj_t pb_type_uart_device_read_all(mp_obj_t self_in) {
 }
 static MP_DEFINE_CONST_FUN_OBJ_1(pb_type_uart_device_read_all_obj, pb_type_uart_device_read_all);
 
+// Drops all bytes received by read_frame().
+static void pb_type_uart_device_read_frame_reset(pb_type_uart_device_obj_t *self) {
+    self->frame_len = 0;
+    self->frame_scan = 0;
+    self->frame_end = 0;
+    self->frame_skip = false;
+}
+
 // pybricks.iodevices.UARTDevice.clear
 static mp_obj_t pb_type_uart_device_clear(mp_obj_t self_in) {
     pb_type_uart_device_obj_t *self = MP_OBJ_TO_PTR(self_in);
     pbdrv_uart_flush(self->uart_dev);
+    pb_type_uart_device_read_frame_reset(self);
     return mp_const_none;
 }
 static MP_DEFINE_CONST_FUN_OBJ_1(pb_type_uart_device_clear_obj, pb_type_uart_device_clear);
@@ -251,15 +332,174 @@ static mp_obj_t pb_type_uart_device_wait_until(mp_obj_t self_in, mp_obj_t patter
 }
 static MP_DEFINE_CONST_FUN_OBJ_2(pb_type_uart_device_wait_until_obj, pb_type_uart_device_wait_until);
 
+// Completes the frame at the start of the buffer. Returns false if the frame
+// should be skipped because it was too long or malformed.
+static bool pb_type_uart_device_read_frame_complete(pb_type_uart_device_obj_t *self, size_t len) {
+    if (self->frame_skip) {
+        self->frame_skip = false;
+        return false;
+    }
+
+    if (!self->frame_cobs) {
+        self->frame_result_len = len;
+        return true;
+    }
+
+    // Decode into the second half of the buffer.
+    self->frame_result_len = pbio_cobs_decode(self->frame_buf, len, &self->frame_buf[self->frame_max_len], self->frame_max_len);
+    return self->frame_result_len > 0;
+}
+
+static pbio_error_t pb_type_uart_device_read_frame_iter_once(pbio_os_state_t *state, mp_obj_t self_in) {
+
+    pb_type_uart_device_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    uint8_t *buf = self->frame_buf;
+
+    // Partial frames are kept, so no data is lost if the operation is
+    // canceled or times out.
+    for (;;) {
+
+        // Drop the previous frame, keeping any bytes received after it.
+        if (self->frame_end) {
+            self->frame_len -= self->frame_end;
+            memmove(buf, buf + self->frame_end, self->frame_len);
+            self->frame_end = 0;
+            self->frame_scan = 0;
+        }
+
+        // Look for the delimiter in the bytes that were not checked yet.
+        const uint8_t *end = memchr(buf + self->frame_scan, self->frame_delimiter, self->frame_len - self->frame_scan);
+        if (end) {
+            size_t len = end - buf;
+            self->frame_end = len + 1;
+            if (pb_type_uart_device_read_frame_complete(self, len)) {
+                return PBIO_SUCCESS;
+            }
+            continue;
+        }
+        self->frame_scan = self->frame_len;
+
+        uint32_t in_waiting = pbdrv_uart_in_waiting(self->uart_dev);
+        if (in_waiting == 0) {
+            break;
+        }
+
+        // Data is available, so these reads complete without blocking.
+        pbio_os_state_t sub = 0;
+
+        // If the buffer is full, the frame is only valid if the next byte is
+        // the delimiter. Otherwise skip the rest of the frame.
+        if (self->frame_len == self->frame_max_len) {
+            uint8_t rx;
+            pb_assert(pbdrv_uart_read(&sub, self->uart_dev, &rx, 1, 0));
+            if (rx == self->frame_delimiter) {
+                self->frame_end = self->frame_len;
+                if (pb_type_uart_device_read_frame_complete(self, self->frame_len)) {
+                    return PBIO_SUCCESS;
+                }
+                continue;
+            }
+            self->frame_skip = true;
+            self->frame_len = 0;
+            self->frame_scan = 0;
+            continue;
+        }
+
+        // Take as many bytes as fit in the buffer.
+        uint32_t size = self->frame_max_len - self->frame_len;
+        if (size > in_waiting) {
+            size = in_waiting;
+        }
+        pb_assert(pbdrv_uart_read(&sub, self->uart_dev, buf + self->frame_len, size, 0));
+        self->frame_len += size;
+    }
+
+    if (self->timeout && pbio_os_timer_is_expired(&self->frame_timer)) {
+        return PBIO_ERROR_TIMEDOUT;
+    }
+    return PBIO_ERROR_AGAIN;
+}
+
+static mp_obj_t pb_type_uart_device_read_frame_return_map(mp_obj_t self_in) {
+    pb_type_uart_device_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    const uint8_t *data = self->frame_cobs ? &self->frame_buf[self->frame_max_len] : self->frame_buf;
+    return mp_obj_new_bytes(data, self->frame_result_len);
+}
+
+// pybricks.iodevices.UARTDevice.read_frame
+static mp_obj_t pb_type_uart_device_read_frame(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+
+    PB_PARSE_ARGS_METHOD(n_args, pos_args, kw_args,
+        pb_type_uart_device_obj_t, self,
+        PB_ARG_DEFAULT_NONE(delimiter),
+        PB_ARG_DEFAULT_FALSE(cobs),
+        PB_ARG_DEFAULT_INT(max_length, 256));
+
+    bool cobs = mp_obj_is_true(cobs_in);
+
+    // COBS frames always end with the COBS delimiter. Otherwise default to
+    // lines of text.
+    uint8_t delimiter = cobs ? PBIO_COBS_DELIMITER : '\n';
+    if (delimiter_in != mp_const_none) {
+        size_t len;
+        const char *data = mp_obj_str_get_data(delimiter_in, &len);
+        if (len != 1 || cobs) {
+            pb_assert(PBIO_ERROR_INVALID_ARG);
+        }
+        delimiter = data[0];
+    }
+
+    size_t max_length = pb_obj_get_positive_int(max_length_in);
+    if (max_length == 0) {
+        pb_assert(PBIO_ERROR_INVALID_ARG);
+    }
+
+    // Reuse the buffer and any partial frame unless the framing changed.
+    if (max_length != self->frame_max_len || delimiter != self->frame_delimiter || cobs != self->frame_cobs) {
+        size_t size = cobs ? max_length * 2 : max_length;
+        self->frame_buf = m_renew(uint8_t, self->frame_buf, self->frame_cobs ? self->frame_max_len * 2 : self->frame_max_len, size);
+        self->frame_max_len = max_length;
+        self->frame_delimiter = delimiter;
+        self->frame_cobs = cobs;
+        pb_type_uart_device_read_frame_reset(self);
+    }
+
+    // The timeout applies to the whole frame.
+    pbio_os_timer_set(&self->frame_timer, self->timeout);
+
+    pb_type_async_t config = {
+        .iter_once = pb_type_uart_device_read_frame_iter_once,
+        .parent_obj = MP_OBJ_FROM_PTR(self),
+        .return_map = pb_type_uart_device_read_frame_return_map,
+    };
+    return pb_type_async_wait_or_await(&config, &self->read_iter, true);
+}
+static MP_DEFINE_CONST_FUN_OBJ_KW(pb_type_uart_device_read_frame_obj, 1, pb_type_uart_device_read_frame);
+
+// pybricks.iodevices.UARTDevice.__del__
+static mp_obj_t pb_type_uart_device_close(mp_obj_t self_in) {
+    pb_type_uart_device_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    // Stop receiving into our buffer unless another instance took over.
+    if (self->rx_buffer) {
+        pbdrv_uart_release_rx_buffer(self->uart_dev, self->rx_buffer);
+        self->rx_buffer = NULL;
+    }
+    return mp_const_none;
+}
+static MP_DEFINE_CONST_FUN_OBJ_1(pb_type_uart_device_close_obj, pb_type_uart_device_close);
+
 // dir(pybricks.iodevices.uart_device)
 static const mp_rom_map_elem_t pb_type_uart_device_locals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR_read),         MP_ROM_PTR(&pb_type_uart_device_read_obj)         },
     { MP_ROM_QSTR(MP_QSTR_read_all),     MP_ROM_PTR(&pb_type_uart_device_read_all_obj)     },
+    { MP_ROM_QSTR(MP_QSTR_readinto),     MP_ROM_PTR(&pb_type_uart_device_readinto_obj)     },
+    { MP_ROM_QSTR(MP_QSTR_read_frame),   MP_ROM_PTR(&pb_type_uart_device_read_frame_obj)   },
     { MP_ROM_QSTR(MP_QSTR_write),        MP_ROM_PTR(&pb_type_uart_device_write_obj)        },
     { MP_ROM_QSTR(MP_QSTR_waiting),      MP_ROM_PTR(&pb_type_uart_device_waiting_obj)      },
     { MP_ROM_QSTR(MP_QSTR_wait_until),   MP_ROM_PTR(&pb_type_uart_device_wait_until_obj)   },
     { MP_ROM_QSTR(MP_QSTR_set_baudrate), MP_ROM_PTR(&pb_type_uart_device_set_baudrate_obj) },
     { MP_ROM_QSTR(MP_QSTR_clear),        MP_ROM_PTR(&pb_type_uart_device_clear_obj)        },
+    { MP_ROM_QSTR(MP_QSTR___del__),      MP_ROM_PTR(&pb_type_uart_device_close_obj)        },
 };
 static MP_DEFINE_CONST_DICT(pb_type_uart_device_locals_dict, pb_type_uart_device_locals_dict_table);
 
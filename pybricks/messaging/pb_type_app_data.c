@@ -1,5 +1,5 @@
 // SPDX-License-Identifier: MIT
-// Copyright (c) 2024 The Pybricks Authors
+// Copyright (c) 2024-2026 The Pybricks Authors
 
 #include "py/mpconfig.h"
 
@@ -83,6 +83,25 @@ static mp_obj_t pb_type_app_data_get_bytes(size_t n_args, const mp_obj_t *pos_ar
 }
 static MP_DEFINE_CONST_FUN_OBJ_KW(pb_type_app_data_get_bytes_obj, 1, pb_type_app_data_get_bytes);
 
+static mp_obj_t pb_type_app_data_get_bytes_into(mp_obj_t self_in, mp_obj_t mode_in, mp_obj_t buffer_in) {
+    pb_type_app_data_obj_t *self = MP_OBJ_TO_PTR(self_in);
+
+    pb_type_app_data_mode_info_t *mode_info = get_mode_info(self, mode_in);
+    if (!mode_info) {
+        mp_raise_ValueError(MP_ERROR_TEXT("invalid mode"));
+    }
+
+    // Same as get_bytes without index, but copied into the given buffer.
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(buffer_in, &bufinfo, MP_BUFFER_WRITE);
+    if (bufinfo.len < mode_info->size) {
+        mp_raise_ValueError(MP_ERROR_TEXT("buffer too small"));
+    }
+    memcpy(bufinfo.buf, &self->rx_buffer[mode_info->offset], mode_info->size);
+    return MP_OBJ_NEW_SMALL_INT(mode_info->size);
+}
+static MP_DEFINE_CONST_FUN_OBJ_3(pb_type_app_data_get_bytes_into_obj, pb_type_app_data_get_bytes_into);
+
 static pbio_error_t app_data_write_bytes_iterate_once(pbio_os_state_t *state, mp_obj_t parent_obj) {
     // No need to pass in buffered arguments since they were copied on the
     // inital run. We can just keep calling this until completion.
@@ -229,6 +248,7 @@ static const mp_rom_map_elem_t pb_type_app_data_locals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR___del__),      MP_ROM_PTR(&pb_type_app_data_close_obj) },
     { MP_ROM_QSTR(MP_QSTR_close),        MP_ROM_PTR(&pb_type_app_data_close_obj) },
     { MP_ROM_QSTR(MP_QSTR_get_bytes),    MP_ROM_PTR(&pb_type_app_data_get_bytes_obj) },
+    { MP_ROM_QSTR(MP_QSTR_get_bytes_into), MP_ROM_PTR(&pb_type_app_data_get_bytes_into_obj) },
     { MP_ROM_QSTR(MP_QSTR_write_bytes),  MP_ROM_PTR(&pb_type_app_data_write_bytes_obj) },
     { MP_ROM_QSTR(MP_QSTR_configure),    MP_ROM_PTR(&pb_type_app_data_configure_obj) },
 };
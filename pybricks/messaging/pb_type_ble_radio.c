@@ -1,6 +1,6 @@
 
 // SPDX-License-Identifier: MIT
-// Copyright (c) 2023 The Pybricks Authors
+// Copyright (c) 2023-2026 The Pybricks Authors
 
 #include "py/mpconfig.h"
 
@@ -39,22 +39,46 @@
 #define OBSERVED_DATA_TIMEOUT_MS (1000)
 #define OBSERVED_DATA_MAX_SIZE (31 /* max adv data size */ - 5 /* overhead */)
 
+// Number of new messages kept per channel until they are read by receive().
+#define OBSERVED_DATA_NUM_FRAMES (4)
+
+typedef struct {
+    uint32_t timestamp;
+    uint8_t size;
+    uint8_t data[OBSERVED_DATA_MAX_SIZE];
+} observed_frame_t;
+
 typedef struct {
     uint32_t timestamp;
     uint8_t channel;
     int8_t rssi;
     uint8_t size;
     uint8_t data[OBSERVED_DATA_MAX_SIZE];
+    // Decoded data, kept until new data arrives. MP_OBJ_NULL if not decoded.
+    mp_obj_t decoded;
+    // Ring buffer of messages that have not been read by receive() yet.
+    observed_frame_t frames[OBSERVED_DATA_NUM_FRAMES];
+    uint8_t frames_start;
+    uint8_t num_frames;
 } observed_data_t;
 
 // pointer to dynamically allocated memory - needed for driver callback
 static observed_data_t *observed_data;
-static uint8_t num_observed_data;
+
+// Index + 1 of each channel in observed_data, or 0 if not observed.
+static uint8_t observed_data_index[UINT8_MAX + 1];
 
 typedef struct {
     mp_obj_base_t base;
     mp_obj_t broadcast_channel;
     pb_type_async_t *iter;
+    // Whether to include a sequence number in broadcasts.
+    bool sequence_numbers;
+    // Sequence number of the last broadcast.
+    uint8_t sequence;
+    // Values of the last broadcast, used to decide when to increment sequence.
+    uint8_t last_values_size;
+    uint8_t last_values[OBSERVED_DATA_MAX_SIZE];
     observed_data_t observed_data[];
 } pb_obj_BLE_t;
 
@@ -79,6 +103,11 @@ typedef enum {
     PB_BLE_BROADCAST_DATA_TYPE_STR = 5,
     /** The Python @c bytes type. */
     PB_BLE_BROADCAST_DATA_TYPE_BYTES = 6,
+    /**
+     * One byte sequence number. If present, this comes first and the values
+     * follow as they would without it.
+     */
+    PB_BLE_BROADCAST_DATA_TYPE_SEQUENCE = 7,
 } pb_ble_broadcast_data_type_t;
 
 #define MFG_SPECIFIC 0xFF
@@ -87,25 +116,17 @@ typedef enum {
 /**
  * Looks up a channel in the observed data table.
  *
- * @param [in]  channel     The channel number (1 to 255).
+ * @param [in]  channel     The channel number (0 to 255).
  * @returns                 A pointer to the channel or @c NULL if the channel
  *                          is not allocated in the table.
  */
-static observed_data_t *lookup_observed_data(uint8_t channel) {
+static observed_data_t *lookup_observed_data(mp_int_t channel) {
 
-    if (!observed_data) {
+    if (!observed_data || channel < 0 || channel > UINT8_MAX || !observed_data_index[channel]) {
         return NULL;
     }
 
-    for (size_t i = 0; i < num_observed_data; i++) {
-        observed_data_t *data = &observed_data[i];
-
-        if (data->channel == channel) {
-            return data;
-        }
-    }
-
-    return NULL;
+    return &observed_data[observed_data_index[channel] - 1];
 }
 
 /**
@@ -126,6 +147,11 @@ static void handle_observe_event(pbdrv_bluetooth_ad_type_t event_type, const uin
     // feature in official LEGO Robot Inventor firmware.
     if (length >= 5 && data[1] == MFG_SPECIFIC && pbio_get_uint16_le(&data[2]) == LEGO_CID) {
         uint8_t channel = data[4];
+        uint8_t size = data[0] - 4;
+
+        if (data[0] < 4 || size > OBSERVED_DATA_MAX_SIZE) {
+            return;
+        }
 
         observed_data_t *ch_data = lookup_observed_data(channel);
 
@@ -144,8 +170,25 @@ static void handle_observe_event(pbdrv_bluetooth_ad_type_t event_type, const uin
         // Update moving RSSI average based on time difference.
         ch_data->rssi = (ch_data->rssi * (RSSI_FILTER_WINDOW_MS - diff) + rssi * diff) / RSSI_FILTER_WINDOW_MS;
 
+        // The same advertisement is received many times. Only different
+        // data is queued as a new message.
+        if (size != ch_data->size || memcmp(ch_data->data, &data[5], size)) {
+            ch_data->decoded = MP_OBJ_NULL;
+
+            // If full, drop the oldest message.
+            if (ch_data->num_frames == OBSERVED_DATA_NUM_FRAMES) {
+                ch_data->frames_start = (ch_data->frames_start + 1) % OBSERVED_DATA_NUM_FRAMES;
+                ch_data->num_frames--;
+            }
+            observed_frame_t *frame = &ch_data->frames[(ch_data->frames_start + ch_data->num_frames) % OBSERVED_DATA_NUM_FRAMES];
+            frame->timestamp = ch_data->timestamp;
+            frame->size = size;
+            memcpy(frame->data, &data[5], size);
+            ch_data->num_frames++;
+        }
+
         // Extract user broadcast data from signal.
-        ch_data->size = data[0] - 4;
+        ch_data->size = size;
         memcpy(ch_data->data, &data[5], OBSERVED_DATA_MAX_SIZE);
     }
 }
@@ -292,18 +335,25 @@ static mp_obj_t pb_module_ble_broadcast(size_t n_args, const mp_obj_t *pos_args,
 
     uint8_t data[5 + OBSERVED_DATA_MAX_SIZE];
 
+    // Optional sequence number goes first. It is filled in below.
+    size_t values_index = 0;
+    if (self->sequence_numbers) {
+        data[5] = PB_BLE_BROADCAST_DATA_TYPE_SEQUENCE << 5 | 1;
+        values_index = 2;
+    }
+
     // Get either one or several data objects ready for transmission.
     mp_obj_t *objs;
     size_t n_objs;
     size_t index;
     if (pb_obj_is_array(data_in)) {
-        index = 0;
+        index = values_index;
         mp_obj_get_array(data_in, &n_objs, &objs);
     } else {
         // Set first type to indicate single object.
-        data[5] = PB_BLE_BROADCAST_DATA_TYPE_SINGLE_OBJECT << 5;
+        data[5 + values_index] = PB_BLE_BROADCAST_DATA_TYPE_SINGLE_OBJECT << 5;
         // The one and only value is included directly after.
-        index = 1;
+        index = values_index + 1;
         n_objs = 1;
         objs = &data_in;
     }
@@ -313,12 +363,29 @@ static mp_obj_t pb_module_ble_broadcast(size_t n_args, const mp_obj_t *pos_args,
         index = pb_module_ble_encode(&data[5], index, objs[i]);
     }
 
+    // Only increment the sequence number if the values changed, so
+    // broadcasting the same values in a loop is not seen as new messages.
+    const uint8_t *values = &data[5 + values_index];
+    size_t values_size = index - values_index;
+    bool values_changed = self->sequence_numbers &&
+        (values_size != self->last_values_size || memcmp(self->last_values, values, values_size));
+    if (self->sequence_numbers) {
+        data[6] = self->sequence + values_changed;
+    }
+
     data[0] = index + 4; // length
     data[1] = MFG_SPECIFIC;
     pbio_set_uint16_le(&data[2], LEGO_CID);
     data[4] = mp_obj_get_int(self->broadcast_channel);
 
     pb_assert(pbdrv_bluetooth_start_broadcasting(data, index + 5));
+
+    if (values_changed) {
+        self->sequence++;
+        self->last_values_size = values_size;
+        memcpy(self->last_values, values, values_size);
+    }
+
     return wait_or_await_operation(self_in);
 }
 static MP_DEFINE_CONST_FUN_OBJ_KW(pb_module_ble_broadcast_obj, 1, pb_module_ble_broadcast);
@@ -326,15 +393,15 @@ static MP_DEFINE_CONST_FUN_OBJ_KW(pb_module_ble_broadcast_obj, 1, pb_module_ble_
 /**
  * Decodes data that was received by the Bluetooth radio.
  *
- * @param [in]      data    Pointer to the start of the advertising data.
+ * @param [in]      data    Pointer to the start of the user broadcast data.
  * @param [in,out]  index   When calling, set to the index in @p data to read.
  *                          On return, the value is updated to the next index.
  * @returns                 The decoded value as a Python object.
  * @throws RuntimeError     If the data was invalid and could not be decoded.
  */
-static mp_obj_t pb_module_ble_decode(const observed_data_t *data, size_t *index) {
-    uint8_t size = data->data[*index] & 0x1F;
-    pb_ble_broadcast_data_type_t data_type = data->data[*index] >> 5;
+static mp_obj_t pb_module_ble_decode(const uint8_t *data, size_t *index) {
+    uint8_t size = data[*index] & 0x1F;
+    pb_ble_broadcast_data_type_t data_type = data[*index] >> 5;
 
     (*index)++;
 
@@ -347,19 +414,19 @@ static mp_obj_t pb_module_ble_decode(const observed_data_t *data, size_t *index)
             return mp_const_false;
         case PB_BLE_BROADCAST_DATA_TYPE_INT:
             if (size == sizeof(int8_t)) {
-                int8_t int8_value = data->data[*index];
+                int8_t int8_value = data[*index];
                 (*index) += sizeof(int8_value);
                 return MP_OBJ_NEW_SMALL_INT(int8_value);
             }
 
             if (size == sizeof(int16_t)) {
-                int16_t int16_value = pbio_get_uint16_le(&data->data[*index]);
+                int16_t int16_value = pbio_get_uint16_le(&data[*index]);
                 (*index) += sizeof(int16_value);
                 return MP_OBJ_NEW_SMALL_INT(int16_value);
             }
 
             if (size == sizeof(int32_t)) {
-                int32_t int32_value = pbio_get_uint32_le(&data->data[*index]);
+                int32_t int32_value = pbio_get_uint32_le(&data[*index]);
                 (*index) += sizeof(int32_value);
                 return mp_obj_new_int(int32_value);
             }
@@ -373,7 +440,7 @@ static mp_obj_t pb_module_ble_decode(const observed_data_t *data, size_t *index)
                 float f;
                 uint32_t u;
             } float_value;
-            float_value.u = pbio_get_uint32_le(&data->data[*index]);
+            float_value.u = pbio_get_uint32_le(&data[*index]);
             (*index) += sizeof(float_value);
             return mp_obj_new_float_from_f(float_value.f);
         }
@@ -382,13 +449,13 @@ static mp_obj_t pb_module_ble_decode(const observed_data_t *data, size_t *index)
             #endif
 
         case PB_BLE_BROADCAST_DATA_TYPE_STR: {
-            const char *str_data = (void *)&data->data[*index];
+            const char *str_data = (void *)&data[*index];
             (*index) += size;
             return mp_obj_new_str(str_data, size);
         }
 
         case PB_BLE_BROADCAST_DATA_TYPE_BYTES: {
-            const byte *bytes_data = (void *)&data->data[*index];
+            const byte *bytes_data = (void *)&data[*index];
             (*index) += size;
             return mp_obj_new_bytes(bytes_data, size);
         }
@@ -396,11 +463,55 @@ static mp_obj_t pb_module_ble_decode(const observed_data_t *data, size_t *index)
             // Does not contain data by itself, is only used as indicator
             // that the next data is the one and only object.
             break;
+        case PB_BLE_BROADCAST_DATA_TYPE_SEQUENCE:
+            // Only valid as header, handled by pb_module_ble_decode_values.
+            break;
     }
 
     mp_raise_msg(&mp_type_RuntimeError, MP_ERROR_TEXT("received bad data"));
 }
 
+/**
+ * Decodes all values in the user broadcast data.
+ *
+ * @param [in]  data        Pointer to the start of the user broadcast data.
+ * @param [in]  size        Size of @p data in bytes.
+ * @param [out] sequence    The sequence number or -1 if the data has none.
+ * @returns                 The one and only decoded value or a tuple of values.
+ * @throws RuntimeError     If the data was invalid and could not be decoded.
+ */
+static mp_obj_t pb_module_ble_decode_values(const uint8_t *data, uint8_t size, mp_int_t *sequence) {
+
+    // Skip optional sequence number.
+    size_t index = 0;
+    *sequence = -1;
+    if (size >= 2 && data[0] == (PB_BLE_BROADCAST_DATA_TYPE_SEQUENCE << 5 | 1)) {
+        *sequence = data[1];
+        index = 2;
+    }
+
+    // Handle single object.
+    if (size > index && data[index] >> 5 == PB_BLE_BROADCAST_DATA_TYPE_SINGLE_OBJECT) {
+        index++;
+        return pb_module_ble_decode(data, &index);
+    }
+
+    // Objects can be encoded in as little as one byte so we could have up to
+    // this many objects received.
+    mp_obj_t items[OBSERVED_DATA_MAX_SIZE];
+
+    size_t i;
+    for (i = 0; i < OBSERVED_DATA_MAX_SIZE; i++) {
+        if (index >= size) {
+            break;
+        }
+
+        items[i] = pb_module_ble_decode(data, &index);
+    }
+
+    return mp_obj_new_tuple(i, items);
+}
+
 /**
  * Retrieves the last received advertising data.
  *
@@ -412,7 +523,7 @@ static mp_obj_t pb_module_ble_decode(const observed_data_t *data, size_t *index)
  * @throws ValueError       If the channel is out of range.
  * @throws RuntimeError     If the last received data was invalid.
  */
-static const observed_data_t *pb_module_ble_get_channel_data(mp_obj_t channel_in) {
+static observed_data_t *pb_module_ble_get_channel_data(mp_obj_t channel_in) {
     mp_int_t channel = mp_obj_get_int(channel_in);
 
     observed_data_t *ch_data = lookup_observed_data(channel);
@@ -425,6 +536,7 @@ static const observed_data_t *pb_module_ble_get_channel_data(mp_obj_t channel_in
     if (mp_hal_ticks_ms() - ch_data->timestamp > OBSERVED_DATA_TIMEOUT_MS) {
         ch_data->size = 0;
         ch_data->rssi = INT8_MIN;
+        ch_data->decoded = MP_OBJ_NULL;
     }
 
     return ch_data;
@@ -443,45 +555,89 @@ static const observed_data_t *pb_module_ble_get_channel_data(mp_obj_t channel_in
  */
 static mp_obj_t pb_module_ble_observe(mp_obj_t self_in, mp_obj_t channel_in) {
 
-    // BEWARE OF DRAGONS: The data returned by pb_module_ble_get_channel_data()
-    // is only valid until the next PBIO event is processed, which can happen
-    // during any MicroPython function call that allocates memory. So, we have
-    // to make a copy of it since we are potentially allocating multiple times
-    // in a loop below.
-    const observed_data_t ch_data = *pb_module_ble_get_channel_data(channel_in);
+    observed_data_t *ch_data = pb_module_ble_get_channel_data(channel_in);
 
     // Have not received data yet or timed out.
-    if (ch_data.rssi == INT8_MIN) {
+    if (ch_data->rssi == INT8_MIN) {
 
         pbdrv_bluetooth_restart_observing_request();
 
         return mp_const_none;
     }
 
-    // Handle single object.
-    if (ch_data.size != 0 && ch_data.data[0] >> 5 == PB_BLE_BROADCAST_DATA_TYPE_SINGLE_OBJECT) {
-        size_t value_index = 1;
-        return pb_module_ble_decode(&ch_data, &value_index);
+    // Data has not changed since it was last decoded.
+    if (ch_data->decoded != MP_OBJ_NULL) {
+        return ch_data->decoded;
     }
 
-    // Objects can be encoded in as little as one byte so we could have up to
-    // this many objects received.
-    mp_obj_t items[OBSERVED_DATA_MAX_SIZE];
+    // BEWARE OF DRAGONS: The data returned by pb_module_ble_get_channel_data()
+    // is only valid until the next PBIO event is processed, which can happen
+    // during any MicroPython function call that allocates memory. So, we have
+    // to make a copy of it since we are potentially allocating multiple times
+    // in a loop below.
+    observed_frame_t frame = { .size = ch_data->size };
+    memcpy(frame.data, ch_data->data, OBSERVED_DATA_MAX_SIZE);
 
-    size_t index = 0;
-    size_t i;
-    for (i = 0; i < OBSERVED_DATA_MAX_SIZE; i++) {
-        if (index >= ch_data.size) {
-            break;
-        }
+    mp_int_t sequence;
+    mp_obj_t decoded = pb_module_ble_decode_values(frame.data, frame.size, &sequence);
 
-        items[i] = pb_module_ble_decode(&ch_data, &index);
+    // Keep the result unless new data arrived while decoding.
+    if (ch_data->size == frame.size && !memcmp(ch_data->data, frame.data, frame.size)) {
+        ch_data->decoded = decoded;
     }
 
-    return mp_obj_new_tuple(i, items);
+    return decoded;
 }
 static MP_DEFINE_CONST_FUN_OBJ_2(pb_module_ble_observe_obj, pb_module_ble_observe);
 
+/**
+ * Retrieves messages received since the last call, oldest first.
+ *
+ * Unlike observe(), each message is returned only once. Up to
+ * ::OBSERVED_DATA_NUM_FRAMES messages are kept, older ones are dropped.
+ *
+ * @param [in]  self_in     The BLE object.
+ * @param [in]  channel_in  Python object containing the channel number.
+ * @returns                 List of (age, sequence, data) tuples, where age is
+ *                          the time in ms since the message was received and
+ *                          sequence is None if the broadcaster does not use
+ *                          sequence numbers.
+ * @throws ValueError       If the channel is out of range.
+ * @throws RuntimeError     If received data was invalid.
+ */
+static mp_obj_t pb_module_ble_receive(mp_obj_t self_in, mp_obj_t channel_in) {
+    observed_data_t *ch_data = lookup_observed_data(mp_obj_get_int(channel_in));
+
+    if (!ch_data) {
+        mp_raise_ValueError(MP_ERROR_TEXT("channel not configured"));
+    }
+
+    mp_obj_t list = mp_obj_new_list(0, NULL);
+
+    // New messages may arrive while allocating below, so only handle the
+    // ones that are here now.
+    for (size_t n = ch_data->num_frames; n > 0; n--) {
+        // Take a copy since the original may be overwritten while allocating.
+        observed_frame_t frame = ch_data->frames[ch_data->frames_start];
+        ch_data->frames_start = (ch_data->frames_start + 1) % OBSERVED_DATA_NUM_FRAMES;
+        ch_data->num_frames--;
+
+        mp_int_t sequence;
+        mp_obj_t items[] = {
+            mp_obj_new_int(mp_hal_ticks_ms() - frame.timestamp),
+            mp_const_none,
+            pb_module_ble_decode_values(frame.data, frame.size, &sequence),
+        };
+        if (sequence >= 0) {
+            items[1] = MP_OBJ_NEW_SMALL_INT(sequence);
+        }
+        mp_obj_list_append(list, mp_obj_new_tuple(MP_ARRAY_SIZE(items), items));
+    }
+
+    return list;
+}
+static MP_DEFINE_CONST_FUN_OBJ_2(pb_module_ble_receive_obj, pb_module_ble_receive);
+
 /**
  * Retrieves the filtered RSSI signal strength of the given channel.
  *
@@ -510,7 +666,7 @@ static MP_DEFINE_CONST_FUN_OBJ_1(pb_module_ble_version_obj, pb_module_ble_versio
 
 mp_obj_t pb_module_ble_data_close(mp_obj_t self_in) {
     observed_data = NULL;
-    num_observed_data = 0;
+    memset(observed_data_index, 0, sizeof(observed_data_index));
     return mp_const_none;
 }
 MP_DEFINE_CONST_FUN_OBJ_1(pb_module_ble_data_close_obj, pb_module_ble_data_close);
@@ -519,6 +675,7 @@ static const mp_rom_map_elem_t common_BLE_locals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR_broadcast), MP_ROM_PTR(&pb_module_ble_broadcast_obj) },
     { MP_ROM_QSTR(MP_QSTR___del__), MP_ROM_PTR(&pb_module_ble_data_close_obj) },
     { MP_ROM_QSTR(MP_QSTR_observe), MP_ROM_PTR(&pb_module_ble_observe_obj) },
+    { MP_ROM_QSTR(MP_QSTR_receive), MP_ROM_PTR(&pb_module_ble_receive_obj) },
     { MP_ROM_QSTR(MP_QSTR_signal_strength), MP_ROM_PTR(&pb_module_ble_signal_strength_obj) },
     { MP_ROM_QSTR(MP_QSTR_version), MP_ROM_PTR(&pb_module_ble_version_obj) },
 };
@@ -529,10 +686,11 @@ static MP_DEFINE_CONST_DICT(common_BLE_locals_dict, common_BLE_locals_dict_table
  *
  * @param [in]  broadcast_channel_in    (int) The channel number to use for broadcasting or None for no broadcasting.
  * @param [in]  observe_channels_in     (list[int]) A list of channels numbers to observe.
+ * @param [in]  sequence_numbers        Whether to include a sequence number in broadcasts.
  * @returns                             A newly allocated object.
  * @throws ValueError                   If either parameter contains an out of range channel number.
  */
-static mp_obj_t pb_type_ble_radio_init(mp_obj_t broadcast_channel_in, mp_obj_t observe_channels_in) {
+static mp_obj_t pb_type_ble_radio_init(mp_obj_t broadcast_channel_in, mp_obj_t observe_channels_in, bool sequence_numbers) {
 
     // Validate channel arguments.
     if (broadcast_channel_in != mp_const_none && (mp_obj_get_int(broadcast_channel_in) < 0 || mp_obj_get_int(broadcast_channel_in) > UINT8_MAX)) {
@@ -545,6 +703,9 @@ static mp_obj_t pb_type_ble_radio_init(mp_obj_t broadcast_channel_in, mp_obj_t o
 
     pb_obj_BLE_t *self = mp_obj_malloc_var_with_finaliser(pb_obj_BLE_t, observed_data_t, num_observe_channels, &pb_type_ble_radio);
     self->broadcast_channel = broadcast_channel_in;
+    self->sequence_numbers = sequence_numbers;
+    self->sequence = 0;
+    self->last_values_size = 0;
 
     for (mp_int_t i = 0; i < num_observe_channels; i++) {
         mp_int_t channel = mp_obj_get_int(mp_obj_subscr(
@@ -556,14 +717,25 @@ static mp_obj_t pb_type_ble_radio_init(mp_obj_t broadcast_channel_in, mp_obj_t o
 
         self->observed_data[i].channel = channel;
         self->observed_data[i].rssi = INT8_MIN;
+        self->observed_data[i].size = 0;
+        self->observed_data[i].decoded = MP_OBJ_NULL;
+        self->observed_data[i].frames_start = 0;
+        self->observed_data[i].num_frames = 0;
 
         // Suppress stale data by making everything outdated.
         self->observed_data[i].timestamp = mp_hal_ticks_ms() - RSSI_FILTER_WINDOW_MS - OBSERVED_DATA_TIMEOUT_MS;
     }
 
     // globals for driver callback
+    memset(observed_data_index, 0, sizeof(observed_data_index));
+    for (mp_int_t i = 0; i < num_observe_channels; i++) {
+        // If a channel is given twice, the first one is used.
+        uint8_t channel = self->observed_data[i].channel;
+        if (!observed_data_index[channel]) {
+            observed_data_index[channel] = i + 1;
+        }
+    }
     observed_data = self->observed_data;
-    num_observed_data = num_observe_channels;
 
     // Start observing right away by default.
     if (num_observe_channels > 0) {
@@ -578,15 +750,16 @@ static mp_obj_t pb_type_ble_radio_init(mp_obj_t broadcast_channel_in, mp_obj_t o
 static mp_obj_t pb_type_ble_radio_make_new(const mp_obj_type_t *type, size_t n_args, size_t n_kw, const mp_obj_t *args) {
     PB_PARSE_ARGS_CLASS(n_args, n_kw, args,
         PB_ARG_DEFAULT_NONE(broadcast_channel),
-        PB_ARG_DEFAULT_OBJ(observe_channels, mp_const_empty_tuple_obj));
-    return pb_type_ble_radio_init(broadcast_channel_in, observe_channels_in);
+        PB_ARG_DEFAULT_OBJ(observe_channels, mp_const_empty_tuple_obj),
+        PB_ARG_DEFAULT_FALSE(sequence_numbers));
+    return pb_type_ble_radio_init(broadcast_channel_in, observe_channels_in, mp_obj_is_true(sequence_numbers_in));
 }
 
 #if PYBRICKS_PY_MESSAGING_BLE_RADIO_OLD
 mp_obj_t pb_type_BLE_new(mp_obj_t broadcast_channel_in, mp_obj_t observe_channels_in) {
     if (broadcast_channel_in != mp_const_none || observe_channels_in != MP_OBJ_FROM_PTR(&mp_const_empty_tuple_obj)) {
         mp_printf(&mp_plat_print, "Hub messaging has been moved. You should use:\n\nfrom pybricks.messaging import BLERadio\nradio = BLERadio(broadcast_channel, observe_channels)\n\n");
-        return pb_type_ble_radio_init(broadcast_channel_in, observe_channels_in);
+        return pb_type_ble_radio_init(broadcast_channel_in, observe_channels_in, false);
     }
     return mp_const_none;
 }
@@ -1,5 +1,5 @@
 // SPDX-License-Identifier: MIT
-// Copyright (c) 2018-2023 The Pybricks Authors
+// Copyright (c) 2018-2026 The Pybricks Authors
 
 #include "py/mpconfig.h"
 
@@ -26,7 +26,7 @@
 typedef struct _pb_type_nxtdevices_colorsensor_obj_t {
     mp_obj_base_t base;
     pbio_port_t *port;
-    mp_obj_t color_map;
+    pb_color_map_t color_map;
 } pb_type_nxtdevices_colorsensor_obj_t;
 
 // pybricks.nxtdevices.ColorSensor.ambient
@@ -1,5 +1,5 @@
 // SPDX-License-Identifier: MIT
-// Copyright (c) 2018-2023 The Pybricks Authors
+// Copyright (c) 2018-2026 The Pybricks Authors
 
 #include "py/mpconfig.h"
 
@@ -22,10 +22,20 @@
 // Class structure for ColorSensor. Note: first two members must match pb_ColorSensor_obj_t
 typedef struct _pupdevices_ColorSensor_obj_t {
     pb_type_device_obj_base_t device_base;
-    mp_obj_t color_map;
+    pb_color_map_t color_map;
     mp_obj_t lights;
+    #if PYBRICKS_PY_DEVICES_COLOR_CALIBRATION
+    pbio_color_calibration_t calibration;
+    bool calibrated;
+    #endif
 } pupdevices_ColorSensor_obj_t;
 
+#if PYBRICKS_PY_DEVICES_COLOR_CALIBRATION
+// Raw RGB references without calibration. The RGB values range from 0 to 1024.
+static const int16_t pupdevices_ColorSensor_black[] = { 0, 0, 0 };
+static const int16_t pupdevices_ColorSensor_white[] = { 1024, 1024, 1024 };
+#endif
+
 // pybricks.pupdevices.ColorSensor.__init__
 static mp_obj_t pupdevices_ColorSensor_make_new(const mp_obj_type_t *type, size_t n_args, size_t n_kw, const mp_obj_t *args) {
     PB_PARSE_ARGS_CLASS(n_args, n_kw, args,
@@ -42,6 +52,10 @@ static mp_obj_t pupdevices_ColorSensor_make_new(const mp_obj_type_t *type, size_
 
     // Save default settings
     pb_color_map_save_default(&self->color_map);
+    #if PYBRICKS_PY_DEVICES_COLOR_CALIBRATION
+    pbio_color_calibration_reset(&self->calibration, pupdevices_ColorSensor_black, pupdevices_ColorSensor_white);
+    self->calibrated = false;
+    #endif
 
     return MP_OBJ_FROM_PTR(self);
 }
@@ -65,6 +79,16 @@ static PB_DEFINE_CONST_TYPE_DEVICE_METHOD_OBJ(get_ambient_obj, LEGO_DEVICE_MODE_
 // Helper for getting HSV with the light on.
 static void get_hsv_reflected(mp_obj_t self_in, pbio_color_hsv_t *hsv) {
     int16_t *data = pb_type_device_get_data(self_in, LEGO_DEVICE_MODE_PUP_COLOR_SENSOR__RGB_I);
+
+    #if PYBRICKS_PY_DEVICES_COLOR_CALIBRATION
+    // Calibration replaces the approximate adjustments below.
+    pupdevices_ColorSensor_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    if (self->calibrated) {
+        pbio_color_calibration_get_hsv(&self->calibration, data, hsv);
+        return;
+    }
+    #endif
+
     const pbio_color_rgb_t rgb = {
         .r = data[0] == 1024 ? 255 : data[0] >> 2,
         .g = data[1] == 1024 ? 255 : data[1] >> 2,
@@ -161,6 +185,59 @@ static mp_obj_t detectable_colors(size_t n_args, const mp_obj_t *pos_args, mp_ma
 }
 static MP_DEFINE_CONST_FUN_OBJ_KW(detectable_colors_obj, 1, detectable_colors);
 
+#if PYBRICKS_PY_DEVICES_COLOR_CALIBRATION
+// pybricks.pupdevices.ColorSensor.calibrate
+static mp_obj_t calibrate(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    PB_PARSE_ARGS_METHOD(n_args, pos_args, kw_args,
+        pupdevices_ColorSensor_obj_t, self,
+        PB_ARG_DEFAULT_NONE(white),
+        PB_ARG_DEFAULT_NONE(black),
+        PB_ARG_DEFAULT_NONE(matrix));
+
+    // Only measure if a reference should be taken from the current reading.
+    const int16_t *raw = pupdevices_ColorSensor_black;
+    if (white_in == mp_const_true || black_in == mp_const_true) {
+        raw = pb_type_device_get_data_blocking(MP_OBJ_FROM_PTR(self), LEGO_DEVICE_MODE_PUP_COLOR_SENSOR__RGB_I);
+    }
+
+    mp_obj_t ret = pb_color_calibration_method(&self->calibration, raw, white_in, black_in, matrix_in);
+    if (ret == mp_const_none) {
+        self->calibrated = true;
+    }
+    return ret;
+}
+static MP_DEFINE_CONST_FUN_OBJ_KW(calibrate_obj, 1, calibrate);
+
+// pybricks.pupdevices.ColorSensor.hsv_into
+static mp_obj_t hsv_into(mp_obj_t sensors_in, mp_obj_t buffer_in) {
+    mp_obj_t *sensors;
+    size_t num_sensors;
+    mp_obj_get_array(sensors_in, &num_sensors, &sensors);
+
+    // Each sensor gives h, s, and v as signed 16-bit values.
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(buffer_in, &bufinfo, MP_BUFFER_WRITE);
+    if (bufinfo.len < num_sensors * 3 * sizeof(int16_t)) {
+        mp_raise_msg(&mp_type_ValueError, MP_ERROR_TEXT("Buffer too small"));
+    }
+
+    for (size_t i = 0; i < num_sensors; i++) {
+        mp_obj_t sensor = pb_obj_get_base_class_obj(sensors[i], &pb_type_pupdevices_ColorSensor);
+
+        // Returns right away if the sensor is already measuring surface
+        // colors, which is the normal case for repeated calls.
+        pb_type_device_get_data_blocking(sensor, LEGO_DEVICE_MODE_PUP_COLOR_SENSOR__RGB_I);
+
+        pbio_color_hsv_t hsv;
+        get_hsv_reflected(sensor, &hsv);
+        pb_color_calibration_store_hsv(&hsv, &bufinfo, i);
+    }
+    return mp_const_none;
+}
+static MP_DEFINE_CONST_FUN_OBJ_2(hsv_into_fun_obj, hsv_into);
+static MP_DEFINE_CONST_STATICMETHOD_OBJ(hsv_into_obj, MP_ROM_PTR(&hsv_into_fun_obj));
+#endif // PYBRICKS_PY_DEVICES_COLOR_CALIBRATION
+
 static const pb_attr_dict_entry_t pupdevices_ColorSensor_attr_dict[] = {
     PB_DEFINE_CONST_ATTR_RO(MP_QSTR_lights, pupdevices_ColorSensor_obj_t, lights),
     PB_ATTR_DICT_SENTINEL
@@ -173,6 +250,10 @@ static const mp_rom_map_elem_t pupdevices_ColorSensor_locals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR_reflection),  MP_ROM_PTR(&get_reflection_obj)           },
     { MP_ROM_QSTR(MP_QSTR_ambient),     MP_ROM_PTR(&get_ambient_obj)              },
     { MP_ROM_QSTR(MP_QSTR_detectable_colors),   MP_ROM_PTR(&detectable_colors_obj)},
+    #if PYBRICKS_PY_DEVICES_COLOR_CALIBRATION
+    { MP_ROM_QSTR(MP_QSTR_calibrate),   MP_ROM_PTR(&calibrate_obj)                },
+    { MP_ROM_QSTR(MP_QSTR_hsv_into),    MP_ROM_PTR(&hsv_into_obj)                 },
+    #endif
 };
 static MP_DEFINE_CONST_DICT(pupdevices_ColorSensor_locals_dict, pupdevices_ColorSensor_locals_dict_table);
 
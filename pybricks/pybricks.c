@@ -1,5 +1,5 @@
 // SPDX-License-Identifier: MIT
-// Copyright (c) 2018-2023 The Pybricks Authors
+// Copyright (c) 2018-2026 The Pybricks Authors
 
 #include <string.h>
 
@@ -10,7 +10,9 @@
 #include "py/objtuple.h"
 #include "py/runtime.h"
 
+#include <pbdrv/block_device.h>
 #include <pbdrv/bluetooth.h>
+#include <pbio/config.h>
 #include <pbio/version.h>
 #include <pbsys/host.h>
 #include <pbsys/status.h>
@@ -190,3 +192,13 @@ void pb_package_pybricks_init(bool import_all) {
     pb_module_tools_init();
 }
 #endif // PYBRICKS_OPT_COMPILER
+
+/**
+ * Finishes background operations started by the user program before its
+ * heap is freed.
+ */
+void pb_package_pybricks_deinit(void) {
+    #if PYBRICKS_PY_COMMON_SYSTEM && PBIO_CONFIG_ENABLE_SYS && PBDRV_CONFIG_BLOCK_DEVICE_RESOURCE_SIZE
+    pb_type_System_resources_deinit();
+    #endif
+}
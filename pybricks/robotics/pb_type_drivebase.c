@@ -1,5 +1,5 @@
 // SPDX-License-Identifier: MIT
-// Copyright (c) 2018-2023 The Pybricks Authors
+// Copyright (c) 2018-2026 The Pybricks Authors
 
 #include "py/mpconfig.h"
 
@@ -35,6 +35,11 @@ struct _pb_type_DriveBase_obj_t {
     mp_obj_t distance_control;
     #endif
     pb_type_async_t *last_awaitable;
+    /**
+     * Trigger given to the most recent maneuver. Referenced here so that it
+     * is not garbage collected while the maneuver is running.
+     */
+    mp_obj_t until;
     /**
      * The move_by method is a sequence of a turn and a straight, so we
      * need to cache the arguments for the straight.
@@ -86,6 +91,7 @@ static mp_obj_t pb_type_DriveBase_make_new(const mp_obj_type_t *type, size_t n_a
     #endif
 
     self->last_awaitable = NULL;
+    self->until = mp_const_none;
 
     return MP_OBJ_FROM_PTR(self);
 }
@@ -135,12 +141,18 @@ static mp_obj_t pb_type_DriveBase_straight(size_t n_args, const mp_obj_t *pos_ar
         pb_type_DriveBase_obj_t, self,
         PB_ARG_REQUIRED(distance),
         PB_ARG_DEFAULT_OBJ(then, pb_Stop_HOLD_obj),
-        PB_ARG_DEFAULT_TRUE(wait));
+        PB_ARG_DEFAULT_TRUE(wait),
+        PB_ARG_DEFAULT_NONE(until));
 
     mp_int_t distance = pb_obj_get_int(distance_in);
     pbio_control_on_completion_t then = pb_type_enum_get_value(then_in, &pb_enum_type_Stop);
 
+    // Optionally stop early when a trigger fires.
+    pbio_trigger_t *until = pb_type_motor_get_until(until_in);
+
     pb_assert(pbio_drivebase_drive_straight(self->db, distance, then));
+    pb_assert(pbio_drivebase_set_stop_trigger(self->db, until, then));
+    self->until = until_in;
 
     // Old way to do parallel movement is to start and not wait on anything.
     if (!mp_obj_is_true(wait_in)) {
@@ -158,12 +170,18 @@ static mp_obj_t pb_type_DriveBase_turn(size_t n_args, const mp_obj_t *pos_args,
         PB_ARG_REQUIRED(angle),
         PB_ARG_DEFAULT_OBJ(then, pb_Stop_HOLD_obj),
         PB_ARG_DEFAULT_TRUE(wait),
-        PB_ARG_DEFAULT_FALSE(absolute));
+        PB_ARG_DEFAULT_FALSE(absolute),
+        PB_ARG_DEFAULT_NONE(until));
 
     mp_int_t angle = pb_obj_get_int(angle_in);
     pbio_control_on_completion_t then = pb_type_enum_get_value(then_in, &pb_enum_type_Stop);
 
+    // Optionally stop early when a trigger fires.
+    pbio_trigger_t *until = pb_type_motor_get_until(until_in);
+
     pb_assert(pbio_drivebase_drive_turn(self->db, angle, mp_obj_is_true(absolute_in), then));
+    pb_assert(pbio_drivebase_set_stop_trigger(self->db, until, then));
+    self->until = until_in;
 
     // Old way to do parallel movement is to start and not wait on anything.
     if (!mp_obj_is_true(wait_in)) {
@@ -242,13 +260,19 @@ static mp_obj_t pb_type_DriveBase_curve(size_t n_args, const mp_obj_t *pos_args,
         PB_ARG_REQUIRED(radius),
         PB_ARG_REQUIRED(angle),
         PB_ARG_DEFAULT_OBJ(then, pb_Stop_HOLD_obj),
-        PB_ARG_DEFAULT_TRUE(wait));
+        PB_ARG_DEFAULT_TRUE(wait),
+        PB_ARG_DEFAULT_NONE(until));
 
     mp_int_t radius = pb_obj_get_int(radius_in);
     mp_int_t angle = pb_obj_get_int(angle_in);
     pbio_control_on_completion_t then = pb_type_enum_get_value(then_in, &pb_enum_type_Stop);
 
+    // Optionally stop early when a trigger fires.
+    pbio_trigger_t *until = pb_type_motor_get_until(until_in);
+
     pb_assert(pbio_drivebase_drive_curve(self->db, radius, angle, then));
+    pb_assert(pbio_drivebase_set_stop_trigger(self->db, until, then));
+    self->until = until_in;
 
     // Old way to do parallel movement is to start and not wait on anything.
     if (!mp_obj_is_true(wait_in)) {
@@ -267,7 +291,8 @@ static mp_obj_t pb_type_DriveBase_arc(size_t n_args, const mp_obj_t *pos_args, m
         PB_ARG_DEFAULT_NONE(angle),
         PB_ARG_DEFAULT_NONE(distance),
         PB_ARG_DEFAULT_OBJ(then, pb_Stop_HOLD_obj),
-        PB_ARG_DEFAULT_TRUE(wait));
+        PB_ARG_DEFAULT_TRUE(wait),
+        PB_ARG_DEFAULT_NONE(until));
 
     // Parse user arguments.
     mp_int_t radius = pb_obj_get_int(radius_in);
@@ -277,11 +302,16 @@ static mp_obj_t pb_type_DriveBase_arc(size_t n_args, const mp_obj_t *pos_args, m
 
     pbio_control_on_completion_t then = pb_type_enum_get_value(then_in, &pb_enum_type_Stop);
 
+    // Optionally stop early when a trigger fires.
+    pbio_trigger_t *until = pb_type_motor_get_until(until_in);
+
     if (distance_in != mp_const_none) {
         pb_assert(pbio_drivebase_drive_arc_distance(self->db, radius, pb_obj_get_int(distance_in), then));
     } else {
         pb_assert(pbio_drivebase_drive_arc_angle(self->db, radius, pb_obj_get_int(angle_in), then));
     }
+    pb_assert(pbio_drivebase_set_stop_trigger(self->db, until, then));
+    self->until = until_in;
 
     // Old way to do parallel movement is to start and not wait on anything.
     if (!mp_obj_is_true(wait_in)) {
@@ -383,6 +413,36 @@ static mp_obj_t pb_type_DriveBase_state(mp_obj_t self_in) {
 }
 MP_DEFINE_CONST_FUN_OBJ_1(pb_type_DriveBase_state_obj, pb_type_DriveBase_state);
 
+// pybricks.robotics.DriveBase.pose
+static mp_obj_t pb_type_DriveBase_pose(mp_obj_t self_in) {
+    pb_type_DriveBase_obj_t *self = MP_OBJ_TO_PTR(self_in);
+
+    int32_t x, y, heading;
+    pb_assert(pbio_drivebase_get_pose(self->db, &x, &y, &heading));
+
+    mp_obj_t ret[3];
+    ret[0] = mp_obj_new_int(x);
+    ret[1] = mp_obj_new_int(y);
+    ret[2] = mp_obj_new_int(heading);
+
+    return mp_obj_new_tuple(3, ret);
+}
+MP_DEFINE_CONST_FUN_OBJ_1(pb_type_DriveBase_pose_obj, pb_type_DriveBase_pose);
+
+// pybricks.robotics.DriveBase.reset_pose
+static mp_obj_t pb_type_DriveBase_reset_pose(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    PB_PARSE_ARGS_METHOD(n_args, pos_args, kw_args,
+        pb_type_DriveBase_obj_t, self,
+        PB_ARG_DEFAULT_INT(x, 0),
+        PB_ARG_DEFAULT_INT(y, 0),
+        PB_ARG_DEFAULT_INT(heading, 0));
+
+    pb_assert(pbio_drivebase_reset_pose(self->db, pb_obj_get_int(x_in), pb_obj_get_int(y_in), pb_obj_get_int(heading_in)));
+
+    return mp_const_none;
+}
+static MP_DEFINE_CONST_FUN_OBJ_KW(pb_type_DriveBase_reset_pose_obj, 1, pb_type_DriveBase_reset_pose);
+
 // pybricks.robotics.DriveBase.done
 static mp_obj_t pb_type_DriveBase_done(mp_obj_t self_in) {
     pb_type_DriveBase_obj_t *self = MP_OBJ_TO_PTR(self_in);
@@ -487,6 +547,8 @@ static const mp_rom_map_elem_t pb_type_DriveBase_locals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR_done),             MP_ROM_PTR(&pb_type_DriveBase_done_obj)     },
     { MP_ROM_QSTR(MP_QSTR_state),            MP_ROM_PTR(&pb_type_DriveBase_state_obj)    },
     { MP_ROM_QSTR(MP_QSTR_reset),            MP_ROM_PTR(&pb_type_DriveBase_reset_obj)    },
+    { MP_ROM_QSTR(MP_QSTR_pose),             MP_ROM_PTR(&pb_type_DriveBase_pose_obj)     },
+    { MP_ROM_QSTR(MP_QSTR_reset_pose),       MP_ROM_PTR(&pb_type_DriveBase_reset_pose_obj) },
     { MP_ROM_QSTR(MP_QSTR_settings),         MP_ROM_PTR(&pb_type_DriveBase_settings_obj) },
     { MP_ROM_QSTR(MP_QSTR_stalled),          MP_ROM_PTR(&pb_type_DriveBase_stalled_obj)  },
     #if PYBRICKS_PY_ROBOTICS_DRIVEBASE_GYRO
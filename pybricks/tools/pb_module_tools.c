@@ -1,5 +1,5 @@
 // SPDX-License-Identifier: MIT
-// Copyright (c) 2018-2023 The Pybricks Authors
+// Copyright (c) 2018-2026 The Pybricks Authors
 
 #include "py/mpconfig.h"
 
@@ -21,6 +21,7 @@
 #include <pbsys/light.h>
 #include <pbsys/program_stop.h>
 #include <pbsys/status.h>
+#include <pbsys/storage.h>
 
 #include <pybricks/parameters.h>
 #include <pybricks/common.h>
@@ -192,6 +193,89 @@ static mp_obj_t pb_module_tools_run_task(size_t n_args, const mp_obj_t *pos_args
 }
 static MP_DEFINE_CONST_FUN_OBJ_KW(pb_module_tools_run_task_obj, 0, pb_module_tools_run_task);
 
+#if PBSYS_CONFIG_STORAGE_KV_SIZE
+
+/**
+ * Gets the buffer of a key given as str or bytes.
+ *
+ * @param [in]  key_in  The key object.
+ * @param [out] info    The buffer info.
+ */
+static void pb_module_tools_get_key(mp_obj_t key_in, mp_buffer_info_t *info) {
+    if (mp_obj_is_str(key_in)) {
+        size_t len;
+        info->buf = (void *)mp_obj_str_get_data(key_in, &len);
+        info->len = len;
+        return;
+    }
+    mp_get_buffer_raise(key_in, info, MP_BUFFER_READ);
+}
+
+/**
+ * Gets a value that was saved with save_value().
+ *
+ * @param [in]  key     The key as str or bytes.
+ * @returns The saved value as bytes, or @c None if nothing was saved.
+ */
+static mp_obj_t pb_module_tools_load_value(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    PB_PARSE_ARGS_FUNCTION(n_args, pos_args, kw_args,
+        PB_ARG_REQUIRED(key));
+
+    mp_buffer_info_t key;
+    pb_module_tools_get_key(key_in, &key);
+
+    const uint8_t *value;
+    uint32_t size;
+    pb_assert(pbsys_storage_kv_get(key.buf, key.len, &value, &size));
+
+    if (!value) {
+        return mp_const_none;
+    }
+    return mp_obj_new_bytes(value, size);
+}
+static MP_DEFINE_CONST_FUN_OBJ_KW(pb_module_tools_load_value_obj, 0, pb_module_tools_load_value);
+
+static pbio_error_t pb_module_tools_save_value_iter_once(pbio_os_state_t *state, mp_obj_t parent_obj) {
+    return pbsys_storage_kv_await_saved(state);
+}
+
+/**
+ * Saves a value in persistent storage right away. Unlike the user data in
+ * System.storage, this does not depend on the hub shutting down properly.
+ *
+ * @param [in]  key     The key as str or bytes.
+ * @param [in]  value   The value as bytes, or @c None to delete the key.
+ * @returns Awaitable that completes when the value is stored.
+ */
+static mp_obj_t pb_module_tools_save_value(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    PB_PARSE_ARGS_FUNCTION(n_args, pos_args, kw_args,
+        PB_ARG_REQUIRED(key),
+        PB_ARG_REQUIRED(value));
+
+    mp_buffer_info_t key;
+    pb_module_tools_get_key(key_in, &key);
+
+    mp_buffer_info_t value = { .buf = NULL, .len = 0 };
+    if (value_in != mp_const_none) {
+        mp_get_buffer_raise(value_in, &value, MP_BUFFER_READ);
+        if (value.len == 0) {
+            mp_raise_ValueError(MP_ERROR_TEXT("Use None to delete a value."));
+        }
+    }
+
+    // Copies the value, so it is safe to wait for it to be written below.
+    pb_assert(pbsys_storage_kv_set(key.buf, key.len, value.buf, value.len));
+
+    pb_type_async_t config = {
+        .parent_obj = mp_const_none,
+        .iter_once = pb_module_tools_save_value_iter_once,
+    };
+    return pb_type_async_wait_or_await(&config, NULL, false);
+}
+static MP_DEFINE_CONST_FUN_OBJ_KW(pb_module_tools_save_value_obj, 0, pb_module_tools_save_value);
+
+#endif // PBSYS_CONFIG_STORAGE_KV_SIZE
+
 // Reset global awaitable state when user program starts.
 void pb_module_tools_init(void) {
     memset(waits, 0, sizeof(waits));
@@ -308,6 +392,10 @@ static const mp_rom_map_elem_t tools_globals_table[] = {
     { MP_ROM_QSTR(MP_QSTR_hub_menu),    MP_ROM_PTR(&pb_module_tools_hub_menu_obj)     },
     #endif // PYBRICKS_PY_TOOLS_HUB_MENU
     { MP_ROM_QSTR(MP_QSTR_run_task),    MP_ROM_PTR(&pb_module_tools_run_task_obj)     },
+    #if PBSYS_CONFIG_STORAGE_KV_SIZE
+    { MP_ROM_QSTR(MP_QSTR_load_value),  MP_ROM_PTR(&pb_module_tools_load_value_obj)   },
+    { MP_ROM_QSTR(MP_QSTR_save_value),  MP_ROM_PTR(&pb_module_tools_save_value_obj)   },
+    #endif // PBSYS_CONFIG_STORAGE_KV_SIZE
     { MP_ROM_QSTR(MP_QSTR_StopWatch),   MP_ROM_PTR(&pb_type_StopWatch)                },
     { MP_ROM_QSTR(MP_QSTR_multitask),   MP_ROM_PTR(&pb_type_Task)                     },
     #if MICROPY_PY_BUILTINS_FLOAT
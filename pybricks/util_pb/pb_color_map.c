@@ -1,5 +1,5 @@
 // SPDX-License-Identifier: MIT
-// Copyright (c) 2018-2020 The Pybricks Authors
+// Copyright (c) 2018-2026 The Pybricks Authors
 
 #include "py/mpconfig.h"
 
@@ -11,11 +11,14 @@
 
 #include <stdint.h>
 #include <stdio.h>
+#include <string.h>
 
 #include <pbio/error.h>
 #include <pbio/color.h>
+#include <pbio/int_math.h>
 
 #include "py/obj.h"
+#include "py/runtime.h"
 
 #include <pybricks/parameters.h>
 
@@ -55,61 +58,51 @@ static const mp_rom_obj_tuple_t pb_color_map_default = {
     }
 };
 
+// Precomputed classifier for the default map. These are all idealized colors,
+// so they use the saturation heuristic.
+static const pb_color_map_entry_t pb_color_map_default_entries[] = {
+    { .hsv = {PBIO_COLOR_HUE_RED, 100, 100}, .color = MP_OBJ_FROM_PTR(&pb_Color_RED_obj) },
+    { .hsv = {PBIO_COLOR_HUE_YELLOW, 100, 100}, .color = MP_OBJ_FROM_PTR(&pb_Color_YELLOW_obj) },
+    { .hsv = {PBIO_COLOR_HUE_GREEN, 100, 100}, .color = MP_OBJ_FROM_PTR(&pb_Color_GREEN_obj) },
+    { .hsv = {PBIO_COLOR_HUE_BLUE, 100, 100}, .color = MP_OBJ_FROM_PTR(&pb_Color_BLUE_obj) },
+    { .hsv = {0, 0, 100}, .color = MP_OBJ_FROM_PTR(&pb_Color_WHITE_obj) },
+    { .hsv = {0, 0, 0}, .color = MP_OBJ_FROM_PTR(&pb_Color_NONE_obj) },
+};
+
 // Set initial default map
-void pb_color_map_save_default(mp_obj_t *color_map) {
-    *color_map = MP_OBJ_FROM_PTR(&pb_color_map_default);
+void pb_color_map_save_default(pb_color_map_t *color_map) {
+    color_map->colors = MP_OBJ_FROM_PTR(&pb_color_map_default);
+    color_map->entries = pb_color_map_default_entries;
+    color_map->num_entries = MP_ARRAY_SIZE(pb_color_map_default_entries);
+    color_map->distance_func = pbio_color_get_distance_saturation_heuristic;
 }
 
 // Get a discrete color that matches the given hsv values most closely
-mp_obj_t pb_color_map_get_color(mp_obj_t *color_map, pbio_color_hsv_t *hsv) {
-
-    // Unpack the main list
-    mp_obj_t *colors;
-    size_t n;
-    mp_obj_get_array(*color_map, &n, &colors);
+mp_obj_t pb_color_map_get_color(const pb_color_map_t *color_map, const pbio_color_hsv_t *hsv) {
 
     // Initialize minimal cost to maximum
     mp_obj_t match = mp_const_none;
-    int32_t cost_now = INT32_MAX;
     int32_t cost_min = INT32_MAX;
 
-    pbio_color_distance_func_t distance_func = pbio_color_get_distance_saturation_heuristic;
-
-    // If user only provides fully saturated colors (hue, 100, 100) and/or fully
-    // desaturated colors (0, 0, value), use a simplified heuristic matcher for
-    // better default results that are distance independent. Otherwise use a
-    // bicone color distance measure.
-    for (size_t i = 0; i < n; i++) {
-        const pbio_color_hsv_t *candidate = pb_type_Color_get_hsv(colors[i]);
-
-        // Use bicone mapping if custom (realistic) colors provided.
-        bool idealized_grayscale = candidate->s == 0 && candidate->h == 0;
-        bool idealized_color = candidate->s == 100 && candidate->v == 100;
-        if (!idealized_grayscale && !idealized_color) {
-            distance_func = pbio_color_get_distance_bicone_squared;
-            break;
-        }
-    }
-
     // Compute cost for each candidate
-    for (size_t i = 0; i < n; i++) {
+    for (size_t i = 0; i < color_map->num_entries; i++) {
 
         // Evaluate the cost function
-        cost_now = distance_func(hsv, pb_type_Color_get_hsv(colors[i]));
+        int32_t cost_now = color_map->distance_func(hsv, &color_map->entries[i].hsv);
 
         // If cost is less than before, update the minimum and the match
         if (cost_now < cost_min) {
             cost_min = cost_now;
-            match = colors[i];
+            match = color_map->entries[i].color;
         }
     }
     return match;
 }
 
-mp_obj_t pb_color_map_detectable_colors_method(mp_obj_t *self_color_map, mp_obj_t colors_in) {
+mp_obj_t pb_color_map_detectable_colors_method(pb_color_map_t *color_map, mp_obj_t colors_in) {
     // If no arguments are given, return current map
     if (colors_in == mp_const_none) {
-        return *self_color_map;
+        return color_map->colors;
     }
 
     // If arguments given, ensure all tuple elements have the right type
@@ -120,9 +113,106 @@ mp_obj_t pb_color_map_detectable_colors_method(mp_obj_t *self_color_map, mp_obj_
         pb_assert_type(color_objs[i], &pb_type_Color);
     }
 
+    // Copy the HSV values so that matching does not have to look up objects.
+    // The user may change the list they passed in later on, so the entries
+    // are made from a tuple copy, which is also what gets returned above.
+    pb_color_map_entry_t *entries = m_new(pb_color_map_entry_t, n);
+
+    // If user only provides fully saturated colors (hue, 100, 100) and/or fully
+    // desaturated colors (0, 0, value), use a simplified heuristic matcher for
+    // better default results that are distance independent. Otherwise use a
+    // bicone color distance measure.
+    pbio_color_distance_func_t distance_func = pbio_color_get_distance_saturation_heuristic;
+    for (size_t i = 0; i < n; i++) {
+        const pbio_color_hsv_t *candidate = pb_type_Color_get_hsv(color_objs[i]);
+        entries[i].hsv = *candidate;
+        entries[i].color = color_objs[i];
+
+        // Use bicone mapping if custom (realistic) colors provided.
+        bool idealized_grayscale = candidate->s == 0 && candidate->h == 0;
+        bool idealized_color = candidate->s == 100 && candidate->v == 100;
+        if (!idealized_grayscale && !idealized_color) {
+            distance_func = pbio_color_get_distance_bicone_squared;
+        }
+    }
+
     // Save the given map
-    *self_color_map = colors_in;
+    color_map->colors = mp_obj_new_tuple(n, color_objs);
+    color_map->entries = entries;
+    color_map->num_entries = n;
+    color_map->distance_func = distance_func;
+    return mp_const_none;
+}
+
+#if PYBRICKS_PY_DEVICES_COLOR_CALIBRATION
+
+// Gets a reference from a tuple of raw values, or from the current raw values
+// if the argument is True.
+static void pb_color_calibration_get_reference(mp_obj_t reference_in, const int16_t *raw, int16_t *reference) {
+    if (reference_in == mp_const_true) {
+        memcpy(reference, raw, sizeof(int16_t) * 3);
+        return;
+    }
+    mp_obj_t *values;
+    mp_obj_get_array_fixed_n(reference_in, 3, &values);
+    for (size_t i = 0; i < 3; i++) {
+        reference[i] = pb_obj_get_int(values[i]);
+    }
+}
+
+// Sets or gets the calibration. The raw values are the current reading,
+// used when a reference is given as True.
+mp_obj_t pb_color_calibration_method(pbio_color_calibration_t *cal, const int16_t *raw, mp_obj_t white_in, mp_obj_t black_in, mp_obj_t matrix_in) {
+
+    // If no arguments are given, return current calibration.
+    if (white_in == mp_const_none && black_in == mp_const_none && matrix_in == mp_const_none) {
+        mp_obj_t white[3];
+        mp_obj_t black[3];
+        mp_obj_t matrix[9];
+        for (size_t i = 0; i < 3; i++) {
+            white[i] = mp_obj_new_int(cal->white[i]);
+            black[i] = mp_obj_new_int(cal->black[i]);
+        }
+        for (size_t i = 0; i < 9; i++) {
+            matrix[i] = pb_obj_new_fraction(cal->matrix[i], PBIO_COLOR_CALIBRATION_SCALE);
+        }
+        mp_obj_t ret[] = {
+            mp_obj_new_tuple(3, white),
+            mp_obj_new_tuple(3, black),
+            mp_obj_new_tuple(9, matrix),
+        };
+        return mp_obj_new_tuple(MP_ARRAY_SIZE(ret), ret);
+    }
+
+    // Parse everything before changing anything, so that errors leave the
+    // calibration as it was.
+    pbio_color_calibration_t new_cal = *cal;
+    if (white_in != mp_const_none) {
+        pb_color_calibration_get_reference(white_in, raw, new_cal.white);
+    }
+    if (black_in != mp_const_none) {
+        pb_color_calibration_get_reference(black_in, raw, new_cal.black);
+    }
+    if (matrix_in != mp_const_none) {
+        mp_obj_t *values;
+        mp_obj_get_array_fixed_n(matrix_in, 9, &values);
+        for (size_t i = 0; i < 9; i++) {
+            new_cal.matrix[i] = pbio_int_math_bind(pb_obj_get_scaled_int(values[i], PBIO_COLOR_CALIBRATION_SCALE), INT16_MIN, INT16_MAX);
+        }
+    }
+    if (pbio_color_calibration_set(cal, new_cal.black, new_cal.white, new_cal.matrix) != PBIO_SUCCESS) {
+        mp_raise_ValueError(MP_ERROR_TEXT("white must be brighter than black"));
+    }
     return mp_const_none;
 }
 
+// Stores hsv in a buffer as three signed 16-bit values at the given index,
+// so it can be read as array('h') without allocation.
+void pb_color_calibration_store_hsv(const pbio_color_hsv_t *hsv, mp_buffer_info_t *bufinfo, size_t index) {
+    const int16_t values[] = { hsv->h, hsv->s, hsv->v };
+    memcpy((uint8_t *)bufinfo->buf + index * sizeof(values), values, sizeof(values));
+}
+
+#endif // PYBRICKS_PY_DEVICES_COLOR_CALIBRATION
+
 #endif // PYBRICKS_PY_NXTDEVICES || PYBRICKS_PY_PUPDEVICES
@@ -1,5 +1,5 @@
 // SPDX-License-Identifier: MIT
-// Copyright (c) 2018-2020 The Pybricks Authors
+// Copyright (c) 2018-2026 The Pybricks Authors
 
 #ifndef _PBHSV_H_
 #define _PBHSV_H_
@@ -8,12 +8,38 @@
 
 #include "py/obj.h"
 
+// A detectable color with its HSV value copied out of the Color object.
+typedef struct _pb_color_map_entry_t {
+    pbio_color_hsv_t hsv;
+    mp_obj_t color;
+} pb_color_map_entry_t;
+
+// Color classifier, precomputed whenever the detectable colors are set so
+// that matching a measurement is a plain loop over the entries.
+typedef struct _pb_color_map_t {
+    // Tuple of the colors given by the user, returned by detectable_colors().
+    mp_obj_t colors;
+    // Flat copy of the colors to match against.
+    const pb_color_map_entry_t *entries;
+    size_t num_entries;
+    // Distance metric, chosen once based on the given colors.
+    pbio_color_distance_func_t distance_func;
+} pb_color_map_t;
+
 void pb_color_map_rgb_to_hsv(const pbio_color_rgb_t *rgb, pbio_color_hsv_t *hsv);
 
-void pb_color_map_save_default(mp_obj_t *color_map);
+void pb_color_map_save_default(pb_color_map_t *color_map);
+
+mp_obj_t pb_color_map_get_color(const pb_color_map_t *color_map, const pbio_color_hsv_t *hsv);
+
+mp_obj_t pb_color_map_detectable_colors_method(pb_color_map_t *color_map, mp_obj_t colors_in);
+
+#if PYBRICKS_PY_DEVICES_COLOR_CALIBRATION
+
+mp_obj_t pb_color_calibration_method(pbio_color_calibration_t *cal, const int16_t *raw, mp_obj_t white_in, mp_obj_t black_in, mp_obj_t matrix_in);
 
-mp_obj_t pb_color_map_get_color(mp_obj_t *color_map, pbio_color_hsv_t *hsv);
+void pb_color_calibration_store_hsv(const pbio_color_hsv_t *hsv, mp_buffer_info_t *bufinfo, size_t index);
 
-mp_obj_t pb_color_map_detectable_colors_method(mp_obj_t *self_color_map, mp_obj_t colors_in);
+#endif // PYBRICKS_PY_DEVICES_COLOR_CALIBRATION
 
 #endif // _PBHSV_H_
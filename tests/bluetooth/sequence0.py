@@ -0,0 +1,13 @@
+from pybricks.tools import wait
+from pybricks.messaging import BLERadio
+
+radio = BLERadio(broadcast_channel=124, sequence_numbers=True)
+
+# Broadcast quickly. The receiver should see every value exactly once, unless
+# it falls behind by more than a few messages.
+for i in range(200):
+    radio.broadcast(["Count", i])
+    wait(20)
+
+radio.broadcast(b"STOP")
+wait(500)
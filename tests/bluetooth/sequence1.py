@@ -0,0 +1,18 @@
+from pybricks.tools import wait
+from pybricks.messaging import BLERadio
+
+radio = BLERadio(observe_channels=[124])
+
+last = None
+lost = 0
+
+while True:
+    for age, sequence, data in radio.receive(124):
+        if last is not None and sequence is not None:
+            lost += (sequence - last - 1) % 256
+        last = sequence
+        print(age, sequence, data)
+        if data == b"STOP":
+            print("Lost", lost, "messages")
+            raise SystemExit
+    wait(50)
@@ -0,0 +1,31 @@
+"""
+Hardware Module: Any hub connected to Pybricks Code or pybricksdev over BLE.
+
+Description: Measures how fast stdout is sent to the host. Prints lines of
+a few sizes and reports the effective throughput once all output has been
+sent. Short lines show how well small print calls are combined into full
+notifications. Compare the results before and after changes to the Bluetooth
+drivers or connection parameters.
+"""
+
+from pybricks.tools import StopWatch
+
+TOTAL_SIZE = 20000
+LINE_SIZES = [10, 100]
+
+watch = StopWatch()
+
+for line_size in LINE_SIZES:
+    line = "x" * (line_size - 1)
+    num_lines = TOTAL_SIZE // line_size
+
+    watch.reset()
+    for i in range(num_lines):
+        print(line)
+
+    # Printing returns once data is buffered, so this includes at most a few
+    # packets that are still being sent.
+    elapsed = watch.time()
+
+    print("Sent", line_size * num_lines, "bytes in lines of", line_size, "in", elapsed, "ms")
+    print("Throughput:", line_size * num_lines * 1000 // max(elapsed, 1), "bytes/s")
@@ -0,0 +1,38 @@
+"""
+Hardware Module: EV3 with NXT Ultrasonic Sensor on Port S1.
+
+Description: Polls the distance register in the background and reads the
+cached value without waiting for the bus. One-off reads still work while
+polling is active.
+"""
+
+from pybricks.iodevices import I2CDevice
+from pybricks.parameters import Port
+from pybricks.tools import StopWatch, wait
+
+# Power pin and quirk are the same as for the built-in UltrasonicSensor class.
+sensor = I2CDevice(Port.S1, 0x01, power_pin=1, nxt_quirk=True)
+wait(100)
+
+sensor.start_polling(reg=0x42, length=1, interval=100)
+
+# Nothing has been read yet.
+print("Initial:", sensor.latest())
+wait(300)
+
+# Cached reads take no time.
+watch = StopWatch()
+for i in range(100):
+    data, age = sensor.latest(map=lambda data: data[0] * 10)
+assert watch.time() < 50
+assert age <= 200
+print("Distance:", data, "mm, age:", age, "ms")
+
+# One-off reads are run by the poller in between polls.
+assert sensor.read(reg=0x08, length=4) == b"LEGO"
+
+sensor.stop_polling()
+try:
+    sensor.latest()
+except OSError:
+    print("Polling stopped.")
@@ -0,0 +1,40 @@
+# SPDX-License-Identifier: MIT
+# Copyright (c) 2026 The Pybricks Authors
+
+"""
+Hardware Module: 1
+
+Description: Verify that a motor command ends early when a sensor trigger
+fires. Start with the color sensor on white and roll it onto a black line
+within two seconds.
+"""
+
+from pybricks.iodevices import Trigger
+from pybricks.parameters import Port, Stop
+from pybricks.pupdevices import Motor
+from pybricks.tools import StopWatch
+
+motor = Motor(Port.A)
+watch = StopWatch()
+
+# Mode 1 is reflection in %. The command would take 5 seconds without it.
+trigger = Trigger(Port.B, mode=1, below=20, edge=True)
+motor.run_time(500, 5000, then=Stop.HOLD, until=trigger)
+
+assert trigger.triggered(), "Expected trigger to fire"
+assert watch.time() < 4000, "Expected command to end early"
+
+# A trigger that fires immediately ends the command right away.
+watch.reset()
+trigger = Trigger(Port.B, mode=1, above=-1)
+motor.run_angle(500, 720, until=trigger)
+assert watch.time() < 100, "Expected command to end immediately"
+
+# Cancelled triggers cannot be used.
+trigger = Trigger(Port.B, mode=1, below=-1)
+trigger.cancel()
+try:
+    motor.run_angle(500, 90, until=trigger)
+    raise Exception("Expected cancelled trigger to be rejected")
+except OSError:
+    pass
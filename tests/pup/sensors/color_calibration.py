@@ -0,0 +1,53 @@
+# SPDX-License-Identifier: MIT
+# Copyright (c) 2026 The Pybricks Authors
+
+"""
+Hardware Module: 1
+
+Description: Verifies white and black calibration and batch reading of
+calibrated HSV values.
+"""
+
+from pybricks.pupdevices import Motor, ColorSensor
+from pybricks.parameters import Port
+from uarray import array
+
+# Initialize devices.
+motor = Motor(Port.A)
+color_sensor = ColorSensor(Port.B)
+SPEED = 500
+
+# Color angle targets.
+WHITE = 75
+BLACK = 250
+
+# Take the references from the current readings.
+motor.run_target(SPEED, WHITE)
+color_sensor.calibrate(white=True)
+motor.run_target(SPEED, BLACK)
+color_sensor.calibrate(black=True)
+
+# Calibration can be read back and restored as given.
+white, black, matrix = color_sensor.calibrate()
+assert matrix == (1, 0, 0, 0, 1, 0, 0, 0, 1), "Expected identity matrix"
+color_sensor.calibrate(white=white, black=black, matrix=matrix)
+assert color_sensor.calibrate() == (white, black, matrix)
+
+# Black and white are now at the ends of the value range.
+buf = array("h", [0, 0, 0])
+ColorSensor.hsv_into([color_sensor], buf)
+assert buf[2] < 10, "Expected black, got {0}".format(buf[2])
+motor.run_target(SPEED, WHITE)
+ColorSensor.hsv_into([color_sensor], buf)
+assert buf[1] < 10 and buf[2] > 90, "Expected white, got {0}".format(buf)
+
+# The batch read matches the regular method.
+hsv = color_sensor.hsv()
+assert abs(hsv.v - buf[2]) < 5, "Expected same value"
+
+# Invalid references are rejected.
+try:
+    color_sensor.calibrate(white=black, black=white)
+    raise Exception("Expected ValueError")
+except ValueError:
+    pass
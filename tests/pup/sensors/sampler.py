@@ -0,0 +1,34 @@
+# SPDX-License-Identifier: MIT
+# Copyright (c) 2026 The Pybricks Authors
+
+"""
+Hardware Module: 1
+
+Description: Verify that the background sampler records the color sensor
+reflection mode at a fixed rate while the program is busy.
+"""
+
+from pybricks.iodevices import Sampler
+from pybricks.parameters import Port
+from pybricks.tools import wait
+from ustruct import unpack_from
+
+# Initialize the sampler for mode 1 (reflection) every 5 ms.
+SAMPLE_SIZE = 5
+sampler = Sampler(Port.B, mode=1, period=5)
+
+wait(500)
+data = sampler.read()
+sampler.stop()
+
+count = len(data) // SAMPLE_SIZE
+assert 95 <= count <= 101, "Expected about 100 samples, got {0}".format(count)
+assert sampler.dropped() == 0, "Expected no dropped samples"
+
+# Verify that samples are evenly spaced.
+previous = None
+for i in range(count):
+    time, value = unpack_from("<Ib", data, i * SAMPLE_SIZE)
+    if previous is not None:
+        assert time - previous == 5000, "Unexpected sample spacing"
+    previous = time
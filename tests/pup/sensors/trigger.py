@@ -0,0 +1,32 @@
+# SPDX-License-Identifier: MIT
+# Copyright (c) 2026 The Pybricks Authors
+
+"""
+Hardware Module: 1
+
+Description: Verify that a trigger on the color sensor reflection stops a
+motor as soon as the sensor moves from a white to a black surface. Start
+with the sensor on white and roll it onto a black line.
+"""
+
+from pybricks.iodevices import Trigger
+from pybricks.parameters import Port
+from pybricks.pupdevices import Motor
+from pybricks.tools import wait
+
+motor = Motor(Port.A)
+
+# Mode 1 is reflection in %.
+trigger = Trigger(Port.B, mode=1, below=20, edge=True, stop=motor)
+motor.run(500)
+
+value = trigger.wait()
+assert value < 20, "Expected dark value, got {0}".format(value)
+wait(100)
+assert abs(motor.speed()) < 50, "Expected motor to be stopped"
+
+# Cancelled triggers don't fire.
+trigger = Trigger(Port.B, mode=1, above=-1)
+assert trigger.triggered()
+trigger.cancel()
+assert not trigger.triggered()